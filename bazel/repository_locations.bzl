@@ -808,6 +808,7 @@ REPOSITORY_LOCATIONS_SPEC = dict(
         urls = ["https://github.com/facebook/zstd/archive/v{version}.tar.gz"],
         use_category = ["dataplane_ext"],
         extensions = [
+            "envoy.access_loggers.columnar_file",
             "envoy.compression.zstd.compressor",
             "envoy.compression.zstd.decompressor",
         ],
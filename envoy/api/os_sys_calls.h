@@ -146,6 +146,11 @@ public:
   virtual SysCallPtrResult mmap(void* addr, size_t length, int prot, int flags, int fd,
                                 off_t offset) PURE;
 
+  /**
+   * @see man 2 munmap
+   */
+  virtual SysCallIntResult munmap(void* addr, size_t length) PURE;
+
   /**
    * @see man 2 stat
    */
@@ -47,6 +47,16 @@ struct ConstRawSlice {
 
 using RawSliceVector = absl::InlinedVector<RawSlice, 16>;
 
+/**
+ * Result of Instance::coalesceForWrite().
+ */
+struct CoalesceResult {
+  // Number of bytes copied into coalesced slices.
+  uint64_t bytes_copied_{};
+  // Number of slices at the front of the buffer a write of at most max_slices slices will use.
+  uint64_t write_slices_{};
+};
+
 /**
  * A wrapper class to facilitate passing in externally owned data to a buffer via addBufferFragment.
  * When the buffer no longer needs the data passed in through a fragment, it calls done() on it.
@@ -263,6 +273,17 @@ public:
    */
   virtual void* linearize(uint32_t size) PURE;
 
+  /**
+   * Prepare the front of the buffer for a vectored write of at most max_slices slices. If the
+   * buffer holds more slices than that, runs of adjacent small slices are copied into new slices so
+   * that the write covers more data. Slices of at least copy_threshold bytes and slices referencing
+   * external fragments are never copied. The content of the buffer is unchanged.
+   * @param max_slices the maximum number of slices the caller will write at once.
+   * @param copy_threshold slices smaller than this are eligible for copying.
+   * @return CoalesceResult describing the copy and the resulting slice count.
+   */
+  virtual CoalesceResult coalesceForWrite(uint64_t max_slices, uint64_t copy_threshold) PURE;
+
   /**
    * Move a buffer into this buffer. As little copying is done as possible.
    * @param rhs supplies the buffer to move.
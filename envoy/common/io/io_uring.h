@@ -42,9 +42,22 @@ public:
    */
   IoUringSocket& socket() const { return socket_; }
 
+  /**
+   * Record the flags of the completion queue entry being delivered for the request.
+   */
+  void setCompletionFlags(uint32_t flags) { completion_flags_ = flags; }
+
+  /**
+   * Returns the flags of the completion queue entry being delivered for the request. Multishot and
+   * zero copy requests receive several completions, all but the last one have `IORING_CQE_F_MORE`
+   * set. Injected completions have no flags.
+   */
+  uint32_t completionFlags() const { return completion_flags_; }
+
 private:
   RequestType type_;
   IoUringSocket& socket_;
+  uint32_t completion_flags_{0};
 };
 
 /**
@@ -126,6 +139,25 @@ public:
   virtual IoUringResult prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                                       off_t offset, Request* user_data) PURE;
 
+  /**
+   * Prepares a zero copy sendmsg system call and puts it into the submission queue. The request
+   * receives a second completion flagged with `IORING_CQE_F_NOTIF` once the kernel no longer
+   * references the data, the data must stay valid until then.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareSendmsgZc(os_fd_t fd, const struct msghdr* msg,
+                                         Request* user_data) PURE;
+
+  /**
+   * Prepares a multishot recv system call reading into the buffers registered with
+   * registerBufferRing() and puts it into the submission queue. Every completion carries the id of
+   * the buffer holding the data in its flags.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareRecvMultishot(os_fd_t fd, Request* user_data) PURE;
+
   /**
    * Prepares a close system call and puts it into the submission queue.
    * Returns IoUringResult::Failed in case the submission queue is full already
@@ -175,6 +207,47 @@ public:
    * @param fd is used to refer to the completions will be removed.
    */
   virtual void removeInjectedCompletion(os_fd_t fd) PURE;
+
+  /**
+   * Register a ring of provided buffers with the kernel for multishot receive requests.
+   * @param count the number of buffers, a power of two.
+   * @param size the size of each buffer.
+   * @return false if the kernel does not support provided buffer rings.
+   */
+  virtual bool registerBufferRing(uint32_t count, uint32_t size) PURE;
+
+  /**
+   * Append data received into a provided buffer to a buffer. The provided buffer is referenced by
+   * the destination buffer while few buffers of the ring are held, otherwise the data is copied.
+   * The provided buffer goes back to the ring once the data is no longer referenced.
+   * @param buffer_id the id of the provided buffer, from the completion flags.
+   * @param length the number of bytes received.
+   * @param buffer the buffer to append the data to.
+   */
+  virtual void moveProvidedBufferData(uint16_t buffer_id, uint32_t length,
+                                      Buffer::Instance& buffer) PURE;
+
+  /**
+   * Return a provided buffer to the ring without reading its data. Every completion carrying a
+   * provided buffer must either move its data with moveProvidedBufferData() or release it here,
+   * otherwise the buffer is lost to the ring.
+   * @param buffer_id the id of the provided buffer, from the completion flags.
+   */
+  virtual void releaseProvidedBuffer(uint16_t buffer_id) PURE;
+
+  /**
+   * Register a file descriptor with the ring, so requests on it skip the per request file lookup.
+   * @param fd the file descriptor to register.
+   * @return false if the registered file table is full.
+   */
+  virtual bool registerFile(os_fd_t fd) PURE;
+
+  /**
+   * Unregister a file descriptor registered with registerFile(). This must be called before the
+   * file descriptor is closed. Does nothing if the file descriptor is not registered.
+   * @param fd the file descriptor to unregister.
+   */
+  virtual void unregisterFile(os_fd_t fd) PURE;
 };
 
 using IoUringPtr = std::unique_ptr<IoUring>;
@@ -2,6 +2,8 @@
 
 #include "envoy/compression/compressor/compressor.h"
 
+#include "absl/strings/string_view.h"
+
 namespace Envoy {
 namespace Compression {
 namespace Compressor {
@@ -11,6 +13,19 @@ public:
   virtual ~CompressorFactory() = default;
 
   virtual CompressorPtr createCompressor() PURE;
+
+  /**
+   * Creates a compressor for a response to a client that advertised a compression dictionary.
+   * Compressors that support dictionaries only use one of the factory's own dictionaries if it
+   * is the advertised one, so that the client can decompress the response.
+   * @param dictionary_hash the SHA-256 hash of the dictionary the client has, as sent in the
+   *        Available-Dictionary request header.
+   */
+  virtual CompressorPtr createCompressorForDictionary(absl::string_view dictionary_hash) {
+    UNREFERENCED_PARAMETER(dictionary_hash);
+    return createCompressor();
+  }
+
   virtual const std::string& statsPrefix() const PURE;
   virtual const std::string& contentEncoding() const PURE;
 };
@@ -29,6 +29,18 @@ public:
    */
   virtual std::string formatWithContext(const Context& context,
                                         const StreamInfo::StreamInfo& stream_info) const PURE;
+
+  /**
+   * Append a formatted substitution line to the given output. This lets callers reuse a scratch
+   * buffer across lines rather than allocating a new string for every line.
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the string the formatted line is appended to.
+   */
+  virtual void appendWithContext(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                                 std::string& output) const {
+    output.append(formatWithContext(context, stream_info));
+  }
 };
 
 using FormatterPtr = std::unique_ptr<Formatter>;
@@ -51,6 +63,25 @@ public:
   virtual absl::optional<std::string>
   formatWithContext(const Context& context, const StreamInfo::StreamInfo& stream_info) const PURE;
 
+  /**
+   * Append the value formatted with the given context and stream info to the given output.
+   * Providers override this to write their value without building an intermediate string.
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the string the value is appended to.
+   * @return bool true if a value was appended, false if there is no value, in which case output is
+   *         left unchanged.
+   */
+  virtual bool appendWithContext(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                                 std::string& output) const {
+    const absl::optional<std::string> value = formatWithContext(context, stream_info);
+    if (!value.has_value()) {
+      return false;
+    }
+    output.append(value.value());
+    return true;
+  }
+
   /**
    * Format the value with the given context and stream info.
    * @param context supplies the formatter context.
@@ -584,6 +584,15 @@ public:
    */
   virtual StatefulHeaderKeyFormatterOptConstRef formatter() const PURE;
   virtual StatefulHeaderKeyFormatterOptRef formatter() PURE;
+
+  /**
+   * Keep externally owned storage alive for the lifetime of the header map. Codecs use this to
+   * create reference header strings that point directly into the buffer the headers were parsed
+   * from rather than copying them. As with any reference HeaderString, mutating such a header
+   * switches it to owned storage first.
+   * @param storage supplies the handle keeping the storage alive.
+   */
+  virtual void pinStorage(std::shared_ptr<void> storage) PURE;
 };
 
 using HeaderMapPtr = std::unique_ptr<HeaderMap>;
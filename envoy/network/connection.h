@@ -144,6 +144,11 @@ public:
     Stats::Counter* bind_errors_;
     // Optional counter. Delayed close timeouts will not be tracked if this is nullptr.
     Stats::Counter* delayed_close_timeouts_;
+    // Optional histogram of the number of buffer slices handed to a transport socket write after
+    // write coalescing copied data for it. Not tracked if this is nullptr.
+    Stats::Histogram* write_slices_;
+    // Optional counter of the bytes copied by write coalescing. Not tracked if this is nullptr.
+    Stats::Counter* write_coalesced_bytes_;
   };
 
   ~Connection() override = default;
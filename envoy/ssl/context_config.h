@@ -8,6 +8,7 @@
 
 #include "envoy/common/pure.h"
 #include "envoy/extensions/transport_sockets/tls/v3/common.pb.h"
+#include "envoy/extensions/transport_sockets/tls/v3/tls.pb.h"
 #include "envoy/ssl/certificate_validation_context_config.h"
 #include "envoy/ssl/handshaker.h"
 #include "envoy/ssl/tls_certificate_config.h"
@@ -215,6 +216,14 @@ public:
    */
   virtual bool disableStatefulSessionResumption() const PURE;
 
+  /**
+   * @return the settings for sharing session resumption state with other server contexts, or
+   * nullptr if the context keeps its own.
+   */
+  virtual const envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext::
+      SharedSessionResumption*
+      sharedSessionResumption() const PURE;
+
   /**
    * @return True if we allow full scan certificates when there is no cert matching SNI during
    * downstream TLS handshake, false otherwise.
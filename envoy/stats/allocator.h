@@ -94,6 +94,20 @@ public:
   virtual void forEachSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) const PURE;
   virtual void forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const PURE;
 
+  /**
+   * Iterate over the stats that need to be flushed to sinks and changed since they were last
+   * visited by these functions. Changes are tracked from the first call on, which visits every
+   * stat that needs to be flushed. A visited stat counts as unchanged until its next change. Note,
+   * that implementations can potentially hold on to a mutex that will deadlock if the passed in
+   * functors try to create or delete a stat.
+   * @param f_size functor that is provided the number of changed stats that will be flushed to
+   * sinks. Note that this is called only once, prior to any calls to f_stat.
+   * @param f_stat functor that is provided one changed stat at a time.
+   */
+  virtual void forEachChangedCounter(SizeFn f_size, StatFn<Counter> f_stat) PURE;
+  virtual void forEachChangedGauge(SizeFn f_size, StatFn<Gauge> f_stat) PURE;
+  virtual void forEachChangedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) PURE;
+
   /**
    * Set the predicates to filter stats for sink.
    */
@@ -31,6 +31,12 @@ public:
    * @return An optional override for the number of bins.
    */
   virtual absl::optional<uint32_t> bins(absl::string_view stat_name) const PURE;
+
+  /**
+   * @return whether the workers record the histogram into fixed log-linear buckets rather than
+   * circllhist buffers.
+   */
+  virtual bool fixedLogLinearBuckets(absl::string_view stat_name) const PURE;
 };
 
 using HistogramSettingsConstPtr = std::unique_ptr<const HistogramSettings>;
@@ -107,6 +107,21 @@ public:
    * @param value the value of the sample.
    */
   virtual void onHistogramComplete(const Histogram& histogram, uint64_t value) PURE;
+
+  /**
+   * @return true if the sink only needs the metrics that changed since the previous flush. When
+   * every sink returns true, snapshots leave out unchanged counters, gauges, text readouts and
+   * histograms, without walking all of the stats to find them.
+   */
+  virtual bool changedStatsOnly() const { return false; }
+
+  /**
+   * @return true if flush() may run on the dedicated stats sink thread rather than the main thread.
+   * The snapshot and the metrics it references stay valid until flush() returns, and the next
+   * snapshot is not taken until it has. Such sinks must not use thread local slots or the main
+   * thread's dispatcher from flush().
+   */
+  virtual bool flushOnSinkThread() const { return false; }
 };
 
 using SinkPtr = std::unique_ptr<Sink>;
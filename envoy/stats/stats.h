@@ -107,12 +107,15 @@ public:
    * Flags:
    * Used: used by all stats types to figure out whether they have been used.
    * Logic...: used by gauges to cache how they should be combined with a parent's value.
+   * Changed: used by counters, gauges and text readouts to track whether they changed since they
+   *          were last flushed to sinks.
    */
   struct Flags {
     static constexpr uint8_t Used = 0x01;
     static constexpr uint8_t LogicAccumulate = 0x02;
     static constexpr uint8_t NeverImport = 0x04;
     static constexpr uint8_t Hidden = 0x08;
+    static constexpr uint8_t Changed = 0x10;
   };
   virtual SymbolTable& symbolTable() PURE;
   virtual const SymbolTable& constSymbolTable() const PURE;
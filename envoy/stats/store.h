@@ -145,6 +145,20 @@ public:
   virtual void forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const PURE;
   virtual void forEachSinkedHistogram(SizeFn f_size, StatFn<ParentHistogram> f_stat) const PURE;
 
+  /**
+   * Iterate over the stats that need to be flushed to sinks and changed since they were last
+   * visited by these functions, so that a flush does not need to walk unchanged stats. Changes
+   * are tracked from the first call on, which visits every stat that needs to be flushed. A
+   * visited stat counts as unchanged until its next change, whether or not f_stat reads or
+   * latches it. The same deadlock caveats as for forEachSinkedCounter() apply.
+   * @param f_size functor that is provided the number of changed stats that will be flushed to
+   * sinks. Note that this is called only once, prior to any calls to f_stat.
+   * @param f_stat functor that is provided one changed stat at a time.
+   */
+  virtual void forEachChangedCounter(SizeFn f_size, StatFn<Counter> f_stat) PURE;
+  virtual void forEachChangedGauge(SizeFn f_size, StatFn<Gauge> f_stat) PURE;
+  virtual void forEachChangedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) PURE;
+
   /**
    * Calls 'fn' for every stat. Note that in the case of overlapping scopes, the
    * implementation may call fn more than one time for each counter. Iteration
@@ -705,6 +705,7 @@ public:
   COUNTER(upstream_cx_rx_bytes_total)                                                              \
   COUNTER(upstream_cx_total)                                                                       \
   COUNTER(upstream_cx_tx_bytes_total)                                                              \
+  COUNTER(upstream_cx_write_coalesced_bytes)                                                       \
   COUNTER(upstream_flow_control_backed_up_total)                                                   \
   COUNTER(upstream_flow_control_drained_total)                                                     \
   COUNTER(upstream_flow_control_paused_reading_total)                                              \
@@ -739,6 +740,7 @@ public:
   GAUGE(upstream_rq_pending_active, Accumulate)                                                    \
   HISTOGRAM(upstream_cx_connect_ms, Milliseconds)                                                  \
   HISTOGRAM(upstream_cx_length_ms, Milliseconds)                                                   \
+  HISTOGRAM(upstream_cx_write_slices, Unspecified)                                                 \
   HISTOGRAM(upstream_rq_per_cx, Unspecified)
 
 /**
@@ -85,8 +85,9 @@ AccessLogFileImpl::~AccessLogFileImpl() {
 
   // Flush any remaining data. If file was not opened for some reason, skip flushing part.
   if (file_->isOpen()) {
-    if (flush_buffer_.length() > 0) {
-      doWrite(flush_buffer_);
+    collectWriteShards();
+    if (about_to_write_buffer_.length() > 0) {
+      doWrite(about_to_write_buffer_);
     }
     const Api::IoCallBoolResult result = file_->close();
     ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
@@ -120,9 +121,18 @@ void AccessLogFileImpl::doWrite(Buffer::Instance& buffer) {
   }
 
   stats_.write_total_buffered_.sub(buffer.length());
+  buffered_bytes_.fetch_sub(buffer.length(), std::memory_order_relaxed);
   buffer.drain(buffer.length());
 }
 
+void AccessLogFileImpl::collectWriteShards() {
+  for (WriteShard& shard : write_shards_) {
+    Thread::LockGuard lock(shard.lock_);
+    pending_bytes_.fetch_sub(shard.buffer_.length(), std::memory_order_relaxed);
+    about_to_write_buffer_.move(shard.buffer_);
+  }
+}
+
 void AccessLogFileImpl::flushThreadFunc() {
 
   // Transfer the action from `reopen_file_` to this variable so that `reopen_file_` is only
@@ -136,13 +146,14 @@ void AccessLogFileImpl::flushThreadFunc() {
     {
       Thread::LockGuard write_lock(write_lock_);
 
-      // flush_event_ can be woken up either by large enough flush_buffer or by timer.
-      // In case it was timer, flush_buffer_ can be empty.
+      // flush_event_ can be woken up either by large enough write shards or by timer.
+      // In case it was timer, the write shards can be empty.
       //
       // Note: do not stop waiting when only `do_reopen` is true. In this case, we tried to
       // reopen and failed. We don't want to retry this in a tight loop, so wait for the next
       // event (timer or flush).
-      while (flush_buffer_.length() == 0 && !flush_thread_exit_ && !reopen_file_) {
+      while (pending_bytes_.load(std::memory_order_relaxed) == 0 && !flush_thread_exit_ &&
+             !reopen_file_) {
         // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
         flush_event_.wait(write_lock_);
       }
@@ -152,8 +163,7 @@ void AccessLogFileImpl::flushThreadFunc() {
       }
 
       flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-      about_to_write_buffer_.move(flush_buffer_);
-      ASSERT(flush_buffer_.length() == 0);
+      collectWriteShards();
 
       if (reopen_file_) {
         do_reopen = true;
@@ -187,40 +197,61 @@ void AccessLogFileImpl::flush() {
 
     // flush_lock_ must be held while checking this or else it is
     // possible that flushThreadFunc() has already moved data from
-    // flush_buffer_ to about_to_write_buffer_, has unlocked write_lock_,
+    // write_shards_ to about_to_write_buffer_, has unlocked write_lock_,
     // but has not yet completed doWrite(). This would allow flush() to
     // return before the pending data has actually been written to disk.
     flush_buffer_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
 
-    if (flush_buffer_.length() == 0) {
+    collectWriteShards();
+    if (about_to_write_buffer_.length() == 0) {
       return;
     }
-
-    about_to_write_buffer_.move(flush_buffer_);
-    ASSERT(flush_buffer_.length() == 0);
   }
 
   doWrite(about_to_write_buffer_);
 }
 
 void AccessLogFileImpl::write(absl::string_view data) {
-  Thread::LockGuard lock(write_lock_);
-
-  if (flush_thread_ == nullptr) {
-    createFlushStructures();
+  // Drop rather than buffer without bound when the flush thread cannot keep up with the disk.
+  if (buffered_bytes_.fetch_add(data.length(), std::memory_order_relaxed) + data.length() >
+      MAX_BUFFERED_SIZE) {
+    buffered_bytes_.fetch_sub(data.length(), std::memory_order_relaxed);
+    stats_.write_dropped_.inc();
+    return;
   }
 
   stats_.write_buffered_.inc();
   stats_.write_total_buffered_.add(data.length());
-  flush_buffer_.add(data.data(), data.size());
-  if (flush_buffer_.length() > MIN_FLUSH_SIZE) {
+
+  uint64_t pending;
+  {
+    const uint64_t thread_id = thread_factory_.currentThreadId().getId();
+    WriteShard& shard = write_shards_[thread_id % WRITE_SHARDS];
+    Thread::LockGuard lock(shard.lock_);
+    shard.buffer_.add(data.data(), data.size());
+    pending = pending_bytes_.fetch_add(data.length(), std::memory_order_relaxed);
+  }
+
+  // The flush thread is started after the data is in place so that it finds it on its first pass.
+  if (!flush_thread_started_.load(std::memory_order_acquire)) {
+    createFlushStructures();
+  }
+
+  // Only the write that crosses the threshold wakes up the flush thread.
+  if (pending <= MIN_FLUSH_SIZE && pending + data.length() > MIN_FLUSH_SIZE) {
+    Thread::LockGuard lock(write_lock_);
     flush_event_.notifyOne();
   }
 }
 
 void AccessLogFileImpl::createFlushStructures() {
+  Thread::LockGuard lock(write_lock_);
+  if (flush_thread_ != nullptr) {
+    return;
+  }
   flush_thread_ = thread_factory_.createThread([this]() -> void { flushThreadFunc(); },
                                                Thread::Options{"AccessLogFlush"});
+  flush_thread_started_.store(true, std::memory_order_release);
 }
 
 } // namespace AccessLog
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <string>
 
 #include "envoy/access_log/access_log.h"
@@ -22,6 +24,7 @@ namespace Envoy {
   COUNTER(reopen_failed)                                                                           \
   COUNTER(write_buffered)                                                                          \
   COUNTER(write_completed)                                                                         \
+  COUNTER(write_dropped)                                                                           \
   COUNTER(write_failed)                                                                            \
   GAUGE(write_total_buffered, Accumulate)
 
@@ -62,6 +65,11 @@ private:
  * This implementation uses a flush thread per file, with the idea there aren't that many
  * files. If this turns out to be a good implementation we can potentially have a single flush
  * thread that flushes all files, but we will start with this.
+ *
+ * Writers append to one of several buffer shards chosen by thread, so workers logging to the same
+ * file do not contend on a single lock. The flush thread collects all shards before each write.
+ * If the disk falls behind and more than MAX_BUFFERED_SIZE bytes are waiting, new data is dropped
+ * rather than buffered without bound.
  */
 class AccessLogFileImpl : public AccessLogFile {
 public:
@@ -82,20 +90,32 @@ public:
   void reopen() override;
   void flush() override;
 
+  // Maximum number of bytes buffered but not yet written before new data is dropped.
+  static constexpr uint64_t MAX_BUFFERED_SIZE = 64 * 1024 * 1024;
+
 private:
+  struct WriteShard {
+    Thread::MutexBasicLockable lock_;
+    Buffer::OwnedImpl buffer_ ABSL_GUARDED_BY(lock_);
+  };
+
   void doWrite(Buffer::Instance& buffer);
   void flushThreadFunc();
   void createFlushStructures();
+  // Moves the contents of every write shard into about_to_write_buffer_.
+  void collectWriteShards();
 
   // Minimum size before the flush thread will be told to flush.
   static const uint64_t MIN_FLUSH_SIZE = 1024 * 64;
+  static constexpr uint32_t WRITE_SHARDS = 16;
 
   Filesystem::FilePtr file_;
 
   // These locks are always acquired in the following order if multiple locks are held:
   //    1) write_lock_
   //    2) flush_lock_
-  //    3) file_lock_
+  //    3) a WriteShard lock_
+  //    4) file_lock_
   Thread::BasicLockable& file_lock_;      // This lock is used only by the flush thread when writing
                                           // to disk. This is used to make sure that file blocks do
                                           // not get interleaved by multiple processes writing to
@@ -106,23 +126,26 @@ private:
                                           // and all other data used during flushing and file
                                           // re-opening.
   Thread::MutexBasicLockable
-      write_lock_; // The lock is used when filling the flush buffer. It allows
-                   // multiple threads to write to the same file at relatively
-                   // high performance. It is always local to the process.
+      write_lock_; // The lock is used to wake up and stop the flush thread. Writers only take it
+                   // when the buffered data crosses MIN_FLUSH_SIZE. It is always local to the
+                   // process.
   Thread::ThreadPtr flush_thread_;
+  std::atomic<bool> flush_thread_started_{false};
   Thread::CondVar flush_event_;
   bool flush_thread_exit_ ABSL_GUARDED_BY(write_lock_){false};
   bool reopen_file_ ABSL_GUARDED_BY(write_lock_){false};
-  Buffer::OwnedImpl
-      flush_buffer_ ABSL_GUARDED_BY(write_lock_); // This buffer is used by multiple threads. It
-                                                  // gets filled and then flushed either when max
-                                                  // size is reached or when a timer fires.
+  std::array<WriteShard, WRITE_SHARDS> write_shards_; // These buffers are filled by writers, each
+                                                      // thread using the shard selected by its id,
+                                                      // and flushed either when MIN_FLUSH_SIZE is
+                                                      // reached or when a timer fires.
+  std::atomic<uint64_t> pending_bytes_{0};  // Bytes in write_shards_ not yet collected.
+  std::atomic<uint64_t> buffered_bytes_{0}; // Bytes accepted by write() but not yet written.
   // TODO(jmarantz): this should be ABSL_GUARDED_BY(flush_lock_) but the analysis cannot poke
   // through the std::make_unique assignment. I do not believe it's possible to annotate this
   // properly now due to limitations in the clang thread annotation analysis.
   Buffer::OwnedImpl about_to_write_buffer_; // This buffer is used only by the flush thread. Data
-                                            // is moved from flush_buffer_ under lock, and then
-                                            // the lock is released so that flush_buffer_ can
+                                            // is moved from write_shards_ under lock, and then
+                                            // the lock is released so that write_shards_ can
                                             // continue to fill. This buffer is then used for the
                                             // final write to disk.
   Event::TimerPtr flush_timer_;
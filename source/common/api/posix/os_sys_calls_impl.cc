@@ -192,6 +192,11 @@ SysCallPtrResult OsSysCallsImpl::mmap(void* addr, size_t length, int prot, int f
   return {rc, rc != MAP_FAILED ? 0 : errno};
 }
 
+SysCallIntResult OsSysCallsImpl::munmap(void* addr, size_t length) {
+  const int rc = ::munmap(addr, length);
+  return {rc, rc != -1 ? 0 : errno};
+}
+
 SysCallIntResult OsSysCallsImpl::stat(const char* pathname, struct stat* buf) {
   const int rc = ::stat(pathname, buf);
   return {rc, rc != -1 ? 0 : errno};
@@ -232,6 +232,10 @@ SysCallPtrResult OsSysCallsImpl::mmap(void* addr, size_t length, int prot, int f
   PANIC("mmap not implemented on Windows");
 }
 
+SysCallIntResult OsSysCallsImpl::munmap(void* addr, size_t length) {
+  PANIC("munmap not implemented on Windows");
+}
+
 SysCallIntResult OsSysCallsImpl::stat(const char* pathname, struct stat* buf) {
   const int rc = ::stat(pathname, buf);
   return {rc, rc != -1 ? 0 : errno};
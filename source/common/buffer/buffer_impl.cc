@@ -19,6 +19,60 @@ namespace {
 constexpr uint64_t CopyThreshold = 512;
 } // namespace
 
+thread_local uint64_t SliceStorageCache::max_cached_bytes_ = 0;
+thread_local uint64_t SliceStorageCache::cached_bytes_ = 0;
+thread_local SliceStorageCache::FreeLists SliceStorageCache::free_lists_;
+
+uint32_t SliceStorageCache::sizeClass(uint64_t capacity) {
+  for (uint32_t size_class = 0; size_class < NumSizeClasses; ++size_class) {
+    if (capacity == (PageSize << size_class)) {
+      return size_class;
+    }
+  }
+  return NumSizeClasses;
+}
+
+SliceStorageCache::StoragePtr SliceStorageCache::allocate(uint64_t capacity) {
+  if (cached_bytes_ > 0) {
+    const uint32_t size_class = sizeClass(capacity);
+    if (size_class < NumSizeClasses) {
+      auto& list = free_lists_.lists_[size_class];
+      if (!list.empty()) {
+        StoragePtr storage = std::move(list.back());
+        list.pop_back();
+        cached_bytes_ -= capacity;
+        return storage;
+      }
+    }
+  }
+  return StoragePtr{new uint8_t[capacity]};
+}
+
+void SliceStorageCache::release(StoragePtr&& storage, uint64_t capacity) {
+  if (cached_bytes_ + capacity <= max_cached_bytes_) {
+    const uint32_t size_class = sizeClass(capacity);
+    if (size_class < NumSizeClasses) {
+      free_lists_.lists_[size_class].push_back(std::move(storage));
+      cached_bytes_ += capacity;
+      return;
+    }
+  }
+  storage.reset();
+}
+
+void SliceStorageCache::setMaxCachedBytes(uint64_t max_cached_bytes) {
+  max_cached_bytes_ = max_cached_bytes;
+  // Free the largest storage first, it is the least likely to be reused.
+  for (uint32_t size_class = NumSizeClasses; size_class > 0 && cached_bytes_ > max_cached_bytes;
+       --size_class) {
+    auto& list = free_lists_.lists_[size_class - 1];
+    while (!list.empty() && cached_bytes_ > max_cached_bytes) {
+      list.pop_back();
+      cached_bytes_ -= PageSize << (size_class - 1);
+    }
+  }
+}
+
 thread_local absl::InlinedVector<Slice::StoragePtr,
                                  OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_max_>
     OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_;
@@ -309,6 +363,65 @@ void* OwnedImpl::linearize(uint32_t size) {
   return slices_.front().data();
 }
 
+CoalesceResult OwnedImpl::coalesceForWrite(uint64_t max_slices, uint64_t copy_threshold) {
+  CoalesceResult result;
+  if (slices_.size() <= max_slices) {
+    // A single write already covers the whole buffer, copying would not save any syscalls.
+    result.write_slices_ = slices_.size();
+    return result;
+  }
+
+  const auto small = [copy_threshold](const Slice& slice) {
+    return slice.canCoalesce() && slice.dataSize() < copy_threshold;
+  };
+
+  // Pop slices off the front into `front`, copying runs of small slices into freshly allocated
+  // slices, until max_slices slices have been produced. The produced slices are then pushed back to
+  // the front in their original order.
+  SliceDeque front;
+  bool appending_to_back = false;
+  while (!slices_.empty()) {
+    Slice& slice = slices_.front();
+    const uint64_t slice_size = slice.dataSize();
+    if (appending_to_back && small(slice) && front.back().reservableSize() >= slice_size) {
+      front.back().append(slice.data(), slice_size);
+      slice.transferDrainTrackersTo(front.back());
+      result.bytes_copied_ += slice_size;
+      slices_.pop_front();
+      continue;
+    }
+
+    appending_to_back = false;
+    if (front.size() >= max_slices) {
+      break;
+    }
+    if (small(slice) && slices_.size() > 1 && small(slices_[1])) {
+      // Size the new slice for the whole run, bounded by the default slice size.
+      uint64_t run_size = 0;
+      for (size_t i = 0; i < slices_.size() && small(slices_[i]) &&
+                         run_size + slices_[i].dataSize() <= Slice::default_slice_size_;
+           ++i) {
+        run_size += slices_[i].dataSize();
+      }
+      if (run_size > slice_size) {
+        front.emplace_back(Slice{run_size, account_});
+        appending_to_back = true;
+        continue;
+      }
+    }
+
+    front.emplace_back(std::move(slice));
+    slices_.pop_front();
+  }
+
+  result.write_slices_ = front.size();
+  while (!front.empty()) {
+    slices_.emplace_front(std::move(front.back()));
+    front.pop_back();
+  }
+  return result;
+}
+
 void OwnedImpl::coalesceOrAddSlice(Slice&& other_slice) {
   const uint64_t slice_size = other_slice.dataSize();
   // The `other_slice` content can be coalesced into the existing slice IFF:
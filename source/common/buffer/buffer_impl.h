@@ -1,10 +1,12 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/http/stream_reset_handler.h"
@@ -19,6 +21,70 @@
 namespace Envoy {
 namespace Buffer {
 
+/**
+ * Thread local cache of slice backing storage. When a slice owning a power of two number of 4kb
+ * pages, up to MaxCachedSize, is destroyed, its storage is kept in a free list for its size class
+ * instead of being returned to the heap, and handed out again to the next slice of the same size
+ * created on that thread. The cache is disabled (bounded to 0 bytes) unless the owning thread
+ * calls setMaxCachedBytes(); workers do so at startup and shrink it under memory pressure.
+ */
+class SliceStorageCache {
+public:
+  using StoragePtr = std::unique_ptr<uint8_t[]>;
+
+  static constexpr uint64_t PageSize = 4096;
+  static constexpr uint32_t NumSizeClasses = 5;
+  static constexpr uint64_t MaxCachedSize = PageSize << (NumSizeClasses - 1);
+  static constexpr uint64_t DefaultMaxCachedBytes = 4 * 1024 * 1024;
+
+  /**
+   * @param capacity the size of the storage, a multiple of PageSize.
+   * @return storage of exactly capacity bytes, taken from the calling thread's cache if possible.
+   */
+  static StoragePtr allocate(uint64_t capacity);
+
+  /**
+   * Return storage allocated with allocate() to the calling thread's cache, or free it if it does
+   * not belong to a size class or the cache is full.
+   * @param storage the storage to release.
+   * @param capacity the size of the storage.
+   */
+  static void release(StoragePtr&& storage, uint64_t capacity);
+
+  /**
+   * Bound the calling thread's cache, freeing cached storage above the new bound.
+   * @param max_cached_bytes the maximum number of bytes to cache. 0 disables the cache.
+   */
+  static void setMaxCachedBytes(uint64_t max_cached_bytes);
+
+  /**
+   * @return the number of bytes cached by the calling thread.
+   */
+  static uint64_t cachedBytes() { return cached_bytes_; }
+
+private:
+  struct FreeLists {
+    ~FreeLists() {
+      // Slices destroyed after this point on the same thread must not touch the free lists.
+      max_cached_bytes_ = 0;
+      cached_bytes_ = 0;
+    }
+
+    std::array<std::vector<StoragePtr>, NumSizeClasses> lists_;
+  };
+
+  /**
+   * @return the size class index of storage of this capacity, or NumSizeClasses if the
+   *         capacity is not cacheable.
+   */
+  static uint32_t sizeClass(uint64_t capacity);
+
+  // The counters are trivially destructible so they remain readable while the thread exits.
+  static thread_local uint64_t max_cached_bytes_;
+  static thread_local uint64_t cached_bytes_;
+  static thread_local FreeLists free_lists_;
+};
+
 /**
  * A Slice manages a contiguous block of bytes.
  * The block is arranged like this:
@@ -37,7 +103,7 @@ namespace Buffer {
 class Slice {
 public:
   using Reservation = RawSlice;
-  using StoragePtr = std::unique_ptr<uint8_t[]>;
+  using StoragePtr = SliceStorageCache::StoragePtr;
 
   struct SizedStorage {
     StoragePtr mem_{};
@@ -57,7 +123,7 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)), storage_(SliceStorageCache::allocate(capacity_)),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -114,6 +180,7 @@ public:
   Slice& operator=(Slice&& rhs) noexcept {
     if (this != &rhs) {
       callAndClearDrainTrackersAndCharges();
+      releaseStorage();
 
       capacity_ = rhs.capacity_;
       storage_ = std::move(rhs.storage_);
@@ -139,6 +206,7 @@ public:
 
   ~Slice() {
     callAndClearDrainTrackersAndCharges();
+    releaseStorage();
     if (releasor_) {
       releasor_();
     }
@@ -365,10 +433,19 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    return {SliceStorageCache::allocate(slice_size), static_cast<size_t>(slice_size)};
   }
 
 protected:
+  /**
+   * Hand owned storage, if any, back to the calling thread's SliceStorageCache.
+   */
+  void releaseStorage() {
+    if (storage_ != nullptr) {
+      SliceStorageCache::release(std::move(storage_), capacity_);
+    }
+  }
+
   /** Length of the byte array that base_ points to. This is also the offset in bytes from the start
    * of the slice to the end of the Reservable section. */
   uint64_t capacity_ = 0;
@@ -666,6 +743,7 @@ public:
   SliceDataPtr extractMutableFrontSlice() override;
   uint64_t length() const override;
   void* linearize(uint32_t size) override;
+  CoalesceResult coalesceForWrite(uint64_t max_slices, uint64_t copy_threshold) override;
   void move(Instance& rhs) override;
   void move(Instance& rhs, uint64_t length) override;
   void move(Instance& rhs, uint64_t length, bool reset_drain_trackers_and_accounting) override;
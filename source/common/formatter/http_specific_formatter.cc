@@ -70,6 +70,17 @@ absl::optional<std::string> HeaderFormatter::format(const Http::HeaderMap& heade
   return std::string(val);
 }
 
+bool HeaderFormatter::append(const Http::HeaderMap& headers, std::string& output) const {
+  const Http::HeaderEntry* header = findHeader(headers);
+  if (!header) {
+    return false;
+  }
+
+  absl::string_view val = header->value().getStringView();
+  output.append(SubstitutionFormatUtils::truncateStringView(val, max_length_));
+  return true;
+}
+
 Protobuf::Value HeaderFormatter::formatValue(const Http::HeaderMap& headers) const {
   const Http::HeaderEntry* header = findHeader(headers);
   if (!header) {
@@ -92,6 +103,12 @@ ResponseHeaderFormatter::formatWithContext(const HttpFormatterContext& context,
   return HeaderFormatter::format(context.responseHeaders());
 }
 
+bool ResponseHeaderFormatter::appendWithContext(const HttpFormatterContext& context,
+                                                const StreamInfo::StreamInfo&,
+                                                std::string& output) const {
+  return HeaderFormatter::append(context.responseHeaders(), output);
+}
+
 Protobuf::Value
 ResponseHeaderFormatter::formatValueWithContext(const HttpFormatterContext& context,
                                                 const StreamInfo::StreamInfo&) const {
@@ -109,6 +126,12 @@ RequestHeaderFormatter::formatWithContext(const HttpFormatterContext& context,
   return HeaderFormatter::format(context.requestHeaders());
 }
 
+bool RequestHeaderFormatter::appendWithContext(const HttpFormatterContext& context,
+                                               const StreamInfo::StreamInfo&,
+                                               std::string& output) const {
+  return HeaderFormatter::append(context.requestHeaders(), output);
+}
+
 Protobuf::Value
 RequestHeaderFormatter::formatValueWithContext(const HttpFormatterContext& context,
                                                const StreamInfo::StreamInfo&) const {
@@ -126,6 +149,12 @@ ResponseTrailerFormatter::formatWithContext(const HttpFormatterContext& context,
   return HeaderFormatter::format(context.responseTrailers());
 }
 
+bool ResponseTrailerFormatter::appendWithContext(const HttpFormatterContext& context,
+                                                 const StreamInfo::StreamInfo&,
+                                                 std::string& output) const {
+  return HeaderFormatter::append(context.responseTrailers(), output);
+}
+
 Protobuf::Value
 ResponseTrailerFormatter::formatValueWithContext(const HttpFormatterContext& context,
                                                  const StreamInfo::StreamInfo&) const {
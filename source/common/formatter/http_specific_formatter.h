@@ -56,6 +56,7 @@ public:
 
 protected:
   absl::optional<std::string> format(const Http::HeaderMap& headers) const;
+  bool append(const Http::HeaderMap& headers, std::string& output) const;
   Protobuf::Value formatValue(const Http::HeaderMap& headers) const;
 
 private:
@@ -101,6 +102,9 @@ public:
   absl::optional<std::string>
   formatWithContext(const HttpFormatterContext& context,
                     const StreamInfo::StreamInfo& stream_info) const override;
+  bool appendWithContext(const HttpFormatterContext& context,
+                         const StreamInfo::StreamInfo& stream_info,
+                         std::string& output) const override;
   Protobuf::Value formatValueWithContext(const HttpFormatterContext& context,
                                          const StreamInfo::StreamInfo& stream_info) const override;
 };
@@ -117,6 +121,9 @@ public:
   absl::optional<std::string>
   formatWithContext(const HttpFormatterContext& context,
                     const StreamInfo::StreamInfo& stream_info) const override;
+  bool appendWithContext(const HttpFormatterContext& context,
+                         const StreamInfo::StreamInfo& stream_info,
+                         std::string& output) const override;
   Protobuf::Value formatValueWithContext(const HttpFormatterContext& context,
                                          const StreamInfo::StreamInfo& stream_info) const override;
 };
@@ -133,6 +140,9 @@ public:
   absl::optional<std::string>
   formatWithContext(const HttpFormatterContext& context,
                     const StreamInfo::StreamInfo& stream_info) const override;
+  bool appendWithContext(const HttpFormatterContext& context,
+                         const StreamInfo::StreamInfo& stream_info,
+                         std::string& output) const override;
   Protobuf::Value formatValueWithContext(const HttpFormatterContext& context,
                                          const StreamInfo::StreamInfo& stream_info) const override;
 };
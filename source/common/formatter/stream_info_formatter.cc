@@ -621,6 +621,15 @@ public:
 
     return fmt::format_int(millis.value()).str();
   }
+  bool append(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    const auto millis = extractMillis(stream_info);
+    if (!millis) {
+      return false;
+    }
+
+    absl::StrAppend(&output, millis.value());
+    return true;
+  }
   Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const override {
     const auto millis = extractMillis(stream_info);
     if (!millis) {
@@ -653,6 +662,10 @@ public:
   absl::optional<std::string> format(const StreamInfo::StreamInfo& stream_info) const override {
     return fmt::format_int(field_extractor_(stream_info)).str();
   }
+  bool append(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    absl::StrAppend(&output, field_extractor_(stream_info));
+    return true;
+  }
   Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const override {
     return ValueUtil::numberValue(field_extractor_(stream_info));
   }
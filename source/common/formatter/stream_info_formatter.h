@@ -26,6 +26,10 @@ public:
   formatWithContext(const Context&, const StreamInfo::StreamInfo& stream_info) const override {
     return format(stream_info);
   }
+  bool appendWithContext(const Context&, const StreamInfo::StreamInfo& stream_info,
+                         std::string& output) const override {
+    return append(stream_info, output);
+  }
   Protobuf::Value formatValueWithContext(const Context&,
                                          const StreamInfo::StreamInfo& stream_info) const override {
     return formatValue(stream_info);
@@ -39,6 +43,22 @@ public:
    */
   virtual absl::optional<std::string> format(const StreamInfo::StreamInfo& stream_info) const PURE;
 
+  /**
+   * Append the value formatted with the given stream info to the given output. The default
+   * implementation appends the result of format().
+   * @param stream_info supplies the stream info.
+   * @param output supplies the string the value is appended to.
+   * @return bool true if a value was appended, false if there is no value.
+   */
+  virtual bool append(const StreamInfo::StreamInfo& stream_info, std::string& output) const {
+    const absl::optional<std::string> value = format(stream_info);
+    if (!value.has_value()) {
+      return false;
+    }
+    output.append(value.value());
+    return true;
+  }
+
   /**
    * Format the value with the given stream info.
    * @param stream_info supplies the stream info.
@@ -367,19 +367,20 @@ std::string FormatterImpl::formatWithContext(const Context& context,
                                              const StreamInfo::StreamInfo& stream_info) const {
   std::string log_line;
   log_line.reserve(256);
+  appendWithContext(context, stream_info, log_line);
+  return log_line;
+}
 
+void FormatterImpl::appendWithContext(const Context& context,
+                                      const StreamInfo::StreamInfo& stream_info,
+                                      std::string& output) const {
   for (const auto& provider : providers_) {
-    const absl::optional<std::string> bit = provider->formatWithContext(context, stream_info);
     // Add the formatted value if there is one. Otherwise add a default value
     // of "-" if omit_empty_values_ is not set.
-    if (bit.has_value()) {
-      log_line += bit.value();
-    } else if (!omit_empty_values_) {
-      log_line += DefaultUnspecifiedValueStringView;
+    if (!provider->appendWithContext(context, stream_info, output) && !omit_empty_values_) {
+      output.append(DefaultUnspecifiedValueStringView);
     }
   }
-
-  return log_line;
 }
 
 void stringValueToLogLine(const JsonFormatterImpl::Formatters& formatters, const Context& context,
@@ -37,6 +37,11 @@ public:
                                                 const StreamInfo::StreamInfo&) const override {
     return str_.string_value();
   }
+  bool appendWithContext(const Context&, const StreamInfo::StreamInfo&,
+                         std::string& output) const override {
+    output.append(str_.string_value());
+    return true;
+  }
   Protobuf::Value formatValueWithContext(const Context&,
                                          const StreamInfo::StreamInfo&) const override {
     return str_;
@@ -59,6 +64,11 @@ public:
     std::string str = absl::StrFormat("%g", num_.number_value());
     return str;
   }
+  bool appendWithContext(const Context&, const StreamInfo::StreamInfo&,
+                         std::string& output) const override {
+    absl::StrAppendFormat(&output, "%g", num_.number_value());
+    return true;
+  }
   Protobuf::Value formatValueWithContext(const Context&,
                                          const StreamInfo::StreamInfo&) const override {
     return num_;
@@ -93,6 +103,8 @@ public:
   // Formatter
   std::string formatWithContext(const Context& context,
                                 const StreamInfo::StreamInfo& stream_info) const override;
+  void appendWithContext(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                         std::string& output) const override;
 
 protected:
   FormatterImpl(absl::Status& creation_status, absl::string_view format,
@@ -47,6 +47,7 @@ namespace Http {
   COUNTER(downstream_cx_total)                                                                     \
   COUNTER(downstream_cx_tx_bytes_total)                                                            \
   COUNTER(downstream_cx_upgrades_total)                                                            \
+  COUNTER(downstream_cx_write_coalesced_bytes)                                                     \
   COUNTER(downstream_flow_control_paused_reading_total)                                            \
   COUNTER(downstream_flow_control_resumed_reading_total)                                           \
   COUNTER(downstream_rq_1xx)                                                                       \
@@ -86,6 +87,7 @@ namespace Http {
   GAUGE(downstream_cx_http1_soft_drain, Accumulate)                                                \
   GAUGE(downstream_rq_active, Accumulate)                                                          \
   HISTOGRAM(downstream_cx_length_ms, Milliseconds)                                                 \
+  HISTOGRAM(downstream_cx_write_slices, Unspecified)                                               \
   HISTOGRAM(downstream_rq_time, Milliseconds)
 
 /**
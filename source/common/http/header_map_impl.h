@@ -16,6 +16,8 @@
 #include "source/common/common/utility.h"
 #include "source/common/http/headers.h"
 
+#include "absl/container/inlined_vector.h"
+
 namespace Envoy {
 namespace Http {
 
@@ -111,6 +113,7 @@ public:
     return StatefulHeaderKeyFormatterOptConstRef(makeOptRefFromPtr(formatter_.get()));
   }
   StatefulHeaderKeyFormatterOptRef formatter() { return makeOptRefFromPtr(formatter_.get()); }
+  void pinStorage(std::shared_ptr<void> storage) { pinned_storage_.push_back(std::move(storage)); }
 
 protected:
   struct HeaderEntryImpl : public HeaderEntry, NonCopyable {
@@ -339,6 +342,9 @@ protected:
   virtual void clearInline() PURE;
   virtual HeaderEntryImpl** inlineHeaders() PURE;
 
+  // Codec owned storage that reference header strings in headers_ may point into. Declared first
+  // so that it is released after the headers referencing it.
+  absl::InlinedVector<std::shared_ptr<void>, 1> pinned_storage_;
   HeaderList headers_;
   // TODO(mattklein123): The formatter does not currently get copied when a header map gets
   // copied. This may be problematic in certain cases like request shadowing. This is omitted
@@ -430,6 +436,9 @@ public:
     return HeaderMapImpl::formatter();
   }
   StatefulHeaderKeyFormatterOptRef formatter() override { return HeaderMapImpl::formatter(); }
+  void pinStorage(std::shared_ptr<void> storage) override {
+    HeaderMapImpl::pinStorage(std::move(storage));
+  }
 
   // Generic custom header functions for each fully typed interface. To avoid accidental issues,
   // the Handle type is different for each interface, which is why these functions live here vs.
@@ -149,7 +149,8 @@ bool isHeaderNameValid(absl::string_view name) {
 
 BalsaParser::BalsaParser(MessageType type, ParserCallbacks* connection, size_t max_header_length,
                          bool enable_trailers, bool allow_custom_methods)
-    : message_type_(type), connection_(connection), enable_trailers_(enable_trailers),
+    : headers_(std::make_shared<quiche::BalsaHeaders>()), message_type_(type),
+      connection_(connection), enable_trailers_(enable_trailers),
       allow_custom_methods_(allow_custom_methods) {
   ASSERT(connection_ != nullptr);
 
@@ -165,7 +166,7 @@ BalsaParser::BalsaParser(MessageType type, ParserCallbacks* connection, size_t m
       "envoy.reloadable_features.http1_balsa_disallow_lone_cr_in_chunk_extension");
   framer_.set_http_validation_policy(http_validation_policy);
 
-  framer_.set_balsa_headers(&headers_);
+  framer_.set_balsa_headers(headers_.get());
   framer_.set_balsa_visitor(this);
   framer_.set_max_header_length(max_header_length);
   framer_.set_invalid_chars_level(quiche::BalsaFrame::InvalidCharsLevel::kError);
@@ -189,7 +190,7 @@ size_t BalsaParser::execute(const char* slice, int len) {
       if (first_message_) {
         first_message_ = false;
       } else {
-        framer_.Reset();
+        resetFramer();
       }
     }
 
@@ -218,7 +219,7 @@ size_t BalsaParser::execute(const char* slice, int len) {
 
   if (len == 0 && headers_done_ && !isChunked() &&
       ((message_type_ == MessageType::Response && hasTransferEncoding()) ||
-       !headers_.content_length_valid())) {
+       !headers_->content_length_valid())) {
     MessageDone();
     return 0;
   }
@@ -246,33 +247,34 @@ CallbackResult BalsaParser::pause() {
 ParserStatus BalsaParser::getStatus() const { return status_; }
 
 Http::Code BalsaParser::statusCode() const {
-  return static_cast<Http::Code>(headers_.parsed_response_code());
+  return static_cast<Http::Code>(headers_->parsed_response_code());
 }
 
 bool BalsaParser::isHttp11() const {
   if (message_type_ == MessageType::Request) {
-    return absl::EndsWith(headers_.first_line(), Http::Headers::get().ProtocolStrings.Http11String);
+    return absl::EndsWith(headers_->first_line(),
+                          Http::Headers::get().ProtocolStrings.Http11String);
   } else {
-    return absl::StartsWith(headers_.first_line(),
+    return absl::StartsWith(headers_->first_line(),
                             Http::Headers::get().ProtocolStrings.Http11String);
   }
 }
 
 absl::optional<uint64_t> BalsaParser::contentLength() const {
-  if (!headers_.content_length_valid()) {
+  if (!headers_->content_length_valid()) {
     return absl::nullopt;
   }
-  return headers_.content_length();
+  return headers_->content_length();
 }
 
-bool BalsaParser::isChunked() const { return headers_.transfer_encoding_is_chunked(); }
+bool BalsaParser::isChunked() const { return headers_->transfer_encoding_is_chunked(); }
 
-absl::string_view BalsaParser::methodName() const { return headers_.request_method(); }
+absl::string_view BalsaParser::methodName() const { return headers_->request_method(); }
 
 absl::string_view BalsaParser::errorMessage() const { return error_message_; }
 
 int BalsaParser::hasTransferEncoding() const {
-  return headers_.HasHeader(Http::Headers::get().TransferEncoding);
+  return headers_->HasHeader(Http::Headers::get().TransferEncoding);
 }
 
 void BalsaParser::OnRawBodyInput(absl::string_view /*input*/) {}
@@ -318,7 +320,9 @@ void BalsaParser::OnRequestFirstLineInput(absl::string_view /*line_input*/,
     error_message_ = "HPE_INVALID_VERSION";
     return;
   }
+  header_data_pinnable_ = true;
   status_ = convertResult(connection_->onUrl(request_uri.data(), request_uri.size()));
+  header_data_pinnable_ = false;
 }
 
 void BalsaParser::OnResponseFirstLineInput(absl::string_view /*line_input*/,
@@ -333,7 +337,9 @@ void BalsaParser::OnResponseFirstLineInput(absl::string_view /*line_input*/,
     error_message_ = "HPE_INVALID_VERSION";
     return;
   }
+  header_data_pinnable_ = true;
   status_ = convertResult(connection_->onStatus(reason_input.data(), reason_input.size()));
+  header_data_pinnable_ = false;
 }
 
 void BalsaParser::OnChunkLength(size_t chunk_length) {
@@ -371,7 +377,7 @@ void BalsaParser::MessageDone() {
   }
   status_ = convertResult(connection_->onMessageComplete());
   if (!delay_reset_) {
-    framer_.Reset();
+    resetFramer();
   }
   first_byte_processed_ = false;
   headers_done_ = false;
@@ -429,7 +435,10 @@ void BalsaParser::validateAndProcessHeadersOrTrailersImpl(const quiche::BalsaHea
       continue;
     }
 
+    // Trailers are handed over in a separate BalsaHeaders instance which is not retained.
+    header_data_pinnable_ = !trailers;
     status_ = convertResult(connection_->onHeaderField(key.data(), key.length()));
+    header_data_pinnable_ = false;
     if (status_ == ParserStatus::Error) {
       return;
     }
@@ -448,11 +457,27 @@ void BalsaParser::validateAndProcessHeadersOrTrailersImpl(const quiche::BalsaHea
                                                          value_without_cr_or_lf.length()));
     } else {
       // No need to copy if header value does not contain CR or LF.
+      header_data_pinnable_ = !trailers;
       status_ = convertResult(connection_->onHeaderValue(value.data(), value.length()));
+      header_data_pinnable_ = false;
     }
   }
 }
 
+std::shared_ptr<void> BalsaParser::pinHeaderStorage() {
+  headers_pinned_ = true;
+  return headers_;
+}
+
+void BalsaParser::resetFramer() {
+  if (headers_pinned_) {
+    headers_ = std::make_shared<quiche::BalsaHeaders>();
+    framer_.set_balsa_headers(headers_.get());
+    headers_pinned_ = false;
+  }
+  framer_.Reset();
+}
+
 ParserStatus BalsaParser::convertResult(CallbackResult result) const {
   return result == CallbackResult::Error ? ParserStatus::Error : status_;
 }
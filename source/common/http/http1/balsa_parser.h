@@ -35,6 +35,8 @@ public:
   absl::string_view methodName() const override;
   absl::string_view errorMessage() const override;
   int hasTransferEncoding() const override;
+  bool headerDataPinnable() const override { return header_data_pinnable_; }
+  std::shared_ptr<void> pinHeaderStorage() override;
 
 private:
   // quiche::BalsaVisitorInterface implementation
@@ -68,8 +70,14 @@ private:
   // Typical use would be `status_ = convertResult(result);`
   ABSL_MUST_USE_RESULT ParserStatus convertResult(CallbackResult result) const;
 
+  // Reset `framer_` for the next message. If the storage of the current message has been pinned,
+  // a fresh BalsaHeaders instance is installed first so that pinned data is left untouched.
+  void resetFramer();
+
   quiche::BalsaFrame framer_;
-  quiche::BalsaHeaders headers_;
+  // Shared so that the header block of a message can outlive the parser's use of it, see
+  // pinHeaderStorage().
+  std::shared_ptr<quiche::BalsaHeaders> headers_;
 
   const MessageType message_type_ = MessageType::Request;
   ParserCallbacks* connection_ = nullptr;
@@ -77,6 +85,10 @@ private:
   const bool allow_custom_methods_ = false;
   bool first_byte_processed_ = false;
   bool headers_done_ = false;
+  // True while invoking a callback with data pointing into `headers_`.
+  bool header_data_pinnable_ = false;
+  // True if `headers_` has been handed out by pinHeaderStorage() for the current message.
+  bool headers_pinned_ = false;
   // True until the first byte of the second message arrives.
   bool first_message_ = true;
   ParserStatus status_ = ParserStatus::Ok;
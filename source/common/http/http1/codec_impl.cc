@@ -1,5 +1,6 @@
 #include "source/common/http/http1/codec_impl.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -93,6 +94,16 @@ StatefulHeaderKeyFormatterPtr statefulFormatterFromSettings(const Http::Http1Set
 
 constexpr size_t CRLF_SIZE = 2;
 
+// Moving out of or clearing a reference HeaderString leaves the referenced view in place, so
+// switch it back to empty owned storage before it is reused for the next header.
+void resetHeaderString(HeaderString& header) {
+  if (header.isReference()) {
+    header.setCopy(absl::string_view());
+  } else {
+    header.clear();
+  }
+}
+
 } // namespace
 
 static constexpr absl::string_view CRLF = "\r\n";
@@ -536,8 +547,10 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
     : connection_(connection), stats_(stats), codec_settings_(settings),
       encode_only_header_key_formatter_(encodeOnlyFormatterFromSettings(settings)),
       processing_trailers_(false), handling_upgrade_(false), reset_stream_called_(false),
-      deferred_end_stream_headers_(false), dispatching_(false), max_headers_kb_(max_headers_kb),
-      max_headers_count_(max_headers_count) {
+      deferred_end_stream_headers_(false), dispatching_(false), header_storage_pinned_(false),
+      zero_copy_headers_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http1_zero_copy_headers")),
+      max_headers_kb_(max_headers_kb), max_headers_count_(max_headers_count) {
   parser_ = std::make_unique<BalsaParser>(type, this, max_headers_kb_ * 1024, enableTrailers(),
                                           codec_settings_.allow_custom_methods_);
 }
@@ -557,7 +570,12 @@ Status ConnectionImpl::completeCurrentHeader() {
     // Strip trailing whitespace of the current header value if any. Leading whitespace was trimmed
     // in ConnectionImpl::onHeaderValue. http_parser does not strip leading or trailing whitespace
     // as the spec requires: https://tools.ietf.org/html/rfc7230#section-3.2.4
-    current_header_value_.rtrim();
+    if (current_header_value_.isReference()) {
+      current_header_value_.setReference(
+          StringUtil::rtrim(current_header_value_.getStringView()));
+    } else {
+      current_header_value_.rtrim();
+    }
 
     // If there is a stateful formatter installed, remember the original header key before
     // converting to lower case.
@@ -565,11 +583,22 @@ Status ConnectionImpl::completeCurrentHeader() {
     if (formatter.has_value()) {
       formatter->processKey(current_header_field_.getStringView());
     }
-    current_header_field_.inlineTransform([](char c) { return absl::ascii_tolower(c); });
+    if (current_header_field_.isReference()) {
+      // The key points into pinned parser storage, which the parser allows to be lower cased in
+      // place. See Parser::pinHeaderStorage().
+      const absl::string_view key = current_header_field_.getStringView();
+      char* key_data = const_cast<char*>(key.data());
+      std::transform(key_data, key_data + key.size(), key_data,
+                     [](char c) { return absl::ascii_tolower(c); });
+    } else {
+      current_header_field_.inlineTransform([](char c) { return absl::ascii_tolower(c); });
+    }
 
     headers_or_trailers.addViaMove(std::move(current_header_field_),
                                    std::move(current_header_value_));
   }
+  resetHeaderString(current_header_field_);
+  resetHeaderString(current_header_value_);
 
   // Check if the number of headers exceeds the limit.
   if (headers_or_trailers.size() > max_headers_count_) {
@@ -595,10 +624,24 @@ Status ConnectionImpl::onMessageBeginImpl() {
   protocol_ = Protocol::Http11;
   processing_trailers_ = false;
   header_parsing_state_ = HeaderParsingState::Field;
+  header_storage_pinned_ = false;
   allocHeaders(statefulFormatterFromSettings(codec_settings_));
   return onMessageBeginBase();
 }
 
+bool ConnectionImpl::maybeReferenceHeaderData(HeaderString& header, absl::string_view data) {
+  if (!zero_copy_headers_ || processing_trailers_ || !header.empty() ||
+      !parser_->headerDataPinnable()) {
+    return false;
+  }
+  if (!header_storage_pinned_) {
+    headersOrTrailers().pinStorage(parser_->pinHeaderStorage());
+    header_storage_pinned_ = true;
+  }
+  header.setReference(data);
+  return true;
+}
+
 uint32_t ConnectionImpl::getHeadersSize() {
   return current_header_field_.size() + current_header_value_.size() +
          headersOrTrailers().byteSize();
@@ -799,7 +842,9 @@ Status ConnectionImpl::onHeaderFieldImpl(const char* data, size_t length) {
     RETURN_IF_ERROR(completeCurrentHeader());
   }
 
-  current_header_field_.append(data, length);
+  if (!maybeReferenceHeaderData(current_header_field_, {data, length})) {
+    current_header_field_.append(data, length);
+  }
 
   return checkMaxHeadersSize();
 }
@@ -830,7 +875,9 @@ Status ConnectionImpl::onHeaderValueImpl(const char* data, size_t length) {
     // whitespace as the spec requires: https://tools.ietf.org/html/rfc7230#section-3.2.4 .
     header_value = StringUtil::ltrim(header_value);
   }
-  current_header_value_.append(header_value.data(), header_value.length());
+  if (!maybeReferenceHeaderData(current_header_value_, header_value)) {
+    current_header_value_.append(header_value.data(), header_value.length());
+  }
 
   return checkMaxHeadersSize();
 }
@@ -1124,6 +1171,7 @@ Status ServerConnectionImpl::handlePath(RequestHeaderMap& headers, absl::string_
        (method == header_values.MethodValues.Options &&
         active_request_->request_url_.getStringView()[0] == '*'))) {
     headers.addViaMove(std::move(path), std::move(active_request_->request_url_));
+    resetHeaderString(active_request_->request_url_);
     return okStatus();
   }
 
@@ -1138,6 +1186,7 @@ Status ServerConnectionImpl::handlePath(RequestHeaderMap& headers, absl::string_
    */
   if (!codec_settings_.allow_absolute_url_ && !is_connect) {
     headers.addViaMove(std::move(path), std::move(active_request_->request_url_));
+    resetHeaderString(active_request_->request_url_);
     return okStatus();
   }
 
@@ -1173,7 +1222,7 @@ Status ServerConnectionImpl::handlePath(RequestHeaderMap& headers, absl::string_
   if (!absolute_url.pathAndQueryParams().empty()) {
     headers.setPath(absolute_url.pathAndQueryParams());
   }
-  active_request_->request_url_.clear();
+  resetHeaderString(active_request_->request_url_);
   return okStatus();
 }
 
@@ -1281,7 +1330,9 @@ Status ServerConnectionImpl::onMessageBeginBase() {
 
 Status ServerConnectionImpl::onUrlBase(const char* data, size_t length) {
   if (active_request_) {
-    active_request_->request_url_.append(data, length);
+    if (!maybeReferenceHeaderData(active_request_->request_url_, {data, length})) {
+      active_request_->request_url_.append(data, length);
+    }
 
     RETURN_IF_ERROR(checkMaxHeadersSize());
   }
@@ -1420,8 +1471,8 @@ Status ServerConnectionImpl::checkHeaderNameForUnderscores() {
       ENVOY_CONN_LOG(debug, "Dropping header with invalid characters in its name: {}", connection_,
                      current_header_field_.getStringView());
       stats_.incDroppedHeadersWithUnderscores();
-      current_header_field_.clear();
-      current_header_value_.clear();
+      resetHeaderString(current_header_field_);
+      resetHeaderString(current_header_value_);
     } else {
       ENVOY_CONN_LOG(debug, "Rejecting request due to header name with underscores: {}",
                      connection_, current_header_field_.getStringView());
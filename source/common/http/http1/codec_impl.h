@@ -298,6 +298,14 @@ protected:
    */
   Status checkMaxHeadersSize();
 
+  /**
+   * Make `header` reference `data` if the parser can pin the storage backing it, avoiding a copy.
+   * Only an empty header string is turned into a reference; subsequent fragments of the same
+   * header are appended which copies the referenced data as usual.
+   * @return whether `data` was referenced. If false, the caller must copy it.
+   */
+  bool maybeReferenceHeaderData(HeaderString& header, absl::string_view data);
+
   Network::Connection& connection_;
   CodecStats& stats_;
   const Http1Settings codec_settings_;
@@ -317,6 +325,10 @@ protected:
   bool deferred_end_stream_headers_ : 1;
   bool dispatching_ : 1;
   bool dispatching_slice_already_drained_ : 1;
+  // Set once the parser storage of the current message has been pinned into its header map.
+  bool header_storage_pinned_ : 1;
+  // Latched value of `envoy.reloadable_features.http1_zero_copy_headers`.
+  const bool zero_copy_headers_;
   StreamInfo::BytesMeterSharedPtr bytes_meter_before_stream_;
   const uint32_t max_headers_kb_;
   const uint32_t max_headers_count_;
@@ -25,6 +25,10 @@ public:
   absl::string_view methodName() const override;
   absl::string_view errorMessage() const override;
   int hasTransferEncoding() const override;
+  // http_parser hands out pointers into the caller's input buffer, which is drained after each
+  // dispatch, so header data is never pinnable.
+  bool headerDataPinnable() const override { return false; }
+  std::shared_ptr<void> pinHeaderStorage() override { return nullptr; }
 
 private:
   class Impl;
@@ -150,6 +150,17 @@ public:
 
   // Returns whether the Transfer-Encoding header is present.
   virtual int hasTransferEncoding() const PURE;
+
+  // Returns whether the data passed to the onUrl(), onStatus(), onHeaderField() or onHeaderValue()
+  // callback currently executing lives in storage that can be kept alive with pinHeaderStorage(),
+  // as opposed to a transient buffer that callers must copy from.
+  virtual bool headerDataPinnable() const PURE;
+
+  // Returns a handle that keeps the storage backing pinnable header data of the current message
+  // alive once the parser has moved on to the next message. The parser never writes to pinned
+  // storage again and only compares header names in it case-insensitively, so holders may lower
+  // case header names in place.
+  virtual std::shared_ptr<void> pinHeaderStorage() PURE;
 };
 
 using ParserPtr = std::unique_ptr<Parser>;
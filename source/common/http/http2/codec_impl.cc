@@ -262,7 +262,7 @@ void ConnectionImpl::StreamImpl::encodeHeadersBase(const HeaderMap& headers, boo
   bytes_meter_->addDecompressedHeaderBytesSent(headers.byteSize());
 
   submitHeaders(headers, end_stream);
-  if (parent_.sendPendingFramesAndHandleError()) {
+  if (parent_.sendPendingFramesOrScheduleFlush()) {
     // Intended to check through coverage that this error case is tested
     return;
   }
@@ -334,6 +334,14 @@ void ConnectionImpl::StreamImpl::encodeTrailersBase(const HeaderMap& trailers) {
 
   bytes_meter_->addDecompressedHeaderBytesSent(trailers.byteSize());
 
+  if (pending_send_data_->length() > 0 && parent_.flush_once_per_dispatch_) {
+    // The body may only be waiting for the flush at the end of the event loop iteration, send it
+    // now so the trailers are not held back behind a stream flush timer.
+    if (parent_.sendPendingFramesAndHandleError()) {
+      return;
+    }
+  }
+
   if (pending_send_data_->length() > 0) {
     // In this case we want trailers to come after we release all pending body data that is
     // waiting on window updates. We need to save the trailers so that we can emit them later.
@@ -346,7 +354,7 @@ void ConnectionImpl::StreamImpl::encodeTrailersBase(const HeaderMap& trailers) {
     }
   } else {
     submitTrailers(trailers);
-    if (parent_.sendPendingFramesAndHandleError()) {
+    if (parent_.sendPendingFramesOrScheduleFlush()) {
       // Intended to check through coverage that this error case is tested
       return;
     }
@@ -362,7 +370,7 @@ void ConnectionImpl::StreamImpl::encodeMetadata(const MetadataMapVector& metadat
     parent_.adapter_->SubmitMetadata(stream_id_, 16 * 1024, std::move(source));
   }
 
-  if (parent_.sendPendingFramesAndHandleError()) {
+  if (parent_.sendPendingFramesOrScheduleFlush()) {
     // Intended to check through coverage that this error case is tested
     return;
   }
@@ -418,7 +426,7 @@ void ConnectionImpl::StreamImpl::processBufferedData() {
 void ConnectionImpl::StreamImpl::grantPeerAdditionalStreamWindow() {
   parent_.adapter_->MarkDataConsumedForStream(stream_id_, unconsumed_bytes_);
   unconsumed_bytes_ = 0;
-  if (parent_.sendPendingFramesAndHandleError()) {
+  if (parent_.sendPendingFramesOrScheduleFlush()) {
     // Intended to check through coverage that this error case is tested
     return;
   }
@@ -744,7 +752,10 @@ void ConnectionImpl::StreamImpl::encodeDataHelper(Buffer::Instance& data, bool e
     data_deferred_ = false;
   }
 
-  if (parent_.sendPendingFramesAndHandleError()) {
+  // The end of the stream is sent right away, otherwise the stream flush timer would be armed for
+  // data that is only waiting for the end of the event loop iteration.
+  if (local_end_stream_ ? parent_.sendPendingFramesAndHandleError()
+                        : parent_.sendPendingFramesOrScheduleFlush()) {
     // Intended to check through coverage that this error case is tested
     return;
   }
@@ -865,6 +876,8 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
       stream_error_on_invalid_http_messaging_(
           http2_options.override_stream_error_on_invalid_http_message().value()),
       protocol_constraints_(stats, http2_options), dispatching_(false), raised_goaway_(false),
+      flush_once_per_dispatch_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.http2_flush_once_per_dispatch")),
       random_(random_generator),
       last_received_data_time_(connection_.dispatcher().timeSource().monotonicTime()) {
   if (http2_options.has_use_oghttp2_codec()) {
@@ -1377,6 +1390,12 @@ Status ConnectionImpl::trackInboundFrames(int32_t stream_id, size_t length, uint
 
 ssize_t ConnectionImpl::onSend(const uint8_t* data, size_t length) {
   ENVOY_CONN_LOG(trace, "send data: bytes={}", connection_, length);
+  if (flush_once_per_dispatch_) {
+    // Written to the connection once all the pending frames are serialized.
+    addOutboundFrameFragment(pending_output_, data, length);
+    return length;
+  }
+
   Buffer::OwnedImpl buffer;
   addOutboundFrameFragment(buffer, data, length);
 
@@ -1553,6 +1572,9 @@ Status ConnectionImpl::sendPendingFrames() {
   }
 
   const int rc = adapter_->Send();
+  if (pending_output_.length() > 0) {
+    connection_.write(pending_output_, false);
+  }
   if (rc != 0) {
     ASSERT(rc == ERR_CALLBACK_FAILURE);
     return codecProtocolError(codecStrError(rc));
@@ -1601,6 +1623,20 @@ bool ConnectionImpl::sendPendingFramesAndHandleError() {
   return false;
 }
 
+bool ConnectionImpl::sendPendingFramesOrScheduleFlush() {
+  // Frames are always sent at the end of dispatch.
+  if (!flush_once_per_dispatch_ || dispatching_) {
+    return sendPendingFramesAndHandleError();
+  }
+
+  if (!flush_pending_frames_callback_) {
+    flush_pending_frames_callback_ = connection_.dispatcher().createSchedulableCallback(
+        [this]() { sendPendingFramesAndHandleError(); });
+  }
+  flush_pending_frames_callback_->scheduleCallbackCurrentIteration();
+  return false;
+}
+
 void ConnectionImpl::sendSettingsHelper(
     const envoy::config::core::v3::Http2ProtocolOptions& http2_options, bool disable_push) {
   absl::InlinedVector<http2::adapter::Http2Setting, 10> settings;
@@ -663,6 +663,15 @@ protected:
    * Return true if the disconnect callback has been scheduled.
    */
   bool sendPendingFramesAndHandleError();
+
+  /**
+   * Used by the stream encode paths instead of sendPendingFramesAndHandleError(). When flushing
+   * once per dispatch is enabled, pending frames are sent by a callback at the end of the current
+   * event loop iteration, so that the frames of all the streams encoded in the meantime reach the
+   * network connection in a single write.
+   * Return true if the disconnect callback has been scheduled.
+   */
+  bool sendPendingFramesOrScheduleFlush();
   void sendSettings(const envoy::config::core::v3::Http2ProtocolOptions& http2_options,
                     bool disable_push);
   void sendSettingsHelper(const envoy::config::core::v3::Http2ProtocolOptions& http2_options,
@@ -798,7 +807,12 @@ private:
   std::map<int32_t, StreamImpl*> pending_deferred_reset_streams_;
   bool dispatching_ : 1;
   bool raised_goaway_ : 1;
+  const bool flush_once_per_dispatch_ : 1;
   Event::SchedulableCallbackPtr protocol_constraint_violation_callback_;
+  Event::SchedulableCallbackPtr flush_pending_frames_callback_;
+  // Frames serialized by a single sendPendingFrames() call when flushing once per dispatch. This
+  // must be destroyed before protocol_constraints_ as the frame fragments reference it.
+  Buffer::OwnedImpl pending_output_;
   Random::RandomGenerator& random_;
   MonotonicTime last_received_data_time_{};
   Event::TimerPtr keepalive_send_timer_;
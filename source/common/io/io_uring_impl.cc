@@ -2,6 +2,8 @@
 
 #include <sys/eventfd.h>
 
+#include "source/common/buffer/buffer_impl.h"
+
 namespace Envoy {
 namespace Io {
 
@@ -17,6 +19,31 @@ bool isIoUringSupported() {
   return is_supported;
 }
 
+bool isIoUringOpcodeSupported(int opcode) {
+  struct io_uring_probe* probe = io_uring_get_probe();
+  if (probe == nullptr) {
+    return false;
+  }
+  const bool is_supported = io_uring_opcode_supported(probe, opcode);
+  io_uring_free_probe(probe);
+  return is_supported;
+}
+
+void IoUringImpl::ProvidedBufferRing::recycle(uint16_t buffer_id) {
+  ASSERT(outstanding_ > 0);
+  outstanding_--;
+  addToRing(buffer_id);
+}
+
+void IoUringImpl::ProvidedBufferRing::addToRing(uint16_t buffer_id) {
+  if (ring_ == nullptr) {
+    return;
+  }
+  io_uring_buf_ring_add(ring_, buffer(buffer_id), size_, buffer_id,
+                        io_uring_buf_ring_mask(count_), 0);
+  io_uring_buf_ring_advance(ring_, 1);
+}
+
 IoUringImpl::IoUringImpl(uint32_t io_uring_size, bool use_submission_queue_polling)
     : cqes_(io_uring_size, nullptr) {
   struct io_uring_params p {};
@@ -30,7 +57,15 @@ IoUringImpl::IoUringImpl(uint32_t io_uring_size, bool use_submission_queue_polli
   RELEASE_ASSERT(ret == 0, fmt::format("unable to initialize io_uring: {}", errorDetails(-ret)));
 }
 
-IoUringImpl::~IoUringImpl() { io_uring_queue_exit(&ring_); }
+IoUringImpl::~IoUringImpl() {
+  if (provided_buffers_ != nullptr) {
+    io_uring_free_buf_ring(&ring_, provided_buffers_->ring_, provided_buffers_->count_,
+                           BufferGroup);
+    // Buffers still referenced by buffer fragments are released without going back to the ring.
+    provided_buffers_->ring_ = nullptr;
+  }
+  io_uring_queue_exit(&ring_);
+}
 
 os_fd_t IoUringImpl::registerEventfd() {
   ASSERT(!isEventfdRegistered());
@@ -69,7 +104,9 @@ void IoUringImpl::forEveryCompletion(const CompletionCb& completion_cb) {
 
   for (unsigned i = 0; i < count; ++i) {
     struct io_uring_cqe* cqe = cqes_[i];
-    completion_cb(reinterpret_cast<Request*>(cqe->user_data), cqe->res, false);
+    Request* req = reinterpret_cast<Request*>(cqe->user_data);
+    req->setCompletionFlags(cqe->flags);
+    completion_cb(req, cqe->res, false);
   }
 
   io_uring_cq_advance(&ring_, count);
@@ -132,6 +169,7 @@ IoUringResult IoUringImpl::prepareReadv(os_fd_t fd, const struct iovec* iovecs,
   }
 
   io_uring_prep_readv(sqe, fd, iovecs, nr_vecs, offset);
+  maybeUseRegisteredFile(sqe, fd);
   io_uring_sqe_set_data(sqe, user_data);
   return IoUringResult::Ok;
 }
@@ -147,6 +185,41 @@ IoUringResult IoUringImpl::prepareWritev(os_fd_t fd, const struct iovec* iovecs,
   }
 
   io_uring_prep_writev(sqe, fd, iovecs, nr_vecs, offset);
+  maybeUseRegisteredFile(sqe, fd);
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
+IoUringResult IoUringImpl::prepareSendmsgZc(os_fd_t fd, const struct msghdr* msg,
+                                            Request* user_data) {
+  ENVOY_LOG(trace, "prepare sendmsg zc for fd = {}", fd);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_sendmsg_zc(sqe, fd, msg, MSG_NOSIGNAL);
+  maybeUseRegisteredFile(sqe, fd);
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
+IoUringResult IoUringImpl::prepareRecvMultishot(os_fd_t fd, Request* user_data) {
+  ENVOY_LOG(trace, "prepare multishot recv for fd = {}", fd);
+  ASSERT(provided_buffers_ != nullptr);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = BufferGroup;
+  maybeUseRegisteredFile(sqe, fd);
   io_uring_sqe_set_data(sqe, user_data);
   return IoUringResult::Ok;
 }
@@ -207,6 +280,112 @@ void IoUringImpl::injectCompletion(os_fd_t fd, Request* user_data, int32_t resul
             fmt::ptr(user_data), injected_completions_.size());
 }
 
+bool IoUringImpl::registerBufferRing(uint32_t count, uint32_t size) {
+  ASSERT(provided_buffers_ == nullptr);
+  ASSERT(count > 0 && (count & (count - 1)) == 0);
+  int ret = 0;
+  struct io_uring_buf_ring* ring = io_uring_setup_buf_ring(&ring_, count, BufferGroup, 0, &ret);
+  if (ring == nullptr) {
+    ENVOY_LOG(debug, "unable to register provided buffer ring: {}", errorDetails(-ret));
+    return false;
+  }
+
+  provided_buffers_ = std::make_shared<ProvidedBufferRing>();
+  provided_buffers_->ring_ = ring;
+  provided_buffers_->mem_ = std::make_unique<uint8_t[]>(static_cast<size_t>(count) * size);
+  provided_buffers_->count_ = count;
+  provided_buffers_->size_ = size;
+  const int mask = io_uring_buf_ring_mask(count);
+  for (uint32_t i = 0; i < count; i++) {
+    io_uring_buf_ring_add(ring, provided_buffers_->buffer(i), size, i, mask, i);
+  }
+  io_uring_buf_ring_advance(ring, count);
+  return true;
+}
+
+void IoUringImpl::moveProvidedBufferData(uint16_t buffer_id, uint32_t length,
+                                         Buffer::Instance& buffer) {
+  ASSERT(provided_buffers_ != nullptr);
+  ASSERT(buffer_id < provided_buffers_->count_);
+  ASSERT(length <= provided_buffers_->size_);
+  provided_buffers_->outstanding_++;
+  // Referencing the data keeps the buffer out of the ring until the data is drained. Copy once half
+  // of the ring is held, so that slow consumers can not starve the multishot receive requests.
+  if (provided_buffers_->outstanding_ > provided_buffers_->count_ / 2) {
+    buffer.add(provided_buffers_->buffer(buffer_id), length);
+    provided_buffers_->recycle(buffer_id);
+    return;
+  }
+
+  auto* fragment = new Buffer::BufferFragmentImpl(
+      provided_buffers_->buffer(buffer_id), length,
+      [provided_buffers = provided_buffers_, buffer_id](
+          const void*, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+        provided_buffers->recycle(buffer_id);
+        delete this_fragment;
+      });
+  buffer.addBufferFragment(*fragment);
+}
+
+void IoUringImpl::releaseProvidedBuffer(uint16_t buffer_id) {
+  ASSERT(provided_buffers_ != nullptr);
+  ASSERT(buffer_id < provided_buffers_->count_);
+  provided_buffers_->addToRing(buffer_id);
+}
+
+bool IoUringImpl::registerFile(os_fd_t fd) {
+  if (!registered_file_table_) {
+    int ret = io_uring_register_files_sparse(&ring_, MaxRegisteredFiles);
+    if (ret != 0) {
+      ENVOY_LOG(debug, "unable to register file table: {}", errorDetails(-ret));
+      return false;
+    }
+    registered_file_table_ = true;
+    free_file_indexes_.reserve(MaxRegisteredFiles);
+    for (uint32_t i = MaxRegisteredFiles; i > 0; i--) {
+      free_file_indexes_.push_back(i - 1);
+    }
+  }
+  if (free_file_indexes_.empty() || registered_files_.contains(fd)) {
+    return false;
+  }
+
+  const uint32_t index = free_file_indexes_.back();
+  int ret = io_uring_register_files_update(&ring_, index, &fd, 1);
+  if (ret < 0) {
+    ENVOY_LOG(debug, "unable to register fd = {}: {}", fd, errorDetails(-ret));
+    return false;
+  }
+  free_file_indexes_.pop_back();
+  registered_files_.emplace(fd, index);
+  ENVOY_LOG(trace, "registered fd = {} at index {}", fd, index);
+  return true;
+}
+
+void IoUringImpl::unregisterFile(os_fd_t fd) {
+  auto it = registered_files_.find(fd);
+  if (it == registered_files_.end()) {
+    return;
+  }
+  // In flight requests keep their own reference to the file.
+  int invalid_fd = -1;
+  int ret = io_uring_register_files_update(&ring_, it->second, &invalid_fd, 1);
+  RELEASE_ASSERT(ret >= 0, fmt::format("unable to unregister fd: {}", errorDetails(-ret)));
+  free_file_indexes_.push_back(it->second);
+  registered_files_.erase(it);
+}
+
+void IoUringImpl::maybeUseRegisteredFile(struct io_uring_sqe* sqe, os_fd_t fd) {
+  if (registered_files_.empty()) {
+    return;
+  }
+  auto it = registered_files_.find(fd);
+  if (it != registered_files_.end()) {
+    sqe->fd = it->second;
+    sqe->flags |= IOSQE_FIXED_FILE;
+  }
+}
+
 void IoUringImpl::removeInjectedCompletion(os_fd_t fd) {
   ENVOY_LOG(trace, "remove injected completions for fd = {}, size = {}", fd,
             injected_completions_.size());
@@ -5,6 +5,7 @@
 
 #include "source/common/common/logger.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "liburing.h"
 
 namespace Envoy {
@@ -12,6 +13,11 @@ namespace Io {
 
 bool isIoUringSupported();
 
+/**
+ * @return true if the running kernel supports the given io_uring opcode.
+ */
+bool isIoUringOpcodeSupported(int opcode);
+
 struct InjectedCompletion {
   InjectedCompletion(os_fd_t fd, Request* user_data, int32_t result)
       : fd_(fd), user_data_(user_data), result_(result) {}
@@ -40,18 +46,60 @@ public:
                              Request* user_data) override;
   IoUringResult prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                               off_t offset, Request* user_data) override;
+  IoUringResult prepareSendmsgZc(os_fd_t fd, const struct msghdr* msg,
+                                 Request* user_data) override;
+  IoUringResult prepareRecvMultishot(os_fd_t fd, Request* user_data) override;
   IoUringResult prepareClose(os_fd_t fd, Request* user_data) override;
   IoUringResult prepareCancel(Request* cancelling_user_data, Request* user_data) override;
   IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) override;
   IoUringResult submit() override;
   void injectCompletion(os_fd_t fd, Request* user_data, int32_t result) override;
   void removeInjectedCompletion(os_fd_t fd) override;
+  bool registerBufferRing(uint32_t count, uint32_t size) override;
+  void moveProvidedBufferData(uint16_t buffer_id, uint32_t length,
+                              Buffer::Instance& buffer) override;
+  void releaseProvidedBuffer(uint16_t buffer_id) override;
+  bool registerFile(os_fd_t fd) override;
+  void unregisterFile(os_fd_t fd) override;
+
+  // The buffer group of the provided buffer ring.
+  static constexpr uint16_t BufferGroup = 0;
+  // The size of the sparse registered file table.
+  static constexpr uint32_t MaxRegisteredFiles = 4096;
+
+  /**
+   * The ring of provided buffers. It is shared with the buffer fragments referencing its buffers,
+   * so that buffers released after the io_uring instance is gone stay valid.
+   */
+  struct ProvidedBufferRing {
+    uint8_t* buffer(uint16_t buffer_id) const { return mem_.get() + buffer_id * size_; }
+    // Return a buffer held by a buffer fragment to the ring.
+    void recycle(uint16_t buffer_id);
+    // Put a buffer back into the ring, if the ring is still registered.
+    void addToRing(uint16_t buffer_id);
+
+    // Reset once the io_uring instance frees the ring.
+    struct io_uring_buf_ring* ring_{};
+    std::unique_ptr<uint8_t[]> mem_;
+    uint32_t count_{};
+    uint32_t size_{};
+    // The number of buffers held by buffer fragments.
+    uint32_t outstanding_{};
+  };
 
 private:
+  // Replace the file descriptor of a prepared submission queue entry with its registered file
+  // index, if it has one.
+  void maybeUseRegisteredFile(struct io_uring_sqe* sqe, os_fd_t fd);
+
   struct io_uring ring_ {};
   std::vector<struct io_uring_cqe*> cqes_;
   os_fd_t event_fd_{INVALID_SOCKET};
   std::list<InjectedCompletion> injected_completions_;
+  std::shared_ptr<ProvidedBufferRing> provided_buffers_;
+  bool registered_file_table_{false};
+  absl::flat_hash_map<os_fd_t, uint32_t> registered_files_;
+  std::vector<uint32_t> free_file_indexes_;
 };
 
 } // namespace Io
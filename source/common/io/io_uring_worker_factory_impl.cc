@@ -9,9 +9,15 @@ IoUringWorkerFactoryImpl::IoUringWorkerFactoryImpl(uint32_t io_uring_size,
                                                    bool use_submission_queue_polling,
                                                    uint32_t read_buffer_size,
                                                    uint32_t write_timeout_ms,
+                                                   uint32_t multishot_read_buffer_count,
+                                                   uint32_t zero_copy_send_threshold,
+                                                   bool register_client_socket_fds,
                                                    ThreadLocal::SlotAllocator& tls)
     : io_uring_size_(io_uring_size), use_submission_queue_polling_(use_submission_queue_polling),
-      read_buffer_size_(read_buffer_size), write_timeout_ms_(write_timeout_ms), tls_(tls) {}
+      read_buffer_size_(read_buffer_size), write_timeout_ms_(write_timeout_ms),
+      multishot_read_buffer_count_(multishot_read_buffer_count),
+      zero_copy_send_threshold_(zero_copy_send_threshold),
+      register_client_socket_fds_(register_client_socket_fds), tls_(tls) {}
 
 OptRef<IoUringWorker> IoUringWorkerFactoryImpl::getIoUringWorker() {
   auto ret = tls_.get();
@@ -25,9 +31,15 @@ void IoUringWorkerFactoryImpl::onWorkerThreadInitialized() {
   tls_.set([io_uring_size = io_uring_size_,
             use_submission_queue_polling = use_submission_queue_polling_,
             read_buffer_size = read_buffer_size_,
-            write_timeout_ms = write_timeout_ms_](Event::Dispatcher& dispatcher) {
-    return std::make_shared<IoUringWorkerImpl>(io_uring_size, use_submission_queue_polling,
-                                               read_buffer_size, write_timeout_ms, dispatcher);
+            write_timeout_ms = write_timeout_ms_,
+            multishot_read_buffer_count = multishot_read_buffer_count_,
+            zero_copy_send_threshold = zero_copy_send_threshold_,
+            register_client_socket_fds =
+                register_client_socket_fds_](Event::Dispatcher& dispatcher) {
+    return std::make_shared<IoUringWorkerImpl>(
+        io_uring_size, use_submission_queue_polling, read_buffer_size, write_timeout_ms,
+        multishot_read_buffer_count, zero_copy_send_threshold, register_client_socket_fds,
+        dispatcher);
   });
 }
 
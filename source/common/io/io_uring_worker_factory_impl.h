@@ -10,7 +10,8 @@ class IoUringWorkerFactoryImpl : public IoUringWorkerFactory {
 public:
   IoUringWorkerFactoryImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                            uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                           ThreadLocal::SlotAllocator& tls);
+                           uint32_t multishot_read_buffer_count, uint32_t zero_copy_send_threshold,
+                           bool register_client_socket_fds, ThreadLocal::SlotAllocator& tls);
 
   OptRef<IoUringWorker> getIoUringWorker() override;
 
@@ -22,6 +23,9 @@ private:
   const bool use_submission_queue_polling_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  const uint32_t multishot_read_buffer_count_;
+  const uint32_t zero_copy_send_threshold_;
+  const bool register_client_socket_fds_;
   ThreadLocal::TypedSlot<IoUringWorker> tls_;
 };
 
@@ -1,5 +1,7 @@
 #include "source/common/io/io_uring_worker_impl.h"
 
+#include "absl/numeric/bits.h"
+
 namespace Envoy {
 namespace Io {
 
@@ -16,6 +18,8 @@ WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector&
     iov_[i].iov_base = slices[i].mem_;
     iov_[i].iov_len = slices[i].len_;
   }
+  msg_.msg_iov = iov_.get();
+  msg_.msg_iovlen = slices.size();
 }
 
 IoUringSocketEntry::IoUringSocketEntry(os_fd_t fd, IoUringWorkerImpl& parent, Event::FileReadyCb cb,
@@ -60,14 +64,29 @@ void IoUringSocketEntry::onRemoteClose() {
 
 IoUringWorkerImpl::IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                                      uint32_t read_buffer_size, uint32_t write_timeout_ms,
+                                     uint32_t multishot_read_buffer_count,
+                                     uint32_t zero_copy_send_threshold,
+                                     bool register_client_socket_fds,
                                      Event::Dispatcher& dispatcher)
     : IoUringWorkerImpl(std::make_unique<IoUringImpl>(io_uring_size, use_submission_queue_polling),
-                        read_buffer_size, write_timeout_ms, dispatcher) {}
+                        read_buffer_size, write_timeout_ms, multishot_read_buffer_count,
+                        zero_copy_send_threshold, register_client_socket_fds, dispatcher) {}
 
 IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size,
-                                     uint32_t write_timeout_ms, Event::Dispatcher& dispatcher)
+                                     uint32_t write_timeout_ms,
+                                     uint32_t multishot_read_buffer_count,
+                                     uint32_t zero_copy_send_threshold,
+                                     bool register_client_socket_fds,
+                                     Event::Dispatcher& dispatcher)
     : io_uring_(std::move(io_uring)), read_buffer_size_(read_buffer_size),
-      write_timeout_ms_(write_timeout_ms), dispatcher_(dispatcher) {
+      write_timeout_ms_(write_timeout_ms), zero_copy_send_threshold_(zero_copy_send_threshold),
+      register_client_socket_fds_(register_client_socket_fds), dispatcher_(dispatcher) {
+  if (multishot_read_buffer_count > 0) {
+    // Fall back to a read request per read if the kernel does not support provided buffer rings.
+    multishot_read_ = io_uring_->registerBufferRing(absl::bit_ceil(multishot_read_buffer_count),
+                                                    read_buffer_size_);
+  }
+
   const os_fd_t event_fd = io_uring_->registerEventfd();
   // We only care about the read event of Eventfd, since we only receive the
   // event here.
@@ -124,6 +143,11 @@ IoUringSocket& IoUringWorkerImpl::addClientSocket(os_fd_t fd, Event::FileReadyCb
   // The client socket should not be read enabled until it is connected.
   std::unique_ptr<IoUringClientSocket> socket = std::make_unique<IoUringClientSocket>(
       fd, *this, std::move(cb), write_timeout_ms_, enable_close_event);
+  // Upstream connections are long lived, registering their fd saves a file table lookup on every
+  // request.
+  if (register_client_socket_fds_ && !io_uring_->registerFile(fd)) {
+    ENVOY_LOG(trace, "unable to register client socket, fd = {}", fd);
+  }
   return addSocket(std::move(socket));
 }
 
@@ -153,6 +177,24 @@ IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
 }
 
 Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
+  if (multishot_read_) {
+    // The request stays alive until its last completion, each completion picks a provided buffer.
+    Request* req = new Request(Request::RequestType::Read, socket);
+
+    ENVOY_LOG(trace, "submit multishot recv request, fd = {}, read req = {}", socket.fd(),
+              fmt::ptr(req));
+
+    auto res = io_uring_->prepareRecvMultishot(socket.fd(), req);
+    if (res == IoUringResult::Failed) {
+      // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+      submit();
+      res = io_uring_->prepareRecvMultishot(socket.fd(), req);
+      RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare multishot recv");
+    }
+    submit();
+    return req;
+  }
+
   ReadRequest* req = new ReadRequest(socket, read_buffer_size_);
 
   ENVOY_LOG(trace, "submit read request, fd = {}, read req = {}", socket.fd(), fmt::ptr(req));
@@ -172,6 +214,27 @@ Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
                                                const Buffer::RawSliceVector& slices) {
   WriteRequest* req = new WriteRequest(socket, slices);
 
+  if (zero_copy_send_threshold_ > 0) {
+    uint64_t length = 0;
+    for (const Buffer::RawSlice& slice : slices) {
+      length += slice.len_;
+    }
+    if (length >= zero_copy_send_threshold_) {
+      ENVOY_LOG(trace, "submit zero copy send request, fd = {}, req = {}, size = {}", socket.fd(),
+                fmt::ptr(req), length);
+
+      auto res = io_uring_->prepareSendmsgZc(socket.fd(), &req->msg_, req);
+      if (res == IoUringResult::Failed) {
+        // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+        submit();
+        res = io_uring_->prepareSendmsgZc(socket.fd(), &req->msg_, req);
+        RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare sendmsg zc");
+      }
+      submit();
+      return req;
+    }
+  }
+
   ENVOY_LOG(trace, "submit write request, fd = {}, req = {}", socket.fd(), fmt::ptr(req));
 
   auto res = io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
@@ -190,6 +253,9 @@ Request* IoUringWorkerImpl::submitCloseRequest(IoUringSocket& socket) {
 
   ENVOY_LOG(trace, "submit close request, fd = {}, close req = {}", socket.fd(), fmt::ptr(req));
 
+  // The registered file table holds a reference to the socket that would keep it open.
+  io_uring_->unregisterFile(socket.fd());
+
   auto res = io_uring_->prepareClose(socket.fd(), req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
@@ -238,9 +304,35 @@ Request* IoUringWorkerImpl::submitShutdownRequest(IoUringSocket& socket, int how
 IoUringSocketEntryPtr IoUringWorkerImpl::removeSocket(IoUringSocketEntry& socket) {
   // Remove all the injection completion for this socket.
   io_uring_->removeInjectedCompletion(socket.fd());
+  // The fd may be kept open and handed to another worker.
+  io_uring_->unregisterFile(socket.fd());
   return socket.removeFromList(sockets_);
 }
 
+void IoUringWorkerImpl::moveReadData(Request& req, uint32_t length, Buffer::Instance& buffer) {
+  const uint32_t flags = req.completionFlags();
+  if (flags & IORING_CQE_F_BUFFER) {
+    io_uring_->moveProvidedBufferData(flags >> IORING_CQE_BUFFER_SHIFT, length, buffer);
+    return;
+  }
+
+  ReadRequest& read_req = static_cast<ReadRequest&>(req);
+  Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
+      read_req.buf_.release(), length,
+      [](const void* data, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+        delete[] reinterpret_cast<const uint8_t*>(data);
+        delete this_fragment;
+      });
+  buffer.addBufferFragment(*fragment);
+}
+
+void IoUringWorkerImpl::discardReadData(Request& req) {
+  const uint32_t flags = req.completionFlags();
+  if (flags & IORING_CQE_F_BUFFER) {
+    io_uring_->releaseProvidedBuffer(flags >> IORING_CQE_BUFFER_SHIFT);
+  }
+}
+
 void IoUringWorkerImpl::injectCompletion(IoUringSocket& socket, Request::RequestType type,
                                          int32_t result) {
   Request* req = new Request(type, socket);
@@ -294,7 +386,10 @@ void IoUringWorkerImpl::onFileEvent() {
       break;
     }
 
-    delete req;
+    // Multishot and zero copy requests are completed by their last completion.
+    if (!(req->completionFlags() & IORING_CQE_F_MORE)) {
+      delete req;
+    }
   });
   delay_submit_ = false;
   submit();
@@ -429,14 +524,7 @@ void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected)
 }
 
 void IoUringServerSocket::moveReadDataToBuffer(Request* req, size_t data_length) {
-  ReadRequest* read_req = static_cast<ReadRequest*>(req);
-  Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
-      read_req->buf_.release(), data_length,
-      [](const void* data, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
-        delete[] reinterpret_cast<const uint8_t*>(data);
-        delete this_fragment;
-      });
-  read_buf_.addBufferFragment(*fragment);
+  parent_.moveReadData(*req, data_length, read_buf_);
 }
 
 void IoUringServerSocket::onReadCompleted(int32_t result) {
@@ -457,12 +545,19 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
             "onRead with result {}, fd = {}, injected = {}, status_ = {}, enable_close_event = {}",
             result, fd_, injected, static_cast<int>(status_), enable_close_event_);
   if (!injected) {
-    read_req_ = nullptr;
+    // A multishot read request stays armed until a completion without `IORING_CQE_F_MORE`.
+    if (!(req->completionFlags() & IORING_CQE_F_MORE)) {
+      read_req_ = nullptr;
+    }
     // If the socket is going to close, discard all results.
-    if (status_ == Closed && write_or_shutdown_req_ == nullptr && read_cancel_req_ == nullptr &&
-        write_or_shutdown_cancel_req_ == nullptr) {
-      if (result > 0 && keep_fd_open_) {
-        moveReadDataToBuffer(req, result);
+    if (status_ == Closed && write_or_shutdown_req_ == nullptr && read_req_ == nullptr &&
+        read_cancel_req_ == nullptr && write_or_shutdown_cancel_req_ == nullptr) {
+      if (result > 0) {
+        if (keep_fd_open_) {
+          moveReadDataToBuffer(req, result);
+        } else {
+          parent_.discardReadData(*req);
+        }
       }
       closeInternal();
       return;
@@ -473,7 +568,8 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
   if (result > 0) {
     moveReadDataToBuffer(req, result);
   } else {
-    if (result != -ECANCELED) {
+    // Running out of provided buffers terminates a multishot read, it is simply re-armed below.
+    if (result != -ECANCELED && result != -ENOBUFS) {
       read_error_ = result;
     }
   }
@@ -562,6 +658,16 @@ void IoUringServerSocket::onWrite(Request* req, int32_t result, bool injected) {
   ENVOY_LOG(trace, "onWrite with result {}, fd = {}, injected = {}, status_ = {}", result, fd_,
             injected, static_cast<int>(status_));
   if (!injected) {
+    const uint32_t flags = req->completionFlags();
+    if (flags & IORING_CQE_F_MORE) {
+      // A zero copy send completes twice, the pages of the write buffer are pinned until the
+      // notification arrives, so the result is applied only then.
+      zero_copy_send_result_ = result;
+      return;
+    }
+    if (flags & IORING_CQE_F_NOTIF) {
+      result = zero_copy_send_result_;
+    }
     write_or_shutdown_req_ = nullptr;
   }
 
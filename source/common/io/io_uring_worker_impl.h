@@ -23,6 +23,8 @@ public:
   WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices);
 
   std::unique_ptr<struct iovec[]> iov_;
+  // Only used by zero copy sends.
+  struct msghdr msg_ {};
 };
 
 class IoUringSocketEntry;
@@ -32,9 +34,11 @@ class IoUringWorkerImpl : public IoUringWorker, private Logger::Loggable<Logger:
 public:
   IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                     uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    uint32_t multishot_read_buffer_count, uint32_t zero_copy_send_threshold,
+                    bool register_client_socket_fds, Event::Dispatcher& dispatcher);
   IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    uint32_t multishot_read_buffer_count, uint32_t zero_copy_send_threshold,
+                    bool register_client_socket_fds, Event::Dispatcher& dispatcher);
   ~IoUringWorkerImpl() override;
 
   // IoUringWorker
@@ -64,6 +68,12 @@ public:
   // Return the number of sockets in this worker.
   uint32_t getNumOfSockets() const override { return sockets_.size(); }
 
+  // Append the data of a read request completion to a buffer.
+  void moveReadData(Request& req, uint32_t length, Buffer::Instance& buffer);
+
+  // Drop the data of a read request completion, returning its provided buffer to the ring.
+  void discardReadData(Request& req);
+
 protected:
   // Add a socket to the worker.
   IoUringSocketEntry& addSocket(IoUringSocketEntryPtr&& socket);
@@ -74,6 +84,11 @@ protected:
   IoUringPtr io_uring_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  // Writes of at least this many bytes use zero copy sends. 0 disables zero copy sends.
+  const uint32_t zero_copy_send_threshold_;
+  const bool register_client_socket_fds_;
+  // Whether reads use multishot recv requests on the provided buffer ring.
+  bool multishot_read_{false};
   // The dispatcher of this worker is running on.
   Event::Dispatcher& dispatcher_;
   // The file event of iouring's eventfd.
@@ -224,6 +239,9 @@ protected:
   // For write. iouring socket will write sequentially in the order of write_buf_ and shutdown_
   // Unless the write_buf_ is empty, the shutdown operation will not be performed.
   Buffer::OwnedImpl write_buf_;
+  // The result of a zero copy send waiting for the notification that the kernel released
+  // write_buf_. The written data is only drained once the notification arrives.
+  int32_t zero_copy_send_result_{0};
   // shutdown_ has 3 states. A absl::nullopt indicates the socket has not been shutdown, a false
   // value represents the socket wants to be shutdown but the shutdown has not been performed or
   // completed, and a true value means the socket has been shutdown.
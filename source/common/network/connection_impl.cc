@@ -48,6 +48,12 @@ absl::string_view ipVersionAsString(Network::Address::IpVersion ip_version) {
   return ip_version == Network::Address::IpVersion::v4 ? "v4" : "v6";
 }
 
+// The number of slices IoSocketHandleImpl::write() hands to a single writev() call.
+constexpr uint64_t kMaxWriteSlices = 16;
+// Write buffer slices smaller than this are copied together when coalescing writes. Larger slices
+// are always written from their own storage.
+constexpr uint64_t kWriteCoalesceThreshold = 1024;
+
 } // namespace
 
 void ConnectionImplUtility::updateBufferStats(uint64_t delta, uint64_t new_total,
@@ -89,7 +95,9 @@ ConnectionImpl::ConnectionImpl(Event::Dispatcher& dispatcher, ConnectionSocketPt
       write_end_stream_(false), current_write_end_stream_(false), dispatch_buffered_data_(false),
       transport_wants_read_(false),
       enable_close_through_filter_manager_(Runtime::runtimeFeatureEnabled(
-          "envoy.reloadable_features.connection_close_through_filter_manager")) {
+          "envoy.reloadable_features.connection_close_through_filter_manager")),
+      coalesce_write_slices_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.coalesce_write_slices")) {
 
   if (!socket_->isOpen()) {
     IS_ENVOY_BUG("Client socket failure");
@@ -800,6 +808,20 @@ ConnectionImpl::unixSocketPeerCredentials() const {
 #endif
 }
 
+void ConnectionImpl::coalesceWriteBuffer() {
+  const Buffer::CoalesceResult result =
+      write_buffer_->coalesceForWrite(kMaxWriteSlices, kWriteCoalesceThreshold);
+  if (connection_stats_ == nullptr || result.bytes_copied_ == 0) {
+    return;
+  }
+  if (connection_stats_->write_slices_ != nullptr) {
+    connection_stats_->write_slices_->recordValue(result.write_slices_);
+  }
+  if (connection_stats_->write_coalesced_bytes_ != nullptr) {
+    connection_stats_->write_coalesced_bytes_->add(result.bytes_copied_);
+  }
+}
+
 void ConnectionImpl::onWriteReady() {
   ENVOY_CONN_LOG(trace, "write ready", *this);
 
@@ -827,6 +849,9 @@ void ConnectionImpl::onWriteReady() {
     }
   }
 
+  if (coalesce_write_slices_) {
+    coalesceWriteBuffer();
+  }
   IoResult result = transport_socket_->doWrite(*write_buffer_, write_end_stream_);
   ASSERT(!result.end_stream_read_); // The interface guarantees that only read operations set this.
   uint64_t new_buffer_size = write_buffer_->length();
@@ -225,6 +225,10 @@ private:
   void updateReadBufferStats(uint64_t num_read, uint64_t new_size);
   void updateWriteBufferStats(uint64_t num_written, uint64_t new_size);
 
+  // Copy small slices at the front of the write buffer together ahead of a transport socket write
+  // and record the write coalescing stats.
+  void coalesceWriteBuffer();
+
   // Write data to the connection bypassing filter chain (optionally).
   void write(Buffer::Instance& data, bool end_stream, bool through_filter_chain);
 
@@ -264,6 +268,8 @@ private:
   // in transport socket internal buffers.
   bool transport_wants_read_ : 1;
   bool enable_close_through_filter_manager_ : 1;
+  // Latched value of `envoy.reloadable_features.coalesce_write_slices`.
+  const bool coalesce_write_slices_ : 1;
 };
 
 class ServerConnectionImpl : public ConnectionImpl, virtual public ServerConnection {
@@ -173,12 +173,19 @@ Server::BootstrapExtensionPtr SocketInterfaceImpl::createBootstrapExtension(
       config, context.messageValidationVisitor());
   if (message.has_io_uring_options() && Io::isIoUringSupported()) {
     const auto& options = message.io_uring_options();
+    // Zero copy send is only attempted when the running kernel knows about it.
+    const uint32_t zero_copy_send_threshold =
+        Io::isIoUringOpcodeSupported(IORING_OP_SENDMSG_ZC)
+            ? PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, zero_copy_send_threshold, 0)
+            : 0;
     std::shared_ptr<Io::IoUringWorkerFactoryImpl> io_uring_worker_factory =
         std::make_shared<Io::IoUringWorkerFactoryImpl>(
             PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, io_uring_size, 1000),
             options.enable_submission_queue_polling(),
             PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, read_buffer_size, 8192),
             PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, write_timeout_ms, 1000),
+            PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, multishot_read_buffer_count, 0),
+            zero_copy_send_threshold, options.register_client_socket_fds(),
             context.threadLocal());
     io_uring_worker_factory_ = io_uring_worker_factory;
 
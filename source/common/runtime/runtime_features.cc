@@ -175,6 +175,18 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_enable_new_dns_implementation);
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_reverse_conn_force_local_reply);
 // RELEASE_ASSERT when upstream stream detects UAF of downstream response decoder instance.
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_abort_when_accessing_dead_decoder);
+// Lets HTTP/1 header strings reference the parser's header block instead of copying each name
+// and value. Flip to true after more production testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http1_zero_copy_headers);
+// Copies runs of small write buffer slices together before each socket write so writev() covers
+// more data per syscall. Flip to true after more production testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_coalesce_write_slices);
+// Lets workers recycle the storage of destroyed buffer slices through a bounded per-worker cache.
+// Flip to true after more production testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_buffer_slice_storage_cache);
+// Sends the HTTP/2 frames encoded outside of dispatch once per event loop iteration instead of
+// after every encode call. Flip to true after more production testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http2_flush_once_per_dispatch);
 // Block of non-boolean flags. Use of int flags is deprecated. Do not add more.
 ABSL_FLAG(uint64_t, re2_max_program_size_error_level, 100, ""); // NOLINT
 ABSL_FLAG(uint64_t, re2_max_program_size_warn_level,            // NOLINT
@@ -17,6 +17,7 @@
 #include "source/common/stats/symbol_table.h"
 
 #include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
 
 namespace Envoy {
 namespace Stats {
@@ -88,6 +89,8 @@ public:
   void markUnused() override { flags_ &= ~Metric::Flags::Used; }
   bool hidden() const override { return flags_ & Metric::Flags::Hidden; }
 
+  void clearChanged() { flags_ &= ~Metric::Flags::Changed; }
+
   // RefcountInterface
   void incRefCount() override { ++ref_count_; }
   bool decRefCount() override {
@@ -121,6 +124,24 @@ public:
   virtual void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) PURE;
 
 protected:
+  /**
+   * Sets the given flags along with Metric::Flags::Changed. The first change since the stat was
+   * last flushed queues it with the allocator, so flushing changed stats only visits those. Until
+   * the allocator tracks changes, Changed is left unset so that every stat flagged changed is
+   * queued.
+   */
+  void setFlagsAndMarkChanged(uint16_t flags) {
+    if (!alloc_.track_changed_stats_) {
+      if (flags != 0) {
+        flags_ |= flags;
+      }
+      return;
+    }
+    if (!(flags_.fetch_or(flags | Metric::Flags::Changed) & Metric::Flags::Changed)) {
+      alloc_.markChanged(static_cast<BaseClass&>(*this));
+    }
+  }
+
   AllocatorImpl& alloc_;
 
   // ref_count_ can be incremented as an atomic, without taking a new lock, as
@@ -147,6 +168,7 @@ public:
     const size_t count = alloc_.counters_.erase(statName());
     ASSERT(count == 1);
     alloc_.sinked_counters_.erase(this);
+    alloc_.eraseChangedLockHeld<Counter>(this);
   }
 
   // Stats::Counter
@@ -155,7 +177,7 @@ public:
     // used(). From a system perspective this should be eventually consistent.
     value_ += amount;
     pending_increment_ += amount;
-    flags_ |= Flags::Used;
+    setFlagsAndMarkChanged(Flags::Used);
   }
   void inc() override { add(1); }
   uint64_t latch() override { return pending_increment_.exchange(0); }
@@ -196,23 +218,25 @@ public:
     const size_t count = alloc_.gauges_.erase(statName());
     ASSERT(count == 1);
     alloc_.sinked_gauges_.erase(this);
+    alloc_.eraseChangedLockHeld<Gauge>(this);
   }
 
   // Stats::Gauge
   void add(uint64_t amount) override {
     child_value_ += amount;
-    flags_ |= Flags::Used;
+    setFlagsAndMarkChanged(Flags::Used);
   }
   void dec() override { sub(1); }
   void inc() override { add(1); }
   void set(uint64_t value) override {
     child_value_ = value;
-    flags_ |= Flags::Used;
+    setFlagsAndMarkChanged(Flags::Used);
   }
   void sub(uint64_t amount) override {
     ASSERT(child_value_ >= amount);
     ASSERT(used() || amount == 0);
     child_value_ -= amount;
+    setFlagsAndMarkChanged(0);
   }
   uint64_t value() const override { return child_value_ + parent_value_; }
 
@@ -261,7 +285,10 @@ public:
     }
   }
 
-  void setParentValue(uint64_t value) override { parent_value_ = value; }
+  void setParentValue(uint64_t value) override {
+    parent_value_ = value;
+    setFlagsAndMarkChanged(0);
+  }
 
 private:
   std::atomic<uint64_t> parent_value_{0};
@@ -278,14 +305,17 @@ public:
     const size_t count = alloc_.text_readouts_.erase(statName());
     ASSERT(count == 1);
     alloc_.sinked_text_readouts_.erase(this);
+    alloc_.eraseChangedLockHeld<TextReadout>(this);
   }
 
   // Stats::TextReadout
   void set(absl::string_view value) override {
     std::string value_copy(value);
-    absl::MutexLock lock(mutex_);
-    value_ = std::move(value_copy);
-    flags_ |= Flags::Used;
+    {
+      absl::MutexLock lock(mutex_);
+      value_ = std::move(value_copy);
+    }
+    setFlagsAndMarkChanged(Flags::Used);
   }
   std::string value() const override {
     absl::MutexLock lock(mutex_);
@@ -440,6 +470,84 @@ void AllocatorImpl::forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout>
   }
 }
 
+void AllocatorImpl::forEachChangedCounter(SizeFn f_size, StatFn<Counter> f_stat) {
+  forEachChanged<Counter>(f_size, f_stat);
+}
+
+void AllocatorImpl::forEachChangedGauge(SizeFn f_size, StatFn<Gauge> f_stat) {
+  forEachChanged<Gauge>(f_size, f_stat);
+}
+
+void AllocatorImpl::forEachChangedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) {
+  forEachChanged<TextReadout>(f_size, f_stat);
+}
+
+AllocatorImpl::ChangedStatsShard& AllocatorImpl::changedStatsShard(const Metric* stat) {
+  return changed_stats_[absl::Hash<const Metric*>()(stat) % ChangedStatsShardCount];
+}
+
+template <class StatType> void AllocatorImpl::markChanged(StatType& stat) {
+  ChangedStatsShard& shard = changedStatsShard(&stat);
+  Thread::LockGuard lock(shard.mutex_);
+  shard.statsLockHeld(&stat).insert(&stat);
+}
+
+template <class StatType> void AllocatorImpl::eraseChangedLockHeld(StatType* stat) {
+  if (!track_changed_stats_) {
+    return;
+  }
+  ChangedStatsShard& shard = changedStatsShard(stat);
+  Thread::LockGuard lock(shard.mutex_);
+  shard.statsLockHeld(stat).erase(stat);
+}
+
+template <class StatType>
+void AllocatorImpl::forEachChanged(SizeFn f_size, StatFn<StatType> f_stat) {
+  // Holding mutex_ keeps the changed stats from being freed while they are visited.
+  Thread::LockGuard lock(mutex_);
+  const StatType* tag = nullptr;
+  if (!track_changed_stats_) {
+    track_changed_stats_ = true;
+    visit_all_changed_ = AllChangedTypeBits;
+  }
+
+  // Take the queued stats of every shard. A stat is only queued again once its changed flag is
+  // cleared below, so each of them is either visited or, if it is not sinked, dropped for good.
+  std::vector<StatType*> stats;
+  for (ChangedStatsShard& shard : changed_stats_) {
+    Thread::LockGuard changed_lock(shard.mutex_);
+    StatPointerSet<StatType>& shard_stats = shard.statsLockHeld(tag);
+    stats.insert(stats.end(), shard_stats.begin(), shard_stats.end());
+    shard_stats.clear();
+  }
+  // Stats that are not sinked keep their changed flag, so they are never queued again.
+  const StatPointerSet<StatType>& sinked_stats = sinkedStatsLockHeld(tag);
+  const auto not_sinked = [this, &sinked_stats](StatType* stat) {
+    return sink_predicates_ != nullptr ? !sinked_stats.contains(stat) : stat->hidden();
+  };
+  stats.erase(std::remove_if(stats.begin(), stats.end(), not_sinked), stats.end());
+  // Clear the changed flags before the stats are read, so that a racing change queues them again.
+  // Only stats queued by markChanged() are in the shards, so they are all StatsSharedImpls.
+  for (StatType* stat : stats) {
+    static_cast<StatsSharedImpl<StatType>*>(stat)->clearChanged();
+  }
+
+  // Changes made before tracking started were not queued, so every stat is visited the first time.
+  if (visit_all_changed_ & changedTypeBit(tag)) {
+    visit_all_changed_ &= ~changedTypeBit(tag);
+    const StatSet<StatType>& all_stats = statsLockHeld(tag);
+    stats.assign(all_stats.begin(), all_stats.end());
+    stats.erase(std::remove_if(stats.begin(), stats.end(), not_sinked), stats.end());
+  }
+
+  if (f_size != nullptr) {
+    f_size(stats.size());
+  }
+  for (StatType* stat : stats) {
+    f_stat(*stat);
+  }
+}
+
 void AllocatorImpl::setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) {
   Thread::LockGuard lock(mutex_);
   ASSERT(sink_predicates_ == nullptr);
@@ -479,6 +587,7 @@ void AllocatorImpl::markCounterForDeletion(const CounterSharedPtr& counter) {
   deleted_counters_.emplace_back(*iter);
   counters_.erase(iter);
   sinked_counters_.erase(counter.get());
+  eraseChangedLockHeld<Counter>(counter.get());
 }
 
 void AllocatorImpl::markGaugeForDeletion(const GaugeSharedPtr& gauge) {
@@ -493,6 +602,7 @@ void AllocatorImpl::markGaugeForDeletion(const GaugeSharedPtr& gauge) {
   deleted_gauges_.emplace_back(*iter);
   gauges_.erase(iter);
   sinked_gauges_.erase(gauge.get());
+  eraseChangedLockHeld<Gauge>(gauge.get());
 }
 
 void AllocatorImpl::markTextReadoutForDeletion(const TextReadoutSharedPtr& text_readout) {
@@ -507,6 +617,7 @@ void AllocatorImpl::markTextReadoutForDeletion(const TextReadoutSharedPtr& text_
   deleted_text_readouts_.emplace_back(*iter);
   text_readouts_.erase(iter);
   sinked_text_readouts_.erase(text_readout.get());
+  eraseChangedLockHeld<TextReadout>(text_readout.get());
 }
 
 } // namespace Stats
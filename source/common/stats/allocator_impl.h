@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <functional>
 #include <vector>
 
 #include "envoy/common/optref.h"
@@ -44,6 +47,10 @@ public:
   void forEachSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) const override;
   void forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const override;
 
+  void forEachChangedCounter(SizeFn f_size, StatFn<Counter> f_stat) override;
+  void forEachChangedGauge(SizeFn f_size, StatFn<Gauge> f_stat) override;
+  void forEachChangedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) override;
+
   void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) override;
 #ifndef ENVOY_CONFIG_COVERAGE
   void debugPrint();
@@ -68,6 +75,65 @@ protected:
                                        const StatNameTagVector& stat_name_tags);
 
 private:
+  template <typename StatType> using StatPointerSet = absl::flat_hash_set<StatType*>;
+
+  /**
+   * A shard of the stats changed since they were last visited by forEachChanged*(). Stats are
+   * marked changed from the worker threads, so they are spread over shards by address, each with
+   * its own mutex, and the flush takes the sets of every shard.
+   */
+  struct alignas(64) ChangedStatsShard {
+    StatPointerSet<Counter>& statsLockHeld(const Counter*) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+      return counters_;
+    }
+    StatPointerSet<Gauge>& statsLockHeld(const Gauge*) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+      return gauges_;
+    }
+    StatPointerSet<TextReadout>& statsLockHeld(const TextReadout*)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+      return text_readouts_;
+    }
+
+    Thread::MutexBasicLockable mutex_;
+    StatPointerSet<Counter> counters_ ABSL_GUARDED_BY(mutex_);
+    StatPointerSet<Gauge> gauges_ ABSL_GUARDED_BY(mutex_);
+    StatPointerSet<TextReadout> text_readouts_ ABSL_GUARDED_BY(mutex_);
+  };
+  static constexpr uint32_t ChangedStatsShardCount = 64;
+
+  ChangedStatsShard& changedStatsShard(const Metric* stat);
+  template <class StatType> void markChanged(StatType& stat);
+  template <class StatType>
+  void eraseChangedLockHeld(StatType* stat) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  template <class StatType> void forEachChanged(SizeFn f_size, StatFn<StatType> f_stat);
+
+  // Overloads selecting the sets of a stat type for the templates above.
+  StatSet<Counter>& statsLockHeld(const Counter*) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return counters_;
+  }
+  StatSet<Gauge>& statsLockHeld(const Gauge*) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return gauges_;
+  }
+  StatSet<TextReadout>& statsLockHeld(const TextReadout*) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return text_readouts_;
+  }
+  StatPointerSet<Counter>& sinkedStatsLockHeld(const Counter*)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return sinked_counters_;
+  }
+  StatPointerSet<Gauge>& sinkedStatsLockHeld(const Gauge*) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return sinked_gauges_;
+  }
+  StatPointerSet<TextReadout>& sinkedStatsLockHeld(const TextReadout*)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return sinked_text_readouts_;
+  }
+  // Bits of visit_all_changed_ for each stat type.
+  static constexpr uint8_t changedTypeBit(const Counter*) { return 1; }
+  static constexpr uint8_t changedTypeBit(const Gauge*) { return 2; }
+  static constexpr uint8_t changedTypeBit(const TextReadout*) { return 4; }
+  static constexpr uint8_t AllChangedTypeBits = 7;
+
   template <class BaseClass> friend class StatsSharedImpl;
   friend class CounterImpl;
   friend class GaugeImpl;
@@ -84,12 +150,19 @@ private:
   StatSet<Gauge> gauges_ ABSL_GUARDED_BY(mutex_);
   StatSet<TextReadout> text_readouts_ ABSL_GUARDED_BY(mutex_);
 
-  template <typename StatType> using StatPointerSet = absl::flat_hash_set<StatType*>;
   // Stat pointers that participate in the flush to sink process.
   StatPointerSet<Counter> sinked_counters_ ABSL_GUARDED_BY(mutex_);
   StatPointerSet<Gauge> sinked_gauges_ ABSL_GUARDED_BY(mutex_);
   StatPointerSet<TextReadout> sinked_text_readouts_ ABSL_GUARDED_BY(mutex_);
 
+  // Stats only flag and queue their changes once track_changed_stats_ is set by the first
+  // forEachChanged*() call. The stat types whose bit is set in visit_all_changed_ have not been
+  // visited since, so their next visit includes every stat. When a shard mutex is held along with
+  // mutex_, mutex_ is acquired first.
+  std::atomic<bool> track_changed_stats_{false};
+  uint8_t visit_all_changed_ ABSL_GUARDED_BY(mutex_){0};
+  std::array<ChangedStatsShard, ChangedStatsShardCount> changed_stats_;
+
   // Predicates used to filter stats to be flushed.
   std::unique_ptr<SinkPredicates> sink_predicates_;
   SymbolTable& symbol_table_;
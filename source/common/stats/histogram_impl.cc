@@ -111,7 +111,8 @@ HistogramSettingsImpl::HistogramSettingsImpl(const envoy::config::metrics::v3::S
                                buckets.empty()
                                    ? absl::nullopt
                                    : absl::make_optional<ConstSupportedBuckets>(std::move(buckets)),
-                               PROTOBUF_GET_OPTIONAL_WRAPPED(matcher, bins));
+                               PROTOBUF_GET_OPTIONAL_WRAPPED(matcher, bins),
+                               matcher.fixed_log_linear_buckets());
         }
 
         return configs;
@@ -135,6 +136,55 @@ absl::optional<uint32_t> HistogramSettingsImpl::bins(absl::string_view stat_name
   return {};
 }
 
+bool HistogramSettingsImpl::fixedLogLinearBuckets(absl::string_view stat_name) const {
+  for (const auto& config : configs_) {
+    if (config.matcher_.match(stat_name) && config.fixed_log_linear_buckets_) {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t LogLinearBuckets::lowerBound(uint32_t index) {
+  ASSERT(index < NumBuckets);
+  if (index < SubBuckets) {
+    return index;
+  }
+  const uint32_t shift = index / SubBuckets - 1;
+  return static_cast<uint64_t>(SubBuckets + index % SubBuckets) << shift;
+}
+
+uint64_t LogLinearBuckets::width(uint32_t index) {
+  ASSERT(index < NumBuckets);
+  return index < SubBuckets ? 1 : uint64_t(1) << (index / SubBuckets - 1);
+}
+
+void LogLinearBuckets::mergePageAndClear(uint64_t* __restrict target, uint32_t page,
+                                         uint32_t* __restrict counts) {
+  ASSERT(page < NumPages);
+  const uint32_t first = page * PageBuckets;
+  const uint32_t size = std::min(PageBuckets, NumBuckets - first);
+  target += first;
+  for (uint32_t i = 0; i < size; ++i) {
+    target[i] += counts[i];
+  }
+  std::fill_n(counts, size, 0);
+}
+
+void LogLinearBuckets::insertInto(histogram_t* histogram, const uint64_t* counts) {
+  for (uint32_t i = 0; i < NumBuckets; ++i) {
+    if (counts[i] == 0) {
+      continue;
+    }
+    const uint64_t bucket_width = width(i);
+    if (bucket_width == 1) {
+      hist_insert_intscale(histogram, lowerBound(i), 0, counts[i]);
+    } else {
+      hist_insert(histogram, lowerBound(i) + bucket_width / 2.0, counts[i]);
+    }
+  }
+}
+
 const ConstSupportedBuckets& HistogramSettingsImpl::defaultBuckets() {
   CONSTRUCT_ON_FIRST_USE(ConstSupportedBuckets,
                          {0.5, 1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 30000,
@@ -12,6 +12,7 @@
 #include "source/common/common/non_copyable.h"
 #include "source/common/stats/metric_impl.h"
 
+#include "absl/numeric/bits.h"
 #include "circllhist.h"
 
 namespace Envoy {
@@ -26,6 +27,7 @@ public:
   // HistogramSettings
   const ConstSupportedBuckets& buckets(absl::string_view stat_name) const override;
   absl::optional<uint32_t> bins(absl::string_view stat_name) const override;
+  bool fixedLogLinearBuckets(absl::string_view stat_name) const override;
 
   static ConstSupportedBuckets& defaultBuckets();
 
@@ -34,10 +36,48 @@ private:
     Matchers::StringMatcherImpl matcher_;
     absl::optional<ConstSupportedBuckets> buckets_;
     absl::optional<uint32_t> bins_;
+    bool fixed_log_linear_buckets_;
   };
   const std::vector<Config> configs_{};
 };
 
+/**
+ * Fixed log-linear bucket layout covering the whole uint64_t range. Values below 8 have a bucket
+ * each, and every following power of two is split into 8 buckets of equal width.
+ */
+class LogLinearBuckets {
+public:
+  static constexpr uint32_t SubBucketBits = 3;
+  static constexpr uint32_t SubBuckets = 1 << SubBucketBits;
+  static constexpr uint32_t NumBuckets = SubBuckets * (64 - SubBucketBits + 1);
+  // Per worker counts are kept in pages of PageBuckets buckets, 8 powers of two each, allocated on
+  // first use since the values of a histogram usually span a few powers of two.
+  static constexpr uint32_t PageBuckets = SubBuckets * 8;
+  static constexpr uint32_t NumPages = (NumBuckets + PageBuckets - 1) / PageBuckets;
+
+  static uint32_t index(uint64_t value) {
+    if (value < SubBuckets) {
+      return value;
+    }
+    const uint32_t shift = 63 - absl::countl_zero(value) - SubBucketBits;
+    return SubBuckets * (shift + 1) + ((value >> shift) & (SubBuckets - 1));
+  }
+  static uint64_t lowerBound(uint32_t index);
+  static uint64_t width(uint32_t index);
+
+  /**
+   * Adds the counts of a page to target, which holds NumBuckets counts, and clears them. Written as
+   * a plain loop over both arrays so that the compiler vectorizes it.
+   */
+  static void mergePageAndClear(uint64_t* target, uint32_t page, uint32_t* counts);
+
+  /**
+   * Inserts the non-empty buckets of NumBuckets counts into a circllhist, at the middle of each
+   * bucket.
+   */
+  static void insertInto(histogram_t* histogram, const uint64_t* counts);
+};
+
 /**
  * Implementation of HistogramStatistics for circllhist.
  */
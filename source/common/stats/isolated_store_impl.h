@@ -224,6 +224,19 @@ public:
     UNREFERENCED_PARAMETER(f_stat);
   }
 
+  // Changes are not tracked, so every stat is visited as changed.
+  void forEachChangedCounter(SizeFn f_size, StatFn<Counter> f_stat) override {
+    forEachCounter(f_size, f_stat);
+  }
+
+  void forEachChangedGauge(SizeFn f_size, StatFn<Gauge> f_stat) override {
+    forEachGauge(f_size, f_stat);
+  }
+
+  void forEachChangedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) override {
+    forEachTextReadout(f_size, f_stat);
+  }
+
   NullCounterImpl& nullCounter() override { return *null_counter_; }
   NullGaugeImpl& nullGauge() override { return *null_gauge_; }
 
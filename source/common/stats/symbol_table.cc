@@ -626,22 +626,49 @@ void StatNameStorage::free(SymbolTable& table) {
 }
 
 void StatNamePool::clear() {
-  for (StatNameStorage& storage : storage_vector_) {
-    // nolint: https://github.com/llvm/llvm-project/issues/81597
-    // NOLINTNEXTLINE(clang-analyzer-unix.Malloc)
-    storage.free(symbol_table_);
+  for (const Block& block : blocks_) {
+    const uint8_t* p = block.storage_.get();
+    const uint8_t* end = p + block.size_;
+    while (p < end) {
+      const StatName stat_name(p);
+      p += stat_name.size();
+      // nolint: https://github.com/llvm/llvm-project/issues/81597
+      // NOLINTNEXTLINE(clang-analyzer-unix.Malloc)
+      symbol_table_.free(stat_name);
+    }
+  }
+  blocks_.clear();
+}
+
+uint8_t* StatNamePool::allocate(size_t bytes) {
+  if (blocks_.empty() || blocks_.back().capacity_ - blocks_.back().size_ < bytes) {
+    const size_t block_bytes =
+        blocks_.empty() ? MinBlockBytes : std::min(2 * blocks_.back().capacity_, MaxBlockBytes);
+    const size_t capacity = std::max(block_bytes, bytes);
+    blocks_.push_back(Block{std::make_unique<SymbolTable::Storage>(capacity), capacity, 0});
   }
-  storage_vector_.clear();
+  Block& block = blocks_.back();
+  uint8_t* storage = block.storage_.get() + block.size_;
+  block.size_ += bytes;
+  return storage;
 }
 
 const uint8_t* StatNamePool::addReturningStorage(absl::string_view str) {
-  storage_vector_.emplace_back(str, symbol_table_);
-  return storage_vector_.back().bytes();
+  // encode() has already taken the symbol references on behalf of the
+  // encoding, so we only need to move the bytes into the pool.
+  const SymbolTable::StoragePtr encoding = symbol_table_.encode(str);
+  const size_t size = StatName(encoding.get()).size();
+  uint8_t* storage = allocate(size);
+  std::copy(encoding.get(), encoding.get() + size, storage);
+  return storage;
 }
 
 StatName StatNamePool::add(StatName name) {
-  storage_vector_.emplace_back(name, symbol_table_);
-  return storage_vector_.back().statName();
+  const size_t size = name.size();
+  uint8_t* storage = allocate(size);
+  std::copy(name.dataIncludingSize(), name.dataIncludingSize() + size, storage);
+  symbol_table_.incRefCount(name);
+  return StatName(storage);
 }
 
 StatName StatNamePool::add(absl::string_view str) { return StatName(addReturningStorage(str)); }
@@ -360,6 +360,7 @@ private:
   friend class StatNameDeathTest;
   friend class StatNameDynamicStorage;
   friend class StatNameList;
+  friend class StatNamePool;
   friend class StatNameStorage;
 
   /**
@@ -783,11 +784,35 @@ public:
   const uint8_t* addReturningStorage(absl::string_view name);
 
 private:
-  // We keep the stat names in a vector of StatNameStorage, storing the
-  // SymbolTable reference separately. This saves 8 bytes per StatName,
+  // A chunk of memory holding the encodings of consecutively added names,
+  // packed back to back.
+  struct Block {
+    SymbolTable::StoragePtr storage_;
+    size_t capacity_;
+    size_t size_;
+  };
+
+  /**
+   * Reserves space for a name encoding at the end of the last block, starting
+   * a new block if it does not fit.
+   *
+   * @param bytes the number of bytes required, including the size prefix.
+   * @return where to write the encoding; it stays valid until clear().
+   */
+  uint8_t* allocate(size_t bytes);
+
+  // The first block holds MinBlockBytes, and each following one doubles in
+  // size up to MaxBlockBytes. Names larger than that get a block of their own.
+  static constexpr size_t MinBlockBytes = 64;
+  static constexpr size_t MaxBlockBytes = 4096;
+
+  // We pack the encodings into blocks rather than giving each name its own
+  // StatNameStorage. Stat names are typically only a few bytes long, so a
+  // separate allocation and pointer per name would cost several times the
+  // encoding itself. The SymbolTable reference is stored once for the pool,
   // at the cost of having a destructor that calls clear().
   SymbolTable& symbol_table_;
-  std::vector<StatNameStorage> storage_vector_;
+  std::vector<Block> blocks_;
 };
 
 /**
@@ -1,5 +1,6 @@
 #include "source/common/stats/thread_local_store.h"
 
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <list>
@@ -55,7 +56,7 @@ ThreadLocalStoreImpl::~ThreadLocalStoreImpl() {
 void ThreadLocalStoreImpl::setHistogramSettings(HistogramSettingsConstPtr&& histogram_settings) {
   iterateScopes([this](const ScopeImplSharedPtr& scope)
                     ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) -> bool {
-                      assertLocked(*scope);
+                      Thread::LockGuard central_cache_lock(scope->central_cache_lock_);
                       ASSERT(scope->centralCacheLockHeld()->histograms_.empty());
                       return true;
                     });
@@ -76,7 +77,7 @@ void ThreadLocalStoreImpl::setStatsMatcher(StatsMatcherPtr&& stats_matcher) {
   const uint32_t first_histogram_index = deleted_histograms_.size();
   iterateScopesLockHeld([this](const ScopeImplSharedPtr& scope) ABSL_EXCLUSIVE_LOCKS_REQUIRED(
                             lock_) -> bool {
-    assertLocked(*scope);
+    Thread::LockGuard central_cache_lock(scope->central_cache_lock_);
     const CentralCacheEntrySharedPtr& central_cache = scope->centralCacheLockHeld();
     removeRejectedStats<CounterSharedPtr>(central_cache->counters_,
                                           [this](const CounterSharedPtr& counter) mutable {
@@ -297,8 +298,10 @@ void ThreadLocalStoreImpl::releaseScopeCrossThread(ScopeImpl* scope) {
     // VirtualHosts.
     bool need_post = scopes_to_cleanup_.empty();
     scopes_to_cleanup_.push_back(scope->scope_id_);
-    assertLocked(*scope);
-    central_cache_entries_to_cleanup_.push_back(scope->centralCacheLockHeld());
+    {
+      Thread::LockGuard central_cache_lock(scope->central_cache_lock_);
+      central_cache_entries_to_cleanup_.push_back(scope->centralCacheLockHeld());
+    }
     lock.release();
 
     if (need_post) {
@@ -398,6 +401,7 @@ void ThreadLocalStoreImpl::clearHistogramsFromCaches() {
 ThreadLocalStoreImpl::ScopeImpl::ScopeImpl(ThreadLocalStoreImpl& parent, StatName prefix,
                                            bool evictable)
     : scope_id_(parent.next_scope_id_++), parent_(parent), evictable_(evictable),
+      central_cache_lock_(parent.centralCacheLock(scope_id_)),
       prefix_(prefix, parent.alloc_.symbolTable()),
       central_cache_(new CentralCacheEntry(parent.alloc_.symbolTable())) {}
 
@@ -505,7 +509,9 @@ StatType& ThreadLocalStoreImpl::ScopeImpl::safeMakeStat(
 
   // We must now look in the central store so we must be locked. We grab a reference to the
   // central store location. It might contain nothing. In this case, we allocate a new stat.
-  Thread::LockGuard lock(parent_.lock_);
+  // Only this scope's shard of the central cache locks is taken, so workers populating their
+  // TLS caches for different scopes do not contend with each other.
+  Thread::LockGuard lock(central_cache_lock_);
   auto iter = central_cache_map.find(full_stat_name);
   RefcountPtr<StatType>* central_ref = nullptr;
   if (iter != central_cache_map.end()) {
@@ -661,8 +667,8 @@ Histogram& ThreadLocalStoreImpl::ScopeImpl::histogramFromStatNameWithTags(
     }
   }
 
-  Thread::LockGuard lock(parent_.lock_);
-  const CentralCacheEntrySharedPtr& central_cache = centralCacheNoThreadAnalysis();
+  Thread::LockGuard lock(central_cache_lock_);
+  const CentralCacheEntrySharedPtr& central_cache = centralCacheLockHeld();
   auto iter = central_cache->histograms_.find(final_stat_name);
   ParentHistogramImplSharedPtr* central_ref = nullptr;
   if (iter != central_cache->histograms_.end()) {
@@ -678,6 +684,8 @@ Histogram& ThreadLocalStoreImpl::ScopeImpl::histogramFromStatNameWithTags(
     const auto string_stat_name = symbolTable().toString(final_stat_name);
     buckets = &parent_.histogram_settings_->buckets(string_stat_name);
     const auto bins = parent_.histogram_settings_->bins(string_stat_name);
+    const bool fixed_log_linear_buckets =
+        parent_.histogram_settings_->fixedLogLinearBuckets(string_stat_name);
 
     RefcountPtr<ParentHistogramImpl> stat;
     {
@@ -688,7 +696,8 @@ Histogram& ThreadLocalStoreImpl::ScopeImpl::histogramFromStatNameWithTags(
       } else {
         stat = new ParentHistogramImpl(final_stat_name, unit, parent_,
                                        tag_helper.tagExtractedName(), tag_helper.statNameTags(),
-                                       *buckets, bins, parent_.next_histogram_id_++);
+                                       *buckets, bins, fixed_log_linear_buckets,
+                                       parent_.next_histogram_id_++);
         if (!parent_.shutting_down_) {
           parent_.histogram_set_.insert(stat.get());
           if (parent_.sink_predicates_.has_value() &&
@@ -746,22 +755,22 @@ TextReadout& ThreadLocalStoreImpl::ScopeImpl::textReadoutFromStatNameWithTags(
 }
 
 CounterOptConstRef ThreadLocalStoreImpl::ScopeImpl::findCounter(StatName name) const {
-  Thread::LockGuard lock(parent_.lock_);
+  Thread::LockGuard lock(central_cache_lock_);
   return findStatLockHeld<Counter>(name, central_cache_->counters_);
 }
 
 GaugeOptConstRef ThreadLocalStoreImpl::ScopeImpl::findGauge(StatName name) const {
-  Thread::LockGuard lock(parent_.lock_);
+  Thread::LockGuard lock(central_cache_lock_);
   return findStatLockHeld<Gauge>(name, central_cache_->gauges_);
 }
 
 HistogramOptConstRef ThreadLocalStoreImpl::ScopeImpl::findHistogram(StatName name) const {
-  Thread::LockGuard lock(parent_.lock_);
+  Thread::LockGuard lock(central_cache_lock_);
   return findHistogramLockHeld(name);
 }
 
 HistogramOptConstRef ThreadLocalStoreImpl::ScopeImpl::findHistogramLockHeld(StatName name) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(parent_.lock_) {
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(central_cache_lock_) {
   auto iter = central_cache_->histograms_.find(name);
   if (iter == central_cache_->histograms_.end()) {
     return absl::nullopt;
@@ -772,7 +781,7 @@ HistogramOptConstRef ThreadLocalStoreImpl::ScopeImpl::findHistogramLockHeld(Stat
 }
 
 TextReadoutOptConstRef ThreadLocalStoreImpl::ScopeImpl::findTextReadout(StatName name) const {
-  Thread::LockGuard lock(parent_.lock_);
+  Thread::LockGuard lock(central_cache_lock_);
   return findStatLockHeld<TextReadout>(name, central_cache_->text_readouts_);
 }
 
@@ -795,7 +804,8 @@ Histogram& ThreadLocalStoreImpl::tlsHistogram(ParentHistogramImpl& parent, uint6
 
   TlsHistogramSharedPtr hist_tls_ptr(
       new ThreadLocalHistogramImpl(parent.statName(), parent.unit(), tag_helper.tagExtractedName(),
-                                   tag_helper.statNameTags(), symbolTable(), parent.bins()));
+                                   tag_helper.statNameTags(), symbolTable(), parent.bins(),
+                                   parent.fixedLogLinearBuckets()));
 
   parent.addTlsHistogram(hist_tls_ptr);
 
@@ -810,39 +820,87 @@ ThreadLocalHistogramImpl::ThreadLocalHistogramImpl(StatName name, Histogram::Uni
                                                    StatName tag_extracted_name,
                                                    const StatNameTagVector& stat_name_tags,
                                                    SymbolTable& symbol_table,
-                                                   absl::optional<uint32_t> bins)
+                                                   absl::optional<uint32_t> bins,
+                                                   bool fixed_log_linear_buckets)
     : HistogramImplHelper(name, tag_extracted_name, stat_name_tags, symbol_table), unit_(unit),
-      used_(false), created_thread_id_(std::this_thread::get_id()), symbol_table_(symbol_table) {
+      fixed_log_linear_buckets_(fixed_log_linear_buckets), used_(false),
+      created_thread_id_(std::this_thread::get_id()), symbol_table_(symbol_table) {
+  if (fixed_log_linear_buckets_) {
+    return;
+  }
   histograms_[0] = bins ? hist_alloc_nbins(bins.value()) : hist_alloc();
   histograms_[1] = bins ? hist_alloc_nbins(bins.value()) : hist_alloc();
 }
 
 ThreadLocalHistogramImpl::~ThreadLocalHistogramImpl() {
   MetricImpl::clear(symbol_table_);
-  hist_free(histograms_[0]);
-  hist_free(histograms_[1]);
+  if (!fixed_log_linear_buckets_) {
+    hist_free(histograms_[0]);
+    hist_free(histograms_[1]);
+  }
 }
 
 void ThreadLocalHistogramImpl::recordValue(uint64_t value) {
   ASSERT(std::this_thread::get_id() == created_thread_id_);
-  hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  if (fixed_log_linear_buckets_) {
+    const uint32_t index = LogLinearBuckets::index(value);
+    const uint32_t page = index / LogLinearBuckets::PageBuckets;
+    std::unique_ptr<FixedBuckets>& buckets = fixed_buckets_[current_active_];
+    if (buckets == nullptr) {
+      buckets = std::make_unique<FixedBuckets>();
+    }
+    std::unique_ptr<uint32_t[]>& counts = buckets->pages_[page];
+    if (counts == nullptr) {
+      counts = std::make_unique<uint32_t[]>(LogLinearBuckets::PageBuckets);
+    }
+    counts[index % LogLinearBuckets::PageBuckets]++;
+    buckets->recorded_[page] = true;
+  } else {
+    hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  }
   used_ = true;
 }
 
 void ThreadLocalHistogramImpl::merge(histogram_t* target) {
+  ASSERT(!fixed_log_linear_buckets_);
   histogram_t** other_histogram = &histograms_[otherHistogramIndex()];
   hist_accumulate(target, other_histogram, 1);
   hist_clear(*other_histogram);
 }
 
+void ThreadLocalHistogramImpl::mergeFixedBuckets(uint64_t* target) {
+  ASSERT(fixed_log_linear_buckets_);
+  // The worker records into the other set until the next beginMerge(), so this set is only
+  // touched here.
+  std::unique_ptr<FixedBuckets>& buckets = fixed_buckets_[otherHistogramIndex()];
+  if (buckets == nullptr) {
+    return;
+  }
+  bool recorded = false;
+  for (uint32_t page = 0; page < LogLinearBuckets::NumPages; ++page) {
+    if (!buckets->recorded_[page]) {
+      buckets->pages_[page].reset();
+      continue;
+    }
+    LogLinearBuckets::mergePageAndClear(target, page, buckets->pages_[page].get());
+    buckets->recorded_[page] = false;
+    recorded = true;
+  }
+  if (!recorded) {
+    buckets.reset();
+  }
+}
+
 ParentHistogramImpl::ParentHistogramImpl(StatName name, Histogram::Unit unit,
                                          ThreadLocalStoreImpl& thread_local_store,
                                          StatName tag_extracted_name,
                                          const StatNameTagVector& stat_name_tags,
                                          ConstSupportedBuckets& supported_buckets,
-                                         absl::optional<uint32_t> bins, uint64_t id)
+                                         absl::optional<uint32_t> bins,
+                                         bool fixed_log_linear_buckets, uint64_t id)
     : MetricImpl(name, tag_extracted_name, stat_name_tags, thread_local_store.symbolTable()),
-      unit_(unit), bins_(bins), thread_local_store_(thread_local_store),
+      unit_(unit), bins_(bins), fixed_log_linear_buckets_(fixed_log_linear_buckets),
+      thread_local_store_(thread_local_store),
       interval_histogram_(hist_alloc()), cumulative_histogram_(hist_alloc()),
       interval_statistics_(interval_histogram_, unit, supported_buckets),
       cumulative_statistics_(cumulative_histogram_, unit, supported_buckets), id_(id) {}
@@ -930,15 +988,25 @@ void ParentHistogramImpl::merge() {
   Thread::ReleasableLockGuard lock(merge_lock_);
   if (merged_ || usedLockHeld()) {
     hist_clear(interval_histogram_);
-    // Here we could copy all the pointers to TLS histograms in the tls_histogram_ list,
-    // then release the lock before we do the actual merge. However it is not a big deal
-    // because the tls_histogram merge is not that expensive as it is a single histogram
-    // merge and adding TLS histograms is rare.
-    for (const TlsHistogramSharedPtr& tls_histogram : tls_histograms_) {
-      tls_histogram->merge(interval_histogram_);
+    if (fixed_log_linear_buckets_) {
+      // Add up the workers' counts first so that the circllhist is only built once.
+      std::array<uint64_t, LogLinearBuckets::NumBuckets> counts{};
+      for (const TlsHistogramSharedPtr& tls_histogram : tls_histograms_) {
+        tls_histogram->mergeFixedBuckets(counts.data());
+      }
+      lock.release();
+      LogLinearBuckets::insertInto(interval_histogram_, counts.data());
+    } else {
+      // Here we could copy all the pointers to TLS histograms in the tls_histogram_ list,
+      // then release the lock before we do the actual merge. However it is not a big deal
+      // because the tls_histogram merge is not that expensive as it is a single histogram
+      // merge and adding TLS histograms is rare.
+      for (const TlsHistogramSharedPtr& tls_histogram : tls_histograms_) {
+        tls_histogram->merge(interval_histogram_);
+      }
+      // Since TLS merge is done, we can release the lock here.
+      lock.release();
     }
-    // Since TLS merge is done, we can release the lock here.
-    lock.release();
     hist_accumulate(cumulative_histogram_, &interval_histogram_, 1);
     cumulative_statistics_.refresh(cumulative_histogram_);
     interval_statistics_.refresh(interval_histogram_);
@@ -1074,6 +1142,7 @@ void ThreadLocalStoreImpl::evictUnused() {
     iterateScopesLockHeld([evicted_metrics](const ScopeImplSharedPtr& scope) -> bool {
       if (scope->evictable_) {
         MetricBag metrics(scope->scope_id_);
+        Thread::LockGuard central_cache_lock(scope->central_cache_lock_);
         CentralCacheEntrySharedPtr& central_cache = scope->centralCacheMutableNoThreadAnalysis();
         auto filter_unused = []<typename T>(StatNameHashMap<T>& unused_metrics) {
           return [&unused_metrics](std::pair<StatName, T> kv) {
@@ -1179,6 +1248,18 @@ void ThreadLocalStoreImpl::forEachSinkedTextReadout(SizeFn f_size,
   alloc_.forEachSinkedTextReadout(f_size, f_stat);
 }
 
+void ThreadLocalStoreImpl::forEachChangedCounter(SizeFn f_size, StatFn<Counter> f_stat) {
+  alloc_.forEachChangedCounter(f_size, f_stat);
+}
+
+void ThreadLocalStoreImpl::forEachChangedGauge(SizeFn f_size, StatFn<Gauge> f_stat) {
+  alloc_.forEachChangedGauge(f_size, f_stat);
+}
+
+void ThreadLocalStoreImpl::forEachChangedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) {
+  alloc_.forEachChangedTextReadout(f_size, f_stat);
+}
+
 void ThreadLocalStoreImpl::forEachSinkedHistogram(SizeFn f_size,
                                                   StatFn<ParentHistogram> f_stat) const {
   if (sink_predicates_.has_value()) {
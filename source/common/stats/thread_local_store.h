@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
@@ -35,11 +36,18 @@ class ThreadLocalHistogramImpl : public HistogramImplHelper {
 public:
   ThreadLocalHistogramImpl(StatName name, Histogram::Unit unit, StatName tag_extracted_name,
                            const StatNameTagVector& stat_name_tags, SymbolTable& symbol_table,
-                           absl::optional<uint32_t> bins);
+                           absl::optional<uint32_t> bins, bool fixed_log_linear_buckets);
   ~ThreadLocalHistogramImpl() override;
 
   void merge(histogram_t* target);
 
+  /**
+   * Used instead of merge() for histograms recording into fixed log-linear buckets. Adds the
+   * counts of the inactive buckets to target, which holds LogLinearBuckets::NumBuckets counts,
+   * and frees the pages that did not receive any value.
+   */
+  void mergeFixedBuckets(uint64_t* target);
+
   /**
    * Called in the beginning of merge process. Swaps the histogram used for collection so that we do
    * not have to lock the histogram in high throughput TLS writes.
@@ -65,10 +73,24 @@ public:
   bool hidden() const override { return false; }
 
 private:
+  /**
+   * One set of fixed log-linear bucket counts, in pages of LogLinearBuckets::PageBuckets counts.
+   */
+  struct FixedBuckets {
+    std::unique_ptr<uint32_t[]> pages_[LogLinearBuckets::NumPages];
+    // Whether the page received a value since it was last merged.
+    bool recorded_[LogLinearBuckets::NumPages]{};
+  };
+
   const Histogram::Unit unit_;
   uint64_t otherHistogramIndex() const { return 1 - current_active_; }
   uint64_t current_active_{0};
-  histogram_t* histograms_[2];
+  histogram_t* histograms_[2]{};
+  const bool fixed_log_linear_buckets_;
+  // Two sets of fixed bucket counts swapped like histograms_, used instead of histograms_ for fixed
+  // log-linear buckets. Sets and pages are allocated by the first value recorded into them and
+  // freed by a merge that finds them idle, so histograms that record rarely hold no counts.
+  std::unique_ptr<FixedBuckets> fixed_buckets_[2];
   std::atomic<bool> used_;
   const std::thread::id created_thread_id_;
   SymbolTable& symbol_table_;
@@ -86,7 +108,7 @@ public:
   ParentHistogramImpl(StatName name, Histogram::Unit unit, ThreadLocalStoreImpl& parent,
                       StatName tag_extracted_name, const StatNameTagVector& stat_name_tags,
                       ConstSupportedBuckets& supported_buckets, absl::optional<uint32_t> bins,
-                      uint64_t id);
+                      bool fixed_log_linear_buckets, uint64_t id);
   ~ParentHistogramImpl() override;
 
   void addTlsHistogram(const TlsHistogramSharedPtr& hist_ptr);
@@ -131,6 +153,7 @@ public:
   void setShuttingDown(bool shutting_down) { shutting_down_ = shutting_down; }
   bool shuttingDown() const { return shutting_down_; }
   absl::optional<uint32_t> bins() const { return bins_; }
+  bool fixedLogLinearBuckets() const { return fixed_log_linear_buckets_; }
 
 private:
   bool usedLockHeld() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(merge_lock_);
@@ -139,6 +162,7 @@ private:
 
   const Histogram::Unit unit_;
   const absl::optional<uint32_t> bins_;
+  const bool fixed_log_linear_buckets_;
   ThreadLocalStoreImpl& thread_local_store_;
   histogram_t* interval_histogram_;
   histogram_t* cumulative_histogram_;
@@ -212,6 +236,10 @@ public:
   void forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const override;
   void forEachSinkedHistogram(SizeFn f_size, StatFn<ParentHistogram> f_stat) const override;
 
+  void forEachChangedCounter(SizeFn f_size, StatFn<Counter> f_stat) override;
+  void forEachChangedGauge(SizeFn f_size, StatFn<Gauge> f_stat) override;
+  void forEachChangedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) override;
+
   void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) override;
   OptRef<SinkPredicates> sinkPredicates() override { return sink_predicates_; }
 
@@ -331,36 +359,36 @@ private:
     }
 
     bool iterate(const IterateFn<Counter>& fn) const override {
-      Thread::LockGuard lock(parent_.lock_);
+      Thread::LockGuard lock(central_cache_lock_);
       return iterateLockHeld(fn);
     }
     bool iterate(const IterateFn<Gauge>& fn) const override {
-      Thread::LockGuard lock(parent_.lock_);
+      Thread::LockGuard lock(central_cache_lock_);
       return iterateLockHeld(fn);
     }
     bool iterate(const IterateFn<Histogram>& fn) const override {
-      Thread::LockGuard lock(parent_.lock_);
+      Thread::LockGuard lock(central_cache_lock_);
       return iterateLockHeld(fn);
     }
     bool iterate(const IterateFn<TextReadout>& fn) const override {
-      Thread::LockGuard lock(parent_.lock_);
+      Thread::LockGuard lock(central_cache_lock_);
       return iterateLockHeld(fn);
     }
 
     bool iterateLockHeld(const IterateFn<Counter>& fn) const
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(parent_.lock_) {
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(central_cache_lock_) {
       return iterHelper(fn, centralCacheLockHeld()->counters_);
     }
     bool iterateLockHeld(const IterateFn<Gauge>& fn) const
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(parent_.lock_) {
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(central_cache_lock_) {
       return iterHelper(fn, centralCacheLockHeld()->gauges_);
     }
     bool iterateLockHeld(const IterateFn<Histogram>& fn) const
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(parent_.lock_) {
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(central_cache_lock_) {
       return iterHelper(fn, centralCacheLockHeld()->histograms_);
     }
     bool iterateLockHeld(const IterateFn<TextReadout>& fn) const
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(parent_.lock_) {
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(central_cache_lock_) {
       return iterHelper(fn, centralCacheLockHeld()->text_readouts_);
     }
     ThreadLocalStoreImpl& store() override { return parent_; }
@@ -427,13 +455,10 @@ private:
 
     StatName prefix() const override { return prefix_.statName(); }
 
-    // Returns the central cache, asserting that the parent lock is held.
-    //
-    // When a ThreadLocalStore method takes lock_ and then accesses
-    // scope->central_cache_, the analysis system cannot understand that the
-    // scope's parent_.lock_ is held, so we assert that here.
+    // Returns the central cache, requiring that the scope's shard of the central
+    // cache locks is held.
     const CentralCacheEntrySharedPtr& centralCacheLockHeld() const
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(parent_.lock_) {
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(central_cache_lock_) {
       return central_cache_;
     }
 
@@ -456,9 +481,15 @@ private:
     ThreadLocalStoreImpl& parent_;
     const bool evictable_{};
 
+    // Guards central_cache_. This is one of the parent's central_cache_locks_,
+    // selected by scope_id_, so that stat creation in different scopes does not
+    // serialize on the store-wide lock_. Acquired after parent_.lock_ when both
+    // are held.
+    Thread::MutexBasicLockable& central_cache_lock_;
+
   private:
     StatNameStorage prefix_;
-    mutable CentralCacheEntrySharedPtr central_cache_ ABSL_GUARDED_BY(parent_.lock_);
+    mutable CentralCacheEntrySharedPtr central_cache_ ABSL_GUARDED_BY(central_cache_lock_);
   };
 
   struct TlsCache : public ThreadLocal::ThreadLocalObject {
@@ -481,19 +512,6 @@ private:
 
   using ScopeImplSharedPtr = std::shared_ptr<ScopeImpl>;
 
-  /**
-   * assertLocked exists to help compiler figure out that lock_ and scope->parent_.lock_ is
-   * actually the same lock known under two different names. This function requires lock_ to
-   * be held when it's called and at the same time it is annotated as if it checks in runtime
-   * that scope->parent_.lock_ is held. It does not actually perform any runtime checks, because
-   * those aren't needed since we know that scope->parent_ refers to ThreadLockStoreImpl and
-   * therefore scope->parent_.lock is the same as lock_.
-   */
-  void assertLocked(const ScopeImpl& scope) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_)
-      ABSL_ASSERT_EXCLUSIVE_LOCK(scope.parent_.lock_) {
-    UNREFERENCED_PARAMETER(scope);
-  }
-
   /**
    * Calls fn_lock_held for every scope with, lock_ held. This avoids iterate/destruct
    * races for scopes.
@@ -514,7 +532,7 @@ private:
   template <class StatFn> bool iterHelper(StatFn fn) const {
     return iterateScopes([this, fn](const ScopeImplSharedPtr& scope)
                              ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) -> bool {
-                               assertLocked(*scope);
+                               Thread::LockGuard central_cache_lock(scope->central_cache_lock_);
                                return scope->iterateLockHeld(fn);
                              });
   }
@@ -538,6 +556,14 @@ private:
                                  StatNameHashSet* tls_rejected_stats);
   TlsCache& tlsCache() { return **tls_cache_; }
   void addScope(std::shared_ptr<ScopeImpl>& new_scope);
+  Thread::MutexBasicLockable& centralCacheLock(uint64_t scope_id) const {
+    return central_cache_locks_[scope_id % CentralCacheLockShards];
+  }
+
+  // Number of locks guarding the central caches of the scopes. Scopes are
+  // spread over the shards by ID, so workers creating stats in different scopes
+  // rarely contend; creating the stat itself still takes the allocator lock.
+  static constexpr uint64_t CentralCacheLockShards = 64;
 
   OptRef<SinkPredicates> sink_predicates_;
   Allocator& alloc_;
@@ -545,6 +571,7 @@ private:
   using TlsCacheSlot = ThreadLocal::TypedSlotPtr<TlsCache>;
   ThreadLocal::TypedSlotPtr<TlsCache> tls_cache_;
   mutable Thread::MutexBasicLockable lock_;
+  mutable std::array<Thread::MutexBasicLockable, CentralCacheLockShards> central_cache_locks_;
   absl::flat_hash_map<ScopeImpl*, std::weak_ptr<ScopeImpl>> scopes_ ABSL_GUARDED_BY(lock_);
   ScopeSharedPtr default_scope_;
   std::list<std::reference_wrapper<Sink>> timer_sinks_;
@@ -55,11 +55,12 @@ bool AsyncTcpClientImpl::connect() {
   }
 
   connect_timer_->enableTimer(cluster_info_->connectTimeout());
-  connection_->setConnectionStats({cluster_info_->trafficStats()->upstream_cx_rx_bytes_total_,
-                                   cluster_info_->trafficStats()->upstream_cx_rx_bytes_buffered_,
-                                   cluster_info_->trafficStats()->upstream_cx_tx_bytes_total_,
-                                   cluster_info_->trafficStats()->upstream_cx_tx_bytes_buffered_,
-                                   &cluster_info_->trafficStats()->bind_errors_, nullptr});
+  Upstream::ClusterTrafficStats& traffic_stats = *cluster_info_->trafficStats();
+  connection_->setConnectionStats(
+      {traffic_stats.upstream_cx_rx_bytes_total_, traffic_stats.upstream_cx_rx_bytes_buffered_,
+       traffic_stats.upstream_cx_tx_bytes_total_, traffic_stats.upstream_cx_tx_bytes_buffered_,
+       &traffic_stats.bind_errors_, nullptr, &traffic_stats.upstream_cx_write_slices_,
+       &traffic_stats.upstream_cx_write_coalesced_bytes_});
   connection_->noDelay(true);
   connection_->connect();
   return true;
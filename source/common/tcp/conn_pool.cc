@@ -30,7 +30,9 @@ ActiveTcpClient::ActiveTcpClient(Envoy::ConnectionPool::ConnPoolImplBase& parent
                                    cluster_traffic_stats.upstream_cx_rx_bytes_buffered_,
                                    cluster_traffic_stats.upstream_cx_tx_bytes_total_,
                                    cluster_traffic_stats.upstream_cx_tx_bytes_buffered_,
-                                   &cluster_traffic_stats.bind_errors_, nullptr});
+                                   &cluster_traffic_stats.bind_errors_, nullptr,
+                                   &cluster_traffic_stats.upstream_cx_write_slices_,
+                                   &cluster_traffic_stats.upstream_cx_write_coalesced_bytes_});
   connection_->noDelay(true);
   connection_->connect();
 
@@ -12,7 +12,11 @@ DefaultTlsCertificateSelector::DefaultTlsCertificateSelector(
     : server_ctx_(dynamic_cast<ServerContextImpl&>(selector_ctx)),
       tls_contexts_(selector_ctx.getTlsContexts()), ocsp_staple_policy_(config.ocspStaplePolicy()),
       full_scan_certs_on_sni_mismatch_(config.fullScanCertsOnSNIMismatch()) {
-  for (auto& ctx : tls_contexts_) {
+  for (size_t i = 0; i < tls_contexts_.size(); i++) {
+    const auto& ctx = tls_contexts_[i];
+    // Index all the contexts by curve, so that the full scan only looks at the contexts the
+    // client supports instead of all of them.
+    curve_contexts_map_[ctx.ec_group_curve_name_].push_back(i);
     if (ctx.cert_chain_ == nullptr) {
       continue;
     }
@@ -20,7 +24,6 @@ DefaultTlsCertificateSelector::DefaultTlsCertificateSelector(
     const int pkey_id = EVP_PKEY_id(public_key.get());
     // Load DNS SAN entries and Subject Common Name as server name patterns after certificate
     // chain loaded, and populate ServerNamesMap which will be used to match SNI.
-    has_rsa_ |= (pkey_id == EVP_PKEY_RSA);
     populateServerNamesMap(ctx, pkey_id);
   }
 };
@@ -36,20 +39,23 @@ void DefaultTlsCertificateSelector::populateServerNamesMap(const Ssl::TlsContext
     if (absl::StartsWith(sn, "*.")) {
       sn_pattern = sn.substr(1);
     }
-    PkeyTypesMap pkey_types_map;
     // Multiple certs with different key type are allowed for one server name pattern.
-    auto sn_match = server_names_map_.try_emplace(sn_pattern, pkey_types_map).first;
-    auto pt_match = sn_match->second.find(pkey_id);
-    if (pt_match != sn_match->second.end()) {
-      // When there are duplicate names, prefer the earlier one.
-      //
-      // If all of the SANs in a certificate are unused due to duplicates, it could be useful
-      // to issue a warning, but that would require additional tracking that hasn't been
-      // implemented.
-      return;
+    NamedContexts& named_contexts = server_names_map_[sn_pattern];
+    for (const NamedContext& named_ctx : named_contexts) {
+      if (named_ctx.pkey_id_ == pkey_id) {
+        // When there are duplicate names, prefer the earlier one.
+        //
+        // If all of the SANs in a certificate are unused due to duplicates, it could be useful
+        // to issue a warning, but that would require additional tracking that hasn't been
+        // implemented.
+        return;
+      }
+    }
+    if (pkey_id == EVP_PKEY_EC) {
+      named_contexts.insert(named_contexts.begin(), NamedContext{pkey_id, ctx});
+    } else {
+      named_contexts.push_back(NamedContext{pkey_id, ctx});
     }
-    sn_match->second.emplace(
-        std::pair<int, std::reference_wrapper<const Ssl::TlsContext>>(pkey_id, ctx));
   };
 
   bssl::UniquePtr<GENERAL_NAMES> san_names(static_cast<GENERAL_NAMES*>(
@@ -120,6 +126,21 @@ DefaultTlsCertificateSelector::selectTlsContext(const SSL_CLIENT_HELLO& ssl_clie
           ocsp_staple_action == Ssl::OcspStapleAction::Staple};
 }
 
+size_t DefaultTlsCertificateSelector::firstUsableContext(Ssl::CurveNID curve,
+                                                        bool client_ocsp_capable) {
+  auto it = curve_contexts_map_.find(curve);
+  if (it == curve_contexts_map_.end()) {
+    return tls_contexts_.size();
+  }
+  for (const size_t index : it->second) {
+    if (ocspStapleAction(tls_contexts_[index], client_ocsp_capable) !=
+        Ssl::OcspStapleAction::Fail) {
+      return index;
+    }
+  }
+  return tls_contexts_.size();
+}
+
 Ssl::OcspStapleAction DefaultTlsCertificateSelector::ocspStapleAction(const Ssl::TlsContext& ctx,
                                                                       bool client_ocsp_capable) {
   if (!client_ocsp_capable) {
@@ -223,9 +244,8 @@ DefaultTlsCertificateSelector::findTlsContext(absl::string_view sni,
     if (it == server_names_map_.end()) {
       return;
     }
-    const auto& pkey_types_map = it->second;
-    for (const auto& entry : pkey_types_map) {
-      if (selected(entry.second.get())) {
+    for (const NamedContext& named_ctx : it->second) {
+      if (selected(named_ctx.ctx_.get())) {
         break;
       }
     }
@@ -264,17 +284,22 @@ DefaultTlsCertificateSelector::findTlsContext(absl::string_view sni,
   // Full scan certs if SNI is not provided by client;
   // Full scan certs if client provides SNI but no cert matches to it,
   // it requires full_scan_certs_on_sni_mismatch is enabled.
+  // The scan selects the first configured cert which meets all requirements, preferring ECDSA
+  // certs over the others, so it only needs to look at the certs of the curves the client
+  // supports.
   if (selected_ctx == nullptr) {
-    candidate_ctx = nullptr;
-    // Skip loop when there is no cert compatible to key type
-    if (client_ecdsa_capable || (!client_ecdsa_capable && has_rsa_)) {
-      for (const auto& ctx : tls_contexts_) {
-        if (selected(ctx)) {
-          break;
-        }
-      }
+    size_t index = tls_contexts_.size();
+    for (const Ssl::CurveNID curve : client_ecdsa_capabilities) {
+      index = std::min(index, firstUsableContext(curve, client_ocsp_capable));
+    }
+    if (index == tls_contexts_.size()) {
+      index = firstUsableContext(Ssl::EC_CURVE_INVALID_NID, client_ocsp_capable);
+    }
+    if (index == tls_contexts_.size()) {
+      index = 0;
     }
-    tail_select(false);
+    selected_ctx = &tls_contexts_[index];
+    ocsp_staple_action = ocspStapleAction(*selected_ctx, client_ocsp_capable);
   }
 
   ASSERT(selected_ctx != nullptr);
@@ -8,6 +8,9 @@
 #include "source/common/tls/server_context_impl.h"
 #include "source/common/tls/stats.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace TransportSockets {
@@ -36,15 +39,27 @@ public:
 
 private:
   // Currently, at most one certificate of a given key type may be specified for each exact
-  // server name or wildcard domain name.
-  using PkeyTypesMap = absl::flat_hash_map<int, std::reference_wrapper<const Ssl::TlsContext>>;
+  // server name or wildcard domain name. The ECDSA certificate comes first, as it is preferred for
+  // the clients which support it.
+  struct NamedContext {
+    int pkey_id_;
+    std::reference_wrapper<const Ssl::TlsContext> ctx_;
+  };
+  using NamedContexts = absl::InlinedVector<NamedContext, 2>;
   // Both exact server names and wildcard domains are part of the same map, in which wildcard
   // domains are prefixed with "." (i.e. ".example.com" for "*.example.com") to differentiate
   // between exact and wildcard entries.
-  using ServerNamesMap = absl::flat_hash_map<std::string, PkeyTypesMap>;
+  using ServerNamesMap = absl::flat_hash_map<std::string, NamedContexts>;
+  // The positions in ``tls_contexts_`` of the contexts whose certificate uses a given ECDSA curve,
+  // or EC_CURVE_INVALID_NID for the non-ECDSA certificates, in configuration order.
+  using CurveContextsMap = absl::flat_hash_map<Ssl::CurveNID, std::vector<size_t>>;
 
   void populateServerNamesMap(const Ssl::TlsContext& ctx, const int pkey_id);
 
+  // Returns the position of the first context with a certificate for the given curve which
+  // adheres to the OCSP staple policy, or the number of contexts if there is none.
+  size_t firstUsableContext(Ssl::CurveNID curve, bool client_ocsp_capable);
+
   Ssl::OcspStapleAction ocspStapleAction(const Ssl::TlsContext& ctx, bool client_ocsp_capable);
 
   // ServerContext own this selector, it's safe to use itself here.
@@ -52,7 +67,7 @@ private:
   const std::vector<Ssl::TlsContext>& tls_contexts_;
 
   ServerNamesMap server_names_map_;
-  bool has_rsa_{false};
+  CurveContextsMap curve_contexts_map_;
 
   const Ssl::ServerContextConfig::OcspStaplePolicy ocsp_staple_policy_;
   bool full_scan_certs_on_sni_mismatch_;
@@ -166,6 +166,10 @@ ServerContextConfigImpl::ServerContextConfigImpl(
         std::chrono::seconds(DurationUtil::durationToSeconds(config.session_timeout()));
   }
 
+  if (config.has_shared_session_resumption()) {
+    shared_session_resumption_ = config.shared_session_resumption();
+  }
+
   if (config.common_tls_context().has_custom_tls_certificate_selector()) {
     // If a custom tls context provider is configured, derive the factory from the config.
     const auto& provider_config = config.common_tls_context().custom_tls_certificate_selector();
@@ -40,6 +40,12 @@ public:
     return disable_stateful_session_resumption_;
   }
 
+  const envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext::
+      SharedSessionResumption*
+      sharedSessionResumption() const override {
+    return shared_session_resumption_.has_value() ? &shared_session_resumption_.value() : nullptr;
+  }
+
   bool fullScanCertsOnSNIMismatch() const override { return full_scan_certs_on_sni_mismatch_; }
   bool preferClientCiphers() const override { return prefer_client_ciphers_; }
 
@@ -77,6 +83,9 @@ private:
   absl::optional<std::chrono::seconds> session_timeout_;
   const bool disable_stateless_session_resumption_;
   const bool disable_stateful_session_resumption_;
+  absl::optional<
+      envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext::SharedSessionResumption>
+      shared_session_resumption_;
   bool full_scan_certs_on_sni_mismatch_;
   const bool prefer_client_ciphers_;
 };
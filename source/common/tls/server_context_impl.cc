@@ -135,6 +135,13 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
         });
   }
 
+  if (config.sharedSessionResumption() != nullptr &&
+      !config.capabilities().handles_session_resumption) {
+    shared_session_resumption_ =
+        SharedSessionResumptionRegistry::get(factory_context)
+            ->getOrCreate(*config.sharedSessionResumption(), factory_context);
+  }
+
   const auto tls_certificates = config.tlsCertificates();
 
   for (uint32_t i = 0; i < tls_certificates.size(); ++i) {
@@ -164,7 +171,8 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
     // `SSL_CTX_set_tlsext_ticket_key_cb`.
     if (config.disableStatelessSessionResumption()) {
       SSL_CTX_set_options(ctx.ssl_ctx_.get(), SSL_OP_NO_TICKET);
-    } else if (!session_ticket_keys_.empty() && !config.capabilities().handles_session_resumption) {
+    } else if ((!session_ticket_keys_.empty() || shared_session_resumption_ != nullptr) &&
+               !config.capabilities().handles_session_resumption) {
       SSL_CTX_set_tlsext_ticket_key_cb(
           ctx.ssl_ctx_.get(),
           [](SSL* ssl, uint8_t* key_name, uint8_t* iv, EVP_CIPHER_CTX* ctx, HMAC_CTX* hmac_ctx,
@@ -180,6 +188,22 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
 
     if (config.disableStatefulSessionResumption()) {
       SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(), SSL_SESS_CACHE_OFF);
+    } else if (shared_session_resumption_ != nullptr) {
+      // Sessions are only kept in the shared cache, so that they outlive this context and can be
+      // resumed by the other contexts with the same session ID context.
+      SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(),
+                                     SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+      SSL_CTX_sess_set_new_cb(ctx.ssl_ctx_.get(), [](SSL* ssl, SSL_SESSION* session) -> int {
+        return fromSslCtx(SSL_get_SSL_CTX(ssl)).newSession(session);
+      });
+      SSL_CTX_sess_set_get_cb(
+          ctx.ssl_ctx_.get(),
+          [](SSL* ssl, const uint8_t* id, int id_length, int* out_copy) -> SSL_SESSION* {
+            return fromSslCtx(SSL_get_SSL_CTX(ssl)).getSession(ssl, id, id_length, out_copy);
+          });
+      SSL_CTX_sess_set_remove_cb(ctx.ssl_ctx_.get(), [](SSL_CTX* ssl_ctx, SSL_SESSION* session) {
+        fromSslCtx(ssl_ctx).removeSession(session);
+      });
     }
 
     if (config.sessionTimeout() && !config.capabilities().handles_session_resumption) {
@@ -329,12 +353,15 @@ int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv
 
   if (encrypt == 1) {
     // Encrypt
-    RELEASE_ASSERT(!session_ticket_keys_.empty(), "");
+    RELEASE_ASSERT(!session_ticket_keys_.empty() || shared_session_resumption_ != nullptr, "");
     // TODO(ggreenway): validate in SDS that session_ticket_keys_ cannot be empty,
     // or if we allow it to be emptied, reconfigure the context so this callback
     // isn't set.
 
-    const Envoy::Ssl::ServerContextConfig::SessionTicketKey& key = session_ticket_keys_.front();
+    // Configured keys take precedence over the keys derived for shared session resumption.
+    const Envoy::Ssl::ServerContextConfig::SessionTicketKey key =
+        session_ticket_keys_.empty() ? shared_session_resumption_->ticketKeys().encryptionKey()
+                                     : session_ticket_keys_.front();
 
     static_assert(std::tuple_size<decltype(key.name_)>::value == SSL_TICKET_KEY_NAME_LEN,
                   "Expected key.name length");
@@ -357,6 +384,21 @@ int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv
     return 1; // success
   } else {
     // Decrypt
+    if (session_ticket_keys_.empty()) {
+      const absl::optional<SessionTicketKeyDeriver::DecryptionKey> key =
+          shared_session_resumption_->ticketKeys().decryptionKey(
+              absl::MakeConstSpan(key_name, SSL_TICKET_KEY_NAME_LEN));
+      if (!key.has_value()) {
+        return 0; // decryption failed
+      }
+      if (!HMAC_Init_ex(hmac_ctx, key->key_.hmac_key_.data(), key->key_.hmac_key_.size(), hmac,
+                        nullptr) ||
+          !EVP_DecryptInit_ex(ctx, cipher, nullptr, key->key_.aes_key_.data(), iv)) {
+        return -1;
+      }
+      return key->renew_ ? 2 : 1;
+    }
+
     bool is_enc_key = true; // first element is the encryption key
     for (const Envoy::Ssl::ServerContextConfig::SessionTicketKey& key : session_ticket_keys_) {
       static_assert(std::tuple_size<decltype(key.name_)>::value == SSL_TICKET_KEY_NAME_LEN,
@@ -382,6 +424,48 @@ int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv
   }
 }
 
+ServerContextImpl& ServerContextImpl::fromSslCtx(SSL_CTX* ssl_ctx) {
+  ContextImpl* context_impl = static_cast<ContextImpl*>(SSL_CTX_get_app_data(ssl_ctx));
+  ServerContextImpl* server_context_impl = dynamic_cast<ServerContextImpl*>(context_impl);
+  RELEASE_ASSERT(server_context_impl != nullptr, ""); // for Coverity
+  return *server_context_impl;
+}
+
+int ServerContextImpl::newSession(SSL_SESSION* session) {
+  unsigned id_length;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_length);
+  uint8_t* data;
+  size_t length;
+  if (id_length > 0 && SSL_SESSION_to_bytes(session, &data, &length)) {
+    shared_session_resumption_->sessionCache().insert(
+        absl::string_view(reinterpret_cast<const char*>(id), id_length),
+        std::string(reinterpret_cast<const char*>(data), length));
+    OPENSSL_free(data);
+  }
+  // The cache keeps a copy, rather than taking ownership of the session.
+  return 0;
+}
+
+SSL_SESSION* ServerContextImpl::getSession(SSL* ssl, const uint8_t* id, int id_length,
+                                           int* out_copy) {
+  // The returned session is a new one that BoringSSL takes ownership of.
+  *out_copy = 0;
+  const absl::optional<std::string> session = shared_session_resumption_->sessionCache().lookup(
+      absl::string_view(reinterpret_cast<const char*>(id), id_length));
+  if (!session.has_value()) {
+    return nullptr;
+  }
+  return SSL_SESSION_from_bytes(reinterpret_cast<const uint8_t*>(session->data()), session->size(),
+                                SSL_get_SSL_CTX(ssl));
+}
+
+void ServerContextImpl::removeSession(SSL_SESSION* session) {
+  unsigned id_length;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_length);
+  shared_session_resumption_->sessionCache().remove(
+      absl::string_view(reinterpret_cast<const char*>(id), id_length));
+}
+
 // Returns a list of client capabilities for ECDSA curves as NIDs. An empty vector indicates
 // a client that is unable to handle ECDSA.
 Ssl::CurveNIDVector
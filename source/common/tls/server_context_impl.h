@@ -25,6 +25,7 @@
 #include "source/common/tls/context_manager_impl.h"
 #include "source/common/tls/default_tls_certificate_selector.h"
 #include "source/common/tls/ocsp/ocsp.h"
+#include "source/common/tls/session_resumption.h"
 #include "source/common/tls/stats.h"
 
 #include "absl/synchronization/mutex.h"
@@ -83,11 +84,19 @@ private:
   int sessionTicketProcess(SSL* ssl, uint8_t* key_name, uint8_t* iv, EVP_CIPHER_CTX* ctx,
                            HMAC_CTX* hmac_ctx, int encrypt);
 
+  // Callbacks of the shared session cache, @see SSL_CTX_sess_set_new_cb.
+  static ServerContextImpl& fromSslCtx(SSL_CTX* ssl_ctx);
+  int newSession(SSL_SESSION* session);
+  SSL_SESSION* getSession(SSL* ssl, const uint8_t* id, int id_length, int* out_copy);
+  void removeSession(SSL_SESSION* session);
+
   absl::StatusOr<SessionContextID>
   generateHashForSessionContextId(const std::vector<std::string>& server_names);
 
   Ssl::TlsCertificateSelectorPtr tls_certificate_selector_;
   const std::vector<Envoy::Ssl::ServerContextConfig::SessionTicketKey> session_ticket_keys_;
+  // Set if session resumption state is shared with other contexts.
+  SharedSessionResumptionSharedPtr shared_session_resumption_;
   const Ssl::ServerContextConfig::OcspStaplePolicy ocsp_staple_policy_;
 };
 
@@ -0,0 +1,229 @@
+#include "source/common/tls/session_resumption.h"
+
+#include <algorithm>
+
+#include "envoy/common/key_value_store.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/hex.h"
+#include "source/common/common/logger.h"
+#include "source/common/config/utility.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/hash/hash.h"
+#include "openssl/digest.h"
+#include "openssl/hkdf.h"
+#include "openssl/rand.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+SINGLETON_MANAGER_REGISTRATION(shared_session_resumption_registry);
+
+namespace {
+
+// BoringSSL's default size of the session cache of a context.
+constexpr uint32_t DefaultMaxCachedSessions = 20480;
+constexpr std::chrono::seconds DefaultTicketKeyRotationInterval{3600};
+constexpr size_t SecretLength = 32;
+constexpr absl::string_view SecretStoreKey = "session_ticket_secret";
+constexpr absl::string_view KeyDerivationInfo = "envoy tls session ticket key";
+// The bytes of a key name that hold the period, the others being derived from the secret.
+constexpr size_t PeriodLength = sizeof(uint64_t);
+
+} // namespace
+
+SharedSessionCache::SharedSessionCache(uint32_t max_sessions)
+    : max_sessions_per_shard_(std::max<size_t>(1, (max_sessions + NumShards - 1) / NumShards)) {}
+
+SharedSessionCache::Shard& SharedSessionCache::shardFor(absl::string_view session_id) {
+  return shards_[absl::Hash<absl::string_view>{}(session_id) % NumShards];
+}
+
+void SharedSessionCache::insert(absl::string_view session_id, std::string session) {
+  Shard& shard = shardFor(session_id);
+  absl::MutexLock lock(&shard.mu_);
+  auto it = shard.index_.find(session_id);
+  if (it != shard.index_.end()) {
+    it->second->second = std::move(session);
+    shard.sessions_.splice(shard.sessions_.begin(), shard.sessions_, it->second);
+    return;
+  }
+  if (shard.sessions_.size() >= max_sessions_per_shard_) {
+    shard.index_.erase(shard.sessions_.back().first);
+    shard.sessions_.pop_back();
+  }
+  shard.sessions_.emplace_front(std::string(session_id), std::move(session));
+  shard.index_.emplace(shard.sessions_.front().first, shard.sessions_.begin());
+}
+
+absl::optional<std::string> SharedSessionCache::lookup(absl::string_view session_id) {
+  Shard& shard = shardFor(session_id);
+  absl::MutexLock lock(&shard.mu_);
+  auto it = shard.index_.find(session_id);
+  if (it == shard.index_.end()) {
+    return absl::nullopt;
+  }
+  shard.sessions_.splice(shard.sessions_.begin(), shard.sessions_, it->second);
+  return it->second->second;
+}
+
+void SharedSessionCache::remove(absl::string_view session_id) {
+  Shard& shard = shardFor(session_id);
+  absl::MutexLock lock(&shard.mu_);
+  auto it = shard.index_.find(session_id);
+  if (it == shard.index_.end()) {
+    return;
+  }
+  const Shard::SessionList::iterator session = it->second;
+  shard.index_.erase(it);
+  shard.sessions_.erase(session);
+}
+
+size_t SharedSessionCache::size() const {
+  size_t size = 0;
+  for (const Shard& shard : shards_) {
+    absl::MutexLock lock(&shard.mu_);
+    size += shard.sessions_.size();
+  }
+  return size;
+}
+
+SessionTicketKeyDeriver::SessionTicketKeyDeriver(std::string secret,
+                                                 std::chrono::seconds rotation_interval,
+                                                 TimeSource& time_source)
+    : secret_(std::move(secret)), rotation_interval_(rotation_interval),
+      time_source_(time_source) {
+  ASSERT(rotation_interval_.count() > 0);
+}
+
+uint64_t SessionTicketKeyDeriver::currentPeriod() const {
+  const auto now = std::chrono::duration_cast<std::chrono::seconds>(
+      time_source_.systemTime().time_since_epoch());
+  return now.count() / rotation_interval_.count();
+}
+
+SessionTicketKeyDeriver::SessionTicketKey
+SessionTicketKeyDeriver::deriveKey(uint64_t period) const {
+  SessionTicketKey key;
+  for (size_t i = 0; i < PeriodLength; ++i) {
+    key.name_[i] = static_cast<uint8_t>(period >> (8 * (PeriodLength - 1 - i)));
+  }
+
+  std::string info(KeyDerivationInfo);
+  info.append(reinterpret_cast<const char*>(key.name_.data()), PeriodLength);
+  std::array<uint8_t, sizeof(key.name_) - PeriodLength + sizeof(key.hmac_key_) +
+                          sizeof(key.aes_key_)>
+      derived;
+  const int rc = HKDF(derived.data(), derived.size(), EVP_sha256(),
+                      reinterpret_cast<const uint8_t*>(secret_.data()), secret_.size(), nullptr, 0,
+                      reinterpret_cast<const uint8_t*>(info.data()), info.size());
+  RELEASE_ASSERT(rc == 1, "");
+
+  auto next = derived.begin();
+  std::copy_n(next, key.name_.size() - PeriodLength, key.name_.begin() + PeriodLength);
+  next += key.name_.size() - PeriodLength;
+  std::copy_n(next, key.hmac_key_.size(), key.hmac_key_.begin());
+  next += key.hmac_key_.size();
+  std::copy_n(next, key.aes_key_.size(), key.aes_key_.begin());
+  return key;
+}
+
+SessionTicketKeyDeriver::SessionTicketKey SessionTicketKeyDeriver::encryptionKey() const {
+  return deriveKey(currentPeriod());
+}
+
+absl::optional<SessionTicketKeyDeriver::DecryptionKey>
+SessionTicketKeyDeriver::decryptionKey(absl::Span<const uint8_t> key_name) const {
+  if (key_name.size() != sizeof(SessionTicketKey::name_)) {
+    return absl::nullopt;
+  }
+  uint64_t period = 0;
+  for (size_t i = 0; i < PeriodLength; ++i) {
+    period = (period << 8) | key_name[i];
+  }
+  const uint64_t current_period = currentPeriod();
+  if (period != current_period && period + 1 != current_period) {
+    return absl::nullopt;
+  }
+  SessionTicketKey key = deriveKey(period);
+  if (!std::equal(key.name_.begin(), key.name_.end(), key_name.begin())) {
+    // The ticket was encrypted with a key derived from another secret.
+    return absl::nullopt;
+  }
+  return DecryptionKey{key, period != current_period};
+}
+
+SharedSessionResumption::SharedSessionResumption(const SharedSessionResumptionConfig& config,
+                                                 std::string secret, TimeSource& time_source)
+    : session_cache_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_cached_sessions, DefaultMaxCachedSessions)),
+      ticket_keys_(std::move(secret),
+                   config.has_ticket_key_rotation_interval()
+                       ? std::chrono::seconds(DurationUtil::durationToSeconds(
+                             config.ticket_key_rotation_interval()))
+                       : DefaultTicketKeyRotationInterval,
+                   time_source) {}
+
+std::shared_ptr<SharedSessionResumptionRegistry>
+SharedSessionResumptionRegistry::get(Server::Configuration::CommonFactoryContext& factory_context) {
+  // Pinned, so that the secrets outlive the contexts using them.
+  return factory_context.singletonManager().getTyped<SharedSessionResumptionRegistry>(
+      SINGLETON_MANAGER_REGISTERED_NAME(shared_session_resumption_registry),
+      [] { return std::make_shared<SharedSessionResumptionRegistry>(); }, true);
+}
+
+SharedSessionResumptionSharedPtr SharedSessionResumptionRegistry::getOrCreate(
+    const SharedSessionResumptionConfig& config,
+    Server::Configuration::CommonFactoryContext& factory_context) {
+  Entry& entry = entries_[MessageUtil::hash(config)];
+  SharedSessionResumptionSharedPtr state = entry.state_.lock();
+  if (state != nullptr) {
+    return state;
+  }
+  if (entry.secret_.empty()) {
+    entry.secret_ = loadOrCreateSecret(config, factory_context);
+  }
+  state = std::make_shared<SharedSessionResumption>(config, entry.secret_,
+                                                    factory_context.timeSource());
+  entry.state_ = state;
+  return state;
+}
+
+std::string SharedSessionResumptionRegistry::loadOrCreateSecret(
+    const SharedSessionResumptionConfig& config,
+    Server::Configuration::CommonFactoryContext& factory_context) {
+  KeyValueStorePtr store;
+  if (config.has_key_value_store_config()) {
+    auto& factory = Config::Utility::getAndCheckFactory<KeyValueStoreFactory>(
+        config.key_value_store_config().config());
+    store = factory.createStore(config.key_value_store_config(),
+                                factory_context.messageValidationVisitor(),
+                                factory_context.mainThreadDispatcher(),
+                                factory_context.api().fileSystem());
+    const absl::optional<absl::string_view> stored = store->get(SecretStoreKey);
+    if (stored.has_value()) {
+      const std::vector<uint8_t> secret = Hex::decode(std::string(stored.value()));
+      if (secret.size() == SecretLength) {
+        return {secret.begin(), secret.end()};
+      }
+      ENVOY_LOG_MISC(warn, "ignoring invalid TLS session ticket secret in the key value store");
+    }
+  }
+
+  std::vector<uint8_t> secret(SecretLength);
+  const int rc = RAND_bytes(secret.data(), secret.size());
+  RELEASE_ASSERT(rc == 1, "");
+  if (store != nullptr) {
+    store->addOrUpdate(SecretStoreKey, Hex::encode(secret), absl::nullopt);
+    store->flush();
+  }
+  return {secret.begin(), secret.end()};
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
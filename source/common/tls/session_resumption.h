@@ -0,0 +1,181 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/transport_sockets/tls/v3/tls.pb.h"
+#include "envoy/server/factory_context.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/ssl/context_config.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+using SharedSessionResumptionConfig =
+    envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext::SharedSessionResumption;
+
+/**
+ * A cache of serialized TLS sessions, shared by server contexts and used from all the worker
+ * threads. It is split into shards, each with its own lock and LRU list, so that concurrent
+ * handshakes rarely contend on a lock.
+ */
+class SharedSessionCache {
+public:
+  /**
+   * @param max_sessions the maximum number of sessions kept across all the shards.
+   */
+  explicit SharedSessionCache(uint32_t max_sessions);
+
+  /**
+   * Adds a session, evicting the least recently used session of its shard if the shard is full.
+   * @param session_id the ID of the session.
+   * @param session the serialized session.
+   */
+  void insert(absl::string_view session_id, std::string session);
+
+  /**
+   * @return the serialized session with the given ID, if it is cached.
+   */
+  absl::optional<std::string> lookup(absl::string_view session_id);
+
+  /**
+   * Removes a session. This is a no-op if the session is not cached.
+   */
+  void remove(absl::string_view session_id);
+
+  /**
+   * @return the number of sessions cached.
+   */
+  size_t size() const;
+
+private:
+  static constexpr size_t NumShards = 16;
+
+  struct Shard {
+    using SessionList = std::list<std::pair<std::string, std::string>>;
+
+    mutable absl::Mutex mu_;
+    // Sessions ordered from most to least recently used.
+    SessionList sessions_ ABSL_GUARDED_BY(mu_);
+    // Keyed by views of the session IDs in sessions_.
+    absl::flat_hash_map<absl::string_view, SessionList::iterator> index_ ABSL_GUARDED_BY(mu_);
+  };
+
+  Shard& shardFor(absl::string_view session_id);
+
+  const size_t max_sessions_per_shard_;
+  std::array<Shard, NumShards> shards_;
+};
+
+/**
+ * Derives session ticket keys from a secret and the current rotation period. The keys rotate
+ * without any timer or coordination: every context sharing the secret, including one in another
+ * process that loaded the secret from the same store, derives the same key for a period. Each key
+ * name starts with the period it belongs to, so that the key of a ticket can be derived again.
+ */
+class SessionTicketKeyDeriver {
+public:
+  using SessionTicketKey = Ssl::ServerContextConfig::SessionTicketKey;
+
+  struct DecryptionKey {
+    SessionTicketKey key_;
+    // Whether the ticket should be renewed, because a newer key encrypts new tickets.
+    bool renew_;
+  };
+
+  SessionTicketKeyDeriver(std::string secret, std::chrono::seconds rotation_interval,
+                          TimeSource& time_source);
+
+  /**
+   * @return the key for encrypting new tickets.
+   */
+  SessionTicketKey encryptionKey() const;
+
+  /**
+   * @param key_name the name of the key a ticket was encrypted with.
+   * @return the key with that name, if it is the key of the current or of the previous period.
+   */
+  absl::optional<DecryptionKey> decryptionKey(absl::Span<const uint8_t> key_name) const;
+
+private:
+  uint64_t currentPeriod() const;
+  SessionTicketKey deriveKey(uint64_t period) const;
+
+  const std::string secret_;
+  const std::chrono::seconds rotation_interval_;
+  TimeSource& time_source_;
+};
+
+/**
+ * The session resumption state shared by the server contexts configured with the same
+ * SharedSessionResumptionConfig.
+ */
+class SharedSessionResumption {
+public:
+  SharedSessionResumption(const SharedSessionResumptionConfig& config, std::string secret,
+                          TimeSource& time_source);
+
+  SharedSessionCache& sessionCache() { return session_cache_; }
+  const SessionTicketKeyDeriver& ticketKeys() const { return ticket_keys_; }
+
+private:
+  SharedSessionCache session_cache_;
+  const SessionTicketKeyDeriver ticket_keys_;
+};
+
+using SharedSessionResumptionSharedPtr = std::shared_ptr<SharedSessionResumption>;
+
+/**
+ * Hands out the SharedSessionResumption for a configuration, creating it if no context uses it.
+ * The ticket key secret of each configuration is kept for the lifetime of the server, so that
+ * contexts created after all the previous ones were destroyed can still decrypt their tickets.
+ *
+ * Contexts are created on the main thread, which is the only thread that uses the registry.
+ */
+class SharedSessionResumptionRegistry : public Singleton::Instance {
+public:
+  /**
+   * @return the server's registry.
+   */
+  static std::shared_ptr<SharedSessionResumptionRegistry>
+  get(Server::Configuration::CommonFactoryContext& factory_context);
+
+  /**
+   * @return the state shared by the contexts with the given configuration.
+   */
+  SharedSessionResumptionSharedPtr
+  getOrCreate(const SharedSessionResumptionConfig& config,
+              Server::Configuration::CommonFactoryContext& factory_context);
+
+private:
+  struct Entry {
+    std::string secret_;
+    std::weak_ptr<SharedSessionResumption> state_;
+  };
+
+  // Loads the secret from the configured key value store, storing a new one if there is none.
+  static std::string
+  loadOrCreateSecret(const SharedSessionResumptionConfig& config,
+                     Server::Configuration::CommonFactoryContext& factory_context);
+
+  absl::flat_hash_map<uint64_t, Entry> entries_;
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
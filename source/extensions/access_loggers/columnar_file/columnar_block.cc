@@ -0,0 +1,221 @@
+#include "source/extensions/access_loggers/columnar_file/columnar_block.h"
+
+#include <memory>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/fmt.h"
+
+#include "absl/strings/match.h"
+#include "zstd.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace ColumnarFile {
+namespace {
+
+void addVarint(Buffer::Instance& output, uint64_t value) {
+  uint8_t bytes[10];
+  size_t length = 0;
+  while (value >= 0x80) {
+    bytes[length++] = static_cast<uint8_t>(value) | 0x80;
+    value >>= 7;
+  }
+  bytes[length++] = static_cast<uint8_t>(value);
+  output.add(bytes, length);
+}
+
+void addString(Buffer::Instance& output, absl::string_view value) {
+  addVarint(output, value.size());
+  output.add(value.data(), value.size());
+}
+
+class PayloadReader {
+public:
+  explicit PayloadReader(absl::string_view payload) : remaining_(payload) {}
+
+  bool readVarint(uint64_t& value) {
+    value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+      if (remaining_.empty()) {
+        return false;
+      }
+      const uint8_t byte = remaining_[0];
+      remaining_.remove_prefix(1);
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool readString(std::string& value) {
+    uint64_t length;
+    if (!readVarint(length) || length > remaining_.size()) {
+      return false;
+    }
+    value.assign(remaining_.data(), length);
+    remaining_.remove_prefix(length);
+    return true;
+  }
+
+  bool empty() const { return remaining_.empty(); }
+  size_t size() const { return remaining_.size(); }
+
+private:
+  absl::string_view remaining_;
+};
+
+} // namespace
+
+BlockBuilder::BlockBuilder(const std::vector<std::string>& column_names) {
+  columns_.reserve(column_names.size());
+  for (const std::string& name : column_names) {
+    columns_.emplace_back(name);
+  }
+}
+
+void BlockBuilder::addRecord(absl::Span<const absl::string_view> values) {
+  ASSERT(values.size() == columns_.size());
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    Column& column = columns_[i];
+    auto it = column.index_.find(values[i]);
+    if (it == column.index_.end()) {
+      column.dictionary_.emplace_back(values[i]);
+      it = column.index_.emplace(column.dictionary_.back(), column.dictionary_.size() - 1).first;
+    }
+    column.codes_.push_back(it->second);
+  }
+  ++records_;
+}
+
+void BlockBuilder::clear() {
+  for (Column& column : columns_) {
+    column.index_.clear();
+    column.dictionary_.clear();
+    column.codes_.clear();
+  }
+  records_ = 0;
+}
+
+void BlockBuilder::serialize(Buffer::Instance& output) const {
+  addVarint(output, records_);
+  addVarint(output, columns_.size());
+  for (const Column& column : columns_) {
+    addString(output, column.name_);
+    addVarint(output, column.dictionary_.size());
+    for (const std::string& value : column.dictionary_) {
+      addString(output, value);
+    }
+    for (const uint32_t code : column.codes_) {
+      addVarint(output, code);
+    }
+  }
+}
+
+absl::StatusOr<DecodedBlock> decodeBlock(absl::string_view payload) {
+  PayloadReader reader(payload);
+  uint64_t record_count;
+  uint64_t column_count;
+  // Every column takes at least two bytes and every value one, which bounds the sizes before
+  // allocating.
+  if (!reader.readVarint(record_count) || !reader.readVarint(column_count) ||
+      column_count > reader.size() ||
+      (column_count > 0 && record_count > reader.size() / column_count)) {
+    return absl::InvalidArgumentError("truncated columnar block header");
+  }
+  // Loggers have at least one column, and without columns the record count would be unbounded.
+  if (column_count == 0 && record_count > 0) {
+    return absl::InvalidArgumentError("columnar block records without columns");
+  }
+
+  DecodedBlock block;
+  block.column_names_.resize(column_count);
+  block.records_.resize(record_count, std::vector<std::string>(column_count));
+  std::vector<std::string> dictionary;
+  for (uint64_t column = 0; column < column_count; ++column) {
+    uint64_t dictionary_size;
+    if (!reader.readString(block.column_names_[column]) || !reader.readVarint(dictionary_size) ||
+        dictionary_size > reader.size()) {
+      return absl::InvalidArgumentError(fmt::format("truncated column {}", column));
+    }
+    dictionary.resize(dictionary_size);
+    for (std::string& value : dictionary) {
+      if (!reader.readString(value)) {
+        return absl::InvalidArgumentError(
+            fmt::format("truncated dictionary of column '{}'", block.column_names_[column]));
+      }
+    }
+    for (std::vector<std::string>& record : block.records_) {
+      uint64_t code;
+      if (!reader.readVarint(code) || code >= dictionary_size) {
+        return absl::InvalidArgumentError(
+            fmt::format("invalid value of column '{}'", block.column_names_[column]));
+      }
+      record[column] = dictionary[code];
+    }
+  }
+  if (!reader.empty()) {
+    return absl::InvalidArgumentError("trailing data after columnar block");
+  }
+  return block;
+}
+
+absl::StatusOr<std::vector<absl::string_view>> splitFrames(absl::string_view data) {
+  std::vector<absl::string_view> frames;
+  while (!data.empty()) {
+    if (data.size() < BlockHeaderSize || !absl::StartsWith(data, BlockMagic)) {
+      return absl::InvalidArgumentError(
+          fmt::format("invalid frame header at frame {}", frames.size()));
+    }
+    uint32_t compressed_size = 0;
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+      compressed_size |= static_cast<uint32_t>(static_cast<uint8_t>(data[BlockMagic.size() + i]))
+                         << (8 * i);
+    }
+    data.remove_prefix(BlockHeaderSize);
+    if (compressed_size > data.size()) {
+      return absl::InvalidArgumentError(fmt::format("truncated frame {}", frames.size()));
+    }
+    frames.push_back(data.substr(0, compressed_size));
+    data.remove_prefix(compressed_size);
+  }
+  return frames;
+}
+
+absl::StatusOr<std::string> decompressFrame(absl::string_view compressed) {
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+  RELEASE_ASSERT(dctx != nullptr, "");
+
+  std::string output;
+  char chunk[16384];
+  ZSTD_inBuffer input{compressed.data(), compressed.size(), 0};
+  size_t result;
+  do {
+    ZSTD_outBuffer out{chunk, sizeof(chunk), 0};
+    result = ZSTD_decompressStream(dctx.get(), &out, &input);
+    if (ZSTD_isError(result)) {
+      return absl::InvalidArgumentError(ZSTD_getErrorName(result));
+    }
+    output.append(chunk, out.pos);
+    if (result != 0 && input.pos == input.size && out.pos < out.size) {
+      return absl::InvalidArgumentError("truncated zstd frame");
+    }
+  } while (result != 0);
+
+  if (input.pos != input.size) {
+    return absl::InvalidArgumentError("trailing data after zstd frame");
+  }
+  return output;
+}
+
+void addFrameHeader(Buffer::Instance& output, uint32_t compressed_size) {
+  output.add(BlockMagic);
+  output.writeLEInt<uint32_t>(compressed_size);
+}
+
+} // namespace ColumnarFile
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "envoy/buffer/buffer.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace ColumnarFile {
+
+/**
+ * A columnar access log file is a sequence of frames. Each frame is:
+ *
+ *   magic             4 bytes, "ECB1"
+ *   compressed_size   4 bytes, little endian
+ *   payload           compressed_size bytes, a single zstd frame
+ *
+ * The decompressed payload holds one block of records. All integers are unsigned LEB128 varints:
+ *
+ *   record_count
+ *   column_count
+ *   column_count times:
+ *     name_length, name
+ *     dictionary_size
+ *     dictionary_size times: value_length, value
+ *     record_count times: index into the dictionary
+ */
+constexpr absl::string_view BlockMagic = "ECB1";
+constexpr uint64_t BlockHeaderSize = 8;
+
+/**
+ * Accumulates records for one block, dictionary coding every column.
+ */
+class BlockBuilder {
+public:
+  explicit BlockBuilder(const std::vector<std::string>& column_names);
+
+  /**
+   * Add a record. values must hold one value per column, in column order.
+   */
+  void addRecord(absl::Span<const absl::string_view> values);
+
+  uint32_t records() const { return records_; }
+
+  /**
+   * Remove all records, keeping the columns.
+   */
+  void clear();
+
+  /**
+   * Append the uncompressed block payload to output.
+   */
+  void serialize(Buffer::Instance& output) const;
+
+private:
+  struct Column {
+    explicit Column(absl::string_view name) : name_(name) {}
+
+    const std::string name_;
+    // The dictionary is a deque so that the views used as map keys stay valid as it grows.
+    std::deque<std::string> dictionary_;
+    absl::flat_hash_map<absl::string_view, uint32_t> index_;
+    std::vector<uint32_t> codes_;
+  };
+
+  std::vector<Column> columns_;
+  uint32_t records_{};
+};
+
+/**
+ * A decoded block: the column names and every record's values, in column order.
+ */
+struct DecodedBlock {
+  std::vector<std::string> column_names_;
+  std::vector<std::vector<std::string>> records_;
+};
+
+/**
+ * Decode an uncompressed block payload produced by BlockBuilder::serialize().
+ */
+absl::StatusOr<DecodedBlock> decodeBlock(absl::string_view payload);
+
+/**
+ * Split a columnar access log file into the compressed payloads of its frames.
+ */
+absl::StatusOr<std::vector<absl::string_view>> splitFrames(absl::string_view data);
+
+/**
+ * Decompress the payload of one frame.
+ */
+absl::StatusOr<std::string> decompressFrame(absl::string_view compressed);
+
+/**
+ * Write the frame header for a payload of the given compressed size.
+ */
+void addFrameHeader(Buffer::Instance& output, uint32_t compressed_size);
+
+} // namespace ColumnarFile
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,96 @@
+#include "source/extensions/access_loggers/columnar_file/columnar_file_access_log_impl.h"
+
+#include "source/common/buffer/buffer_impl.h"
+
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace ColumnarFile {
+namespace {
+
+// Matches the default chunk size of the zstd compressor extension.
+constexpr uint32_t CompressorChunkSize = 4096;
+
+} // namespace
+
+BlockWriter::BlockWriter(BlockWriterConfigConstSharedPtr config,
+                         AccessLog::AccessLogFileSharedPtr log_file, Event::Dispatcher& dispatcher)
+    : config_(std::move(config)), log_file_(std::move(log_file)), block_(config_->column_names_),
+      flush_timer_(dispatcher.createTimer([this]() -> void { flush(); })) {}
+
+BlockWriter::~BlockWriter() { flush(); }
+
+void BlockWriter::addRecord(absl::Span<const absl::string_view> values) {
+  if (block_.records() == 0) {
+    flush_timer_->enableTimer(config_->flush_interval_);
+  }
+  block_.addRecord(values);
+  if (block_.records() >= config_->records_per_block_) {
+    flush();
+  }
+}
+
+void BlockWriter::flush() {
+  flush_timer_->disableTimer();
+  if (block_.records() == 0) {
+    return;
+  }
+
+  Buffer::OwnedImpl payload;
+  block_.serialize(payload);
+  block_.clear();
+
+  Compression::Zstd::Compressor::ZstdCompressorImpl compressor(
+      config_->compression_level_, false, 0, nullptr, CompressorChunkSize);
+  compressor.compress(payload, Envoy::Compression::Compressor::State::Finish);
+
+  // The whole frame is written at once so that frames from different threads never interleave.
+  Buffer::OwnedImpl frame;
+  addFrameHeader(frame, payload.length());
+  frame.move(payload);
+  const uint64_t length = frame.length();
+  log_file_->write(absl::string_view(static_cast<const char*>(frame.linearize(length)), length));
+}
+
+ColumnarFileAccessLog::ColumnarFileAccessLog(
+    const Filesystem::FilePathAndType& access_log_file_info, AccessLog::FilterPtr&& filter,
+    BlockWriterConfigConstSharedPtr config, std::vector<Formatter::FormatterPtr>&& formatters,
+    AccessLog::AccessLogManager& log_manager, ThreadLocal::SlotAllocator& tls)
+    : ImplBase(std::move(filter)), formatters_(std::move(formatters)),
+      tls_slot_(ThreadLocal::TypedSlot<BlockWriter>::makeUnique(tls)) {
+  ASSERT(formatters_.size() == config->column_names_.size());
+  auto file_or_error = log_manager.createAccessLog(access_log_file_info);
+  THROW_IF_NOT_OK_REF(file_or_error.status());
+  tls_slot_->set([config, log_file = file_or_error.value()](Event::Dispatcher& dispatcher) {
+    return std::make_shared<BlockWriter>(config, log_file, dispatcher);
+  });
+}
+
+void ColumnarFileAccessLog::emitLog(const Formatter::HttpFormatterContext& context,
+                                    const StreamInfo::StreamInfo& stream_info) {
+  BlockWriter& writer = **tls_slot_;
+  std::string& record = writer.recordBuffer();
+  record.clear();
+
+  // Format every value into the same scratch buffer. Views are taken only once it stops growing.
+  absl::InlinedVector<size_t, 16> ends;
+  for (const Formatter::FormatterPtr& formatter : formatters_) {
+    formatter->appendWithContext(context, stream_info, record);
+    ends.push_back(record.size());
+  }
+
+  absl::InlinedVector<absl::string_view, 16> values;
+  size_t begin = 0;
+  for (const size_t end : ends) {
+    values.push_back(absl::string_view(record).substr(begin, end - begin));
+    begin = end;
+  }
+  writer.addRecord(values);
+}
+
+} // namespace ColumnarFile
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/access_log/access_log.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/formatter/substitution_formatter.h"
+#include "source/extensions/access_loggers/columnar_file/columnar_block.h"
+#include "source/extensions/access_loggers/common/access_log_base.h"
+#include "source/extensions/compression/zstd/compressor/zstd_compressor_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace ColumnarFile {
+
+struct BlockWriterConfig {
+  std::vector<std::string> column_names_;
+  uint32_t records_per_block_;
+  uint32_t compression_level_;
+  std::chrono::milliseconds flush_interval_;
+};
+
+using BlockWriterConfigConstSharedPtr = std::shared_ptr<const BlockWriterConfig>;
+
+/**
+ * Per-thread writer that batches records into blocks, so that workers never share a block.
+ * A block is written once it is full, or flush_interval_ after its first record.
+ */
+class BlockWriter : public ThreadLocal::ThreadLocalObject {
+public:
+  BlockWriter(BlockWriterConfigConstSharedPtr config, AccessLog::AccessLogFileSharedPtr log_file,
+              Event::Dispatcher& dispatcher);
+  ~BlockWriter() override;
+
+  void addRecord(absl::Span<const absl::string_view> values);
+
+  /**
+   * Compress and write the buffered records, if any.
+   */
+  void flush();
+
+  /**
+   * @return a scratch buffer for formatting the values of a record on this thread.
+   */
+  std::string& recordBuffer() { return record_buffer_; }
+
+private:
+  const BlockWriterConfigConstSharedPtr config_;
+  const AccessLog::AccessLogFileSharedPtr log_file_;
+  BlockBuilder block_;
+  std::string record_buffer_;
+  Event::TimerPtr flush_timer_;
+};
+
+/**
+ * Access log Instance that writes dictionary coded, zstd compressed blocks of records to a file.
+ */
+class ColumnarFileAccessLog : public Common::ImplBase {
+public:
+  ColumnarFileAccessLog(const Filesystem::FilePathAndType& access_log_file_info,
+                        AccessLog::FilterPtr&& filter, BlockWriterConfigConstSharedPtr config,
+                        std::vector<Formatter::FormatterPtr>&& formatters,
+                        AccessLog::AccessLogManager& log_manager, ThreadLocal::SlotAllocator& tls);
+
+private:
+  // Common::ImplBase
+  void emitLog(const Formatter::HttpFormatterContext& context,
+               const StreamInfo::StreamInfo& stream_info) override;
+
+  const std::vector<Formatter::FormatterPtr> formatters_;
+  ThreadLocal::TypedSlotPtr<BlockWriter> tls_slot_;
+};
+
+} // namespace ColumnarFile
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,67 @@
+#include "source/extensions/access_loggers/columnar_file/config.h"
+
+#include <memory>
+
+#include "envoy/extensions/access_loggers/columnar_file/v3/columnar_file.pb.h"
+#include "envoy/extensions/access_loggers/columnar_file/v3/columnar_file.pb.validate.h"
+#include "envoy/registry/registry.h"
+#include "envoy/server/filter_config.h"
+
+#include "source/common/formatter/substitution_formatter.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/access_loggers/columnar_file/columnar_file_access_log_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace ColumnarFile {
+
+AccessLog::InstanceSharedPtr ColumnarFileAccessLogFactory::createAccessLogInstance(
+    const Protobuf::Message& config, AccessLog::FilterPtr&& filter,
+    Server::Configuration::GenericFactoryContext& context,
+    std::vector<Formatter::CommandParserPtr>&& command_parsers) {
+  const auto& proto_config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::access_loggers::columnar_file::v3::ColumnarFileAccessLog&>(
+      config, context.messageValidationVisitor());
+
+  auto block_config = std::make_shared<BlockWriterConfig>();
+  block_config->records_per_block_ =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, records_per_block, 1024);
+  block_config->compression_level_ =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, compression_level, 3);
+  block_config->flush_interval_ =
+      std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(proto_config, flush_interval, 1000));
+
+  std::vector<Formatter::FormatterPtr> formatters;
+  for (const auto& column : proto_config.columns()) {
+    block_config->column_names_.push_back(column.name());
+    formatters.push_back(THROW_OR_RETURN_VALUE(
+        Formatter::FormatterImpl::create(column.format(), false, command_parsers),
+        std::unique_ptr<Formatter::FormatterImpl>));
+  }
+
+  Filesystem::FilePathAndType file_info{Filesystem::DestinationType::File, proto_config.path()};
+  return std::make_shared<ColumnarFileAccessLog>(
+      file_info, std::move(filter), std::move(block_config), std::move(formatters),
+      context.serverFactoryContext().accessLogManager(),
+      context.serverFactoryContext().threadLocal());
+}
+
+ProtobufTypes::MessagePtr ColumnarFileAccessLogFactory::createEmptyConfigProto() {
+  return std::make_unique<
+      envoy::extensions::access_loggers::columnar_file::v3::ColumnarFileAccessLog>();
+}
+
+std::string ColumnarFileAccessLogFactory::name() const {
+  return "envoy.access_loggers.columnar_file";
+}
+
+/**
+ * Static registration for the columnar file access log. @see RegisterFactory.
+ */
+REGISTER_FACTORY(ColumnarFileAccessLogFactory, AccessLog::AccessLogInstanceFactory);
+
+} // namespace ColumnarFile
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -18,6 +18,7 @@
 #include "source/extensions/access_loggers/common/grpc_access_logger_utils.h"
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -51,6 +52,14 @@ public:
    */
   virtual void log(HttpLogProto&& entry) PURE;
 
+  /**
+   * Log http access entry built in place in the pending batch, which saves building a separate
+   * entry and moving it into the batch.
+   * @param build supplies the function that fills in the entry. The entry may be a reused one
+   *        that was cleared, so it must not rely on the storage being new.
+   */
+  virtual void logInPlace(absl::FunctionRef<void(HttpLogProto&)> build) PURE;
+
   /**
    * Log tcp access entry.
    * @param entry supplies the access log to send.
@@ -132,6 +141,25 @@ public:
     }
   }
 
+  void logInPlace(absl::FunctionRef<void(HttpLogProto&)> build) override {
+    if (!canLogMore()) {
+      return;
+    }
+    HttpLogProto* entry = newEntry();
+    if (entry != nullptr) {
+      build(*entry);
+      approximate_message_size_bytes_ += entry->ByteSizeLong();
+    } else {
+      HttpLogProto separate_entry;
+      build(separate_entry);
+      approximate_message_size_bytes_ += separate_entry.ByteSizeLong();
+      addEntry(std::move(separate_entry));
+    }
+    if (approximate_message_size_bytes_ >= max_buffer_size_bytes_) {
+      flush();
+    }
+  }
+
   void log(TcpLogProto&& entry) override {
     approximate_message_size_bytes_ += entry.ByteSizeLong();
     addEntry(std::move(entry));
@@ -149,6 +177,9 @@ private:
   virtual void initMessage() PURE;
   virtual void addEntry(HttpLogProto&& entry) PURE;
   virtual void addEntry(TcpLogProto&& entry) PURE;
+  // Adds an empty entry to the message for logInPlace() to fill in, or returns nullptr if the
+  // entries are built separately and added with addEntry().
+  virtual HttpLogProto* newEntry() { return nullptr; }
   virtual void clearMessage() { message_.Clear(); }
 
   void flush() {
@@ -42,10 +42,11 @@ packBody(const ::opentelemetry::proto::common::v1::AnyValue& body) {
   return output;
 }
 
-::opentelemetry::proto::common::v1::AnyValue
-unpackBody(const ::opentelemetry::proto::common::v1::KeyValueList& value) {
-  ASSERT(value.values().size() == 1 && value.values(0).key() == BODY_KEY);
-  return value.values(0).value();
+// Moving the single body value out of the packed "KeyValueList" into output.
+void unpackBody(Protobuf::RepeatedPtrField<::opentelemetry::proto::common::v1::KeyValue>& packed,
+                ::opentelemetry::proto::common::v1::AnyValue& output) {
+  ASSERT(packed.size() == 1 && packed.Get(0).key() == BODY_KEY);
+  output.Swap(packed.Mutable(0)->mutable_value());
 }
 
 } // namespace
@@ -80,36 +81,42 @@ AccessLog::AccessLog(
 
 void AccessLog::emitLog(const Formatter::HttpFormatterContext& log_context,
                         const StreamInfo::StreamInfo& stream_info) {
-  opentelemetry::proto::logs::v1::LogRecord log_entry;
-  log_entry.set_time_unix_nano(std::chrono::duration_cast<std::chrono::nanoseconds>(
-                                   stream_info.startTime().time_since_epoch())
-                                   .count());
-
-  // Unpacking the body "KeyValueList" to "AnyValue".
-  if (body_formatter_) {
-    const auto formatted_body = unpackBody(body_formatter_->format(log_context, stream_info));
-    *log_entry.mutable_body() = formatted_body;
-  }
-  const auto formatted_attributes = attributes_formatter_->format(log_context, stream_info);
-  *log_entry.mutable_attributes() = formatted_attributes.values();
-
-  // Setting the trace id if available.
-  // OpenTelemetry trace id is a [16]byte array, backend(e.g. OTel-collector) will reject the
-  // request if the length is not 16. Some trace provider(e.g. zipkin) may return it as a 64-bit hex
-  // string. In this case, we need to convert it to a 128-bit hex string, padding left with zeros.
-  std::string trace_id_hex = log_context.activeSpan().getTraceId();
-  if (trace_id_hex.size() == 32) {
-    *log_entry.mutable_trace_id() = absl::HexStringToBytes(trace_id_hex);
-  } else if (trace_id_hex.size() == 16) {
-    auto trace_id = absl::StrCat(Hex::uint64ToHex(0), trace_id_hex);
-    *log_entry.mutable_trace_id() = absl::HexStringToBytes(trace_id);
-  }
-  std::string span_id_hex = log_context.activeSpan().getSpanId();
-  if (!span_id_hex.empty()) {
-    *log_entry.mutable_span_id() = absl::HexStringToBytes(span_id_hex);
-  }
-
-  tls_slot_->getTyped<ThreadLocalLogger>().logger_->log(std::move(log_entry));
+  ThreadLocalLogger& thread_local_logger = tls_slot_->getTyped<ThreadLocalLogger>();
+  auto build_log_entry = [&](opentelemetry::proto::logs::v1::LogRecord& log_entry) {
+    log_entry.set_time_unix_nano(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     stream_info.startTime().time_since_epoch())
+                                     .count());
+
+    // The body and attributes are formatted in place so that no intermediate protos are copied.
+    if (body_formatter_) {
+      Protobuf::RepeatedPtrField<::opentelemetry::proto::common::v1::KeyValue>& packed_body =
+          thread_local_logger.packed_body_;
+      packed_body.Clear();
+      body_formatter_->format(log_context, stream_info, packed_body);
+      unpackBody(packed_body, *log_entry.mutable_body());
+    }
+    attributes_formatter_->format(log_context, stream_info, *log_entry.mutable_attributes());
+
+    // Setting the trace id if available.
+    // OpenTelemetry trace id is a [16]byte array, backend(e.g. OTel-collector) will reject the
+    // request if the length is not 16. Some trace provider(e.g. zipkin) may return it as a 64-bit
+    // hex string. In this case, we need to convert it to a 128-bit hex string, padding left with
+    // zeros.
+    std::string trace_id_hex = log_context.activeSpan().getTraceId();
+    if (trace_id_hex.size() == 32) {
+      *log_entry.mutable_trace_id() = absl::HexStringToBytes(trace_id_hex);
+    } else if (trace_id_hex.size() == 16) {
+      auto trace_id = absl::StrCat(Hex::uint64ToHex(0), trace_id_hex);
+      *log_entry.mutable_trace_id() = absl::HexStringToBytes(trace_id);
+    }
+    std::string span_id_hex = log_context.activeSpan().getSpanId();
+    if (!span_id_hex.empty()) {
+      *log_entry.mutable_span_id() = absl::HexStringToBytes(span_id_hex);
+    }
+  };
+  // The record is built in place in the logger's pending batch, so that no separate record is
+  // built and copied into it.
+  thread_local_logger.logger_->logInPlace(build_log_entry);
 }
 
 } // namespace OpenTelemetry
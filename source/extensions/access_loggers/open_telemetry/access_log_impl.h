@@ -47,6 +47,8 @@ private:
     ThreadLocalLogger(GrpcAccessLoggerSharedPtr logger);
 
     const GrpcAccessLoggerSharedPtr logger_;
+    // The body packed as a single key value, reused for each log entry.
+    Protobuf::RepeatedPtrField<::opentelemetry::proto::common::v1::KeyValue> packed_body_;
   };
 
   // Common::ImplBase
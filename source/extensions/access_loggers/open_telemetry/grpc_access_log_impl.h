@@ -89,6 +89,9 @@ private:
   void addEntry(opentelemetry::proto::logs::v1::LogRecord&& entry) override;
   // Non used addEntry method (the above is used for both TCP and HTTP).
   void addEntry(Protobuf::Empty&& entry) override { (void)entry; };
+  // Log records are added in place. clearMessage() keeps the cleared records for reuse, so later
+  // batches reuse the records of earlier ones along with their attribute key values.
+  opentelemetry::proto::logs::v1::LogRecord* newEntry() override;
   bool isEmpty() override;
   void initMessage() override;
   void clearMessage() override;
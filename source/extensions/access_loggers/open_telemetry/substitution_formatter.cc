@@ -1,6 +1,5 @@
 #include "source/extensions/access_loggers/open_telemetry/substitution_formatter.h"
 
-#include <algorithm>
 #include <list>
 #include <string>
 #include <vector>
@@ -10,7 +9,6 @@
 #include "source/common/common/assert.h"
 #include "source/common/formatter/substitution_formatter.h"
 
-#include "absl/strings/str_join.h"
 #include "opentelemetry/proto/common/v1/common.pb.h"
 
 static const std::string DefaultUnspecifiedValueString = "-";
@@ -82,65 +80,71 @@ OpenTelemetryFormatter::FormatBuilder::toFormatStringValue(const std::string& st
                                std::vector<Formatter::FormatterProviderPtr>);
 }
 
-::opentelemetry::proto::common::v1::AnyValue OpenTelemetryFormatter::providersCallback(
+void OpenTelemetryFormatter::formatValue(
+    const OpenTelemetryFormatValue& value, const Formatter::HttpFormatterContext& context,
+    const StreamInfo::StreamInfo& info,
+    ::opentelemetry::proto::common::v1::AnyValue& output) const {
+  absl::visit(
+      OpenTelemetryFormatMapVisitorHelper{
+          [&](const std::vector<Formatter::FormatterProviderPtr>& providers) {
+            formatProviders(providers, context, info, *output.mutable_string_value());
+          },
+          [&](const OpenTelemetryFormatMapWrapper& format_map) {
+            formatMap(format_map, context, info, *output.mutable_kvlist_value()->mutable_values());
+          },
+          [&](const OpenTelemetryFormatListWrapper& format_list) {
+            formatList(format_list, context, info, *output.mutable_array_value());
+          },
+      },
+      value);
+}
+
+void OpenTelemetryFormatter::formatProviders(
     const std::vector<Formatter::FormatterProviderPtr>& providers,
-    const Formatter::HttpFormatterContext& context, const StreamInfo::StreamInfo& info) const {
+    const Formatter::HttpFormatterContext& context, const StreamInfo::StreamInfo& info,
+    std::string& output) const {
   ASSERT(!providers.empty());
-  ::opentelemetry::proto::common::v1::AnyValue output;
-  std::vector<std::string> bits(providers.size());
-
-  std::transform(
-      providers.begin(), providers.end(), bits.begin(),
-      [&](const Formatter::FormatterProviderPtr& provider) {
-        return provider->formatWithContext(context, info).value_or(DefaultUnspecifiedValueString);
-      });
-
-  output.set_string_value(absl::StrJoin(bits, ""));
-  return output;
+  for (const Formatter::FormatterProviderPtr& provider : providers) {
+    if (!provider->appendWithContext(context, info, output)) {
+      output.append(DefaultUnspecifiedValueString);
+    }
+  }
 }
 
-::opentelemetry::proto::common::v1::AnyValue OpenTelemetryFormatter::openTelemetryFormatMapCallback(
-    const OpenTelemetryFormatter::OpenTelemetryFormatMapWrapper& format_map,
-    const OpenTelemetryFormatter::OpenTelemetryFormatMapVisitor& visitor) const {
-  ::opentelemetry::proto::common::v1::AnyValue output;
-  auto* kv_list = output.mutable_kvlist_value();
+void OpenTelemetryFormatter::formatMap(
+    const OpenTelemetryFormatMapWrapper& format_map, const Formatter::HttpFormatterContext& context,
+    const StreamInfo::StreamInfo& info,
+    Protobuf::RepeatedPtrField<::opentelemetry::proto::common::v1::KeyValue>& output) const {
+  output.Reserve(output.size() + format_map.value_->size());
   for (const auto& pair : *format_map.value_) {
-    ::opentelemetry::proto::common::v1::AnyValue value = absl::visit(visitor, pair.second);
-    auto* kv = kv_list->add_values();
+    auto* kv = output.Add();
     kv->set_key(pair.first);
-    *kv->mutable_value() = value;
+    formatValue(pair.second, context, info, *kv->mutable_value());
   }
-  return output;
 }
 
-::opentelemetry::proto::common::v1::AnyValue
-OpenTelemetryFormatter::openTelemetryFormatListCallback(
-    const OpenTelemetryFormatter::OpenTelemetryFormatListWrapper& format_list,
-    const OpenTelemetryFormatter::OpenTelemetryFormatMapVisitor& visitor) const {
-  ::opentelemetry::proto::common::v1::AnyValue output;
-  auto* array_value = output.mutable_array_value();
-  for (const auto& val : *format_list.value_) {
-    ::opentelemetry::proto::common::v1::AnyValue value = absl::visit(visitor, val);
-    *array_value->add_values() = value;
+void OpenTelemetryFormatter::formatList(
+    const OpenTelemetryFormatListWrapper& format_list,
+    const Formatter::HttpFormatterContext& context, const StreamInfo::StreamInfo& info,
+    ::opentelemetry::proto::common::v1::ArrayValue& output) const {
+  output.mutable_values()->Reserve(format_list.value_->size());
+  for (const auto& value : *format_list.value_) {
+    formatValue(value, context, info, *output.add_values());
   }
-  return output;
+}
+
+void OpenTelemetryFormatter::format(
+    const Formatter::HttpFormatterContext& context, const StreamInfo::StreamInfo& info,
+    Protobuf::RepeatedPtrField<::opentelemetry::proto::common::v1::KeyValue>& output) const {
+  formatMap(kv_list_output_format_, context, info, output);
 }
 
 ::opentelemetry::proto::common::v1::KeyValueList
 OpenTelemetryFormatter::format(const Formatter::HttpFormatterContext& context,
                                const StreamInfo::StreamInfo& info) const {
-  OpenTelemetryFormatMapVisitor visitor{
-      [&](const std::vector<Formatter::FormatterProviderPtr>& providers) {
-        return providersCallback(providers, context, info);
-      },
-      [&, this](const OpenTelemetryFormatter::OpenTelemetryFormatMapWrapper& format_map) {
-        return openTelemetryFormatMapCallback(format_map, visitor);
-      },
-      [&, this](const OpenTelemetryFormatter::OpenTelemetryFormatListWrapper& format_list) {
-        return openTelemetryFormatListCallback(format_list, visitor);
-      },
-  };
-  return openTelemetryFormatMapCallback(kv_list_output_format_, visitor).kvlist_value();
+  ::opentelemetry::proto::common::v1::KeyValueList output;
+  format(context, info, *output.mutable_values());
+  return output;
 }
 
 } // namespace OpenTelemetry
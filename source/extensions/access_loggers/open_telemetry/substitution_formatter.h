@@ -7,6 +7,8 @@
 #include "envoy/formatter/substitution_formatter.h"
 #include "envoy/stream_info/stream_info.h"
 
+#include "source/common/protobuf/protobuf.h"
+
 #include "opentelemetry/proto/common/v1/common.pb.h"
 
 namespace Envoy {
@@ -14,7 +16,7 @@ namespace Extensions {
 namespace AccessLoggers {
 namespace OpenTelemetry {
 
-// Helper classes for OpenTelemetryFormatter::OpenTelemetryMapFormatVisitor.
+// Helper classes for visiting OpenTelemetryFormatter::OpenTelemetryFormatValue.
 template <class... Ts> struct OpenTelemetryFormatMapVisitorHelper : Ts... {
   using Ts::operator()...;
 };
@@ -32,6 +34,14 @@ public:
   ::opentelemetry::proto::common::v1::KeyValueList
   format(const Formatter::HttpFormatterContext& context, const StreamInfo::StreamInfo& info) const;
 
+  /**
+   * Format directly into output, appending one entry per configured key. Values are built in place
+   * rather than in temporaries that are then copied into the log record.
+   */
+  void format(const Formatter::HttpFormatterContext& context, const StreamInfo::StreamInfo& info,
+              Protobuf::RepeatedPtrField<::opentelemetry::proto::common::v1::KeyValue>& output)
+      const;
+
 private:
   struct OpenTelemetryFormatMapWrapper;
   struct OpenTelemetryFormatListWrapper;
@@ -52,14 +62,6 @@ private:
     OpenTelemetryFormatListPtr value_;
   };
 
-  using OpenTelemetryFormatMapVisitor = OpenTelemetryFormatMapVisitorHelper<
-      std::function<::opentelemetry::proto::common::v1::AnyValue(
-          const std::vector<Formatter::FormatterProviderPtr>&)>,
-      std::function<::opentelemetry::proto::common::v1::AnyValue(
-          const OpenTelemetryFormatter::OpenTelemetryFormatMapWrapper&)>,
-      std::function<::opentelemetry::proto::common::v1::AnyValue(
-          const OpenTelemetryFormatter::OpenTelemetryFormatListWrapper&)>>;
-
   // Methods for building the format map.
   class FormatBuilder {
   public:
@@ -77,16 +79,21 @@ private:
   };
 
   // Methods for doing the actual formatting.
-  ::opentelemetry::proto::common::v1::AnyValue
-  providersCallback(const std::vector<Formatter::FormatterProviderPtr>& providers,
-                    const Formatter::HttpFormatterContext& context,
-                    const StreamInfo::StreamInfo& info) const;
-  ::opentelemetry::proto::common::v1::AnyValue openTelemetryFormatMapCallback(
-      const OpenTelemetryFormatter::OpenTelemetryFormatMapWrapper& format_map,
-      const OpenTelemetryFormatMapVisitor& visitor) const;
-  ::opentelemetry::proto::common::v1::AnyValue openTelemetryFormatListCallback(
-      const OpenTelemetryFormatter::OpenTelemetryFormatListWrapper& format_list,
-      const OpenTelemetryFormatMapVisitor& visitor) const;
+  void formatValue(const OpenTelemetryFormatValue& value,
+                   const Formatter::HttpFormatterContext& context,
+                   const StreamInfo::StreamInfo& info,
+                   ::opentelemetry::proto::common::v1::AnyValue& output) const;
+  void formatProviders(const std::vector<Formatter::FormatterProviderPtr>& providers,
+                       const Formatter::HttpFormatterContext& context,
+                       const StreamInfo::StreamInfo& info, std::string& output) const;
+  void formatMap(const OpenTelemetryFormatMapWrapper& format_map,
+                 const Formatter::HttpFormatterContext& context, const StreamInfo::StreamInfo& info,
+                 Protobuf::RepeatedPtrField<::opentelemetry::proto::common::v1::KeyValue>& output)
+      const;
+  void formatList(const OpenTelemetryFormatListWrapper& format_list,
+                  const Formatter::HttpFormatterContext& context,
+                  const StreamInfo::StreamInfo& info,
+                  ::opentelemetry::proto::common::v1::ArrayValue& output) const;
 
   const OpenTelemetryFormatMapWrapper kv_list_output_format_;
 };
@@ -1,7 +1,9 @@
 #include "source/extensions/common/async_files/async_file_context_thread_pool.h"
 
 #include <fcntl.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -138,6 +140,60 @@ private:
   const size_t length_;
 };
 
+class ActionReadMappedFile
+    : public AsyncFileActionThreadPool<absl::StatusOr<Buffer::InstancePtr>> {
+public:
+  ActionReadMappedFile(AsyncFileHandle handle, off_t offset, size_t length,
+                       absl::AnyInvocable<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete)
+      : AsyncFileActionThreadPool<absl::StatusOr<Buffer::InstancePtr>>(handle,
+                                                                       std::move(on_complete)),
+        offset_(offset), length_(length) {}
+
+  absl::StatusOr<Buffer::InstancePtr> executeImpl() override {
+    ASSERT(fileDescriptor() != -1);
+    auto result = std::make_unique<Buffer::OwnedImpl>();
+    // Touching a mapped page beyond the end of the file raises SIGBUS, so the range is clipped
+    // to the file size, giving a partial result like read.
+    struct stat stat_result;
+    auto stat_call = posix().fstat(fileDescriptor(), &stat_result);
+    if (stat_call.return_value_ != 0) {
+      return statusAfterFileError(stat_call);
+    }
+    if (offset_ >= stat_result.st_size) {
+      return result;
+    }
+    const size_t length = std::min<size_t>(length_, stat_result.st_size - offset_);
+    if (length == 0) {
+      return result;
+    }
+    // Mappings must start at a page boundary.
+    static const off_t page_size = sysconf(_SC_PAGESIZE);
+    const off_t map_offset = offset_ - offset_ % page_size;
+    const size_t map_length = length + (offset_ - map_offset);
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    // Faults the pages in on this thread rather than on the thread that reads the buffer.
+    flags |= MAP_POPULATE;
+#endif
+    auto mapped = posix().mmap(nullptr, map_length, PROT_READ, flags, fileDescriptor(), map_offset);
+    if (mapped.return_value_ == MAP_FAILED) {
+      return statusAfterFileError(mapped);
+    }
+    result->addBufferFragment(*new Buffer::BufferFragmentImpl(
+        static_cast<const char*>(mapped.return_value_) + (offset_ - map_offset), length,
+        [&os_sys_calls = posix(), addr = mapped.return_value_,
+         map_length](const void*, size_t, const Buffer::BufferFragmentImpl* fragment) {
+          os_sys_calls.munmap(addr, map_length);
+          delete fragment;
+        }));
+    return result;
+  }
+
+private:
+  const off_t offset_;
+  const size_t length_;
+};
+
 class ActionWriteFile : public AsyncFileActionThreadPool<absl::StatusOr<size_t>> {
 public:
   ActionWriteFile(AsyncFileHandle handle, Buffer::Instance& contents, off_t offset,
@@ -248,6 +304,13 @@ absl::StatusOr<CancelFunction> AsyncFileContextThreadPool::read(
                                                                           std::move(on_complete)));
 }
 
+absl::StatusOr<CancelFunction> AsyncFileContextThreadPool::readMapped(
+    Event::Dispatcher* dispatcher, off_t offset, size_t length,
+    absl::AnyInvocable<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) {
+  return checkFileAndEnqueue(dispatcher, std::make_unique<ActionReadMappedFile>(
+                                             handle(), offset, length, std::move(on_complete)));
+}
+
 absl::StatusOr<CancelFunction>
 AsyncFileContextThreadPool::write(Event::Dispatcher* dispatcher, Buffer::Instance& contents,
                                   off_t offset,
@@ -52,6 +52,15 @@ public:
   read(Event::Dispatcher* dispatcher, off_t offset, size_t length,
        absl::AnyInvocable<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) PURE;
 
+  // Like read, but maps the range of the file into memory rather than copying it. The buffer
+  // passed to on_complete references the mapping, which is released when the buffer is drained,
+  // so the data is only copied if the buffer's consumer needs to modify it. The mapped pages are
+  // populated before on_complete is called, so that reading them does not block on the file
+  // system. The file must not be truncated while the buffer is alive.
+  virtual absl::StatusOr<CancelFunction>
+  readMapped(Event::Dispatcher* dispatcher, off_t offset, size_t length,
+             absl::AnyInvocable<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) PURE;
+
   // Enqueues an action to write to the currently open file, at position offset, the bytes contained
   // by contents. It is an error to call write on an AsyncFileContext that does not have a file
   // open.
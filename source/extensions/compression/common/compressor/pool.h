@@ -0,0 +1,167 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "envoy/compression/compressor/compressor.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Common {
+namespace Compressor {
+
+// Default bound on the memory held by each thread's idle compressors.
+constexpr uint64_t DefaultMaxPooledBytes = 16 * 1024 * 1024;
+
+/**
+ * A per-thread pool of idle compressors whose contexts can be reused for another stream. Setting
+ * up a compression context and its window is a large part of the cost of compressing a small
+ * response, so reusing them saves both the allocations and the initialization.
+ *
+ * T must be an Envoy::Compression::Compressor::Compressor that also provides:
+ *   void reset(): prepares the compressor for a new stream, keeping its parameters and memory.
+ *   uint64_t memoryUsage() const: the approximate number of bytes held by the compressor.
+ *
+ * The pool is not thread-safe; each worker thread has its own, @see ThreadLocalCompressorPool.
+ */
+template <class T> class CompressorPool : NonCopyable {
+public:
+  /**
+   * @param max_contexts the maximum number of idle compressors to keep.
+   * @param max_bytes the maximum total memoryUsage() of the idle compressors.
+   */
+  CompressorPool(uint32_t max_contexts, uint64_t max_bytes)
+      : max_contexts_(max_contexts), max_bytes_(max_bytes) {}
+
+  /**
+   * @return an idle compressor reset for a new stream, or nullptr if the pool is empty.
+   */
+  std::unique_ptr<T> acquire() {
+    if (idle_.empty()) {
+      return nullptr;
+    }
+    IdleCompressor idle = std::move(idle_.back());
+    idle_.pop_back();
+    idle_bytes_ -= idle.memory_usage_;
+    idle.compressor_->reset();
+    return std::move(idle.compressor_);
+  }
+
+  /**
+   * Returns a compressor to the pool once its stream is done, whether or not the stream finished.
+   * The compressor is destroyed instead if keeping it would exceed the pool's bounds.
+   */
+  void release(std::unique_ptr<T> compressor) {
+    ASSERT(compressor != nullptr);
+    const uint64_t memory_usage = compressor->memoryUsage();
+    if (idle_.size() >= max_contexts_ || idle_bytes_ + memory_usage > max_bytes_) {
+      return;
+    }
+    idle_bytes_ += memory_usage;
+    idle_.push_back(IdleCompressor{std::move(compressor), memory_usage});
+  }
+
+  size_t idleCount() const { return idle_.size(); }
+  uint64_t idleBytes() const { return idle_bytes_; }
+
+private:
+  struct IdleCompressor {
+    std::unique_ptr<T> compressor_;
+    uint64_t memory_usage_;
+  };
+
+  const uint32_t max_contexts_;
+  const uint64_t max_bytes_;
+  std::vector<IdleCompressor> idle_;
+  uint64_t idle_bytes_{0};
+};
+
+/**
+ * A compressor borrowed from a CompressorPool, which it is returned to when destroyed.
+ */
+template <class T> class PooledCompressor : public Envoy::Compression::Compressor::Compressor {
+public:
+  PooledCompressor(std::unique_ptr<T> compressor, std::shared_ptr<CompressorPool<T>> pool)
+      : compressor_(std::move(compressor)), pool_(std::move(pool)) {}
+  ~PooledCompressor() override { pool_->release(std::move(compressor_)); }
+
+  // Envoy::Compression::Compressor::Compressor
+  void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override {
+    compressor_->compress(buffer, state);
+  }
+
+private:
+  std::unique_ptr<T> compressor_;
+  // Shared so that a compressor outliving its factory can still be returned.
+  const std::shared_ptr<CompressorPool<T>> pool_;
+};
+
+/**
+ * Gives each worker thread its own CompressorPool, and creates compressors from it.
+ */
+template <class T> class ThreadLocalCompressorPool {
+public:
+  using CompressorCreator = std::function<std::unique_ptr<T>()>;
+  using CompressorPreparer = std::function<void(T&)>;
+
+  /**
+   * @param max_contexts the maximum number of idle compressors kept by each thread.
+   * @param max_bytes the maximum memory held by the idle compressors of each thread.
+   * @param tls the slot allocator for the per-thread pools.
+   * @param creator creates a new compressor when the thread's pool is empty.
+   */
+  ThreadLocalCompressorPool(uint32_t max_contexts, uint64_t max_bytes,
+                            ThreadLocal::SlotAllocator& tls, CompressorCreator creator)
+      : tls_slot_(ThreadLocal::TypedSlot<ThreadLocalPool>::makeUnique(tls)),
+        creator_(std::move(creator)) {
+    tls_slot_->set([max_contexts, max_bytes](Event::Dispatcher&) {
+      return std::make_shared<ThreadLocalPool>(max_contexts, max_bytes);
+    });
+  }
+
+  /**
+   * @param prepare if set, is called with the compressor before it is returned, to set it up for
+   *        the stream.
+   * @return a compressor from the calling thread's pool, or a new one if the pool is empty.
+   */
+  Envoy::Compression::Compressor::CompressorPtr
+  createCompressor(const CompressorPreparer& prepare = nullptr) {
+    std::shared_ptr<CompressorPool<T>> pool = (*tls_slot_)->pool_;
+    std::unique_ptr<T> compressor = pool->acquire();
+    if (compressor == nullptr) {
+      compressor = creator_();
+    }
+    if (prepare) {
+      prepare(*compressor);
+    }
+    return std::make_unique<PooledCompressor<T>>(std::move(compressor), std::move(pool));
+  }
+
+  /**
+   * @return the calling thread's pool.
+   */
+  const CompressorPool<T>& pool() const { return *(*tls_slot_)->pool_; }
+
+private:
+  struct ThreadLocalPool : public ThreadLocal::ThreadLocalObject {
+    ThreadLocalPool(uint32_t max_contexts, uint64_t max_bytes)
+        : pool_(std::make_shared<CompressorPool<T>>(max_contexts, max_bytes)) {}
+
+    const std::shared_ptr<CompressorPool<T>> pool_;
+  };
+
+  ThreadLocal::TypedSlotPtr<ThreadLocalPool> tls_slot_;
+  const CompressorCreator creator_;
+};
+
+} // namespace Compressor
+} // namespace Common
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -6,6 +6,7 @@
 
 #include "source/common/http/headers.h"
 #include "source/extensions/compression/common/compressor/factory_base.h"
+#include "source/extensions/compression/common/compressor/pool.h"
 #include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
 
 namespace Envoy {
@@ -36,9 +37,13 @@ const std::string& gzipExtensionName() {
 
 } // namespace
 
+using GzipCompressorPool =
+    Compression::Common::Compressor::ThreadLocalCompressorPool<ZlibCompressorImpl>;
+
 class GzipCompressorFactory : public Envoy::Compression::Compressor::CompressorFactory {
 public:
-  GzipCompressorFactory(const envoy::extensions::compression::gzip::compressor::v3::Gzip& gzip);
+  GzipCompressorFactory(const envoy::extensions::compression::gzip::compressor::v3::Gzip& gzip,
+                        ThreadLocal::SlotAllocator& tls);
 
   // Envoy::Compression::Compressor::CompressorFactory
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override;
@@ -48,6 +53,8 @@ public:
   }
 
 private:
+  std::unique_ptr<ZlibCompressorImpl> createZlibCompressor();
+
   static ZlibCompressorImpl::CompressionLevel
   compressionLevelEnum(envoy::extensions::compression::gzip::compressor::v3::Gzip::CompressionLevel
                            compression_level);
@@ -60,6 +67,7 @@ private:
   const int32_t memory_level_;
   const int32_t window_bits_;
   const uint32_t chunk_size_;
+  std::unique_ptr<GzipCompressorPool> pool_;
 };
 
 class GzipCompressorLibraryFactory
@@ -35,6 +35,23 @@ void ZlibCompressorImpl::init(CompressionLevel comp_level, CompressionStrategy c
                                   window_bits, memory_level, static_cast<uint64_t>(comp_strategy));
   RELEASE_ASSERT(result >= 0, "");
   initialized_ = true;
+  window_bits_ = window_bits;
+  memory_level_ = memory_level;
+}
+
+void ZlibCompressorImpl::reset() {
+  ASSERT(initialized_);
+  const int result = deflateReset(zstream_ptr_.get());
+  RELEASE_ASSERT(result == Z_OK, "");
+  zstream_ptr_->avail_out = chunk_size_;
+  zstream_ptr_->next_out = chunk_char_ptr_.get();
+}
+
+uint64_t ZlibCompressorImpl::memoryUsage() const {
+  // The low four bits of window_bits are the window size, the others select the header format.
+  const uint64_t window_size_bits = window_bits_ & 15;
+  return (uint64_t{1} << (window_size_bits + 2)) + (uint64_t{1} << (memory_level_ + 9)) +
+         chunk_size_;
 }
 
 void ZlibCompressorImpl::compress(Buffer::Instance& buffer,
@@ -82,12 +82,27 @@ public:
   void init(CompressionLevel level, CompressionStrategy strategy, int64_t window_bits,
             uint64_t memory_level);
 
+  /**
+   * Prepares an initialized compressor for a new stream, keeping its parameters and the memory of
+   * its context. @see Common::Compressor::CompressorPool.
+   */
+  void reset();
+
+  /**
+   * @return the approximate number of bytes held by the compressor, as estimated from its window
+   * and memory level. @see zconf.h
+   */
+  uint64_t memoryUsage() const;
+
   // Compression::Compressor::Compressor
   void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override;
 
 private:
   bool deflateNext(int64_t flush_state);
   void process(Buffer::Instance& output_buffer, int64_t flush_state);
+
+  int64_t window_bits_{0};
+  uint64_t memory_level_{0};
 };
 
 } // namespace Compressor
@@ -84,6 +84,28 @@ public:
 
   T* getFirstDictionary() { return getDictionary(true, 0); };
 
+  /**
+   * Makes a dictionary available on all threads. In replace mode it replaces all the current
+   * dictionaries, otherwise it is added alongside them. Must be called on the main thread.
+   * @param data the dictionary content.
+   * @return the ID of the dictionary, or 0 if it is not a valid dictionary.
+   */
+  unsigned addDictionary(absl::string_view data) {
+    auto dictionary = DictionarySharedPtr(builder_(data.data(), data.length()));
+    auto id = getDictId(dictionary.get());
+    if (id != 0) {
+      tls_slot_->runOnAllThreads(
+          [dictionary = std::move(dictionary), id,
+           replace_mode = replace_mode_](OptRef<DictionaryThreadLocalMap> dictionary_map) {
+            if (replace_mode) {
+              dictionary_map->clear();
+            }
+            dictionary_map->insert_or_assign(id, dictionary);
+          });
+    }
+    return id;
+  }
+
 private:
   class DictionarySharedPtr : public std::shared_ptr<T> {
   public:
@@ -1,5 +1,9 @@
 #include "source/extensions/compression/zstd/compressor/config.h"
 
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/config/datasource.h"
+#include "source/common/crypto/utility.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Compression {
@@ -13,20 +17,94 @@ ZstdCompressorFactory::ZstdCompressorFactory(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(zstd, compression_level, ZSTD_CLEVEL_DEFAULT)),
       enable_checksum_(zstd.enable_checksum()), strategy_(zstd.strategy()),
       chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(zstd, chunk_size, ZSTD_CStreamOutSize())) {
+  Protobuf::RepeatedPtrField<envoy::config::core::v3::DataSource> dictionaries;
   if (zstd.has_dictionary()) {
-    Protobuf::RepeatedPtrField<envoy::config::core::v3::DataSource> dictionaries;
     dictionaries.Add()->CopyFrom(zstd.dictionary());
+  }
+  if (zstd.has_dictionary() || zstd.has_dictionary_training()) {
     cdict_manager_ = std::make_unique<ZstdCDictManager>(
         dictionaries, dispatcher, api, tls, true,
         [this](const void* dict_buffer, size_t dict_size) -> ZSTD_CDict* {
           return ZSTD_createCDict(dict_buffer, dict_size, compression_level_);
         });
   }
+  if (zstd.has_dictionary_training()) {
+    advertised_dictionaries_ = ThreadLocal::TypedSlot<AdvertisedDictionaries>::makeUnique(tls);
+    advertised_dictionaries_->set(
+        [](Event::Dispatcher&) { return std::make_shared<AdvertisedDictionaries>(); });
+    if (zstd.has_dictionary()) {
+      // Clients that have the configured dictionary can use it until one is trained.
+      const std::string dictionary = THROW_OR_RETURN_VALUE(
+          Config::DataSource::read(zstd.dictionary(), false, api), std::string);
+      setAdvertisedDictionary(dictionary,
+                              ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size()));
+    }
+    dictionary_trainer_ = std::make_unique<ZstdDictionaryTrainer>(
+        zstd.dictionary_training(), dispatcher, api.threadFactory(), api.fileSystem(),
+        [this](absl::string_view dictionary) {
+          const unsigned id = cdict_manager_->addDictionary(dictionary);
+          if (id != 0) {
+            setAdvertisedDictionary(dictionary, id);
+          }
+        });
+  }
+  const uint32_t max_pooled_contexts =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(zstd, max_pooled_contexts, 0);
+  if (max_pooled_contexts > 0) {
+    pool_ = std::make_unique<ZstdCompressorPool>(
+        max_pooled_contexts,
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(zstd, max_pooled_bytes,
+                                        Compression::Common::Compressor::DefaultMaxPooledBytes),
+        tls, [this]() { return createZstdCompressor(); });
+  }
 }
 
 Envoy::Compression::Compressor::CompressorPtr ZstdCompressorFactory::createCompressor() {
+  return createCompressorForDictionary("");
+}
+
+Envoy::Compression::Compressor::CompressorPtr
+ZstdCompressorFactory::createCompressorForDictionary(absl::string_view dictionary_hash) {
+  if (advertised_dictionaries_ == nullptr) {
+    // The configured dictionary, if any, is used for all clients.
+    if (pool_ != nullptr) {
+      return pool_->createCompressor();
+    }
+    return createZstdCompressor();
+  }
+
+  ZSTD_CDict* cdict = nullptr;
+  const auto& ids = (*advertised_dictionaries_)->ids_;
+  if (const auto it = ids.find(dictionary_hash); it != ids.end()) {
+    // The dictionary may already have been replaced on this thread, which leaves it unused.
+    cdict = cdict_manager_->getDictionaryById(it->second);
+  }
+  if (pool_ != nullptr) {
+    return pool_->createCompressor(
+        [cdict](ZstdCompressorImpl& compressor) { compressor.useDictionary(cdict); });
+  }
+  std::unique_ptr<ZstdCompressorImpl> compressor = createZstdCompressor();
+  compressor->useDictionary(cdict);
+  return compressor;
+}
+
+std::unique_ptr<ZstdCompressorImpl> ZstdCompressorFactory::createZstdCompressor() {
   return std::make_unique<ZstdCompressorImpl>(compression_level_, enable_checksum_, strategy_,
-                                              cdict_manager_, chunk_size_);
+                                              cdict_manager_, chunk_size_,
+                                              dictionary_trainer_.get());
+}
+
+void ZstdCompressorFactory::setAdvertisedDictionary(absl::string_view dictionary, unsigned id) {
+  Buffer::OwnedImpl buffer(dictionary);
+  const std::vector<uint8_t> digest =
+      Envoy::Common::Crypto::UtilitySingleton::get().getSha256Digest(buffer);
+  advertised_dictionaries_->runOnAllThreads(
+      [hash = std::string(digest.begin(), digest.end()),
+       id](OptRef<AdvertisedDictionaries> advertised) {
+        // Like the dictionary manager, each dictionary replaces the previous ones.
+        advertised->ids_.clear();
+        advertised->ids_.emplace(hash, id);
+      });
 }
 
 Envoy::Compression::Compressor::CompressorFactoryPtr
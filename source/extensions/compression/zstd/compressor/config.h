@@ -3,11 +3,15 @@
 #include "envoy/compression/compressor/factory.h"
 #include "envoy/extensions/compression/zstd/compressor/v3/zstd.pb.h"
 #include "envoy/extensions/compression/zstd/compressor/v3/zstd.pb.validate.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/http/headers.h"
 #include "source/extensions/compression/common/compressor/factory_base.h"
+#include "source/extensions/compression/common/compressor/pool.h"
 #include "source/extensions/compression/zstd/compressor/zstd_compressor_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Compression {
@@ -23,6 +27,9 @@ const std::string& zstdExtensionName() {
 
 } // namespace
 
+using ZstdCompressorPool =
+    Compression::Common::Compressor::ThreadLocalCompressorPool<ZstdCompressorImpl>;
+
 class ZstdCompressorFactory : public Envoy::Compression::Compressor::CompressorFactory {
 public:
   ZstdCompressorFactory(const envoy::extensions::compression::zstd::compressor::v3::Zstd& zstd,
@@ -31,17 +38,33 @@ public:
 
   // Envoy::Compression::Compressor::CompressorFactory
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override;
+  Envoy::Compression::Compressor::CompressorPtr
+  createCompressorForDictionary(absl::string_view dictionary_hash) override;
   const std::string& statsPrefix() const override { return zstdStatsPrefix(); }
   const std::string& contentEncoding() const override {
     return Http::CustomHeaders::get().ContentEncodingValues.Zstd;
   }
 
 private:
+  // The IDs of the dictionaries that clients can advertise, keyed by their SHA-256 hash.
+  struct AdvertisedDictionaries : public ThreadLocal::ThreadLocalObject {
+    absl::flat_hash_map<std::string, unsigned> ids_;
+  };
+
+  std::unique_ptr<ZstdCompressorImpl> createZstdCompressor();
+  // Makes the dictionary with the given content and ID the only one clients can advertise.
+  void setAdvertisedDictionary(absl::string_view dictionary, unsigned id);
+
   const uint32_t compression_level_;
   const bool enable_checksum_;
   const uint32_t strategy_;
   const uint32_t chunk_size_;
   ZstdCDictManagerPtr cdict_manager_{nullptr};
+  // Set when dictionaries are trained. A dictionary is then only used for a response if the
+  // client advertised it, as clients cannot otherwise have it.
+  ThreadLocal::TypedSlotPtr<AdvertisedDictionaries> advertised_dictionaries_;
+  ZstdDictionaryTrainerPtr dictionary_trainer_;
+  std::unique_ptr<ZstdCompressorPool> pool_;
 };
 
 class ZstdCompressorLibraryFactory
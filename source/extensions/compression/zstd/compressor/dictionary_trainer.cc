@@ -0,0 +1,168 @@
+#include "source/extensions/compression/zstd/compressor/dictionary_trainer.h"
+
+#include <cstdio>
+
+#include "source/common/common/utility.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "zdict.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Compressor {
+
+namespace {
+
+constexpr uint32_t DefaultSampleCount = 1000;
+constexpr uint32_t DefaultMaxSampleBytes = 16384;
+// The default dictionary size of the zstd command line tool.
+constexpr uint32_t DefaultDictionarySize = 112640;
+
+} // namespace
+
+ZstdDictionaryTrainer::ZstdDictionaryTrainer(const DictionaryTrainingProto& config,
+                                             Event::Dispatcher& dispatcher,
+                                             Thread::ThreadFactory& thread_factory,
+                                             Filesystem::Instance& file_system,
+                                             DictionaryCallback on_trained)
+    : sample_count_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, sample_count, DefaultSampleCount)),
+      max_sample_bytes_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_sample_bytes, DefaultMaxSampleBytes)),
+      dictionary_size_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, dictionary_size, DefaultDictionarySize)),
+      output_path_(config.output_path()), dispatcher_(dispatcher), file_system_(file_system),
+      on_trained_(std::move(on_trained)) {
+  if (config.has_retrain_interval()) {
+    retrain_interval_ = std::chrono::milliseconds(
+        DurationUtil::durationToMilliseconds(config.retrain_interval()));
+    retrain_timer_ = dispatcher_.createTimer([this]() { startSampling(); });
+  }
+  thread_ = thread_factory.createThread([this]() { work(); });
+}
+
+ZstdDictionaryTrainer::~ZstdDictionaryTrainer() {
+  {
+    absl::MutexLock lock(&mu_);
+    terminating_ = true;
+    ready_ = true;
+  }
+  thread_->join();
+}
+
+void ZstdDictionaryTrainer::addSample(absl::string_view sample) {
+  if (sample.empty()) {
+    return;
+  }
+  absl::MutexLock lock(&mu_);
+  if (!collecting_.load(std::memory_order_relaxed)) {
+    // Another thread completed the set of samples first.
+    return;
+  }
+  sample = sample.substr(0, max_sample_bytes_);
+  samples_.append(sample.data(), sample.size());
+  sample_sizes_.push_back(sample.size());
+  if (sample_sizes_.size() >= sample_count_) {
+    collecting_.store(false, std::memory_order_relaxed);
+    ready_ = true;
+  }
+}
+
+uint32_t ZstdDictionaryTrainer::sampleCount() const {
+  absl::MutexLock lock(&mu_);
+  return sample_sizes_.size();
+}
+
+void ZstdDictionaryTrainer::work() {
+  while (true) {
+    std::string samples;
+    std::vector<size_t> sample_sizes;
+    {
+      absl::MutexLock lock(&mu_);
+      mu_.Await(absl::Condition(&ready_));
+      if (terminating_) {
+        return;
+      }
+      ready_ = false;
+      samples.swap(samples_);
+      sample_sizes.swap(sample_sizes_);
+    }
+
+    std::string dictionary(dictionary_size_, '\0');
+    const size_t result =
+        ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples.data(),
+                              sample_sizes.data(), static_cast<unsigned>(sample_sizes.size()));
+    if (ZDICT_isError(result)) {
+      ENVOY_LOG(warn, "zstd dictionary training from {} samples failed: {}", sample_sizes.size(),
+                ZDICT_getErrorName(result));
+      dictionary.clear();
+    } else {
+      dictionary.resize(result);
+      ENVOY_LOG(info, "trained zstd dictionary {} of {} bytes from {} samples",
+                ZDICT_getDictID(dictionary.data(), dictionary.size()), dictionary.size(),
+                sample_sizes.size());
+      if (!output_path_.empty()) {
+        writeDictionary(dictionary);
+      }
+    }
+
+    // The trainer is only destroyed on the main thread, so the callback can safely check whether
+    // it still exists.
+    dispatcher_.post([this, alive = std::weak_ptr<bool>(alive_),
+                      dictionary = std::move(dictionary)]() {
+      if (!alive.expired()) {
+        onTrained(dictionary);
+      }
+    });
+  }
+}
+
+void ZstdDictionaryTrainer::onTrained(const std::string& dictionary) {
+  if (!dictionary.empty()) {
+    on_trained_(dictionary);
+  }
+  if (retrain_timer_ != nullptr) {
+    retrain_timer_->enableTimer(retrain_interval_);
+  }
+}
+
+void ZstdDictionaryTrainer::startSampling() {
+  absl::MutexLock lock(&mu_);
+  samples_.clear();
+  sample_sizes_.clear();
+  collecting_.store(true, std::memory_order_relaxed);
+}
+
+void ZstdDictionaryTrainer::writeDictionary(const std::string& dictionary) {
+  static constexpr Filesystem::FlagSet DefaultFlags{1 << Filesystem::File::Operation::Write |
+                                                    1 << Filesystem::File::Operation::Create};
+  // The dictionary is written next to output_path and renamed over it, so that a watcher on the
+  // output directory sees a single MovedTo event for a complete file rather than a partial write.
+  const std::string tmp_path = absl::StrCat(output_path_, ".tmp");
+  Filesystem::FilePathAndType file_info{Filesystem::DestinationType::File, tmp_path};
+  auto file = file_system_.createFile(file_info);
+  if (!file || !file->open(DefaultFlags).return_value_) {
+    ENVOY_LOG(error, "failed to write zstd dictionary to {}", tmp_path);
+    return;
+  }
+  const Api::IoCallSizeResult result = file->write(dictionary);
+  file->close();
+  if (!result.ok() || result.return_value_ != static_cast<ssize_t>(dictionary.size())) {
+    ENVOY_LOG(error, "failed to write zstd dictionary to {}", tmp_path);
+    std::remove(tmp_path.c_str());
+    return;
+  }
+  if (std::rename(tmp_path.c_str(), output_path_.c_str()) != 0) {
+    ENVOY_LOG(error, "failed to rename zstd dictionary {} to {}: {}", tmp_path, output_path_,
+              errorDetails(errno));
+    std::remove(tmp_path.c_str());
+  }
+}
+
+} // namespace Compressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
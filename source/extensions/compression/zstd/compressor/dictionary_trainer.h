@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/extensions/compression/zstd/compressor/v3/zstd.pb.h"
+#include "envoy/filesystem/filesystem.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Compressor {
+
+using DictionaryTrainingProto =
+    envoy::extensions::compression::zstd::compressor::v3::Zstd::DictionaryTraining;
+
+/**
+ * Trains zstd dictionaries from samples of the responses being compressed.
+ *
+ * Compressors on any thread add samples until enough have been collected. The dictionary is then
+ * trained on a background thread, as training takes far longer than compressing a response, and
+ * handed to the main thread, which makes it available to new compressors. If a retrain interval
+ * is configured, sampling for the next dictionary starts once the interval has passed.
+ *
+ * The class is final, as the training thread may still be running during the destructor.
+ */
+class ZstdDictionaryTrainer final : public Logger::Loggable<Logger::Id::compression> {
+public:
+  // Called on the main thread with each trained dictionary.
+  using DictionaryCallback = std::function<void(absl::string_view dictionary)>;
+
+  ZstdDictionaryTrainer(const DictionaryTrainingProto& config, Event::Dispatcher& dispatcher,
+                        Thread::ThreadFactory& thread_factory, Filesystem::Instance& file_system,
+                        DictionaryCallback on_trained);
+
+  /**
+   * The destructor may block until the training thread is joined.
+   */
+  ~ZstdDictionaryTrainer();
+
+  /**
+   * @return whether samples are currently being collected. Compressors check this before
+   * copying a sample, so that there is no cost once enough samples have been collected.
+   */
+  bool wantsSamples() const { return collecting_.load(std::memory_order_relaxed); }
+
+  /**
+   * @return the maximum number of leading bytes of a response to sample.
+   */
+  uint32_t maxSampleBytes() const { return max_sample_bytes_; }
+
+  /**
+   * Adds a sample. Once enough samples have been collected the training thread is woken, and
+   * further samples are ignored until sampling restarts. May be called on any thread.
+   * @param sample the leading bytes of a response.
+   */
+  void addSample(absl::string_view sample);
+
+  /**
+   * @return the number of samples collected for the next dictionary.
+   */
+  uint32_t sampleCount() const;
+
+private:
+  /**
+   * The function that runs on the training thread. It waits for a full set of samples, trains
+   * a dictionary from them, writes it to the output path if any, and posts it to the main
+   * thread, until the trainer is destroyed.
+   */
+  void work();
+
+  // Runs on the main thread with a trained dictionary, or an empty one if training failed.
+  void onTrained(const std::string& dictionary);
+
+  // Discards the collected samples and starts collecting new ones.
+  void startSampling();
+
+  void writeDictionary(const std::string& dictionary);
+
+  const uint32_t sample_count_;
+  const uint32_t max_sample_bytes_;
+  const uint32_t dictionary_size_;
+  const std::string output_path_;
+  Event::Dispatcher& dispatcher_;
+  Filesystem::Instance& file_system_;
+  const DictionaryCallback on_trained_;
+  std::chrono::milliseconds retrain_interval_{};
+  Event::TimerPtr retrain_timer_;
+  // Guards the callbacks posted to the main thread against the trainer being destroyed first.
+  const std::shared_ptr<bool> alive_{std::make_shared<bool>(true)};
+
+  std::atomic<bool> collecting_{true};
+  mutable absl::Mutex mu_;
+  // All the samples concatenated, as ZDICT_trainFromBuffer expects, and their sizes.
+  std::string samples_ ABSL_GUARDED_BY(mu_);
+  std::vector<size_t> sample_sizes_ ABSL_GUARDED_BY(mu_);
+  bool ready_ ABSL_GUARDED_BY(mu_) = false;
+  bool terminating_ ABSL_GUARDED_BY(mu_) = false;
+
+  // It is important that thread_ be last, as the new thread runs with 'this' and may access any
+  // other members.
+  Thread::ThreadPtr thread_;
+};
+
+using ZstdDictionaryTrainerPtr = std::unique_ptr<ZstdDictionaryTrainer>;
+
+} // namespace Compressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -1,5 +1,7 @@
 #include "source/extensions/compression/zstd/compressor/zstd_compressor_impl.h"
 
+#include <algorithm>
+
 namespace Envoy {
 namespace Extensions {
 namespace Compression {
@@ -8,21 +10,61 @@ namespace Compressor {
 
 ZstdCompressorImpl::ZstdCompressorImpl(uint32_t compression_level, bool enable_checksum,
                                        uint32_t strategy, const ZstdCDictManagerPtr& cdict_manager,
-                                       uint32_t chunk_size)
+                                       uint32_t chunk_size,
+                                       ZstdDictionaryTrainer* dictionary_trainer)
     : ZstdCompressorImplBase(compression_level, enable_checksum, strategy, chunk_size),
-      cdict_manager_(cdict_manager) {
-  size_t result;
+      cdict_manager_(cdict_manager), dictionary_trainer_(dictionary_trainer) {
+  // The level is superseded by the dictionary's, but is needed while a dictionary manager that
+  // only gets trained dictionaries has none yet.
+  const size_t result =
+      ZSTD_CCtx_setParameter(cctx_.get(), ZSTD_c_compressionLevel, compression_level_);
+  RELEASE_ASSERT(!ZSTD_isError(result), "");
+  if (cdict_manager_) {
+    refDictionary();
+  }
+}
+
+void ZstdCompressorImpl::reset() {
+  // Only the session is reset, so the parameters and the allocated workspace are kept.
+  const size_t result = ZSTD_CCtx_reset(cctx_.get(), ZSTD_reset_session_only);
+  RELEASE_ASSERT(!ZSTD_isError(result), "");
+  output_.pos = 0;
+  input_ = {nullptr, 0, 0};
+  sample_.clear();
   if (cdict_manager_) {
-    ZSTD_CDict* cdict = cdict_manager_->getFirstDictionary();
-    result = ZSTD_CCtx_refCDict(cctx_.get(), cdict);
-  } else {
-    result = ZSTD_CCtx_setParameter(cctx_.get(), ZSTD_c_compressionLevel, compression_level_);
+    // The dictionary may have been reloaded since the context was last used.
+    refDictionary();
   }
+}
+
+uint64_t ZstdCompressorImpl::memoryUsage() const {
+  return ZSTD_sizeof_CCtx(cctx_.get()) + output_.size + sample_.capacity();
+}
+
+void ZstdCompressorImpl::refDictionary() { useDictionary(cdict_manager_->getFirstDictionary()); }
+
+void ZstdCompressorImpl::useDictionary(ZSTD_CDict* cdict) {
+  const size_t result = ZSTD_CCtx_refCDict(cctx_.get(), cdict);
   RELEASE_ASSERT(!ZSTD_isError(result), "");
 }
 
-void ZstdCompressorImpl::compressPreprocess(Buffer::Instance&,
-                                            Envoy::Compression::Compressor::State) {}
+void ZstdCompressorImpl::compressPreprocess(Buffer::Instance& buffer,
+                                            Envoy::Compression::Compressor::State state) {
+  if (dictionary_trainer_ == nullptr || !dictionary_trainer_->wantsSamples()) {
+    return;
+  }
+  if (sample_.size() < dictionary_trainer_->maxSampleBytes()) {
+    const uint64_t length = std::min<uint64_t>(
+        buffer.length(), dictionary_trainer_->maxSampleBytes() - sample_.size());
+    const size_t offset = sample_.size();
+    sample_.resize(offset + length);
+    buffer.copyOut(0, length, sample_.data() + offset);
+  }
+  if (state == Envoy::Compression::Compressor::State::Finish) {
+    dictionary_trainer_->addSample(sample_);
+    sample_.clear();
+  }
+}
 
 void ZstdCompressorImpl::compressProcess(const Buffer::Instance&,
                                          const Buffer::RawSlice& input_slice,
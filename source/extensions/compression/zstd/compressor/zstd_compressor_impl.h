@@ -5,6 +5,7 @@
 #include "source/common/compression/zstd/common/base.h"
 #include "source/common/compression/zstd/compressor/zstd_compressor_impl_base.h"
 #include "source/extensions/compression/zstd/common/dictionary_manager.h"
+#include "source/extensions/compression/zstd/compressor/dictionary_trainer.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -22,9 +23,30 @@ using ZstdCDictManagerPtr = std::unique_ptr<ZstdCDictManager>;
 class ZstdCompressorImpl : public Envoy::Compression::Zstd::Compressor::ZstdCompressorImplBase {
 public:
   ZstdCompressorImpl(uint32_t compression_level, bool enable_checksum, uint32_t strategy,
-                     const ZstdCDictManagerPtr& cdict_manager, uint32_t chunk_size);
+                     const ZstdCDictManagerPtr& cdict_manager, uint32_t chunk_size,
+                     ZstdDictionaryTrainer* dictionary_trainer = nullptr);
+
+  /**
+   * Prepares the compressor for a new stream, keeping its parameters and the memory of its
+   * context. @see Common::Compressor::CompressorPool.
+   */
+  void reset();
+
+  /**
+   * @return the approximate number of bytes held by the compressor.
+   */
+  uint64_t memoryUsage() const;
+
+  /**
+   * Compresses the stream with the given dictionary instead of the dictionary manager's first
+   * one. Must be called before the stream is compressed, and again after each reset().
+   * @param cdict the dictionary, or nullptr to compress without a dictionary.
+   */
+  void useDictionary(ZSTD_CDict* cdict);
 
 private:
+  void refDictionary();
+
   void compressPreprocess(Buffer::Instance& buffer,
                           Envoy::Compression::Compressor::State state) override;
 
@@ -34,6 +56,9 @@ private:
   void compressPostprocess(Buffer::Instance& accumulation_buffer) override;
 
   const ZstdCDictManagerPtr& cdict_manager_;
+  // If set, the leading bytes of each stream are sampled for training a dictionary.
+  ZstdDictionaryTrainer* const dictionary_trainer_;
+  std::string sample_;
 };
 
 } // namespace Compressor
@@ -4,6 +4,7 @@ EXTENSIONS = {
     # Access loggers
     #
 
+    "envoy.access_loggers.columnar_file":               "//source/extensions/access_loggers/columnar_file:config",
     "envoy.access_loggers.file":                        "//source/extensions/access_loggers/file:config",
     "envoy.access_loggers.extension_filters.cel":       "//source/extensions/access_loggers/filters/cel:config",
     "envoy.access_loggers.fluentd"  :                   "//source/extensions/access_loggers/fluentd:config",
@@ -343,7 +344,9 @@ EXTENSIONS = {
     # CacheFilter plugins
     #
     "envoy.extensions.http.cache.file_system_http_cache": "//source/extensions/http/cache/file_system_http_cache:config",
+    "envoy.extensions.http.cache.memory_http_cache": "//source/extensions/http/cache/memory_http_cache:config",
     "envoy.extensions.http.cache.simple":               "//source/extensions/http/cache/simple_http_cache:config",
+    "envoy.extensions.http.cache.tiered_http_cache": "//source/extensions/http/cache/tiered_http_cache:config",
 
     #
     # Internal redirect predicates
@@ -395,6 +398,12 @@ EXTENSIONS = {
 
     "envoy.tls.cert_validator.spiffe":                  "//source/extensions/transport_sockets/tls/cert_validator/spiffe:config",
 
+    #
+    # TLS private key providers
+    #
+
+    "envoy.tls.key_providers.thread_pool":              "//source/extensions/private_key_providers/thread_pool:config",
+
     #
     # HTTP header formatters
     #
@@ -1,10 +1,12 @@
 #include "source/extensions/filters/http/cache/cache_filter.h"
 
 #include "envoy/http/header_map.h"
+#include "envoy/singleton/manager.h"
 
 #include "source/common/common/enum_to_int.h"
 #include "source/common/http/headers.h"
 #include "source/common/http/utility.h"
+#include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/cache/cache_custom_headers.h"
 #include "source/extensions/filters/http/cache/cache_entry_utils.h"
 #include "source/extensions/filters/http/cache/cache_filter_logging_info.h"
@@ -38,12 +40,22 @@ struct CacheResponseCodeDetailValues {
 
 using CacheResponseCodeDetails = ConstSingleton<CacheResponseCodeDetailValues>;
 
+SINGLETON_MANAGER_REGISTRATION(cache_miss_coalescer);
+
 CacheFilterConfig::CacheFilterConfig(
     const envoy::extensions::filters::http::cache::v3::CacheConfig& config,
     Server::Configuration::CommonFactoryContext& context)
     : vary_allow_list_(config.allowed_vary_headers(), context), time_source_(context.timeSource()),
       ignore_request_cache_control_header_(config.ignore_request_cache_control_header()),
-      cluster_manager_(context.clusterManager()) {}
+      miss_coalescing_timeout_(PROTOBUF_GET_MS_OR_DEFAULT(config, miss_coalescing_timeout, 0)),
+      cluster_manager_(context.clusterManager()) {
+  if (config.has_miss_coalescing_timeout()) {
+    // Shared by all filter configs, so that misses are coalesced across listeners too.
+    miss_coalescer_ = context.singletonManager().getTyped<MissCoalescer>(
+        SINGLETON_MANAGER_REGISTERED_NAME(cache_miss_coalescer),
+        [] { return std::make_shared<MissCoalescer>(); });
+  }
+}
 
 CacheFilter::CacheFilter(std::shared_ptr<const CacheFilterConfig> config,
                          std::shared_ptr<HttpCache> http_cache)
@@ -51,6 +63,9 @@ CacheFilter::CacheFilter(std::shared_ptr<const CacheFilterConfig> config,
 
 void CacheFilter::onDestroy() {
   filter_state_ = FilterState::Destroyed;
+  miss_follower_ = nullptr;
+  miss_coalescing_timer_ = nullptr;
+  miss_leader_ = nullptr;
   if (lookup_ != nullptr) {
     lookup_->onDestroy();
   }
@@ -127,6 +142,9 @@ Http::FilterHeadersStatus CacheFilter::decodeHeaders(Http::RequestHeaderMap& hea
                                config_->ignoreRequestCacheControlHeader());
   request_allows_inserts_ = !lookup_request.requestCacheControl().no_store_;
   is_head_request_ = headers.getMethodValue() == Http::Headers::get().MethodValues.Head;
+  if (config_->missCoalescer() != nullptr) {
+    miss_key_ = lookup_request.key();
+  }
   lookup_ = cache_->makeLookupContext(std::move(lookup_request), *decoder_callbacks_);
 
   ASSERT(lookup_);
@@ -137,6 +155,57 @@ Http::FilterHeadersStatus CacheFilter::decodeHeaders(Http::RequestHeaderMap& hea
   return Http::FilterHeadersStatus::StopAllIterationAndWatermark;
 }
 
+bool CacheFilter::waitForCoalescedMiss(Http::RequestHeaderMap& request_headers) {
+  MissCoalescer* coalescer = config_->missCoalescer();
+  // A request that won't insert its response can't be waited for, so it doesn't take part.
+  if (coalescer == nullptr || miss_coalesced_ || !request_allows_inserts_ || is_head_request_) {
+    return false;
+  }
+  miss_coalesced_ = true;
+  MissCoalescer::JoinResult result =
+      coalescer->join(*cache_, miss_key_, decoder_callbacks_->dispatcher(),
+                      [this, &request_headers](bool inserted) {
+                        onCoalescedMissReleased(request_headers, inserted);
+                      });
+  if (result.follower_ == nullptr) {
+    miss_leader_ = std::move(result.leader_);
+    return false;
+  }
+  ENVOY_STREAM_LOG(debug, "CacheFilter waiting for a coalesced cache miss", *decoder_callbacks_);
+  miss_follower_ = std::move(result.follower_);
+  miss_coalescing_timer_ = decoder_callbacks_->dispatcher().createTimer([this, &request_headers] {
+    ENVOY_STREAM_LOG(debug, "CacheFilter timed out waiting for a coalesced cache miss",
+                     *decoder_callbacks_);
+    miss_follower_ = nullptr;
+    sendUpstreamRequest(request_headers);
+  });
+  miss_coalescing_timer_->enableTimer(config_->missCoalescingTimeout());
+  return true;
+}
+
+void CacheFilter::onCoalescedMissReleased(Http::RequestHeaderMap& request_headers,
+                                          bool inserted) {
+  miss_follower_ = nullptr;
+  miss_coalescing_timer_ = nullptr;
+  if (!inserted) {
+    ENVOY_STREAM_LOG(debug, "CacheFilter coalesced cache miss was not inserted",
+                     *decoder_callbacks_);
+    sendUpstreamRequest(request_headers);
+    return;
+  }
+  // Look the response up again, now that it has been inserted. If it is still a miss, e.g.
+  // because it varies on a header that differs between the requests, this request is forwarded
+  // upstream.
+  lookup_->onDestroy();
+  lookup_result_ = nullptr;
+  cache_entry_status_ = absl::nullopt;
+  lookup_ = cache_->makeLookupContext(
+      LookupRequest(request_headers, config_->timeSource().systemTime(), config_->varyAllowList(),
+                    config_->ignoreRequestCacheControlHeader()),
+      *decoder_callbacks_);
+  getHeaders(request_headers);
+}
+
 void CacheFilter::onUpstreamRequestComplete() { upstream_request_ = nullptr; }
 
 void CacheFilter::onUpstreamRequestReset() {
@@ -157,6 +226,14 @@ Http::FilterHeadersStatus CacheFilter::encodeHeaders(Http::ResponseHeaderMap& he
     return Http::FilterHeadersStatus::Continue;
   }
 
+  if (miss_follower_ != nullptr) {
+    // A local reply was generated while waiting for a coalesced cache miss.
+    miss_follower_ = nullptr;
+    miss_coalescing_timer_ = nullptr;
+    filter_state_ = FilterState::NotServingFromCache;
+    return Http::FilterHeadersStatus::Continue;
+  }
+
   if (lookup_result_ == nullptr) {
     // Filter chain iteration is paused while a lookup is outstanding, but the filter chain manager
     // can still generate a local reply. One case where this can happen is when a downstream idle
@@ -327,6 +404,9 @@ void CacheFilter::onHeaders(LookupResult&& result, Http::RequestHeaderMap& reque
     handleCacheHit(/* end_stream_after_headers = */ end_stream);
     return;
   case CacheEntryStatus::Unusable:
+    if (waitForCoalescedMiss(request_headers)) {
+      return;
+    }
     sendUpstreamRequest(request_headers);
     return;
   case CacheEntryStatus::LookupError:
@@ -10,6 +10,7 @@
 #include "source/extensions/filters/http/cache/cache_headers_utils.h"
 #include "source/extensions/filters/http/cache/filter_state.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/filters/http/cache/miss_coalescer.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
 
 namespace Envoy {
@@ -30,11 +31,16 @@ public:
   const Http::AsyncClient::StreamOptions& upstreamOptions() const { return upstream_options_; }
   Upstream::ClusterManager& clusterManager() const { return cluster_manager_; }
   bool ignoreRequestCacheControlHeader() const { return ignore_request_cache_control_header_; }
+  // Null if cache misses are not coalesced.
+  MissCoalescer* missCoalescer() const { return miss_coalescer_.get(); }
+  std::chrono::milliseconds missCoalescingTimeout() const { return miss_coalescing_timeout_; }
 
 private:
   const VaryAllowList vary_allow_list_;
   TimeSource& time_source_;
   const bool ignore_request_cache_control_header_;
+  std::shared_ptr<MissCoalescer> miss_coalescer_;
+  const std::chrono::milliseconds miss_coalescing_timeout_;
   Upstream::ClusterManager& cluster_manager_;
   Http::AsyncClient::StreamOptions upstream_options_;
 };
@@ -74,6 +80,16 @@ private:
   // send a 503 locally.
   void sendNoClusterResponse(absl::string_view cluster_name);
 
+  // For a cache miss that may be cacheable, waits for another request that missed the same key to
+  // insert its response, if misses are coalesced and there is such a request. Otherwise, if this
+  // request is the first to miss, sets miss_leader_.
+  // Returns true if the request is waiting.
+  bool waitForCoalescedMiss(Http::RequestHeaderMap& request_headers);
+
+  // Called when the request that this one waited for has finished or failed inserting its response,
+  // or the wait has timed out.
+  void onCoalescedMissReleased(Http::RequestHeaderMap& request_headers, bool inserted);
+
   // Called by UpstreamRequest if it is reset before CacheFilter is destroyed.
   // CacheFilter must make no more calls to upstream_request_ once this has been called.
   void onUpstreamRequestReset();
@@ -157,6 +173,16 @@ private:
   FilterState filter_state_ = FilterState::Initial;
 
   bool is_head_request_ = false;
+  // The lookup key of the request, only kept if misses are coalesced.
+  Key miss_key_;
+  // Set if this request is the first of the coalesced misses for its key, until it is handed to the
+  // UpstreamRequest.
+  CoalescedMissLeaderPtr miss_leader_;
+  // Set while this request waits for another request that missed the same key.
+  CoalescedMissFollowerPtr miss_follower_;
+  Event::TimerPtr miss_coalescing_timer_;
+  // True once the request has joined a coalesced miss, so that it only waits once.
+  bool miss_coalesced_ = false;
   // This toggle is used to detect callbacks being called directly and not posted.
   bool callback_called_directly_ = false;
   // The status of the insert operation or header update, or decision not to insert or update.
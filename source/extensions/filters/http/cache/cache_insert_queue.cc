@@ -186,6 +186,10 @@ void CacheInsertQueue::onFragmentComplete(bool cache_success, bool end_stream, s
   if (end_stream) {
     ASSERT(fragments_.empty(), "ending a stream with the queue not empty is a bug");
     ASSERT(!watermarked_, "being over the high watermark when the queue is empty makes no sense");
+    if (miss_leader_ != nullptr) {
+      miss_leader_->setInserted();
+      miss_leader_ = nullptr;
+    }
     self_ownership_.reset();
     return;
   }
@@ -4,6 +4,7 @@
 #include <functional>
 
 #include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/filters/http/cache/miss_coalescer.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -46,6 +47,8 @@ public:
   void insertBody(const Buffer::Instance& fragment, bool end_stream);
   void insertTrailers(const Http::ResponseTrailerMap& trailers);
   void setSelfOwned(std::unique_ptr<CacheInsertQueue> self);
+  // Keeps the requests waiting for this response until it has been inserted, or the insert fails.
+  void setCoalescedMissLeader(CoalescedMissLeaderPtr leader) { miss_leader_ = std::move(leader); }
   ~CacheInsertQueue();
 
 private:
@@ -81,6 +84,9 @@ private:
   // while a cache action is still in flight, which can cause the cache to be
   // deleted prematurely.
   std::shared_ptr<HttpCache> cache_;
+  // Destroyed, releasing the requests waiting for the response, when the insert completes or the
+  // queue is destroyed.
+  CoalescedMissLeaderPtr miss_leader_;
 };
 
 } // namespace Cache
@@ -0,0 +1,102 @@
+#include "source/extensions/filters/http/cache/miss_coalescer.h"
+
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+struct InFlightMiss {
+  struct Waiter {
+    Event::Dispatcher& dispatcher_;
+    MissCoalescer::ReleaseCallback on_release_;
+    // Shared with the CoalescedMissFollower, and only accessed on the waiter's dispatcher.
+    std::shared_ptr<bool> cancelled_;
+  };
+
+  InFlightMiss(const HttpCache& cache, uint64_t hash, const Key& key)
+      : cache_(cache), hash_(hash), key_(key) {}
+
+  const HttpCache& cache_;
+  const uint64_t hash_;
+  const Key key_;
+  // Guarded by MissCoalescer::mutex_.
+  std::list<Waiter> waiters_;
+  bool released_ = false;
+};
+
+CoalescedMissLeader::CoalescedMissLeader(std::shared_ptr<MissCoalescer> coalescer,
+                                         std::shared_ptr<InFlightMiss> miss)
+    : coalescer_(std::move(coalescer)), miss_(std::move(miss)) {}
+
+CoalescedMissLeader::~CoalescedMissLeader() { coalescer_->release(*miss_, inserted_); }
+
+CoalescedMissFollower::CoalescedMissFollower(std::shared_ptr<MissCoalescer> coalescer,
+                                             std::shared_ptr<InFlightMiss> miss,
+                                             std::shared_ptr<bool> cancelled)
+    : coalescer_(std::move(coalescer)), miss_(std::move(miss)), cancelled_(std::move(cancelled)) {}
+
+CoalescedMissFollower::~CoalescedMissFollower() {
+  *cancelled_ = true;
+  coalescer_->unfollow(*miss_, cancelled_);
+}
+
+MissCoalescer::JoinResult MissCoalescer::join(const HttpCache& cache, const Key& key,
+                                              Event::Dispatcher& dispatcher,
+                                              ReleaseCallback on_release) {
+  const uint64_t hash = stableHashKey(key);
+  JoinResult result;
+  absl::MutexLock lock(&mutex_);
+  auto [it, inserted] = in_flight_.try_emplace(MissMapKey{&cache, hash});
+  if (inserted) {
+    it->second = std::make_shared<InFlightMiss>(cache, hash, key);
+    result.leader_ = std::make_unique<CoalescedMissLeader>(shared_from_this(), it->second);
+    return result;
+  }
+  if (!Protobuf::util::MessageDifferencer::Equals(it->second->key_, key)) {
+    return result;
+  }
+  auto cancelled = std::make_shared<bool>(false);
+  it->second->waiters_.push_back(
+      InFlightMiss::Waiter{dispatcher, std::move(on_release), cancelled});
+  result.follower_ =
+      std::make_unique<CoalescedMissFollower>(shared_from_this(), it->second, std::move(cancelled));
+  return result;
+}
+
+void MissCoalescer::release(InFlightMiss& miss, bool inserted) {
+  std::list<InFlightMiss::Waiter> waiters;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = in_flight_.find(MissMapKey{&miss.cache_, miss.hash_});
+    if (it != in_flight_.end() && it->second.get() == &miss) {
+      in_flight_.erase(it);
+    }
+    miss.released_ = true;
+    waiters = std::move(miss.waiters_);
+  }
+  for (InFlightMiss::Waiter& waiter : waiters) {
+    waiter.dispatcher_.post([on_release = std::move(waiter.on_release_),
+                             cancelled = std::move(waiter.cancelled_), inserted]() mutable {
+      if (!*cancelled) {
+        std::move(on_release)(inserted);
+      }
+    });
+  }
+}
+
+void MissCoalescer::unfollow(InFlightMiss& miss, const std::shared_ptr<bool>& cancelled) {
+  absl::MutexLock lock(&mutex_);
+  if (miss.released_) {
+    // The release has already been posted, and will see that the follower is cancelled.
+    return;
+  }
+  miss.waiters_.remove_if(
+      [&cancelled](const InFlightMiss::Waiter& waiter) { return waiter.cancelled_ == cancelled; });
+}
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <list>
+#include <memory>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/singleton/instance.h"
+
+#include "source/extensions/filters/http/cache/http_cache.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+class MissCoalescer;
+struct InFlightMiss;
+
+// Held by the request that is forwarded upstream for a coalesced cache miss, until its response
+// has been inserted into the cache or it is known that it won't be. Destroying it releases the
+// requests waiting for it.
+class CoalescedMissLeader {
+public:
+  CoalescedMissLeader(std::shared_ptr<MissCoalescer> coalescer,
+                      std::shared_ptr<InFlightMiss> miss);
+  ~CoalescedMissLeader();
+
+  // Marks the response as inserted, so that the waiting requests look it up in the cache rather
+  // than going upstream themselves.
+  void setInserted() { inserted_ = true; }
+
+private:
+  const std::shared_ptr<MissCoalescer> coalescer_;
+  const std::shared_ptr<InFlightMiss> miss_;
+  bool inserted_ = false;
+};
+using CoalescedMissLeaderPtr = std::unique_ptr<CoalescedMissLeader>;
+
+// Held by a request waiting for a CoalescedMissLeader. Destroying it stops waiting; the release
+// callback is not called after that.
+class CoalescedMissFollower {
+public:
+  CoalescedMissFollower(std::shared_ptr<MissCoalescer> coalescer,
+                        std::shared_ptr<InFlightMiss> miss, std::shared_ptr<bool> cancelled);
+  ~CoalescedMissFollower();
+
+private:
+  const std::shared_ptr<MissCoalescer> coalescer_;
+  const std::shared_ptr<InFlightMiss> miss_;
+  const std::shared_ptr<bool> cancelled_;
+};
+using CoalescedMissFollowerPtr = std::unique_ptr<CoalescedMissFollower>;
+
+/**
+ * Coalesces concurrent cache misses for the same key, across all workers, so that only the first
+ * of them is forwarded upstream. The others wait for its response to be inserted into the cache.
+ * There is one MissCoalescer per server; misses are only coalesced with others in the same cache.
+ */
+class MissCoalescer : public Singleton::Instance,
+                      public std::enable_shared_from_this<MissCoalescer> {
+public:
+  // Called on the waiting request's dispatcher when the leader is destroyed, with true if the
+  // leader's response was inserted into the cache.
+  using ReleaseCallback = absl::AnyInvocable<void(bool inserted)>;
+
+  struct JoinResult {
+    // Set if no other request for the key is in flight; the request should be forwarded upstream.
+    CoalescedMissLeaderPtr leader_;
+    // Set if the request waits for another one.
+    CoalescedMissFollowerPtr follower_;
+  };
+
+  /**
+   * Joins the in-flight miss for the key in the cache, or starts one. If neither handle in the
+   * result is set, the key collided with a different one in flight, and the request should be
+   * forwarded upstream without coalescing.
+   * @param on_release called, posted to dispatcher, when the request should stop waiting. Only
+   *        used if the request becomes a follower.
+   */
+  JoinResult join(const HttpCache& cache, const Key& key, Event::Dispatcher& dispatcher,
+                  ReleaseCallback on_release);
+
+private:
+  friend class CoalescedMissLeader;
+  friend class CoalescedMissFollower;
+
+  using MissMapKey = std::pair<const HttpCache*, uint64_t>;
+
+  void release(InFlightMiss& miss, bool inserted);
+  void unfollow(InFlightMiss& miss, const std::shared_ptr<bool>& cancelled);
+
+  absl::Mutex mutex_;
+  absl::flat_hash_map<MissMapKey, std::shared_ptr<InFlightMiss>> in_flight_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -129,7 +129,7 @@ UpstreamRequest::UpstreamRequest(CacheFilter* filter, LookupContextPtr lookup,
       is_head_request_(filter->is_head_request_),
       request_allows_inserts_(filter->request_allows_inserts_), config_(filter->config_),
       filter_state_(filter->filter_state_), cache_(std::move(cache)),
-      stream_(async_client.start(*this, options)) {
+      miss_leader_(std::move(filter->miss_leader_)), stream_(async_client.start(*this, options)) {
   ASSERT(stream_ != nullptr);
 }
 
@@ -215,6 +215,7 @@ void UpstreamRequest::onHeaders(Http::ResponseHeaderMapPtr&& headers, bool end_s
       // of itself and all the callbacks are cancelled, so they are also filter-destruction-safe.
       insert_queue_ = std::make_unique<CacheInsertQueue>(cache_, *filter_->encoder_callbacks_,
                                                          std::move(insert_context), *this);
+      insert_queue_->setCoalescedMissLeader(std::move(miss_leader_));
       // Add metadata associated with the cached response. Right now this is only response_time;
       const ResponseMetadata metadata = {config_->timeSource().systemTime()};
       insert_queue_->insertHeaders(*headers, metadata, end_stream);
@@ -227,6 +228,9 @@ void UpstreamRequest::onHeaders(Http::ResponseHeaderMapPtr&& headers, bool end_s
   } else {
     setInsertStatus(InsertStatus::NoInsertResponseNotCacheable);
   }
+  // If the response is not being inserted, release the requests waiting for it now rather than
+  // when the upstream response completes.
+  miss_leader_ = nullptr;
   setFilterState(FilterState::NotServingFromCache);
   if (filter_) {
     filter_->decoder_callbacks_->encodeHeaders(std::move(headers), is_head_request_ || end_stream,
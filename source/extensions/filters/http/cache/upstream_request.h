@@ -3,6 +3,7 @@
 #include "source/common/common/logger.h"
 #include "source/extensions/filters/http/cache/cache_filter_logging_info.h"
 #include "source/extensions/filters/http/cache/cache_insert_queue.h"
+#include "source/extensions/filters/http/cache/miss_coalescer.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -74,6 +75,9 @@ private:
   std::shared_ptr<const CacheFilterConfig> config_;
   FilterState filter_state_;
   std::shared_ptr<HttpCache> cache_;
+  // Set if other requests wait for this one to insert its response; handed to the insert queue if
+  // the response is inserted.
+  CoalescedMissLeaderPtr miss_leader_;
   Http::AsyncClient::Stream* stream_ = nullptr;
   std::unique_ptr<CacheInsertQueue> insert_queue_;
 };
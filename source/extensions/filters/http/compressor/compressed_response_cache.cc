@@ -0,0 +1,58 @@
+#include "source/extensions/filters/http/compressor/compressed_response_cache.h"
+
+#include <iterator>
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Compressor {
+
+CompressedResponseCache::CompressedResponseCache(uint64_t max_cache_size_bytes,
+                                                 uint32_t max_body_bytes)
+    : max_cache_size_bytes_(max_cache_size_bytes), max_body_bytes_(max_body_bytes) {}
+
+std::shared_ptr<const std::string> CompressedResponseCache::lookup(absl::string_view digest) {
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(digest);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->compressed_body_;
+}
+
+void CompressedResponseCache::insert(absl::string_view digest,
+                                     std::shared_ptr<const std::string> compressed_body) {
+  Entry entry{std::string(digest), std::move(compressed_body)};
+  const uint64_t size = entrySize(entry);
+  if (size > max_cache_size_bytes_) {
+    return;
+  }
+  absl::MutexLock lock(&mutex_);
+  // Another worker may have compressed the same body concurrently.
+  if (auto it = entries_.find(digest); it != entries_.end()) {
+    eraseLocked(it->second);
+  }
+  while (size_bytes_ + size > max_cache_size_bytes_) {
+    eraseLocked(std::prev(lru_.end()));
+  }
+  lru_.push_front(std::move(entry));
+  entries_.emplace(lru_.front().digest_, lru_.begin());
+  size_bytes_ += size;
+}
+
+uint64_t CompressedResponseCache::sizeBytes() const {
+  absl::MutexLock lock(&mutex_);
+  return size_bytes_;
+}
+
+void CompressedResponseCache::eraseLocked(EntryList::iterator it) {
+  size_bytes_ -= entrySize(*it);
+  entries_.erase(it->digest_);
+  lru_.erase(it);
+}
+
+} // namespace Compressor
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Compressor {
+
+/**
+ * A least-recently-used cache of compressed response bodies keyed by a digest of the
+ * uncompressed body, bounded by the total size of the compressed bodies. It is shared by all
+ * worker threads, so a body that repeats byte for byte is compressed once.
+ */
+class CompressedResponseCache {
+public:
+  /**
+   * @param max_cache_size_bytes the maximum total size of the cached compressed bodies.
+   * @param max_body_bytes the largest uncompressed body that should be cached.
+   */
+  CompressedResponseCache(uint64_t max_cache_size_bytes, uint32_t max_body_bytes);
+
+  /**
+   * @return the largest uncompressed body that should be cached.
+   */
+  uint32_t maxBodyBytes() const { return max_body_bytes_; }
+
+  /**
+   * @param digest the digest of the uncompressed body.
+   * @return the compressed body, or nullptr if it is not in the cache.
+   */
+  std::shared_ptr<const std::string> lookup(absl::string_view digest);
+
+  /**
+   * Adds a compressed body to the cache, evicting the least recently used bodies to make room.
+   * @param digest the digest of the uncompressed body.
+   * @param compressed_body the compressed body.
+   */
+  void insert(absl::string_view digest, std::shared_ptr<const std::string> compressed_body);
+
+  /**
+   * @return the total size of the cached bodies and their digests.
+   */
+  uint64_t sizeBytes() const;
+
+private:
+  struct Entry {
+    const std::string digest_;
+    const std::shared_ptr<const std::string> compressed_body_;
+  };
+  using EntryList = std::list<Entry>;
+
+  static uint64_t entrySize(const Entry& entry) {
+    return entry.digest_.size() + entry.compressed_body_->size();
+  }
+  void eraseLocked(EntryList::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const uint64_t max_cache_size_bytes_;
+  const uint32_t max_body_bytes_;
+  mutable absl::Mutex mutex_;
+  // Most recently used first.
+  EntryList lru_ ABSL_GUARDED_BY(mutex_);
+  // Keys are views of the digests owned by the entries in lru_.
+  absl::flat_hash_map<absl::string_view, EntryList::iterator> entries_ ABSL_GUARDED_BY(mutex_);
+  uint64_t size_bytes_ ABSL_GUARDED_BY(mutex_){0};
+};
+
+using CompressedResponseCachePtr = std::unique_ptr<CompressedResponseCache>;
+
+} // namespace Compressor
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -3,11 +3,15 @@
 #include <cstdint>
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/base64.h"
+#include "source/common/crypto/utility.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/utility.h"
 #include "source/common/protobuf/protobuf.h"
 
 #include "absl/container/flat_hash_set.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -21,6 +25,8 @@ using envoy::extensions::filters::http::compressor::v3::CompressorPerRoute;
 
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
     accept_encoding_handle(Http::CustomHeaders::get().AcceptEncoding);
+Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
+    available_dictionary_handle(Http::CustomHeaders::get().AvailableDictionary);
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::ResponseHeaders>
     cache_control_handle(Http::CustomHeaders::get().CacheControl);
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::ResponseHeaders>
@@ -36,6 +42,19 @@ Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::Respons
 // Default minimum length of an upstream response that allows compression.
 const uint64_t DefaultMinimumContentLength = 30;
 
+// Default largest uncompressed response body kept in the compressed response cache.
+const uint32_t DefaultMaxCachedBodyBytes = 65536;
+
+// Returns the hash in the value of an Available-Dictionary request header, which is a structured
+// field byte sequence such as ":<base64>:", see RFC 9842. An invalid value returns an empty hash.
+std::string availableDictionaryHash(absl::string_view value) {
+  value = StringUtil::trim(value);
+  if (value.size() < 2 || value.front() != ':' || value.back() != ':') {
+    return "";
+  }
+  return Base64::decode(value.substr(1, value.size() - 2));
+}
+
 // Default content types will be used if any is provided by the user.
 const std::vector<std::string>& defaultContentEncoding() {
   CONSTRUCT_ON_FIRST_USE(std::vector<std::string>, {"text/html",
@@ -77,6 +96,17 @@ void compressAndUpdateStats(const Compression::Compressor::CompressorPtr& compre
   stats.total_compressed_bytes_.add(data.length());
 }
 
+CompressedResponseCachePtr compressedResponseCache(
+    const envoy::extensions::filters::http::compressor::v3::Compressor& proto_config) {
+  if (!proto_config.response_direction_config().has_compressed_response_cache()) {
+    return nullptr;
+  }
+  const auto& cache_config = proto_config.response_direction_config().compressed_response_cache();
+  return std::make_unique<CompressedResponseCache>(
+      cache_config.max_cache_size_bytes(),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(cache_config, max_body_bytes, DefaultMaxCachedBodyBytes));
+}
+
 } // namespace
 
 CompressorFilterConfig::DirectionConfig::DirectionConfig(
@@ -142,7 +172,8 @@ CompressorFilterConfig::ResponseDirectionConfig::ResponseDirectionConfig(
               : proto_config.remove_accept_encoding_header()),
       uncompressible_response_codes_(uncompressibleResponseCodesSet(
           proto_config.response_direction_config().uncompressible_response_codes())),
-      response_stats_{generateResponseStats(stats_prefix, scope)} {}
+      response_stats_{generateResponseStats(stats_prefix, scope)},
+      compressed_response_cache_(compressedResponseCache(proto_config)) {}
 
 const envoy::extensions::filters::http::compressor::v3::Compressor::CommonDirectionConfig
 CompressorFilterConfig::ResponseDirectionConfig::commonConfig(
@@ -171,8 +202,12 @@ CompressorFilterConfig::ResponseDirectionConfig::commonConfig(
   return config;
 }
 
-Envoy::Compression::Compressor::CompressorPtr CompressorFilterConfig::makeCompressor() {
-  return compressor_factory_->createCompressor();
+Envoy::Compression::Compressor::CompressorPtr
+CompressorFilterConfig::makeCompressor(absl::string_view dictionary_hash) {
+  if (dictionary_hash.empty()) {
+    return compressor_factory_->createCompressor();
+  }
+  return compressor_factory_->createCompressorForDictionary(dictionary_hash);
 }
 
 CompressorFilter::CompressorFilter(const CompressorFilterConfigSharedPtr config)
@@ -212,6 +247,12 @@ Http::FilterHeadersStatus CompressorFilter::decodeHeaders(Http::RequestHeaderMap
     // decision on compressing the corresponding HTTP response.
     accept_encoding_ = std::make_unique<std::string>(accept_encoding->value().getStringView());
   }
+  const Http::HeaderEntry* available_dictionary =
+      headers.getInline(available_dictionary_handle.handle());
+  if (available_dictionary != nullptr) {
+    // The compressor only uses a dictionary of its own for the response if it is this one.
+    available_dictionary_ = availableDictionaryHash(available_dictionary->value().getStringView());
+  }
 
   const auto& response_config = config_->responseDirectionConfig();
   const auto* per_route_config =
@@ -315,12 +356,21 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeaders(Http::ResponseHeaderMa
       isResponseCodeCompressible(headers, config);
   if (!end_stream && isAcceptEncodingAllowed(isEnabledAndContentLengthBigEnough, headers) &&
       isCompressible && isTransferEncodingAllowed(headers)) {
+    const CompressedResponseCache* cache = config.compressedResponseCache();
+    uint64_t content_length;
+    if (cache != nullptr && headers.ContentLength() != nullptr &&
+        absl::SimpleAtoi(headers.getContentLengthValue(), &content_length) &&
+        content_length <= cache->maxBodyBytes()) {
+      // The compressor is only instantiated if the body is not found in the cache.
+      cacheable_response_body_ = std::make_unique<Buffer::OwnedImpl>();
+    } else {
+      // Finally instantiate the compressor.
+      response_compressor_ = config_->makeCompressor(available_dictionary_);
+    }
     sanitizeEtagHeader(headers);
     headers.removeContentLength();
     headers.setInline(response_content_encoding_handle.handle(), config_->contentEncoding());
     config.stats().compressed_.inc();
-    // Finally instantiate the compressor.
-    response_compressor_ = config_->makeCompressor();
   } else {
     config.stats().not_compressed_.inc();
   }
@@ -329,13 +379,33 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeaders(Http::ResponseHeaderMa
   // the Vary header would need to be inserted to let a caching proxy in front of Envoy
   // know that the requested resource still can be served with compression applied.
   if (isCompressible) {
-    insertVaryHeader(headers);
+    insertVaryHeader(headers, Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+    if (!available_dictionary_.empty()) {
+      // Whether the response could be compressed with a dictionary depends on this header too.
+      insertVaryHeader(headers, Http::CustomHeaders::get().VaryValues.AvailableDictionary);
+    }
   }
 
   return Http::FilterHeadersStatus::Continue;
 }
 
 Http::FilterDataStatus CompressorFilter::encodeData(Buffer::Instance& data, bool end_stream) {
+  if (cacheable_response_body_ != nullptr) {
+    CompressedResponseCache& cache = *config_->responseDirectionConfig().compressedResponseCache();
+    cacheable_response_body_->move(data);
+    // The Content-Length may understate the body, in which case it is compressed as it arrives.
+    const bool cacheable = cacheable_response_body_->length() <= cache.maxBodyBytes();
+    if (!end_stream && cacheable) {
+      return Http::FilterDataStatus::StopIterationNoBuffer;
+    }
+    data.move(*cacheable_response_body_);
+    cacheable_response_body_ = nullptr;
+    if (cacheable) {
+      compressWithCache(cache, data);
+      return Http::FilterDataStatus::Continue;
+    }
+    response_compressor_ = config_->makeCompressor(available_dictionary_);
+  }
   if (response_compressor_ != nullptr) {
     compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(), data,
                            end_stream);
@@ -344,18 +414,48 @@ Http::FilterDataStatus CompressorFilter::encodeData(Buffer::Instance& data, bool
 }
 
 Http::FilterTrailersStatus CompressorFilter::encodeTrailers(Http::ResponseTrailerMap&) {
+  Buffer::OwnedImpl body;
+  if (cacheable_response_body_ != nullptr) {
+    // A response with trailers is not cached; compress whatever body was buffered.
+    body.move(*cacheable_response_body_);
+    cacheable_response_body_ = nullptr;
+    response_compressor_ = config_->makeCompressor(available_dictionary_);
+  }
   if (response_compressor_ != nullptr) {
-    Buffer::OwnedImpl empty_buffer;
     // The presence of trailers means the stream is ended, but encodeData()
     // is never called with end_stream=true, thus let the compression library know
     // that the stream is ended.
     compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(),
-                           empty_buffer, true);
-    encoder_callbacks_->addEncodedData(empty_buffer, true);
+                           body, true);
+    encoder_callbacks_->addEncodedData(body, true);
   }
   return Http::FilterTrailersStatus::Continue;
 }
 
+void CompressorFilter::compressWithCache(CompressedResponseCache& cache, Buffer::Instance& data) {
+  const auto& config = config_->responseDirectionConfig();
+  const std::vector<uint8_t> digest_bytes =
+      Envoy::Common::Crypto::UtilitySingleton::get().getSha256Digest(data);
+  // A body compressed for a client that advertised a dictionary may have been compressed with
+  // it, so it is cached separately for each advertised dictionary.
+  const std::string key =
+      absl::StrCat(absl::string_view(reinterpret_cast<const char*>(digest_bytes.data()),
+                                     digest_bytes.size()),
+                   available_dictionary_);
+  if (std::shared_ptr<const std::string> compressed = cache.lookup(key); compressed != nullptr) {
+    config.responseStats().compressed_response_cache_hit_.inc();
+    config.stats().total_uncompressed_bytes_.add(data.length());
+    data.drain(data.length());
+    data.add(*compressed);
+    config.stats().total_compressed_bytes_.add(data.length());
+    return;
+  }
+  config.responseStats().compressed_response_cache_miss_.inc();
+  response_compressor_ = config_->makeCompressor(available_dictionary_);
+  compressAndUpdateStats(response_compressor_, config.stats(), data, true);
+  cache.insert(key, std::make_shared<const std::string>(data.toString()));
+}
+
 bool CompressorFilter::hasCacheControlNoTransform(Http::ResponseHeaderMap& headers) const {
   const Http::HeaderEntry* cache_control = headers.getInline(cache_control_handle.handle());
   if (cache_control) {
@@ -644,19 +744,17 @@ bool CompressorFilter::isTransferEncodingAllowed(Http::RequestOrResponseHeaderMa
   return true;
 }
 
-void CompressorFilter::insertVaryHeader(Http::ResponseHeaderMap& headers) {
+void CompressorFilter::insertVaryHeader(Http::ResponseHeaderMap& headers,
+                                        const std::string& value) {
   const Http::HeaderEntry* vary = headers.getInline(vary_handle.handle());
   if (vary != nullptr) {
-    if (!StringUtil::findToken(vary->value().getStringView(), ",",
-                               Http::CustomHeaders::get().VaryValues.AcceptEncoding, true)) {
+    if (!StringUtil::findToken(vary->value().getStringView(), ",", value, true)) {
       std::string new_header;
-      absl::StrAppend(&new_header, vary->value().getStringView(), ", ",
-                      Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+      absl::StrAppend(&new_header, vary->value().getStringView(), ", ", value);
       headers.setInline(vary_handle.handle(), new_header);
     }
   } else {
-    headers.setReferenceInline(vary_handle.handle(),
-                               Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+    headers.setReferenceInline(vary_handle.handle(), value);
   }
 }
 
@@ -7,6 +7,7 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/runtime/runtime_protos.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
+#include "source/extensions/filters/http/compressor/compressed_response_cache.h"
 
 #include "absl/types/optional.h"
 
@@ -39,6 +40,9 @@ namespace Compressor {
  *
  * "header_gzip" is specific to the gzip filter and is deprecated since it duplicates
  * "header_compressor_used".
+ *
+ * "compressed_response_cache_hit" and "compressed_response_cache_miss" count the compressed
+ * responses whose body was, or was not, found in the compressed response cache.
  */
 #define RESPONSE_COMPRESSOR_STATS(COUNTER)                                                         \
   COUNTER(no_accept_header)                                                                        \
@@ -47,7 +51,9 @@ namespace Compressor {
   COUNTER(header_compressor_overshadowed)                                                          \
   COUNTER(header_wildcard)                                                                         \
   COUNTER(header_not_valid)                                                                        \
-  COUNTER(not_compressed_etag)
+  COUNTER(not_compressed_etag)                                                                     \
+  COUNTER(compressed_response_cache_hit)                                                           \
+  COUNTER(compressed_response_cache_miss)
 
 /**
  * Struct definitions for compressor stats. @see stats_macros.h
@@ -123,6 +129,10 @@ public:
     bool removeAcceptEncodingHeader() const { return remove_accept_encoding_header_; }
     bool areAllResponseCodesCompressible() const;
     bool isResponseCodeCompressible(uint32_t response_code) const;
+    // The cache of compressed response bodies, or nullptr if it is not configured.
+    CompressedResponseCache* compressedResponseCache() const {
+      return compressed_response_cache_.get();
+    }
 
   private:
     static ResponseCompressorStats generateResponseStats(const std::string& prefix,
@@ -139,6 +149,7 @@ public:
     const bool remove_accept_encoding_header_;
     const absl::flat_hash_set<uint32_t> uncompressible_response_codes_;
     const ResponseCompressorStats response_stats_;
+    const CompressedResponseCachePtr compressed_response_cache_;
   };
 
   CompressorFilterConfig() = delete;
@@ -147,7 +158,12 @@ public:
       const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
       Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory);
 
-  Envoy::Compression::Compressor::CompressorPtr makeCompressor();
+  /**
+   * @param dictionary_hash the hash of the dictionary the client advertised, if any, @see
+   *        Envoy::Compression::Compressor::CompressorFactory::createCompressorForDictionary.
+   */
+  Envoy::Compression::Compressor::CompressorPtr
+  makeCompressor(absl::string_view dictionary_hash = {});
 
   const std::string contentEncoding() const { return content_encoding_; };
   bool chooseFirst() const { return choose_first_; };
@@ -211,7 +227,8 @@ private:
   bool isTransferEncodingAllowed(Http::RequestOrResponseHeaderMap& headers) const;
 
   void sanitizeEtagHeader(Http::ResponseHeaderMap& headers);
-  void insertVaryHeader(Http::ResponseHeaderMap& headers);
+  void compressWithCache(CompressedResponseCache& cache, Buffer::Instance& data);
+  void insertVaryHeader(Http::ResponseHeaderMap& headers, const std::string& value);
 
   class EncodingDecision : public StreamInfo::FilterState::Object {
   public:
@@ -235,9 +252,14 @@ private:
   bool shouldCompress(const EncodingDecision& decision) const;
 
   Envoy::Compression::Compressor::CompressorPtr response_compressor_;
+  // The response body buffered until the end of the stream, to compress it through the
+  // compressed response cache.
+  Buffer::InstancePtr cacheable_response_body_;
   Envoy::Compression::Compressor::CompressorPtr request_compressor_;
   const CompressorFilterConfigSharedPtr config_;
   std::unique_ptr<std::string> accept_encoding_;
+  // The hash of the dictionary advertised in the request's Available-Dictionary header, if any.
+  std::string available_dictionary_;
 };
 
 } // namespace Compressor
@@ -25,6 +25,10 @@ const size_t FileSystemHttpCache::max_update_headers_copy_chunk_size_ = 128 * 10
 const CacheStats& FileSystemHttpCache::stats() const { return shared_->stats_; }
 const ConfigProto& FileSystemHttpCache::config() const { return shared_->config_; }
 
+bool FileSystemHttpCache::shouldMapBodyRead(uint64_t length) const {
+  return config().has_mmap_read_min_bytes() && length >= config().mmap_read_min_bytes().value();
+}
+
 void FileSystemHttpCache::writeVaryNodeToDisk(Event::Dispatcher& dispatcher, const Key& key,
                                               const Http::ResponseHeaderMap& response_headers,
                                               std::shared_ptr<Cleanup> cleanup) {
@@ -88,6 +88,12 @@ public:
    */
   const ConfigProto& config() const;
 
+  /**
+   * @param length the number of body bytes a lookup is about to read.
+   * @return true if the read should map the cache file into memory rather than copy it.
+   */
+  bool shouldMapBodyRead(uint64_t length) const;
+
   /**
    * True if the given key currently has a stream writing to it.
    * @param key the key to check against entries_being_written_.
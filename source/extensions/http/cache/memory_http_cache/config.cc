@@ -0,0 +1,85 @@
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/http/cache/memory_http_cache/v3/memory_http_cache.pb.h"
+#include "envoy/extensions/http/cache/memory_http_cache/v3/memory_http_cache.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/memory_http_cache/memory_http_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace MemoryHttpCache {
+namespace {
+
+/**
+ * A singleton that acts as a factory for generating and looking up MemoryHttpCaches.
+ * When given configs with the same name, the singleton returns pointers to the same cache.
+ * If given configs with the same name but different configuration, an exception is thrown.
+ * The singleton is pinned, so that caches with the same name are shared even while no filter
+ * config holds the singleton.
+ */
+class CacheSingleton : public Envoy::Singleton::Instance {
+public:
+  std::shared_ptr<MemoryHttpCache> get(const ConfigProto& config, Stats::Scope& stats_scope) {
+    std::shared_ptr<MemoryHttpCache> cache;
+    absl::MutexLock lock(&mu_);
+    auto it = caches_.find(config.name());
+    if (it != caches_.end()) {
+      cache = it->second.lock();
+    }
+    if (!cache) {
+      cache = std::make_shared<MemoryHttpCache>(config, stats_scope);
+      caches_[config.name()] = cache;
+    } else if (!Protobuf::util::MessageDifferencer::Equals(cache->config(), config)) {
+      throw EnvoyException(
+          fmt::format("mismatched MemoryHttpCacheConfig with same name\n{}\nvs.\n{}",
+                      cache->config().DebugString(), config.DebugString()));
+    }
+    return cache;
+  }
+
+private:
+  absl::Mutex mu_;
+  // We keep weak_ptr here so the caches can be destroyed if the config is updated to stop using
+  // that config of cache.
+  absl::flat_hash_map<std::string, std::weak_ptr<MemoryHttpCache>> caches_ ABSL_GUARDED_BY(mu_);
+};
+
+SINGLETON_MANAGER_REGISTRATION(memory_http_cache_singleton);
+
+class MemoryHttpCacheFactory : public HttpCacheFactory {
+public:
+  // From UntypedFactory
+  std::string name() const override { return std::string{MemoryHttpCache::name()}; }
+  // From TypedFactory
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<ConfigProto>();
+  }
+  // From HttpCacheFactory
+  std::shared_ptr<HttpCache>
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
+           Server::Configuration::FactoryContext& context) override {
+    ConfigProto config;
+    THROW_IF_NOT_OK(MessageUtil::unpackTo(filter_config.typed_config(), config));
+    MessageUtil::validate(config, context.messageValidationVisitor());
+    std::shared_ptr<CacheSingleton> caches =
+        context.serverFactoryContext().singletonManager().getTyped<CacheSingleton>(
+            SINGLETON_MANAGER_REGISTERED_NAME(memory_http_cache_singleton),
+            [] { return std::make_shared<CacheSingleton>(); }, /* pin = */ true);
+    // A cache may outlive the filter config that created it, so its stats go in the server scope.
+    return caches->get(config, context.serverFactoryContext().scope());
+  }
+};
+
+static Registry::RegisterFactory<MemoryHttpCacheFactory, HttpCacheFactory> register_;
+
+} // namespace
+} // namespace MemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
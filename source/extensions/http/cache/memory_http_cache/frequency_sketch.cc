@@ -0,0 +1,65 @@
+#include "source/extensions/http/cache/memory_http_cache/frequency_sketch.h"
+
+#include <algorithm>
+
+#include "absl/numeric/bits.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace MemoryHttpCache {
+namespace {
+
+// Odd multipliers giving each row an independent index for the same hash.
+constexpr uint64_t RowSeeds[] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+                                 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+
+} // namespace
+
+FrequencySketch::FrequencySketch(uint32_t width)
+    : width_mask_(absl::bit_ceil(std::max<uint32_t>(width, 1)) - 1),
+      sample_size_(10 * static_cast<uint64_t>(width_mask_ + 1)) {
+  counts_.resize(Rows * static_cast<size_t>(width_mask_ + 1));
+}
+
+size_t FrequencySketch::index(uint64_t hash, uint32_t row) const {
+  uint64_t h = (hash + RowSeeds[row]) * RowSeeds[row];
+  h ^= h >> 32;
+  return row * static_cast<size_t>(width_mask_ + 1) + (h & width_mask_);
+}
+
+void FrequencySketch::increment(uint64_t hash) {
+  bool added = false;
+  for (uint32_t row = 0; row < Rows; ++row) {
+    uint8_t& count = counts_[index(hash, row)];
+    if (count < MaxCount) {
+      ++count;
+      added = true;
+    }
+  }
+  if (added && ++additions_ >= sample_size_) {
+    halve();
+  }
+}
+
+uint32_t FrequencySketch::frequency(uint64_t hash) const {
+  uint32_t frequency = MaxCount;
+  for (uint32_t row = 0; row < Rows; ++row) {
+    frequency = std::min<uint32_t>(frequency, counts_[index(hash, row)]);
+  }
+  return frequency;
+}
+
+void FrequencySketch::halve() {
+  for (uint8_t& count : counts_) {
+    count >>= 1;
+  }
+  additions_ /= 2;
+}
+
+} // namespace MemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
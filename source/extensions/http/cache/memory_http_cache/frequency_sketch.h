@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace MemoryHttpCache {
+
+/**
+ * A count-min sketch estimating how often each key hash has been seen recently, as used by
+ * TinyLFU admission. Each of the four rows holds saturating 4-bit counts, and the estimate is the
+ * smallest count for the hash across the rows.
+ *
+ * Once the number of increments reaches ten times the width, all counts are halved, so that keys
+ * that were popular a long time ago do not keep displacing keys that are popular now.
+ *
+ * Not thread-safe.
+ */
+class FrequencySketch {
+public:
+  /**
+   * @param width the number of counters per row. Rounded up to a power of two.
+   */
+  explicit FrequencySketch(uint32_t width);
+
+  /**
+   * Records an occurrence of the hash.
+   */
+  void increment(uint64_t hash);
+
+  /**
+   * @return the estimated number of occurrences of the hash since counts were last halved,
+   *         capped at 15.
+   */
+  uint32_t frequency(uint64_t hash) const;
+
+  uint32_t width() const { return width_mask_ + 1; }
+
+private:
+  static constexpr uint32_t Rows = 4;
+  static constexpr uint8_t MaxCount = 15;
+
+  size_t index(uint64_t hash, uint32_t row) const;
+  void halve();
+
+  std::vector<uint8_t> counts_;
+  uint32_t width_mask_;
+  uint64_t sample_size_;
+  uint64_t additions_{0};
+};
+
+} // namespace MemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
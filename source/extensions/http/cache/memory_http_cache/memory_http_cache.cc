@@ -0,0 +1,607 @@
+#include "source/extensions/http/cache/memory_http_cache/memory_http_cache.h"
+
+#include <algorithm>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/header_map_impl.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_join.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace MemoryHttpCache {
+namespace {
+
+constexpr uint32_t DefaultShardCount = 16;
+
+// The entry size assumed when sizing the frequency sketch of a shard, which should have a counter
+// for every entry the shard can hold.
+constexpr uint64_t AssumedAverageEntrySize = 8 * 1024;
+constexpr uint32_t MinSketchWidth = 64;
+constexpr uint32_t MaxSketchWidth = 1 << 22;
+
+uint32_t sketchWidth(uint64_t capacity_bytes) {
+  return static_cast<uint32_t>(std::clamp<uint64_t>(capacity_bytes / AssumedAverageEntrySize,
+                                                    MinSketchWidth, MaxSketchWidth));
+}
+
+// Returns a Key with the vary identifier added to custom_fields, or nullopt if the vary headers
+// in the response are not compatible with the VaryAllowList in the request.
+absl::optional<Key> variedRequestKey(const Key& key, const Http::RequestHeaderMap& request_headers,
+                                     const VaryAllowList& vary_allow_list,
+                                     const Http::ResponseHeaderMap& response_headers) {
+  absl::btree_set<absl::string_view> vary_header_values =
+      VaryHeaderUtils::getVaryValues(response_headers);
+  ASSERT(!vary_header_values.empty());
+  const absl::optional<std::string> vary_identifier =
+      VaryHeaderUtils::createVaryIdentifier(vary_allow_list, vary_header_values, request_headers);
+  if (!vary_identifier.has_value()) {
+    return absl::nullopt;
+  }
+  Key varied_request_key = key;
+  varied_request_key.add_custom_fields(vary_identifier.value());
+  return varied_request_key;
+}
+
+// References a range of a cached body, keeping the body alive until the buffer is done with it.
+class CachedBodyFragment : public Buffer::BufferFragment {
+public:
+  CachedBodyFragment(std::shared_ptr<const std::string> body, size_t offset, size_t length)
+      : body_(std::move(body)), data_(body_->data() + offset), size_(length) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return data_; }
+  size_t size() const override { return size_; }
+  void done() override { delete this; }
+
+private:
+  const std::shared_ptr<const std::string> body_;
+  const char* const data_;
+  const size_t size_;
+};
+
+class MemoryLookupContext : public LookupContext {
+public:
+  MemoryLookupContext(Event::Dispatcher& dispatcher, MemoryHttpCache& cache,
+                      LookupRequest&& request)
+      : dispatcher_(dispatcher), cache_(cache), request_(std::move(request)) {}
+
+  void getHeaders(LookupHeadersCallback&& cb) override {
+    response_ = cache_.lookup(request_);
+    LookupResult result;
+    bool end_stream = true;
+    if (response_ != nullptr) {
+      result = request_.makeLookupResult(
+          Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*response_->response_headers_),
+          ResponseMetadata(response_->metadata_), response_->body_->size());
+      end_stream = response_->body_->empty() && response_->trailers_ == nullptr;
+    }
+    dispatcher_.post([result = std::move(result), cb = std::move(cb), end_stream,
+                      cancelled = cancelled_]() mutable {
+      if (!*cancelled) {
+        std::move(cb)(std::move(result), end_stream);
+      }
+    });
+  }
+
+  void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override {
+    ASSERT(response_ != nullptr);
+    Buffer::InstancePtr result = response_->bodyRange(range);
+    bool end_stream = response_->trailers_ == nullptr && range.end() == response_->body_->length();
+    dispatcher_.post([result = std::move(result), cb = std::move(cb), end_stream,
+                      cancelled = cancelled_]() mutable {
+      if (!*cancelled) {
+        std::move(cb)(std::move(result), end_stream);
+      }
+    });
+  }
+
+  void getTrailers(LookupTrailersCallback&& cb) override {
+    ASSERT(response_ != nullptr && response_->trailers_ != nullptr);
+    Http::ResponseTrailerMapPtr trailers =
+        Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*response_->trailers_);
+    dispatcher_.post(
+        [cb = std::move(cb), trailers = std::move(trailers), cancelled = cancelled_]() mutable {
+          if (!*cancelled) {
+            std::move(cb)(std::move(trailers));
+          }
+        });
+  }
+
+  const LookupRequest& request() const { return request_; }
+  void onDestroy() override { *cancelled_ = true; }
+  Event::Dispatcher& dispatcher() const { return dispatcher_; }
+
+private:
+  Event::Dispatcher& dispatcher_;
+  std::shared_ptr<bool> cancelled_ = std::make_shared<bool>(false);
+  MemoryHttpCache& cache_;
+  const LookupRequest request_;
+  CachedResponseSharedPtr response_;
+};
+
+class MemoryInsertContext : public InsertContext {
+public:
+  MemoryInsertContext(MemoryLookupContext& lookup_context, MemoryHttpCache& cache)
+      : dispatcher_(lookup_context.dispatcher()), key_(lookup_context.request().key()),
+        request_headers_(lookup_context.request().requestHeaders()),
+        vary_allow_list_(lookup_context.request().varyAllowList()), cache_(cache) {}
+
+  void post(InsertCallback cb, bool result) {
+    dispatcher_.post([cb = std::move(cb), result = result, cancelled = cancelled_]() mutable {
+      if (!*cancelled) {
+        std::move(cb)(result);
+      }
+    });
+  }
+
+  void insertHeaders(const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata, InsertCallback insert_success,
+                     bool end_stream) override {
+    ASSERT(!committed_);
+    response_headers_ = Http::createHeaderMap<Http::ResponseHeaderMapImpl>(response_headers);
+    metadata_ = metadata;
+    if (end_stream) {
+      post(std::move(insert_success), commit());
+    } else {
+      post(std::move(insert_success), withinSizeLimit());
+    }
+  }
+
+  void insertBody(const Buffer::Instance& chunk, InsertCallback ready_for_next_chunk,
+                  bool end_stream) override {
+    ASSERT(!committed_);
+    ASSERT(ready_for_next_chunk || end_stream);
+
+    body_.add(chunk);
+    if (end_stream) {
+      post(std::move(ready_for_next_chunk), commit());
+    } else {
+      // Abort early rather than buffering a response that is too large to be cached.
+      post(std::move(ready_for_next_chunk), withinSizeLimit());
+    }
+  }
+
+  void insertTrailers(const Http::ResponseTrailerMap& trailers,
+                      InsertCallback insert_complete) override {
+    ASSERT(!committed_);
+    trailers_ = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(trailers);
+    post(std::move(insert_complete), commit());
+  }
+
+  void onDestroy() override { *cancelled_ = true; }
+
+private:
+  bool withinSizeLimit() const {
+    return response_headers_->byteSize() + body_.length() <= cache_.maxEntrySize();
+  }
+
+  bool commit() {
+    committed_ = true;
+    auto response = std::make_shared<const CachedResponse>(
+        std::move(response_headers_), std::move(metadata_),
+        std::make_shared<const std::string>(body_.toString()), std::move(trailers_));
+    body_.drain(body_.length());
+    return cache_.insert(key_, request_headers_, vary_allow_list_, std::move(response));
+  }
+
+  Event::Dispatcher& dispatcher_;
+  std::shared_ptr<bool> cancelled_ = std::make_shared<bool>(false);
+  Key key_;
+  const Http::RequestHeaderMap& request_headers_;
+  const VaryAllowList& vary_allow_list_;
+  Http::ResponseHeaderMapPtr response_headers_;
+  ResponseMetadata metadata_;
+  MemoryHttpCache& cache_;
+  Buffer::OwnedImpl body_;
+  bool committed_ = false;
+  Http::ResponseTrailerMapPtr trailers_;
+};
+
+} // namespace
+
+CachedResponse::CachedResponse(Http::ResponseHeaderMapPtr&& response_headers,
+                               ResponseMetadata&& metadata,
+                               std::shared_ptr<const std::string> body,
+                               Http::ResponseTrailerMapPtr&& trailers)
+    : response_headers_(std::move(response_headers)), metadata_(std::move(metadata)),
+      body_(std::move(body)), trailers_(std::move(trailers)),
+      size_(response_headers_->byteSize() + body_->size() +
+            (trailers_ != nullptr ? trailers_->byteSize() : 0)) {}
+
+Buffer::InstancePtr CachedResponse::bodyRange(const AdjustedByteRange& range) const {
+  ASSERT(range.end() <= body_->length(), "Attempt to read past end of body.");
+  auto buffer = std::make_unique<Buffer::OwnedImpl>();
+  if (range.length() > 0) {
+    buffer->addBufferFragment(*new CachedBodyFragment(body_, range.begin(), range.length()));
+  }
+  return buffer;
+}
+
+MemoryCacheShard::MemoryCacheShard(uint64_t capacity_bytes, uint64_t max_entry_size,
+                                   MemoryCacheStats&& stats)
+    : max_entry_size_(max_entry_size),
+      window_capacity_(std::max<uint64_t>(capacity_bytes / 100, 1)),
+      main_capacity_(capacity_bytes - std::min(capacity_bytes, window_capacity_)),
+      protected_capacity_(main_capacity_ / 5 * 4), stats_(std::move(stats)),
+      sketch_(sketchWidth(capacity_bytes)) {}
+
+CachedResponseSharedPtr MemoryCacheShard::lookup(const Key& key, uint64_t hash) {
+  absl::MutexLock lock(&mutex_);
+  // Misses count towards the frequency too, so that a response that is requested often is
+  // admitted as soon as it is inserted.
+  sketch_.increment(hash);
+  absl::optional<NodeList::iterator> it = find(key, hash);
+  if (!it.has_value()) {
+    return nullptr;
+  }
+  onHit(it.value());
+  return it.value()->response_;
+}
+
+bool MemoryCacheShard::insert(const Key& key, uint64_t hash, CachedResponseSharedPtr response) {
+  absl::MutexLock lock(&mutex_);
+  auto existing = index_.find(hash);
+  if (existing != index_.end()) {
+    remove(existing->second);
+  }
+  if (response->size_ > max_entry_size_) {
+    stats_.reject_.inc();
+    updateSizeStats();
+    return false;
+  }
+  window_bytes_ += response->size_;
+  window_.push_front(Node{key, hash, std::move(response), Segment::Window});
+  index_.emplace(hash, window_.begin());
+  stats_.insert_.inc();
+  drainWindow();
+  updateSizeStats();
+  return true;
+}
+
+bool MemoryCacheShard::update(
+    const Key& key, uint64_t hash,
+    absl::FunctionRef<CachedResponseSharedPtr(const CachedResponse&)> update_fn) {
+  absl::MutexLock lock(&mutex_);
+  absl::optional<NodeList::iterator> it = find(key, hash);
+  if (!it.has_value()) {
+    return false;
+  }
+  Node& node = *it.value();
+  CachedResponseSharedPtr response = update_fn(*node.response_);
+  bytes(node.segment_) -= node.response_->size_;
+  bytes(node.segment_) += response->size_;
+  node.response_ = std::move(response);
+  // The headers rarely grow by much, so the shard is only brought back within its capacity by
+  // later inserts.
+  updateSizeStats();
+  return true;
+}
+
+CachedResponseSharedPtr MemoryCacheShard::peek(const Key& key, uint64_t hash) {
+  absl::MutexLock lock(&mutex_);
+  absl::optional<NodeList::iterator> it = find(key, hash);
+  return it.has_value() ? it.value()->response_ : nullptr;
+}
+
+void MemoryCacheShard::erase(const Key& key, uint64_t hash) {
+  absl::MutexLock lock(&mutex_);
+  absl::optional<NodeList::iterator> it = find(key, hash);
+  if (it.has_value()) {
+    remove(it.value());
+    updateSizeStats();
+  }
+}
+
+absl::optional<MemoryCacheShard::NodeList::iterator> MemoryCacheShard::find(const Key& key,
+                                                                            uint64_t hash) {
+  auto it = index_.find(hash);
+  if (it == index_.end() || !Protobuf::util::MessageDifferencer::Equals(it->second->key_, key)) {
+    return absl::nullopt;
+  }
+  return it->second;
+}
+
+MemoryCacheShard::NodeList& MemoryCacheShard::list(Segment segment) {
+  switch (segment) {
+  case Segment::Window:
+    return window_;
+  case Segment::Probation:
+    return probation_;
+  case Segment::Protected:
+    return protected_;
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+uint64_t& MemoryCacheShard::bytes(Segment segment) {
+  switch (segment) {
+  case Segment::Window:
+    return window_bytes_;
+  case Segment::Probation:
+    return probation_bytes_;
+  case Segment::Protected:
+    return protected_bytes_;
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+void MemoryCacheShard::moveTo(NodeList::iterator it, Segment segment) {
+  bytes(it->segment_) -= it->response_->size_;
+  bytes(segment) += it->response_->size_;
+  // Splicing keeps the iterator held by index_ valid.
+  NodeList& to = list(segment);
+  to.splice(to.begin(), list(it->segment_), it);
+  it->segment_ = segment;
+}
+
+void MemoryCacheShard::remove(NodeList::iterator it) {
+  bytes(it->segment_) -= it->response_->size_;
+  index_.erase(it->hash_);
+  list(it->segment_).erase(it);
+}
+
+void MemoryCacheShard::onHit(NodeList::iterator it) {
+  switch (it->segment_) {
+  case Segment::Window:
+  case Segment::Protected:
+    moveTo(it, it->segment_);
+    return;
+  case Segment::Probation:
+    moveTo(it, Segment::Protected);
+    // Demote the least recently used protected entries to make room for the promoted one.
+    while (protected_bytes_ > protected_capacity_) {
+      moveTo(std::prev(protected_.end()), Segment::Probation);
+    }
+    return;
+  }
+}
+
+void MemoryCacheShard::drainWindow() {
+  while (window_bytes_ > window_capacity_) {
+    admit(std::prev(window_.end()));
+  }
+}
+
+void MemoryCacheShard::admit(NodeList::iterator candidate) {
+  const uint64_t size = candidate->response_->size_;
+  const uint64_t main_bytes = probation_bytes_ + protected_bytes_;
+  if (main_bytes + size <= main_capacity_) {
+    moveTo(candidate, Segment::Probation);
+    return;
+  }
+
+  // Collect the least recently used entries of the main segment that would make room for the
+  // candidate, starting with the probation segment. The candidate is only admitted if it is
+  // estimated to be more popular than each of them.
+  const uint32_t candidate_frequency = sketch_.frequency(candidate->hash_);
+  std::vector<NodeList::iterator> victims;
+  uint64_t freed = 0;
+  for (Segment segment : {Segment::Probation, Segment::Protected}) {
+    NodeList& nodes = list(segment);
+    auto it = nodes.end();
+    while (it != nodes.begin() && main_bytes - freed + size > main_capacity_) {
+      --it;
+      if (sketch_.frequency(it->hash_) >= candidate_frequency) {
+        remove(candidate);
+        stats_.reject_.inc();
+        return;
+      }
+      victims.push_back(it);
+      freed += it->response_->size_;
+    }
+  }
+  if (main_bytes - freed + size > main_capacity_) {
+    // The candidate is larger than the whole main segment.
+    remove(candidate);
+    stats_.reject_.inc();
+    return;
+  }
+  for (NodeList::iterator victim : victims) {
+    remove(victim);
+    stats_.eviction_.inc();
+  }
+  moveTo(candidate, Segment::Probation);
+}
+
+void MemoryCacheShard::updateSizeStats() {
+  stats_.size_bytes_.set(window_bytes_ + probation_bytes_ + protected_bytes_);
+  stats_.size_count_.set(index_.size());
+}
+
+MemoryHttpCache::MemoryHttpCache(ConfigProto config, Stats::Scope& stats_scope)
+    : config_(std::move(config)), stat_names_(stats_scope.symbolTable()) {
+  const uint32_t shard_count = PROTOBUF_GET_WRAPPED_OR_DEFAULT(config_, shard_count,
+                                                               DefaultShardCount);
+  const uint64_t shard_capacity = std::max<uint64_t>(config_.max_cache_size_bytes() / shard_count,
+                                                     1);
+  max_entry_size_ = std::min(shard_capacity,
+                             PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+                                 config_, max_individual_cache_entry_size_bytes, shard_capacity));
+  shards_.reserve(shard_count);
+  for (uint32_t i = 0; i < shard_count; ++i) {
+    shards_.push_back(std::make_unique<MemoryCacheShard>(
+        shard_capacity, max_entry_size_,
+        generateStats(stat_names_, stats_scope, config_.name(), i)));
+  }
+}
+
+LookupContextPtr MemoryHttpCache::makeLookupContext(LookupRequest&& request,
+                                                    Http::StreamFilterCallbacks& callbacks) {
+  return std::make_unique<MemoryLookupContext>(callbacks.dispatcher(), *this, std::move(request));
+}
+
+InsertContextPtr MemoryHttpCache::makeInsertContext(LookupContextPtr&& lookup_context,
+                                                    Http::StreamFilterCallbacks&) {
+  ASSERT(lookup_context != nullptr);
+  auto ret = std::make_unique<MemoryInsertContext>(
+      dynamic_cast<MemoryLookupContext&>(*lookup_context), *this);
+  lookup_context->onDestroy();
+  return ret;
+}
+
+void MemoryHttpCache::updateHeaders(const LookupContext& lookup_context,
+                                    const Http::ResponseHeaderMap& response_headers,
+                                    const ResponseMetadata& metadata,
+                                    UpdateHeadersCallback on_complete) {
+  const auto& memory_lookup_context = static_cast<const MemoryLookupContext&>(lookup_context);
+  const LookupRequest& request = memory_lookup_context.request();
+  auto post_complete = [on_complete = std::move(on_complete),
+                        &dispatcher = memory_lookup_context.dispatcher()](bool result) mutable {
+    dispatcher.post([on_complete = std::move(on_complete), result]() mutable {
+      std::move(on_complete)(result);
+    });
+  };
+
+  Key key = request.key();
+  uint64_t hash = stableHashKey(key);
+  CachedResponseSharedPtr cached = shard(hash).lookup(key, hash);
+  if (cached == nullptr) {
+    std::move(post_complete)(false);
+    return;
+  }
+  if (VaryHeaderUtils::hasVary(*cached->response_headers_)) {
+    absl::optional<Key> varied_key = variedRequestKey(
+        key, request.requestHeaders(), request.varyAllowList(), *cached->response_headers_);
+    if (!varied_key.has_value()) {
+      std::move(post_complete)(false);
+      return;
+    }
+    key = std::move(varied_key.value());
+    hash = stableHashKey(key);
+  }
+  const bool updated =
+      shard(hash).update(key, hash, [&](const CachedResponse& entry) -> CachedResponseSharedPtr {
+        Http::ResponseHeaderMapPtr headers =
+            Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*entry.response_headers_);
+        applyHeaderUpdate(response_headers, *headers);
+        Http::ResponseTrailerMapPtr trailers;
+        if (entry.trailers_ != nullptr) {
+          trailers = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*entry.trailers_);
+        }
+        return std::make_shared<const CachedResponse>(
+            std::move(headers), ResponseMetadata(metadata), entry.body_, std::move(trailers));
+      });
+  std::move(post_complete)(updated);
+}
+
+CachedResponseSharedPtr MemoryHttpCache::lookup(const LookupRequest& request) {
+  const uint64_t hash = stableHashKey(request.key());
+  MemoryCacheShard& request_shard = shard(hash);
+  CachedResponseSharedPtr response = request_shard.lookup(request.key(), hash);
+  if (response != nullptr && VaryHeaderUtils::hasVary(*response->response_headers_)) {
+    absl::optional<Key> varied_key =
+        variedRequestKey(request.key(), request.requestHeaders(), request.varyAllowList(),
+                         *response->response_headers_);
+    response = nullptr;
+    if (varied_key.has_value()) {
+      const uint64_t varied_hash = stableHashKey(varied_key.value());
+      response = shard(varied_hash).lookup(varied_key.value(), varied_hash);
+    }
+  }
+  if (response != nullptr) {
+    request_shard.stats().hit_.inc();
+  } else {
+    request_shard.stats().miss_.inc();
+  }
+  return response;
+}
+
+bool MemoryHttpCache::insert(const Key& key, const Http::RequestHeaderMap& request_headers,
+                             const VaryAllowList& vary_allow_list,
+                             CachedResponseSharedPtr response) {
+  const uint64_t hash = stableHashKey(key);
+  GenerationStripe& stripe = generationStripe(hash);
+  absl::MutexLock lock(&stripe.mutex_);
+  ++stripe.generation_;
+  return insertLocked(key, hash, request_headers, vary_allow_list, std::move(response));
+}
+
+bool MemoryHttpCache::insertIfGeneration(const Key& key, uint64_t generation,
+                                         const Http::RequestHeaderMap& request_headers,
+                                         const VaryAllowList& vary_allow_list,
+                                         CachedResponseSharedPtr response) {
+  const uint64_t hash = stableHashKey(key);
+  GenerationStripe& stripe = generationStripe(hash);
+  absl::MutexLock lock(&stripe.mutex_);
+  if (stripe.generation_ != generation) {
+    return false;
+  }
+  return insertLocked(key, hash, request_headers, vary_allow_list, std::move(response));
+}
+
+bool MemoryHttpCache::insertLocked(const Key& key, uint64_t hash,
+                                   const Http::RequestHeaderMap& request_headers,
+                                   const VaryAllowList& vary_allow_list,
+                                   CachedResponseSharedPtr response) {
+  if (!VaryHeaderUtils::hasVary(*response->response_headers_)) {
+    return shard(hash).insert(key, hash, std::move(response));
+  }
+
+  absl::btree_set<absl::string_view> vary_header_values =
+      VaryHeaderUtils::getVaryValues(*response->response_headers_);
+  absl::optional<Key> varied_key =
+      variedRequestKey(key, request_headers, vary_allow_list, *response->response_headers_);
+  if (!varied_key.has_value()) {
+    // Skip the insert if we are unable to create a vary key.
+    return false;
+  }
+  Http::ResponseHeaderMapPtr vary_only_map =
+      Http::createHeaderMap<Http::ResponseHeaderMapImpl>({});
+  vary_only_map->setCopy(Http::CustomHeaders::get().Vary, absl::StrJoin(vary_header_values, ","));
+
+  const uint64_t varied_hash = stableHashKey(varied_key.value());
+  if (!shard(varied_hash).insert(varied_key.value(), varied_hash, std::move(response))) {
+    return false;
+  }
+  // Add a marker entry to flag that this request generates varied responses. Marker entries are
+  // looked up by every request for the resource, so they are rarely evicted.
+  return shard(hash).insert(key, hash,
+                            std::make_shared<const CachedResponse>(
+                                std::move(vary_only_map), ResponseMetadata{},
+                                std::make_shared<const std::string>(), nullptr));
+}
+
+void MemoryHttpCache::erase(const Key& key, const Http::RequestHeaderMap& request_headers,
+                            const VaryAllowList& vary_allow_list) {
+  const uint64_t hash = stableHashKey(key);
+  GenerationStripe& stripe = generationStripe(hash);
+  absl::MutexLock lock(&stripe.mutex_);
+  ++stripe.generation_;
+  CachedResponseSharedPtr cached = shard(hash).peek(key, hash);
+  if (cached == nullptr) {
+    return;
+  }
+  if (!VaryHeaderUtils::hasVary(*cached->response_headers_)) {
+    shard(hash).erase(key, hash);
+    return;
+  }
+  absl::optional<Key> varied_key =
+      variedRequestKey(key, request_headers, vary_allow_list, *cached->response_headers_);
+  if (varied_key.has_value()) {
+    const uint64_t varied_hash = stableHashKey(varied_key.value());
+    shard(varied_hash).erase(varied_key.value(), varied_hash);
+  }
+}
+
+uint64_t MemoryHttpCache::generation(const Key& key) {
+  GenerationStripe& stripe = generationStripe(stableHashKey(key));
+  absl::MutexLock lock(&stripe.mutex_);
+  return stripe.generation_;
+}
+
+CacheInfo MemoryHttpCache::cacheInfo() const {
+  CacheInfo cache_info;
+  cache_info.name_ = name();
+  cache_info.supports_range_requests_ = true;
+  return cache_info;
+}
+
+} // namespace MemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <array>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/http/cache/memory_http_cache/v3/memory_http_cache.pb.h"
+
+#include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/memory_http_cache/frequency_sketch.h"
+#include "source/extensions/http/cache/memory_http_cache/stats.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace MemoryHttpCache {
+
+using ConfigProto = envoy::extensions::http::cache::memory_http_cache::v3::MemoryHttpCacheConfig;
+
+/**
+ * A cached response. It is never modified once cached, so lookups can keep using it after
+ * releasing the shard lock; updating the headers replaces it with a copy that shares the body.
+ */
+struct CachedResponse {
+  CachedResponse(Http::ResponseHeaderMapPtr&& response_headers, ResponseMetadata&& metadata,
+                 std::shared_ptr<const std::string> body, Http::ResponseTrailerMapPtr&& trailers);
+
+  /**
+   * @return a buffer referencing the range of the body without copying it. The buffer keeps the
+   *         body alive, even if the entry is evicted.
+   */
+  Buffer::InstancePtr bodyRange(const AdjustedByteRange& range) const;
+
+  const Http::ResponseHeaderMapPtr response_headers_;
+  const ResponseMetadata metadata_;
+  // Shared with the buffers of the responses served from this entry.
+  const std::shared_ptr<const std::string> body_;
+  const Http::ResponseTrailerMapPtr trailers_;
+  // The number of bytes the entry counts against the cache size.
+  const uint64_t size_;
+};
+using CachedResponseSharedPtr = std::shared_ptr<const CachedResponse>;
+
+/**
+ * One lock-sharded segment of a MemoryHttpCache, evicting with W-TinyLFU.
+ *
+ * New entries go into an LRU window holding 1% of the shard's bytes. An entry pushed out of the
+ * window is only admitted to the main segment if the frequency sketch estimates that it has been
+ * requested more often than each of the entries it would evict from there. The main segment is a
+ * segmented LRU: entries start in the probation segment, and move to the protected segment, which
+ * holds up to 80% of the main bytes, when they are hit.
+ */
+class MemoryCacheShard {
+public:
+  /**
+   * @param max_entry_size the size of the largest response the shard caches, at most
+   *        capacity_bytes.
+   */
+  MemoryCacheShard(uint64_t capacity_bytes, uint64_t max_entry_size, MemoryCacheStats&& stats);
+
+  /**
+   * Records an access to the key and returns its cached response, if any.
+   * @param hash the stableHashKey() of the key.
+   */
+  CachedResponseSharedPtr lookup(const Key& key, uint64_t hash);
+
+  /**
+   * Caches the response for the key, replacing any previous one.
+   * @return false if the response is larger than the maximum entry size.
+   */
+  bool insert(const Key& key, uint64_t hash, CachedResponseSharedPtr response);
+
+  /**
+   * Replaces the response cached for the key with the result of update_fn, which is called with
+   * the shard locked.
+   * @return false if no response is cached for the key.
+   */
+  bool update(const Key& key, uint64_t hash,
+              absl::FunctionRef<CachedResponseSharedPtr(const CachedResponse&)> update_fn);
+
+  /**
+   * @return the response cached for the key, if any, without recording an access.
+   */
+  CachedResponseSharedPtr peek(const Key& key, uint64_t hash);
+
+  /**
+   * Removes the response cached for the key, if any.
+   */
+  void erase(const Key& key, uint64_t hash);
+
+  MemoryCacheStats& stats() { return stats_; }
+
+private:
+  enum class Segment { Window, Probation, Protected };
+
+  struct Node {
+    Key key_;
+    uint64_t hash_;
+    CachedResponseSharedPtr response_;
+    Segment segment_;
+  };
+  using NodeList = std::list<Node>;
+
+  absl::optional<NodeList::iterator> find(const Key& key, uint64_t hash)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  NodeList& list(Segment segment) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  uint64_t& bytes(Segment segment) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void moveTo(NodeList::iterator it, Segment segment) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void remove(NodeList::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void onHit(NodeList::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Moves entries out of the window until it fits, admitting them to the main segment or
+  // dropping them.
+  void drainWindow() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void admit(NodeList::iterator candidate) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void updateSizeStats() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const uint64_t max_entry_size_;
+  const uint64_t window_capacity_;
+  const uint64_t main_capacity_;
+  const uint64_t protected_capacity_;
+  MemoryCacheStats stats_;
+
+  absl::Mutex mutex_;
+  FrequencySketch sketch_ ABSL_GUARDED_BY(mutex_);
+  // Most recently used first.
+  NodeList window_ ABSL_GUARDED_BY(mutex_);
+  NodeList probation_ ABSL_GUARDED_BY(mutex_);
+  NodeList protected_ ABSL_GUARDED_BY(mutex_);
+  uint64_t window_bytes_ ABSL_GUARDED_BY(mutex_){0};
+  uint64_t probation_bytes_ ABSL_GUARDED_BY(mutex_){0};
+  uint64_t protected_bytes_ ABSL_GUARDED_BY(mutex_){0};
+  // Entries are indexed by key hash; the key itself is compared on lookup, and an entry with a
+  // colliding hash is replaced on insert.
+  absl::flat_hash_map<uint64_t, NodeList::iterator> index_ ABSL_GUARDED_BY(mutex_);
+};
+
+/**
+ * A byte-bounded in-memory cache, split into lock-sharded segments. Varied responses are stored
+ * like in SimpleHttpCache: under the key extended with the vary identifier, plus a marker entry
+ * under the plain key that holds only the vary header.
+ */
+class MemoryHttpCache : public HttpCache {
+public:
+  MemoryHttpCache(ConfigProto config, Stats::Scope& stats_scope);
+
+  // HttpCache
+  LookupContextPtr makeLookupContext(LookupRequest&& request,
+                                     Http::StreamFilterCallbacks& callbacks) override;
+  InsertContextPtr makeInsertContext(LookupContextPtr&& lookup_context,
+                                     Http::StreamFilterCallbacks& callbacks) override;
+  void updateHeaders(const LookupContext& lookup_context,
+                     const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata, UpdateHeadersCallback on_complete) override;
+  CacheInfo cacheInfo() const override;
+
+  /**
+   * @return the response cached for the request, following the vary marker if there is one, or
+   *         nullptr. Counts a hit or miss against the shard of the request key.
+   */
+  CachedResponseSharedPtr lookup(const LookupRequest& request);
+
+  /**
+   * Caches a response for the request key, or for the varied key if the response has a vary
+   * header.
+   * @return false if the response was not cached.
+   */
+  bool insert(const Key& key, const Http::RequestHeaderMap& request_headers,
+              const VaryAllowList& vary_allow_list, CachedResponseSharedPtr response);
+
+  /**
+   * Caches a response like insert(), unless the request key has been inserted or erased since
+   * generation() returned the given generation for it. This lets a response read from elsewhere
+   * be cached without overwriting a newer version inserted while it was being read.
+   * @return false if the response was not cached.
+   */
+  bool insertIfGeneration(const Key& key, uint64_t generation,
+                          const Http::RequestHeaderMap& request_headers,
+                          const VaryAllowList& vary_allow_list, CachedResponseSharedPtr response);
+
+  /**
+   * Removes the response cached for the request key, or for the varied key if the response
+   * cached for the request key is a vary marker. The marker itself is kept, since responses for
+   * other variants may still be cached.
+   */
+  void erase(const Key& key, const Http::RequestHeaderMap& request_headers,
+             const VaryAllowList& vary_allow_list);
+
+  /**
+   * @return the invalidation generation of the request key, which insert() and erase() advance.
+   *         Keys may share a generation, so it can also advance when another key changes.
+   */
+  uint64_t generation(const Key& key);
+
+  /**
+   * @return the size in bytes of the largest response that can be cached.
+   */
+  uint64_t maxEntrySize() const { return max_entry_size_; }
+
+  const ConfigProto& config() const { return config_; }
+
+  static absl::string_view name() { return "envoy.extensions.http.cache.memory_http_cache"; }
+
+private:
+  static constexpr uint32_t GenerationStripeCount = 256;
+
+  // The invalidation generation of the keys whose hash falls into the stripe. The lock is held
+  // while a key is inserted or erased, so that a conditional insert cannot interleave with them.
+  struct GenerationStripe {
+    absl::Mutex mutex_;
+    uint64_t generation_ ABSL_GUARDED_BY(mutex_){0};
+  };
+
+  MemoryCacheShard& shard(uint64_t hash) { return *shards_[hash % shards_.size()]; }
+  GenerationStripe& generationStripe(uint64_t hash) {
+    // The low bits of the hash pick the shard, so the stripe is picked with the high bits.
+    return generation_stripes_[(hash >> 32) % GenerationStripeCount];
+  }
+  // Called with the generation stripe of the key locked.
+  bool insertLocked(const Key& key, uint64_t hash, const Http::RequestHeaderMap& request_headers,
+                    const VaryAllowList& vary_allow_list, CachedResponseSharedPtr response);
+
+  const ConfigProto config_;
+  MemoryCacheStatNames stat_names_;
+  uint64_t max_entry_size_;
+  std::vector<std::unique_ptr<MemoryCacheShard>> shards_;
+  std::array<GenerationStripe, GenerationStripeCount> generation_stripes_;
+};
+
+} // namespace MemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,24 @@
+#include "source/extensions/http/cache/memory_http_cache/stats.h"
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace MemoryHttpCache {
+
+MemoryCacheStats generateStats(MemoryCacheStatNames& stat_names, Stats::Scope& scope,
+                               absl::string_view cache_name, uint32_t shard) {
+  Stats::StatName cache_name_statname =
+      stat_names.pool_.add(absl::StrReplaceAll(cache_name, {{".", "_"}}));
+  Stats::StatName shard_statname = stat_names.pool_.add(absl::StrCat(shard));
+  return {stat_names, scope, cache_name_statname, shard_statname};
+}
+
+} // namespace MemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
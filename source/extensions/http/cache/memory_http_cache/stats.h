@@ -0,0 +1,68 @@
+#pragma once
+
+#include "envoy/stats/stats_macros.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace MemoryHttpCache {
+
+/**
+ * All memory cache stats, one set per shard. @see stats_macros.h
+ *
+ * A response that leaves the LRU window without being admitted to the main segment counts as
+ * a reject, like one that is too large to be cached at all.
+ **/
+
+#define ALL_MEMORY_CACHE_STATS(COUNTER, GAUGE, HISTOGRAM, TEXT_READOUT, STATNAME)                  \
+  COUNTER(eviction)                                                                                \
+  COUNTER(hit)                                                                                     \
+  COUNTER(insert)                                                                                  \
+  COUNTER(miss)                                                                                    \
+  COUNTER(reject)                                                                                  \
+  GAUGE(size_bytes, NeverImport)                                                                   \
+  GAUGE(size_count, NeverImport)                                                                   \
+  STATNAME(cache_name)                                                                             \
+  STATNAME(memory_cache)                                                                           \
+  STATNAME(shard)
+
+#define MEMORY_CACHE_COUNTER_HELPER_(NAME)                                                         \
+  , NAME##_(                                                                                       \
+        Envoy::Stats::Utility::counterFromStatNames(scope, {prefix_, stat_names.NAME##_}, tags_))
+#define MEMORY_CACHE_GAUGE_HELPER_(NAME, MODE)                                                     \
+  , NAME##_(Envoy::Stats::Utility::gaugeFromStatNames(                                             \
+        scope, {prefix_, stat_names.NAME##_}, Envoy::Stats::Gauge::ImportMode::MODE, tags_))
+#define MEMORY_CACHE_STATNAME_HELPER_(NAME)
+
+MAKE_STAT_NAMES_STRUCT(MemoryCacheStatNames, ALL_MEMORY_CACHE_STATS);
+
+struct MemoryCacheStats {
+  MemoryCacheStats(const MemoryCacheStatNames& stat_names, Envoy::Stats::Scope& scope,
+                   Stats::StatName cache_name, Stats::StatName shard)
+      : prefix_(stat_names.memory_cache_),
+        tags_({{stat_names.cache_name_, cache_name}, {stat_names.shard_, shard}})
+            ALL_MEMORY_CACHE_STATS(MEMORY_CACHE_COUNTER_HELPER_, MEMORY_CACHE_GAUGE_HELPER_,
+                                   HISTOGRAM_HELPER_, TEXT_READOUT_HELPER_,
+                                   MEMORY_CACHE_STATNAME_HELPER_) {}
+
+private:
+  const Stats::StatName prefix_;
+  Stats::StatNameTagVector tags_;
+
+public:
+  ALL_MEMORY_CACHE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT, GENERATE_HISTOGRAM_STRUCT,
+                         GENERATE_TEXT_READOUT_STRUCT, GENERATE_STATNAME_STRUCT);
+};
+
+/**
+ * @return the stats of one shard of the named cache.
+ */
+MemoryCacheStats generateStats(MemoryCacheStatNames& stat_names, Stats::Scope& scope,
+                               absl::string_view cache_name, uint32_t shard);
+
+} // namespace MemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
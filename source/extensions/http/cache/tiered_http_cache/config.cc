@@ -0,0 +1,111 @@
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/http/cache/tiered_http_cache/v3/tiered_http_cache.pb.h"
+#include "envoy/extensions/http/cache/tiered_http_cache/v3/tiered_http_cache.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/tiered_http_cache/tiered_http_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace TieredHttpCache {
+namespace {
+
+/**
+ * A singleton that acts as a factory for generating and looking up TieredHttpCaches, by the name
+ * of their memory tier. When given configs with the same name, the singleton returns pointers to
+ * the same cache. If given configs with the same name but different configuration, an exception
+ * is thrown. The singleton is pinned, so that caches with the same name are shared even while no
+ * filter config holds the singleton.
+ */
+class CacheSingleton : public Envoy::Singleton::Instance {
+public:
+  std::shared_ptr<TieredHttpCache> get(const ConfigProto& config,
+                                       Server::Configuration::FactoryContext& context) {
+    std::shared_ptr<TieredHttpCache> cache;
+    absl::MutexLock lock(&mu_);
+    const std::string& name = config.memory_tier().name();
+    auto it = caches_.find(name);
+    if (it != caches_.end()) {
+      cache = it->second.lock();
+    }
+    if (!cache) {
+      // A cache may outlive the filter config that created it, so its stats go in the server
+      // scope.
+      cache = std::make_shared<TieredHttpCache>(config, backingTier(config, context),
+                                                context.serverFactoryContext().scope(),
+                                                context.serverFactoryContext().timeSource());
+      caches_[name] = cache;
+    } else if (!Protobuf::util::MessageDifferencer::Equals(cache->config(), config)) {
+      throw EnvoyException(
+          fmt::format("mismatched TieredHttpCacheConfig with same name\n{}\nvs.\n{}",
+                      cache->config().DebugString(), config.DebugString()));
+    }
+    return cache;
+  }
+
+private:
+  static std::shared_ptr<HttpCache> backingTier(const ConfigProto& config,
+                                                Server::Configuration::FactoryContext& context) {
+    const std::string type{
+        TypeUtil::typeUrlToDescriptorFullName(config.backing_tier().type_url())};
+    HttpCacheFactory* const factory =
+        Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(type);
+    if (factory == nullptr) {
+      throw EnvoyException(
+          fmt::format("Didn't find a registered implementation for type: '{}'", type));
+    }
+    if (factory->name() == TieredHttpCache::name()) {
+      throw EnvoyException("the backing tier of a TieredHttpCacheConfig can't be tiered");
+    }
+    // The backing tier is configured like any other cache, so it is shared with other filter
+    // configs that use the same backing cache.
+    envoy::extensions::filters::http::cache::v3::CacheConfig backing_config;
+    *backing_config.mutable_typed_config() = config.backing_tier();
+    return factory->getCache(backing_config, context);
+  }
+
+  absl::Mutex mu_;
+  // We keep weak_ptr here so the caches can be destroyed if the config is updated to stop using
+  // that config of cache.
+  absl::flat_hash_map<std::string, std::weak_ptr<TieredHttpCache>> caches_ ABSL_GUARDED_BY(mu_);
+};
+
+SINGLETON_MANAGER_REGISTRATION(tiered_http_cache_singleton);
+
+class TieredHttpCacheFactory : public HttpCacheFactory {
+public:
+  // From UntypedFactory
+  std::string name() const override { return std::string{TieredHttpCache::name()}; }
+  // From TypedFactory
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<ConfigProto>();
+  }
+  // From HttpCacheFactory
+  std::shared_ptr<HttpCache>
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
+           Server::Configuration::FactoryContext& context) override {
+    ConfigProto config;
+    THROW_IF_NOT_OK(MessageUtil::unpackTo(filter_config.typed_config(), config));
+    MessageUtil::validate(config, context.messageValidationVisitor());
+    std::shared_ptr<CacheSingleton> caches =
+        context.serverFactoryContext().singletonManager().getTyped<CacheSingleton>(
+            SINGLETON_MANAGER_REGISTERED_NAME(tiered_http_cache_singleton),
+            [] { return std::make_shared<CacheSingleton>(); }, /* pin = */ true);
+    return caches->get(config, context);
+  }
+};
+
+static Registry::RegisterFactory<TieredHttpCacheFactory, HttpCacheFactory> register_;
+
+} // namespace
+} // namespace TieredHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
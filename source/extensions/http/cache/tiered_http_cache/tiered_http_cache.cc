@@ -0,0 +1,409 @@
+#include "source/extensions/http/cache/tiered_http_cache/tiered_http_cache.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/header_map_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace TieredHttpCache {
+namespace {
+
+using MemoryHttpCache::CachedResponse;
+using MemoryHttpCache::CachedResponseSharedPtr;
+
+// Wraps the completion callback of a header update in the backing tier, so that the memory
+// tier's copy of the response is removed once the backing tier holds the updated headers. Until
+// then, both tiers serve the previous headers. The removal advances the generation of the key,
+// so lookups that read the previous headers from the backing tier meanwhile don't promote them.
+UpdateHeadersCallback eraseWhenUpdated(TieredHttpCache& cache, const Key& key,
+                                       const Http::RequestHeaderMap& request_headers,
+                                       const VaryAllowList& vary_allow_list,
+                                       UpdateHeadersCallback on_complete) {
+  return [&cache, key,
+          request_headers = Http::createHeaderMap<Http::RequestHeaderMapImpl>(request_headers),
+          &vary_allow_list, on_complete = std::move(on_complete)](bool updated) mutable {
+    if (updated) {
+      cache.memoryTier().erase(key, *request_headers, vary_allow_list);
+    }
+    std::move(on_complete)(updated);
+  };
+}
+
+// Updates the backing tier's copy of a response that was served from the memory tier. The
+// backing tier needs a lookup context of its own, whose headers have been looked up so that it
+// refers to the right variant of a varied response.
+class BackingHeaderUpdate {
+public:
+  static void start(TieredHttpCache& cache, const LookupRequest& request,
+                    Http::StreamFilterCallbacks& callbacks,
+                    const Http::ResponseHeaderMap& response_headers,
+                    const ResponseMetadata& metadata, UpdateHeadersCallback on_complete) {
+    auto update = std::unique_ptr<BackingHeaderUpdate>(new BackingHeaderUpdate(
+        cache, request, callbacks, response_headers, metadata, std::move(on_complete)));
+    BackingHeaderUpdate& ref = *update;
+    // The lookup's callback owns the update until it runs.
+    ref.backing_->getHeaders(
+        [update = std::move(update)](LookupResult&& result, bool) mutable {
+          BackingHeaderUpdate& ref = *update;
+          ref.onHeaders(result);
+          // The lookup can't be destroyed from its own callback, so it's destroyed later.
+          ref.dispatcher_.post([update = std::move(update)]() { update->backing_->onDestroy(); });
+        });
+  }
+
+private:
+  BackingHeaderUpdate(TieredHttpCache& cache, const LookupRequest& request,
+                      Http::StreamFilterCallbacks& callbacks,
+                      const Http::ResponseHeaderMap& response_headers,
+                      const ResponseMetadata& metadata, UpdateHeadersCallback on_complete)
+      : cache_(cache), dispatcher_(callbacks.dispatcher()),
+        response_headers_(Http::createHeaderMap<Http::ResponseHeaderMapImpl>(response_headers)),
+        metadata_(metadata),
+        on_complete_(eraseWhenUpdated(cache, request.key(), request.requestHeaders(),
+                                      request.varyAllowList(), std::move(on_complete))),
+        backing_(cache.backingTier().makeLookupContext(
+            LookupRequest(request.requestHeaders(), cache.timeSource().systemTime(),
+                          request.varyAllowList()),
+            callbacks)) {}
+
+  void onHeaders(const LookupResult& result) {
+    if (result.headers_ == nullptr) {
+      // The backing tier doesn't have the response, so there is nothing to update.
+      std::move(on_complete_)(false);
+      return;
+    }
+    cache_.backingTier().updateHeaders(*backing_, *response_headers_, metadata_,
+                                       std::move(on_complete_));
+  }
+
+  TieredHttpCache& cache_;
+  Event::Dispatcher& dispatcher_;
+  const Http::ResponseHeaderMapPtr response_headers_;
+  const ResponseMetadata metadata_;
+  UpdateHeadersCallback on_complete_;
+  const LookupContextPtr backing_;
+};
+
+class TieredLookupContext : public LookupContext {
+public:
+  TieredLookupContext(TieredHttpCache& cache, LookupRequest&& request,
+                      Http::StreamFilterCallbacks& callbacks)
+      : cache_(cache), callbacks_(callbacks), request_(std::move(request)) {}
+
+  void getHeaders(LookupHeadersCallback&& cb) override {
+    memory_response_ = cache_.memoryTier().lookup(*request_);
+    if (memory_response_ != nullptr) {
+      LookupResult result = request_->makeLookupResult(
+          Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*memory_response_->response_headers_),
+          ResponseMetadata(memory_response_->metadata_), memory_response_->body_->size());
+      if (result.cache_entry_status_ == CacheEntryStatus::Ok) {
+        const bool end_stream =
+            memory_response_->body_->empty() && memory_response_->trailers_ == nullptr;
+        post([cb = std::move(cb), result = std::move(result), end_stream]() mutable {
+          std::move(cb)(std::move(result), end_stream);
+        });
+        return;
+      }
+      // The backing tier holds the same response, and validates it.
+      memory_response_ = nullptr;
+    }
+    backingLookup().getHeaders(
+        [this, cb = std::move(cb)](LookupResult&& result, bool end_stream) mutable {
+          if (shouldPromote(result)) {
+            promotion_ = std::make_unique<Promotion>();
+            promotion_->headers_ =
+                Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*result.headers_);
+            if (end_stream) {
+              promote(nullptr);
+            }
+          }
+          std::move(cb)(std::move(result), end_stream);
+        });
+  }
+
+  void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override {
+    if (memory_response_ != nullptr) {
+      Buffer::InstancePtr body = memory_response_->bodyRange(range);
+      const bool end_stream = memory_response_->trailers_ == nullptr &&
+                              range.end() == memory_response_->body_->length();
+      post([cb = std::move(cb), body = std::move(body), end_stream]() mutable {
+        std::move(cb)(std::move(body), end_stream);
+      });
+      return;
+    }
+    ASSERT(backing_ != nullptr);
+    backing_->getBody(range, [this, begin = range.begin(), cb = std::move(cb)](
+                                 Buffer::InstancePtr&& body, bool end_stream) mutable {
+      if (promotion_ != nullptr) {
+        // Only a body read from start to end in order is promoted.
+        if (body == nullptr || begin != promotion_->body_.length()) {
+          promotion_ = nullptr;
+        } else {
+          promotion_->body_.add(*body);
+          if (end_stream) {
+            promote(nullptr);
+          }
+        }
+      }
+      std::move(cb)(std::move(body), end_stream);
+    });
+  }
+
+  void getTrailers(LookupTrailersCallback&& cb) override {
+    if (memory_response_ != nullptr) {
+      ASSERT(memory_response_->trailers_ != nullptr);
+      Http::ResponseTrailerMapPtr trailers =
+          Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*memory_response_->trailers_);
+      post([cb = std::move(cb), trailers = std::move(trailers)]() mutable {
+        std::move(cb)(std::move(trailers));
+      });
+      return;
+    }
+    ASSERT(backing_ != nullptr);
+    backing_->getTrailers(
+        [this, cb = std::move(cb)](Http::ResponseTrailerMapPtr&& trailers) mutable {
+          if (promotion_ != nullptr) {
+            if (trailers == nullptr) {
+              promotion_ = nullptr;
+            } else {
+              promote(Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*trailers));
+            }
+          }
+          std::move(cb)(std::move(trailers));
+        });
+  }
+
+  void onDestroy() override {
+    *cancelled_ = true;
+    if (backing_ != nullptr) {
+      backing_->onDestroy();
+    }
+  }
+
+  InsertContextPtr makeInsertContext(Http::StreamFilterCallbacks& callbacks);
+
+  void updateHeaders(const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata, UpdateHeadersCallback on_complete) const {
+    if (backing_ != nullptr) {
+      cache_.backingTier().updateHeaders(
+          *backing_, response_headers, metadata,
+          eraseWhenUpdated(cache_, key_, *request_headers_, *vary_allow_list_,
+                           std::move(on_complete)));
+      return;
+    }
+    BackingHeaderUpdate::start(cache_, *request_, callbacks_, response_headers, metadata,
+                               std::move(on_complete));
+  }
+
+private:
+  // A response being read from the backing tier, to be inserted into the memory tier once it
+  // has been read in full.
+  struct Promotion {
+    Http::ResponseHeaderMapPtr headers_;
+    Buffer::OwnedImpl body_;
+  };
+
+  void post(absl::AnyInvocable<void()> cb) const {
+    callbacks_.dispatcher().post([cb = std::move(cb), cancelled = cancelled_]() mutable {
+      if (!*cancelled) {
+        std::move(cb)();
+      }
+    });
+  }
+
+  // Hands the request over to the backing tier, keeping what's needed to insert into the memory
+  // tier later.
+  LookupContext& backingLookup() {
+    if (backing_ == nullptr) {
+      key_ = request_->key();
+      request_headers_ =
+          Http::createHeaderMap<Http::RequestHeaderMapImpl>(request_->requestHeaders());
+      vary_allow_list_ = &request_->varyAllowList();
+      // Recorded before the backing tier is read, so that a response inserted or updated while
+      // it is being read is not overwritten by the promotion.
+      generation_ = cache_.memoryTier().generation(key_);
+      backing_ = cache_.backingTier().makeLookupContext(std::move(request_).value(), callbacks_);
+      request_.reset();
+    }
+    return *backing_;
+  }
+
+  bool shouldPromote(const LookupResult& result) const {
+    return result.cache_entry_status_ == CacheEntryStatus::Ok &&
+           !result.range_details_.has_value() && result.content_length_.has_value() &&
+           result.headers_->byteSize() + result.content_length_.value() <=
+               cache_.memoryTier().maxEntrySize();
+  }
+
+  void promote(Http::ResponseTrailerMapPtr&& trailers) {
+    // The headers carry the age of the response when it was read from the backing tier, so its
+    // residence in the memory tier starts now.
+    ResponseMetadata metadata;
+    metadata.response_time_ = cache_.timeSource().systemTime();
+    auto response = std::make_shared<const CachedResponse>(
+        std::move(promotion_->headers_), std::move(metadata),
+        std::make_shared<const std::string>(promotion_->body_.toString()), std::move(trailers));
+    cache_.memoryTier().insertIfGeneration(key_, generation_, *request_headers_, *vary_allow_list_,
+                                           std::move(response));
+    promotion_ = nullptr;
+  }
+
+  TieredHttpCache& cache_;
+  Http::StreamFilterCallbacks& callbacks_;
+  std::shared_ptr<bool> cancelled_ = std::make_shared<bool>(false);
+  // Unset once the request has been handed over to the backing tier.
+  absl::optional<LookupRequest> request_;
+  // Set when the response is served from the memory tier.
+  CachedResponseSharedPtr memory_response_;
+  // Set when the response is looked up in the backing tier.
+  LookupContextPtr backing_;
+  Key key_;
+  Http::RequestHeaderMapPtr request_headers_;
+  const VaryAllowList* vary_allow_list_ = nullptr;
+  // The memory tier generation of the key when the backing tier lookup started.
+  uint64_t generation_ = 0;
+  std::unique_ptr<Promotion> promotion_;
+};
+
+class TieredInsertContext : public InsertContext {
+public:
+  TieredInsertContext(TieredHttpCache& cache, InsertContextPtr backing, const Key& key,
+                      const Http::RequestHeaderMap& request_headers,
+                      const VaryAllowList& vary_allow_list)
+      : cache_(cache), backing_(std::move(backing)), key_(key),
+        request_headers_(Http::createHeaderMap<Http::RequestHeaderMapImpl>(request_headers)),
+        vary_allow_list_(vary_allow_list) {}
+
+  void insertHeaders(const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata, InsertCallback insert_complete,
+                     bool end_stream) override {
+    // Whatever the memory tier holds for the key is being replaced.
+    cache_.memoryTier().erase(key_, *request_headers_, vary_allow_list_);
+    if (response_headers.byteSize() <= cache_.memoryTier().maxEntrySize()) {
+      response_headers_ = Http::createHeaderMap<Http::ResponseHeaderMapImpl>(response_headers);
+      metadata_ = metadata;
+    }
+    backing_->insertHeaders(response_headers, metadata,
+                            commitWhenComplete(std::move(insert_complete), end_stream),
+                            end_stream);
+  }
+
+  void insertBody(const Buffer::Instance& fragment, InsertCallback ready_for_next_fragment,
+                  bool end_stream) override {
+    if (response_headers_ != nullptr) {
+      if (response_headers_->byteSize() + body_.length() + fragment.length() <=
+          cache_.memoryTier().maxEntrySize()) {
+        body_.add(fragment);
+      } else {
+        // Too large for the memory tier; only the backing tier caches it.
+        response_headers_ = nullptr;
+        body_.drain(body_.length());
+      }
+    }
+    backing_->insertBody(fragment,
+                         commitWhenComplete(std::move(ready_for_next_fragment), end_stream),
+                         end_stream);
+  }
+
+  void insertTrailers(const Http::ResponseTrailerMap& trailers,
+                      InsertCallback insert_complete) override {
+    if (response_headers_ != nullptr) {
+      trailers_ = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(trailers);
+    }
+    backing_->insertTrailers(trailers, commitWhenComplete(std::move(insert_complete), true));
+  }
+
+  void onDestroy() override { backing_->onDestroy(); }
+
+private:
+  // Wraps a callback passed to the backing tier, so that the response is inserted into the memory
+  // tier only once the backing tier has it.
+  InsertCallback commitWhenComplete(InsertCallback cb, bool end_stream) {
+    return [this, cb = std::move(cb), end_stream](bool success) mutable {
+      if (success && end_stream) {
+        if (response_headers_ != nullptr) {
+          cache_.memoryTier().insert(
+              key_, *request_headers_, vary_allow_list_,
+              std::make_shared<const CachedResponse>(
+                  std::move(response_headers_), std::move(metadata_),
+                  std::make_shared<const std::string>(body_.toString()), std::move(trailers_)));
+          body_.drain(body_.length());
+        } else {
+          // Advance the generation of the key all the same, so that lookups which read the
+          // previous response from the backing tier meanwhile don't promote it.
+          cache_.memoryTier().erase(key_, *request_headers_, vary_allow_list_);
+        }
+      }
+      if (cb) {
+        std::move(cb)(success);
+      }
+    };
+  }
+
+  TieredHttpCache& cache_;
+  const InsertContextPtr backing_;
+  const Key key_;
+  const Http::RequestHeaderMapPtr request_headers_;
+  const VaryAllowList& vary_allow_list_;
+  // Unset if the response is too large for the memory tier.
+  Http::ResponseHeaderMapPtr response_headers_;
+  ResponseMetadata metadata_;
+  Buffer::OwnedImpl body_;
+  Http::ResponseTrailerMapPtr trailers_;
+};
+
+InsertContextPtr TieredLookupContext::makeInsertContext(Http::StreamFilterCallbacks& callbacks) {
+  backingLookup();
+  InsertContextPtr backing_insert =
+      cache_.backingTier().makeInsertContext(std::move(backing_), callbacks);
+  if (backing_insert == nullptr) {
+    return nullptr;
+  }
+  return std::make_unique<TieredInsertContext>(cache_, std::move(backing_insert), key_,
+                                               *request_headers_, *vary_allow_list_);
+}
+
+} // namespace
+
+TieredHttpCache::TieredHttpCache(ConfigProto config, std::shared_ptr<HttpCache> backing_tier,
+                                 Stats::Scope& stats_scope, TimeSource& time_source)
+    : config_(std::move(config)), memory_tier_(config_.memory_tier(), stats_scope),
+      backing_tier_(std::move(backing_tier)), time_source_(time_source) {}
+
+LookupContextPtr TieredHttpCache::makeLookupContext(LookupRequest&& request,
+                                                    Http::StreamFilterCallbacks& callbacks) {
+  return std::make_unique<TieredLookupContext>(*this, std::move(request), callbacks);
+}
+
+InsertContextPtr TieredHttpCache::makeInsertContext(LookupContextPtr&& lookup_context,
+                                                    Http::StreamFilterCallbacks& callbacks) {
+  ASSERT(lookup_context != nullptr);
+  InsertContextPtr ret =
+      static_cast<TieredLookupContext&>(*lookup_context).makeInsertContext(callbacks);
+  lookup_context->onDestroy();
+  return ret;
+}
+
+void TieredHttpCache::updateHeaders(const LookupContext& lookup_context,
+                                    const Http::ResponseHeaderMap& response_headers,
+                                    const ResponseMetadata& metadata,
+                                    UpdateHeadersCallback on_complete) {
+  static_cast<const TieredLookupContext&>(lookup_context)
+      .updateHeaders(response_headers, metadata, std::move(on_complete));
+}
+
+CacheInfo TieredHttpCache::cacheInfo() const {
+  CacheInfo cache_info;
+  cache_info.name_ = name();
+  // The memory tier serves ranges; the backing tier must too, for responses only it holds.
+  cache_info.supports_range_requests_ = backing_tier_->cacheInfo().supports_range_requests_;
+  return cache_info;
+}
+
+} // namespace TieredHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
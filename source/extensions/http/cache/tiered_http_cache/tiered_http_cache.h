@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/http/cache/tiered_http_cache/v3/tiered_http_cache.pb.h"
+
+#include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/memory_http_cache/memory_http_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace TieredHttpCache {
+
+using ConfigProto = envoy::extensions::http::cache::tiered_http_cache::v3::TieredHttpCacheConfig;
+
+/**
+ * A MemoryHttpCache in front of another cache, the backing tier.
+ *
+ * The memory tier is write-through: every response is inserted into the backing tier, and into
+ * the memory tier as well once the backing tier has accepted it, if it is small enough. Lookups
+ * that miss the memory tier go to the backing tier, and a response found there is promoted into
+ * the memory tier while it is served. The memory tier's admission policy decides which responses
+ * stay; since the backing tier holds every response, an entry evicted from memory is just dropped.
+ * Inserting a response, or updating it in the backing tier, removes it from the memory tier, and
+ * a promotion is dropped if the response was inserted or updated since its backing tier lookup
+ * started, so that the memory tier doesn't keep serving a version the backing tier has replaced.
+ */
+class TieredHttpCache : public HttpCache {
+public:
+  TieredHttpCache(ConfigProto config, std::shared_ptr<HttpCache> backing_tier,
+                  Stats::Scope& stats_scope, TimeSource& time_source);
+
+  // HttpCache
+  LookupContextPtr makeLookupContext(LookupRequest&& request,
+                                     Http::StreamFilterCallbacks& callbacks) override;
+  InsertContextPtr makeInsertContext(LookupContextPtr&& lookup_context,
+                                     Http::StreamFilterCallbacks& callbacks) override;
+  void updateHeaders(const LookupContext& lookup_context,
+                     const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata, UpdateHeadersCallback on_complete) override;
+  CacheInfo cacheInfo() const override;
+
+  MemoryHttpCache::MemoryHttpCache& memoryTier() { return memory_tier_; }
+  HttpCache& backingTier() { return *backing_tier_; }
+  TimeSource& timeSource() { return time_source_; }
+  const ConfigProto& config() const { return config_; }
+
+  static absl::string_view name() { return "envoy.extensions.http.cache.tiered_http_cache"; }
+
+private:
+  const ConfigProto config_;
+  MemoryHttpCache::MemoryHttpCache memory_tier_;
+  const std::shared_ptr<HttpCache> backing_tier_;
+  TimeSource& time_source_;
+};
+
+} // namespace TieredHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,42 @@
+#include "source/extensions/private_key_providers/thread_pool/config.h"
+
+#include <memory>
+
+#include "envoy/extensions/private_key_providers/thread_pool/v3/thread_pool.pb.h"
+#include "envoy/extensions/private_key_providers/thread_pool/v3/thread_pool.pb.validate.h"
+#include "envoy/registry/registry.h"
+#include "envoy/server/transport_socket_config.h"
+
+#include "source/common/config/utility.h"
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+Ssl::PrivateKeyMethodProviderSharedPtr
+ThreadPoolPrivateKeyMethodFactory::createPrivateKeyMethodProviderInstance(
+    const envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider& proto_config,
+    Server::Configuration::TransportSocketFactoryContext& private_key_provider_context) {
+  ProtobufTypes::MessagePtr message =
+      std::make_unique<envoy::extensions::private_key_providers::thread_pool::v3::
+                           ThreadPoolPrivateKeyMethodConfig>();
+
+  THROW_IF_NOT_OK(Config::Utility::translateOpaqueConfig(
+      proto_config.typed_config(), ProtobufMessage::getNullValidationVisitor(), *message));
+  const auto& conf = MessageUtil::downcastAndValidate<
+      const envoy::extensions::private_key_providers::thread_pool::v3::
+          ThreadPoolPrivateKeyMethodConfig&>(
+      *message, private_key_provider_context.messageValidationVisitor());
+  return std::make_shared<ThreadPoolPrivateKeyMethodProvider>(conf, private_key_provider_context);
+}
+
+REGISTER_FACTORY(ThreadPoolPrivateKeyMethodFactory, Ssl::PrivateKeyMethodProviderInstanceFactory);
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,382 @@
+#include "source/extensions/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "envoy/common/exception.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/config/datasource.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "openssl/err.h"
+#include "openssl/evp.h"
+#include "openssl/pem.h"
+#include "openssl/rsa.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+SINGLETON_MANAGER_REGISTRATION(private_key_thread_pool_registry);
+
+PrivateKeyOperation::PrivateKeyOperation(Type type, bssl::UniquePtr<EVP_PKEY> pkey,
+                                         uint16_t signature_algorithm, const uint8_t* in,
+                                         size_t in_len, Ssl::PrivateKeyConnectionCallbacks& cb)
+    : type_(type), pkey_(std::move(pkey)), signature_algorithm_(signature_algorithm),
+      input_(in, in + in_len), cb_(&cb) {}
+
+void PrivateKeyOperation::run() {
+  succeeded_ = type_ == Type::Sign ? sign() : decrypt();
+  if (!succeeded_) {
+    output_.clear();
+    // The error queue is thread local, so clear it rather than leaving it to the next operation
+    // performed on this thread.
+    ERR_clear_error();
+  }
+}
+
+bool PrivateKeyOperation::sign() {
+  if (EVP_PKEY_id(pkey_.get()) != SSL_get_signature_algorithm_key_type(signature_algorithm_)) {
+    return false;
+  }
+  // The digest is null for Ed25519, which signs the input itself.
+  const EVP_MD* md = SSL_get_signature_algorithm_digest(signature_algorithm_);
+  bssl::ScopedEVP_MD_CTX ctx;
+  EVP_PKEY_CTX* pctx;
+  if (!EVP_DigestSignInit(ctx.get(), &pctx, md, nullptr, pkey_.get())) {
+    return false;
+  }
+  if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm_) &&
+      (!EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PSS_PADDING) ||
+       !EVP_PKEY_CTX_set_rsa_pss_saltlen(pctx, -1 /* salt length is digest length */))) {
+    return false;
+  }
+  size_t out_len = EVP_PKEY_size(pkey_.get());
+  output_.resize(out_len);
+  if (!EVP_DigestSign(ctx.get(), output_.data(), &out_len, input_.data(), input_.size())) {
+    return false;
+  }
+  output_.resize(out_len);
+  return true;
+}
+
+bool PrivateKeyOperation::decrypt() {
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey_.get());
+  if (rsa == nullptr) {
+    return false;
+  }
+  size_t out_len = RSA_size(rsa);
+  output_.resize(out_len);
+  if (!RSA_decrypt(rsa, &out_len, output_.data(), output_.size(), input_.data(), input_.size(),
+                   RSA_NO_PADDING)) {
+    return false;
+  }
+  output_.resize(out_len);
+  return true;
+}
+
+void PrivateKeyOperation::complete() {
+  finished_ = true;
+  if (cb_ != nullptr) {
+    cb_->onPrivateKeyMethodComplete();
+  }
+}
+
+void WorkerHandle::post(Event::PostCb callback) {
+  absl::MutexLock lock(&mu_);
+  if (dispatcher_ != nullptr) {
+    dispatcher_->post(std::move(callback));
+  }
+}
+
+void WorkerHandle::close() {
+  absl::MutexLock lock(&mu_);
+  dispatcher_ = nullptr;
+}
+
+PrivateKeyThreadPool::PrivateKeyThreadPool(uint32_t thread_count,
+                                           Thread::ThreadFactory& thread_factory) {
+  ASSERT(thread_count > 0);
+  threads_.reserve(thread_count);
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    const Thread::Options options{absl::StrCat("pkey_pool_", i)};
+    threads_.push_back(thread_factory.createThread([this]() { work(); }, options));
+  }
+}
+
+PrivateKeyThreadPool::~PrivateKeyThreadPool() {
+  {
+    absl::MutexLock lock(&mu_);
+    terminating_ = true;
+  }
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+}
+
+void PrivateKeyThreadPool::submit(OperationBatch batch) {
+  absl::MutexLock lock(&mu_);
+  batches_.push_back(std::move(batch));
+}
+
+void PrivateKeyThreadPool::work() {
+  const auto has_work = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    return terminating_ || !batches_.empty();
+  };
+  while (true) {
+    OperationBatch batch;
+    {
+      absl::MutexLock lock(&mu_);
+      mu_.Await(absl::Condition(&has_work));
+      if (terminating_) {
+        return;
+      }
+      batch = std::move(batches_.front());
+      batches_.pop_front();
+    }
+    ENVOY_LOG(trace, "performing {} private key operations", batch.operations_.size());
+    for (const PrivateKeyOperationSharedPtr& operation : batch.operations_) {
+      operation->run();
+    }
+    batch.worker_->post([operations = std::move(batch.operations_)]() {
+      for (const PrivateKeyOperationSharedPtr& operation : operations) {
+        operation->complete();
+      }
+    });
+  }
+}
+
+std::shared_ptr<PrivateKeyThreadPoolRegistry>
+PrivateKeyThreadPoolRegistry::get(Server::Configuration::ServerFactoryContext& factory_context) {
+  // Pinned, so that providers created later still find the pools in use.
+  return factory_context.singletonManager().getTyped<PrivateKeyThreadPoolRegistry>(
+      SINGLETON_MANAGER_REGISTERED_NAME(private_key_thread_pool_registry),
+      [] { return std::make_shared<PrivateKeyThreadPoolRegistry>(); }, true);
+}
+
+PrivateKeyThreadPoolSharedPtr
+PrivateKeyThreadPoolRegistry::getOrCreate(uint32_t thread_count,
+                                          Thread::ThreadFactory& thread_factory) {
+  std::weak_ptr<PrivateKeyThreadPool>& entry = pools_[thread_count];
+  PrivateKeyThreadPoolSharedPtr pool = entry.lock();
+  if (pool == nullptr) {
+    pool = std::make_shared<PrivateKeyThreadPool>(thread_count, thread_factory);
+    entry = pool;
+  }
+  return pool;
+}
+
+OperationBatcher::OperationBatcher(Event::Dispatcher& dispatcher,
+                                   PrivateKeyThreadPoolSharedPtr pool, uint32_t max_batch_size,
+                                   ThreadPoolPrivateKeyStats& stats)
+    : worker_(std::make_shared<WorkerHandle>(dispatcher)), pool_(std::move(pool)),
+      max_batch_size_(max_batch_size), stats_(stats),
+      flush_cb_(dispatcher.createSchedulableCallback([this]() { flush(); })) {
+  pending_.reserve(max_batch_size_);
+}
+
+OperationBatcher::~OperationBatcher() { worker_->close(); }
+
+void OperationBatcher::add(PrivateKeyOperationSharedPtr operation) {
+  pending_.push_back(std::move(operation));
+  if (pending_.size() >= max_batch_size_) {
+    flush_cb_->cancel();
+    flush();
+  } else if (pending_.size() == 1) {
+    // Gather the operations started by the other handshakes of this event loop iteration.
+    flush_cb_->scheduleCallbackCurrentIteration();
+  }
+}
+
+void OperationBatcher::flush() {
+  if (pending_.empty()) {
+    return;
+  }
+  stats_.batch_sizes_.recordValue(pending_.size());
+  std::vector<PrivateKeyOperationSharedPtr> operations;
+  operations.reserve(max_batch_size_);
+  operations.swap(pending_);
+  pool_->submit(OperationBatch{worker_, std::move(operations)});
+}
+
+ThreadPoolPrivateKeyConnection::ThreadPoolPrivateKeyConnection(
+    Ssl::PrivateKeyConnectionCallbacks& cb, bssl::UniquePtr<EVP_PKEY> pkey,
+    OperationBatcher& batcher, ThreadPoolPrivateKeyStats& stats)
+    : cb_(cb), pkey_(std::move(pkey)), batcher_(batcher), stats_(stats) {}
+
+ThreadPoolPrivateKeyConnection::~ThreadPoolPrivateKeyConnection() {
+  if (operation_ != nullptr) {
+    operation_->cancel();
+  }
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::start(PrivateKeyOperation::Type type,
+                                                               uint16_t signature_algorithm,
+                                                               const uint8_t* in, size_t in_len) {
+  if (operation_ != nullptr) {
+    // BoringSSL doesn't start an operation before the previous one is complete.
+    return ssl_private_key_failure;
+  }
+  stats_.operations_.inc();
+  operation_ = std::make_shared<PrivateKeyOperation>(type, bssl::UpRef(pkey_), signature_algorithm,
+                                                     in, in_len, cb_);
+  batcher_.add(operation_);
+  return ssl_private_key_retry;
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::complete(uint8_t* out, size_t* out_len,
+                                                                  size_t max_out) {
+  if (operation_ == nullptr) {
+    return ssl_private_key_failure;
+  }
+  // The handshake may be resumed before the operation is complete, for instance when data
+  // arrives on the connection.
+  if (!operation_->finished()) {
+    return ssl_private_key_retry;
+  }
+  const PrivateKeyOperationSharedPtr operation = std::move(operation_);
+  const std::vector<uint8_t>& output = operation->output();
+  if (!operation->succeeded() || output.size() > max_out) {
+    stats_.failures_.inc();
+    return ssl_private_key_failure;
+  }
+  std::copy(output.begin(), output.end(), out);
+  *out_len = output.size();
+  return ssl_private_key_success;
+}
+
+namespace {
+
+ThreadPoolPrivateKeyConnection* getConnection(SSL* ssl) {
+  return ssl == nullptr
+             ? nullptr
+             : static_cast<ThreadPoolPrivateKeyConnection*>(
+                   SSL_get_ex_data(ssl, ThreadPoolPrivateKeyMethodProvider::connectionIndex()));
+}
+
+ssl_private_key_result_t privateKeySign(SSL* ssl, uint8_t*, size_t*, size_t,
+                                        uint16_t signature_algorithm, const uint8_t* in,
+                                        size_t in_len) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection(ssl);
+  if (connection == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return connection->start(PrivateKeyOperation::Type::Sign, signature_algorithm, in, in_len);
+}
+
+ssl_private_key_result_t privateKeyDecrypt(SSL* ssl, uint8_t*, size_t*, size_t, const uint8_t* in,
+                                           size_t in_len) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection(ssl);
+  if (connection == nullptr || EVP_PKEY_id(connection->privateKey()) != EVP_PKEY_RSA) {
+    return ssl_private_key_failure;
+  }
+  return connection->start(PrivateKeyOperation::Type::Decrypt, 0, in, in_len);
+}
+
+ssl_private_key_result_t privateKeyComplete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                            size_t max_out) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection(ssl);
+  if (connection == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return connection->complete(out, out_len, max_out);
+}
+
+ThreadPoolPrivateKeyStats generateStats(const std::string& prefix, Stats::Scope& scope) {
+  return ThreadPoolPrivateKeyStats{ALL_THREAD_POOL_PRIVATE_KEY_STATS(
+      POOL_COUNTER_PREFIX(scope, prefix), POOL_HISTOGRAM_PREFIX(scope, prefix))};
+}
+
+int createIndex() {
+  int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  RELEASE_ASSERT(index >= 0, "Failed to get SSL user data index.");
+  return index;
+}
+
+} // namespace
+
+ThreadPoolPrivateKeyMethodProvider::ThreadPoolPrivateKeyMethodProvider(
+    const envoy::extensions::private_key_providers::thread_pool::v3::
+        ThreadPoolPrivateKeyMethodConfig& config,
+    Server::Configuration::TransportSocketFactoryContext& factory_context)
+    : stats_(generateStats("thread_pool_private_key", factory_context.statsScope())),
+      tls_(ThreadLocal::TypedSlot<OperationBatcher>::makeUnique(
+          factory_context.serverFactoryContext().threadLocal())) {
+  Server::Configuration::ServerFactoryContext& server_context =
+      factory_context.serverFactoryContext();
+  const std::string private_key = THROW_OR_RETURN_VALUE(
+      Config::DataSource::read(config.private_key(), false, server_context.api()), std::string);
+  bssl::UniquePtr<BIO> bio(
+      BIO_new_mem_buf(const_cast<char*>(private_key.data()), private_key.size()));
+  pkey_.reset(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  if (pkey_ == nullptr) {
+    throw EnvoyException("Failed to read private key.");
+  }
+  switch (EVP_PKEY_id(pkey_.get())) {
+  case EVP_PKEY_RSA:
+  case EVP_PKEY_EC:
+  case EVP_PKEY_ED25519:
+    break;
+  default:
+    throw EnvoyException("Not supported key type, only RSA, EC and Ed25519 are supported.");
+  }
+
+  method_ = std::make_shared<SSL_PRIVATE_KEY_METHOD>();
+  method_->sign = privateKeySign;
+  method_->decrypt = privateKeyDecrypt;
+  method_->complete = privateKeyComplete;
+
+  PrivateKeyThreadPoolSharedPtr pool =
+      PrivateKeyThreadPoolRegistry::get(server_context)
+          ->getOrCreate(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, thread_count, 2),
+                        server_context.api().threadFactory());
+  const uint32_t max_batch_size = PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_batch_size, 16);
+  // A batcher per worker thread, so that operations are gathered without locking.
+  tls_->set([pool, max_batch_size, this](Event::Dispatcher& dispatcher) {
+    return std::make_shared<OperationBatcher>(dispatcher, pool, max_batch_size, stats_);
+  });
+}
+
+void ThreadPoolPrivateKeyMethodProvider::registerPrivateKeyMethod(
+    SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher&) {
+  if (SSL_get_ex_data(ssl, connectionIndex()) != nullptr) {
+    throw EnvoyException("Not registering the thread pool provider twice for same context");
+  }
+  ASSERT(tls_->currentThreadRegistered(), "Current thread needs to be registered.");
+  SSL_set_ex_data(ssl, connectionIndex(),
+                  new ThreadPoolPrivateKeyConnection(cb, bssl::UpRef(pkey_), tls_->get().ref(),
+                                                     stats_));
+}
+
+void ThreadPoolPrivateKeyMethodProvider::unregisterPrivateKeyMethod(SSL* ssl) {
+  ThreadPoolPrivateKeyConnection* connection =
+      static_cast<ThreadPoolPrivateKeyConnection*>(SSL_get_ex_data(ssl, connectionIndex()));
+  SSL_set_ex_data(ssl, connectionIndex(), nullptr);
+  delete connection;
+}
+
+bool ThreadPoolPrivateKeyMethodProvider::checkFips() {
+  // The operations are performed by BoringSSL, so the key only has to pass the checks that
+  // keys used directly by the TLS context do.
+  switch (EVP_PKEY_id(pkey_.get())) {
+  case EVP_PKEY_RSA:
+    return RSA_check_fips(EVP_PKEY_get0_RSA(pkey_.get()));
+  case EVP_PKEY_EC:
+    return EC_KEY_check_fips(EVP_PKEY_get0_EC_KEY(pkey_.get()));
+  default:
+    return false;
+  }
+}
+
+int ThreadPoolPrivateKeyMethodProvider::connectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
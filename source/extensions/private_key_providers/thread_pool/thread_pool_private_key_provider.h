@@ -0,0 +1,243 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/schedulable_cb.h"
+#include "envoy/extensions/private_key_providers/thread_pool/v3/thread_pool.pb.h"
+#include "envoy/server/factory_context.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/ssl/private_key/private_key.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread/thread.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+#define ALL_THREAD_POOL_PRIVATE_KEY_STATS(COUNTER, HISTOGRAM)                                      \
+  COUNTER(operations)                                                                              \
+  COUNTER(failures)                                                                                \
+  HISTOGRAM(batch_sizes, Unspecified)
+
+/**
+ * Thread pool private key provider stats. @see stats_macros.h
+ */
+struct ThreadPoolPrivateKeyStats {
+  ALL_THREAD_POOL_PRIVATE_KEY_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
+};
+
+// A private key operation of a handshake. It is created on the worker thread of the connection,
+// performed on a pool thread, and completed back on the worker thread.
+class PrivateKeyOperation {
+public:
+  enum class Type { Sign, Decrypt };
+
+  PrivateKeyOperation(Type type, bssl::UniquePtr<EVP_PKEY> pkey, uint16_t signature_algorithm,
+                      const uint8_t* in, size_t in_len, Ssl::PrivateKeyConnectionCallbacks& cb);
+
+  // Performs the operation. Called on a pool thread.
+  void run();
+
+  // Marks the operation as finished and resumes the handshake, unless the connection is gone.
+  // Called on the worker thread.
+  void complete();
+
+  // Called on the worker thread when the connection is closed before the operation completed.
+  void cancel() { cb_ = nullptr; }
+
+  bool finished() const { return finished_; }
+  bool succeeded() const { return succeeded_; }
+  const std::vector<uint8_t>& output() const { return output_; }
+
+private:
+  bool sign();
+  bool decrypt();
+
+  const Type type_;
+  const bssl::UniquePtr<EVP_PKEY> pkey_;
+  const uint16_t signature_algorithm_;
+  const std::vector<uint8_t> input_;
+
+  // Written on the pool thread, and read on the worker thread once the operation is complete.
+  std::vector<uint8_t> output_;
+  bool succeeded_{};
+
+  // Only accessed on the worker thread.
+  Ssl::PrivateKeyConnectionCallbacks* cb_;
+  bool finished_{};
+};
+
+using PrivateKeyOperationSharedPtr = std::shared_ptr<PrivateKeyOperation>;
+
+// The dispatcher of a worker thread, to which the pool threads post completed operations. It is
+// closed when the worker thread shuts down, after which completed operations are dropped.
+class WorkerHandle {
+public:
+  explicit WorkerHandle(Event::Dispatcher& dispatcher) : dispatcher_(&dispatcher) {}
+
+  // Posts the callback to the worker thread, unless the handle is closed.
+  void post(Event::PostCb callback);
+  void close();
+
+private:
+  absl::Mutex mu_;
+  Event::Dispatcher* dispatcher_ ABSL_GUARDED_BY(mu_);
+};
+
+using WorkerHandleSharedPtr = std::shared_ptr<WorkerHandle>;
+
+// Operations started on a worker thread, which are performed and completed together.
+struct OperationBatch {
+  WorkerHandleSharedPtr worker_;
+  std::vector<PrivateKeyOperationSharedPtr> operations_;
+};
+
+/**
+ * Threads dedicated to private key operations. Each thread takes a whole batch at a time from
+ * a shared queue, performs its operations, and posts them back to their worker thread with a
+ * single post.
+ *
+ * The class is final, as the threads may still be running during the destructor.
+ */
+class PrivateKeyThreadPool final : public Logger::Loggable<Logger::Id::connection> {
+public:
+  PrivateKeyThreadPool(uint32_t thread_count, Thread::ThreadFactory& thread_factory);
+
+  /**
+   * The destructor blocks until the batches in progress are done and the threads are joined.
+   * Queued batches are dropped.
+   */
+  ~PrivateKeyThreadPool();
+
+  /**
+   * Queues a batch of operations. May be called on any thread.
+   */
+  void submit(OperationBatch batch);
+
+private:
+  void work();
+
+  absl::Mutex mu_;
+  std::deque<OperationBatch> batches_ ABSL_GUARDED_BY(mu_);
+  bool terminating_ ABSL_GUARDED_BY(mu_) = false;
+
+  // It is important that threads_ be last, as the new threads run with 'this' and may access
+  // any other members.
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+using PrivateKeyThreadPoolSharedPtr = std::shared_ptr<PrivateKeyThreadPool>;
+
+/**
+ * Hands out the thread pool with a given number of threads, so that the providers of all the
+ * certificates configured with the same number of threads share the threads. Only used on the
+ * main thread, where providers are created.
+ */
+class PrivateKeyThreadPoolRegistry : public Singleton::Instance {
+public:
+  /**
+   * @return the server's registry.
+   */
+  static std::shared_ptr<PrivateKeyThreadPoolRegistry>
+  get(Server::Configuration::ServerFactoryContext& factory_context);
+
+  /**
+   * @return the pool with the given number of threads, creating it if no provider uses it.
+   */
+  PrivateKeyThreadPoolSharedPtr getOrCreate(uint32_t thread_count,
+                                            Thread::ThreadFactory& thread_factory);
+
+private:
+  absl::flat_hash_map<uint32_t, std::weak_ptr<PrivateKeyThreadPool>> pools_;
+};
+
+// Gathers the operations started on a worker thread, and submits them to the pool at the end of
+// the event loop iteration, or as soon as the batch is full.
+class OperationBatcher : public ThreadLocal::ThreadLocalObject {
+public:
+  OperationBatcher(Event::Dispatcher& dispatcher, PrivateKeyThreadPoolSharedPtr pool,
+                   uint32_t max_batch_size, ThreadPoolPrivateKeyStats& stats);
+  ~OperationBatcher() override;
+
+  void add(PrivateKeyOperationSharedPtr operation);
+
+private:
+  void flush();
+
+  const WorkerHandleSharedPtr worker_;
+  const PrivateKeyThreadPoolSharedPtr pool_;
+  const uint32_t max_batch_size_;
+  ThreadPoolPrivateKeyStats& stats_;
+  std::vector<PrivateKeyOperationSharedPtr> pending_;
+  Event::SchedulableCallbackPtr flush_cb_;
+};
+
+// The data of the provider for a given SSL connection.
+class ThreadPoolPrivateKeyConnection {
+public:
+  ThreadPoolPrivateKeyConnection(Ssl::PrivateKeyConnectionCallbacks& cb,
+                                 bssl::UniquePtr<EVP_PKEY> pkey, OperationBatcher& batcher,
+                                 ThreadPoolPrivateKeyStats& stats);
+  ~ThreadPoolPrivateKeyConnection();
+
+  ssl_private_key_result_t start(PrivateKeyOperation::Type type, uint16_t signature_algorithm,
+                                 const uint8_t* in, size_t in_len);
+  ssl_private_key_result_t complete(uint8_t* out, size_t* out_len, size_t max_out);
+
+  EVP_PKEY* privateKey() const { return pkey_.get(); }
+
+private:
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  const bssl::UniquePtr<EVP_PKEY> pkey_;
+  OperationBatcher& batcher_;
+  ThreadPoolPrivateKeyStats& stats_;
+  PrivateKeyOperationSharedPtr operation_;
+};
+
+// ThreadPoolPrivateKeyMethodProvider offloads the private key operations of SSL sockets to
+// a thread pool.
+class ThreadPoolPrivateKeyMethodProvider : public virtual Ssl::PrivateKeyMethodProvider,
+                                           public Logger::Loggable<Logger::Id::connection> {
+public:
+  ThreadPoolPrivateKeyMethodProvider(
+      const envoy::extensions::private_key_providers::thread_pool::v3::
+          ThreadPoolPrivateKeyMethodConfig& config,
+      Server::Configuration::TransportSocketFactoryContext& factory_context);
+
+  // Ssl::PrivateKeyMethodProvider
+  void registerPrivateKeyMethod(SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb,
+                                Event::Dispatcher& dispatcher) override;
+  void unregisterPrivateKeyMethod(SSL* ssl) override;
+  bool checkFips() override;
+  bool isAvailable() override { return true; }
+  Ssl::BoringSslPrivateKeyMethodSharedPtr getBoringSslPrivateKeyMethod() override {
+    return method_;
+  }
+
+  static int connectionIndex();
+
+private:
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  ThreadPoolPrivateKeyStats stats_;
+  ThreadLocal::TypedSlotPtr<OperationBatcher> tls_;
+};
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -49,14 +49,15 @@ UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
                              const Statsd::TagFormat& tag_format)
     : tls_(tls.allocateSlot()), server_address_(std::move(address)), use_tag_(use_tag),
       prefix_(prefix.empty() ? Statsd::getDefaultPrefix() : prefix),
-      buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
+      buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format),
+      flush_writer_(std::make_shared<WriterImpl>(*this)) {
   tls_->set([this](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr {
     return std::make_shared<WriterImpl>(*this);
   });
 }
 
 void UdpStatsdSink::flush(Stats::MetricSnapshot& snapshot) {
-  Writer& writer = tls_->getTyped<Writer>();
+  Writer& writer = *flush_writer_;
   Buffer::OwnedImpl buffer;
 
   for (const auto& counter : snapshot.counters()) {
@@ -390,7 +391,8 @@ void TcpStatsdSink::TlsSink::write(Buffer::Instance& buffer) {
                                      cluster_traffic_stats.upstream_cx_rx_bytes_buffered_,
                                      cluster_traffic_stats.upstream_cx_tx_bytes_total_,
                                      cluster_traffic_stats.upstream_cx_tx_bytes_buffered_,
-                                     &cluster_traffic_stats.bind_errors_, nullptr});
+                                     &cluster_traffic_stats.bind_errors_, nullptr, nullptr,
+                                     nullptr});
     connection_->connect();
   }
 
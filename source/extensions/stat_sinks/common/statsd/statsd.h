@@ -52,7 +52,7 @@ public:
                 const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat())
       : tls_(tls.allocateSlot()), use_tag_(use_tag),
         prefix_(prefix.empty() ? getDefaultPrefix() : prefix),
-        buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
+        buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format), flush_writer_(writer) {
     tls_->set(
         [writer](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr { return writer; });
   }
@@ -60,6 +60,7 @@ public:
   // Stats::Sink
   void flush(Stats::MetricSnapshot& snapshot) override;
   void onHistogramComplete(const Stats::Histogram& histogram, uint64_t value) override;
+  bool flushOnSinkThread() const override { return true; }
 
   bool getUseTagForTest() { return use_tag_; }
   uint64_t getBufferSizeForTest() { return buffer_size_; }
@@ -98,6 +99,8 @@ private:
   const std::string prefix_;
   const uint64_t buffer_size_;
   const Statsd::TagFormat tag_format_;
+  // Used by flush(), which runs on the stats sink thread where there is no thread local writer.
+  const std::shared_ptr<Writer> flush_writer_;
 };
 
 /**
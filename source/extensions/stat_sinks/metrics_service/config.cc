@@ -39,7 +39,8 @@ MetricsServiceSinkFactory::createStatsSink(const Protobuf::Message& config,
                                              envoy::service::metrics::v3::StreamMetricsResponse>>(
       grpc_metrics_streamer,
       PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, report_counters_as_deltas, false),
-      sink_config.emit_tags_as_labels(), sink_config.histogram_emit_mode());
+      sink_config.emit_tags_as_labels(), sink_config.histogram_emit_mode(),
+      sink_config.report_changed_metrics_only());
 }
 
 ProtobufTypes::MessagePtr MetricsServiceSinkFactory::createEmptyConfigProto() {
@@ -133,25 +133,30 @@ template <class RequestProto, class ResponseProto> class MetricsServiceSink : pu
 public:
   MetricsServiceSink(
       const GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto>& grpc_metrics_streamer,
-      bool report_counters_as_deltas, bool emit_labels, HistogramEmitMode histogram_emit_mode)
+      bool report_counters_as_deltas, bool emit_labels, HistogramEmitMode histogram_emit_mode,
+      bool changed_stats_only = false)
       : MetricsServiceSink(
             grpc_metrics_streamer,
-            MetricsFlusher(report_counters_as_deltas, emit_labels, histogram_emit_mode)) {}
+            MetricsFlusher(report_counters_as_deltas, emit_labels, histogram_emit_mode),
+            changed_stats_only) {}
 
   MetricsServiceSink(
       const GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto>& grpc_metrics_streamer,
-      MetricsFlusher&& flusher)
-      : flusher_(std::move(flusher)), grpc_metrics_streamer_(std::move(grpc_metrics_streamer)) {}
+      MetricsFlusher&& flusher, bool changed_stats_only = false)
+      : flusher_(std::move(flusher)), grpc_metrics_streamer_(std::move(grpc_metrics_streamer)),
+        changed_stats_only_(changed_stats_only) {}
 
   // MetricsService::Sink
   void flush(Stats::MetricSnapshot& snapshot) override {
     grpc_metrics_streamer_->send(flusher_.flush(snapshot));
   }
   void onHistogramComplete(const Stats::Histogram&, uint64_t) override {}
+  bool changedStatsOnly() const override { return changed_stats_only_; }
 
 private:
   const MetricsFlusher flusher_;
   GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto> grpc_metrics_streamer_;
+  const bool changed_stats_only_;
 };
 
 } // namespace MetricsService
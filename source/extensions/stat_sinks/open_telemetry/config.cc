@@ -39,7 +39,8 @@ OpenTelemetrySinkFactory::createStatsSink(const Protobuf::Message& config,
         std::make_shared<OpenTelemetryGrpcMetricsExporterImpl>(otlp_options,
                                                                client_or_error.value());
 
-    return std::make_unique<OpenTelemetryGrpcSink>(otlp_metrics_flusher, grpc_metrics_exporter);
+    return std::make_unique<OpenTelemetryGrpcSink>(otlp_metrics_flusher, grpc_metrics_exporter,
+                                                   otlp_options->reportChangedMetricsOnly());
   }
 
   default:
@@ -22,6 +22,7 @@ OtlpOptions::OtlpOptions(const SinkConfig& sink_config,
                          const Tracers::OpenTelemetry::Resource& resource)
     : report_counters_as_deltas_(sink_config.report_counters_as_deltas()),
       report_histograms_as_deltas_(sink_config.report_histograms_as_deltas()),
+      report_changed_metrics_only_(sink_config.report_changed_metrics_only()),
       emit_tags_as_attributes_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, emit_tags_as_attributes, true)),
       use_tag_extracted_name_(
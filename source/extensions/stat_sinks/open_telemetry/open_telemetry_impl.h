@@ -40,6 +40,7 @@ public:
 
   bool reportCountersAsDeltas() { return report_counters_as_deltas_; }
   bool reportHistogramsAsDeltas() { return report_histograms_as_deltas_; }
+  bool reportChangedMetricsOnly() const { return report_changed_metrics_only_; }
   bool emitTagsAsAttributes() { return emit_tags_as_attributes_; }
   bool useTagExtractedName() { return use_tag_extracted_name_; }
   const std::string& statPrefix() { return stat_prefix_; }
@@ -51,6 +52,7 @@ public:
 private:
   const bool report_counters_as_deltas_;
   const bool report_histograms_as_deltas_;
+  const bool report_changed_metrics_only_;
   const bool emit_tags_as_attributes_;
   const bool use_tag_extracted_name_;
   const std::string stat_prefix_;
@@ -155,8 +157,10 @@ using OpenTelemetryGrpcMetricsExporterImplPtr =
 class OpenTelemetryGrpcSink : public Stats::Sink {
 public:
   OpenTelemetryGrpcSink(const OtlpMetricsFlusherSharedPtr& otlp_metrics_flusher,
-                        const OpenTelemetryGrpcMetricsExporterSharedPtr& grpc_metrics_exporter)
-      : metrics_flusher_(otlp_metrics_flusher), metrics_exporter_(grpc_metrics_exporter) {}
+                        const OpenTelemetryGrpcMetricsExporterSharedPtr& grpc_metrics_exporter,
+                        bool changed_stats_only = false)
+      : metrics_flusher_(otlp_metrics_flusher), metrics_exporter_(grpc_metrics_exporter),
+        changed_stats_only_(changed_stats_only) {}
 
   // Stats::Sink
   void flush(Stats::MetricSnapshot& snapshot) override {
@@ -164,10 +168,12 @@ public:
   }
 
   void onHistogramComplete(const Stats::Histogram&, uint64_t) override {}
+  bool changedStatsOnly() const override { return changed_stats_only_; }
 
 private:
   const OtlpMetricsFlusherSharedPtr metrics_flusher_;
   const OpenTelemetryGrpcMetricsExporterSharedPtr metrics_exporter_;
+  const bool changed_stats_only_;
 };
 
 } // namespace OpenTelemetry
@@ -119,9 +119,9 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
       route_config_provider_(server.timeSource()),
       scoped_route_config_provider_(server.timeSource()), clusters_handler_(server),
       config_dump_handler_(config_tracker_, server), init_dump_handler_(server),
-      stats_handler_(server), logs_handler_(server), profiling_handler_(profile_path),
-      runtime_handler_(server), listeners_handler_(server), server_cmd_handler_(server),
-      server_info_handler_(server),
+      stats_handler_(server, factory_context_), logs_handler_(server),
+      profiling_handler_(profile_path), runtime_handler_(server), listeners_handler_(server),
+      server_cmd_handler_(server), server_info_handler_(server),
       // TODO(jsedgwick) add /runtime_reset endpoint that removes all admin-set values
       handlers_{
           makeHandler("/", "Admin home page", MAKE_ADMIN_HANDLER(handlerAdminHome), false, false),
@@ -223,19 +223,7 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
           makeHandler("/ready", "print server state, return 200 if LIVE, otherwise return 503",
                       MAKE_ADMIN_HANDLER(server_info_handler_.handlerReady), false, false),
           stats_handler_.statsHandler(false /* not active mode */),
-          makeHandler("/stats/prometheus", "print server stats in prometheus format",
-                      MAKE_ADMIN_HANDLER(stats_handler_.handlerPrometheusStats), false, false,
-                      {{ParamDescriptor::Type::Boolean, "usedonly",
-                        "Only include stats that have been written by system since restart"},
-                       {ParamDescriptor::Type::Boolean, "text_readouts",
-                        "Render text_readouts as new gaugues with value 0 (increases Prometheus "
-                        "data size)"},
-                       {ParamDescriptor::Type::String, "filter",
-                        "Regular expression (Google re2) for filtering stats"},
-                       {ParamDescriptor::Type::Enum,
-                        "histogram_buckets",
-                        "Histogram bucket display mode",
-                        {"cumulative", "summary"}}}),
+          stats_handler_.prometheusHandler(),
           makeHandler("/stats/recentlookups", "Show recent stat-name lookups",
                       MAKE_ADMIN_HANDLER(stats_handler_.handlerStatsRecentLookups), false, false),
           makeHandler("/stats/recentlookups/clear", "clear list of stat-name lookups and counter",
@@ -1,19 +1,41 @@
 #include "source/server/admin/prometheus_stats.h"
 
 #include <cmath>
+#include <limits>
 
 #include "source/common/common/empty_string.h"
 #include "source/common/common/macros.h"
 #include "source/common/common/regex.h"
+#include "source/common/http/headers.h"
 #include "source/common/stats/histogram_impl.h"
 #include "source/common/upstream/host_utility.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 
 namespace Envoy {
 namespace Server {
 
+class PrometheusStatsFormatter::Renderer::Phase {
+public:
+  virtual ~Phase() = default;
+
+  /**
+   * Renders the next metric family into response.
+   * @return false once all of the families have been rendered.
+   */
+  virtual bool renderNextFamily(Buffer::Instance& response) PURE;
+
+  /**
+   * @return the number of metric families rendered so far.
+   */
+  uint64_t familyCount() const { return family_count_; }
+
+protected:
+  uint64_t family_count_{0};
+};
+
 namespace {
 
 const Regex::CompiledGoogleReMatcher& promRegex() {
@@ -71,43 +93,42 @@ std::string generateNumericOutput(uint64_t value, const Stats::TagVector& tags,
 }
 
 /*
- * Return the prometheus output for a numeric Stat (Counter or Gauge).
+ * Appends the prometheus output for a numeric Stat (Counter or Gauge).
  */
 template <class StatType>
-std::string generateStatNumericOutput(const StatType& metric,
-                                      const std::string& prefixed_tag_extracted_name) {
-  return generateNumericOutput(metric.value(), metric.tags(), prefixed_tag_extracted_name);
+void generateStatNumericOutput(const StatType& metric,
+                               const std::string& prefixed_tag_extracted_name,
+                               const std::string& tags, std::string& output) {
+  absl::StrAppend(&output, prefixed_tag_extracted_name, "{", tags, "} ", metric.value(), "\n");
 }
 
 /*
- * Returns the prometheus output for a TextReadout in gauge format.
+ * Appends the prometheus output for a TextReadout in gauge format.
  * It is a workaround of a limitation of prometheus which stores only numeric metrics.
  * The output is a gauge named the same as a given text-readout. The value of returned gauge is
  * always equal to 0. Returned gauge contains all tags of a given text-readout and one additional
  * tag {"text_value":"textReadout.value"}.
  */
-std::string generateTextReadoutOutput(const Stats::TextReadout& text_readout,
-                                      const std::string& prefixed_tag_extracted_name) {
-  auto tags = text_readout.tags();
-  tags.push_back(Stats::Tag{"text_value", text_readout.value()});
-  const std::string formattedTags = PrometheusStatsFormatter::formattedTags(tags);
-  return fmt::format("{0}{{{1}}} 0\n", prefixed_tag_extracted_name, formattedTags);
+void generateTextReadoutOutput(const Stats::TextReadout& text_readout,
+                               const std::string& prefixed_tag_extracted_name,
+                               const std::string& tags, std::string& output) {
+  absl::StrAppend(&output, prefixed_tag_extracted_name, "{", tags, tags.empty() ? "" : ",",
+                  "text_value=\"", sanitizeValue(text_readout.value()), "\"} 0\n");
 }
 
 /*
- * Returns the prometheus output for a histogram. The output is a multi-line string (with embedded
+ * Appends the prometheus output for a histogram. The output is a multi-line string (with embedded
  * newlines) that contains all the individual bucket counts and sum/count for a single histogram
  * (metric_name plus all tags).
  */
-std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
-                                    const std::string& prefixed_tag_extracted_name) {
-  const std::string tags = PrometheusStatsFormatter::formattedTags(histogram.tags());
-  const std::string hist_tags = histogram.tags().empty() ? EMPTY_STRING : (tags + ",");
+void generateHistogramOutput(const Stats::ParentHistogram& histogram,
+                             const std::string& prefixed_tag_extracted_name,
+                             const std::string& tags, std::string& output) {
+  const std::string hist_tags = tags.empty() ? EMPTY_STRING : (tags + ",");
 
   const Stats::HistogramStatistics& stats = histogram.cumulativeStatistics();
   Stats::ConstSupportedBuckets& supported_buckets = stats.supportedBuckets();
   const std::vector<uint64_t>& computed_buckets = stats.computedBuckets();
-  std::string output;
   for (size_t i = 0; i < supported_buckets.size(); ++i) {
     double bucket = supported_buckets[i];
     uint64_t value = computed_buckets[i];
@@ -126,142 +147,180 @@ std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
                             stats.sampleSum()));
   output.append(fmt::format("{0}_count{{{1}}} {2}\n", prefixed_tag_extracted_name, tags,
                             stats.sampleCount()));
-
-  return output;
 };
 
-/**
- * Processes a stat type (counter, gauge, histogram) by generating all output lines, sorting
- * them by tag-extracted metric name, and then outputting them in the correct sorted order into
- * response.
- *
- * @param response The buffer to put the output into.
- * @param used_only Whether to only output stats that are used.
- * @param regex A filter on which stats to output.
- * @param metrics The metrics to output stats for. This must contain all stats of the given type
- *        to be included in the same output.
- * @param generate_output A function which returns the output text for this metric.
- * @param type The name of the prometheus metric type for used in TYPE annotations.
+/*
+ * Appends the prometheus output for a summary. The output is a multi-line string (with embedded
+ * newlines) that contains all the individual quantile values and sum/count for a single histogram
+ * (metric_name plus all tags).
  */
-template <class StatType>
-uint64_t outputStatType(
-    Buffer::Instance& response, const StatsParams& params,
-    const std::vector<Stats::RefcountPtr<StatType>>& metrics,
-    const std::function<std::string(
-        const StatType& metric, const std::string& prefixed_tag_extracted_name)>& generate_output,
-    absl::string_view type, const Stats::CustomStatNamespaces& custom_namespaces) {
-
-  /*
-   * From
-   * https:*github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
-   *
-   * All lines for a given metric must be provided as one single group, with the optional HELP and
-   * TYPE lines first (in no particular order). Beyond that, reproducible sorting in repeated
-   * expositions is preferred but not required, i.e. do not sort if the computational cost is
-   * prohibitive.
-   */
+void generateSummaryOutput(const Stats::ParentHistogram& histogram,
+                           const std::string& prefixed_tag_extracted_name,
+                           const std::string& tags, std::string& output) {
+  const std::string hist_tags = tags.empty() ? EMPTY_STRING : (tags + ",");
 
-  // This is an unsorted collection of dumb-pointers (no need to increment then decrement every
-  // refcount; ownership is held throughout by `metrics`). It is unsorted for efficiency, but will
-  // be sorted before producing the final output to satisfy the "preferred" ordering from the
-  // prometheus spec: metrics will be sorted by their tags' textual representation, which will be
-  // consistent across calls.
-  using StatTypeUnsortedCollection = std::vector<const StatType*>;
-
-  // Return early to avoid crashing when getting the symbol table from the first metric.
-  if (metrics.empty()) {
-    return 0;
+  const Stats::HistogramStatistics& stats = histogram.intervalStatistics();
+  Stats::ConstSupportedBuckets& supported_quantiles = stats.supportedQuantiles();
+  const std::vector<double>& computed_quantiles = stats.computedQuantiles();
+  for (size_t i = 0; i < supported_quantiles.size(); ++i) {
+    double quantile = supported_quantiles[i];
+    double value = computed_quantiles[i];
+    output.append(fmt::format("{0}{{{1}quantile=\"{2}\"}} {3:.32g}\n", prefixed_tag_extracted_name,
+                              hist_tags, quantile, value));
   }
 
-  // There should only be one symbol table for all of the stats in the admin
-  // interface. If this assumption changes, the name comparisons in this function
-  // will have to change to compare to convert all StatNames to strings before
-  // comparison.
-  const Stats::SymbolTable& global_symbol_table = metrics.front()->constSymbolTable();
+  output.append(fmt::format("{0}_sum{{{1}}} {2:.32g}\n", prefixed_tag_extracted_name, tags,
+                            stats.sampleSum()));
+  output.append(fmt::format("{0}_count{{{1}}} {2}\n", prefixed_tag_extracted_name, tags,
+                            stats.sampleCount()));
+};
 
-  // Sorted collection of metrics sorted by their tagExtractedName, to satisfy the requirements
-  // of the exposition format.
-  std::map<Stats::StatName, StatTypeUnsortedCollection, Stats::StatNameLessThan> groups(
-      global_symbol_table);
+/*
+ * From
+ * https:*github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
+ *
+ * All lines for a given metric must be provided as one single group, with the optional HELP and
+ * TYPE lines first (in no particular order). Beyond that, reproducible sorting in repeated
+ * expositions is preferred but not required, i.e. do not sort if the computational cost is
+ * prohibitive.
+ *
+ * Each phase therefore groups all the stats of one type by their tag-extracted name up front, and
+ * then renders one group, i.e. one metric family, at a time.
+ */
 
-  for (const auto& metric : metrics) {
-    ASSERT(&global_symbol_table == &metric->constSymbolTable());
-    if (!params.shouldShowMetric(*metric)) {
-      continue;
+/**
+ * Renders a stat type (counter, gauge, text readout, histogram) grouped by tag-extracted metric
+ * name.
+ */
+template <class StatType> class StatPhase : public PrometheusStatsFormatter::Renderer::Phase {
+public:
+  using GenerateFn = void (*)(const StatType& metric,
+                              const std::string& prefixed_tag_extracted_name,
+                              const std::string& tags, std::string& output);
+
+  /**
+   * @param metrics The metrics to output stats for. This must contain all stats of the given type
+   *        to be included in the same output.
+   * @param generate_output A function which appends the output text for this metric.
+   * @param type The name of the prometheus metric type for used in TYPE annotations.
+   */
+  StatPhase(std::vector<Stats::RefcountPtr<StatType>> metrics, const StatsParams& params,
+            GenerateFn generate_output, absl::string_view type,
+            const Stats::CustomStatNamespaces& custom_namespaces, PrometheusNameCache* cache)
+      : metrics_(std::move(metrics)), generate_output_(generate_output), type_(type),
+        custom_namespaces_(custom_namespaces), cache_(cache) {
+    // Return early to avoid crashing when getting the symbol table from the first metric.
+    if (metrics_.empty()) {
+      return;
     }
-    groups[metric->tagExtractedStatName()].push_back(metric.get());
+
+    // There should only be one symbol table for all of the stats in the admin
+    // interface. If this assumption changes, the name comparisons in this function
+    // will have to change to compare to convert all StatNames to strings before
+    // comparison.
+    const Stats::SymbolTable& global_symbol_table = metrics_.front()->constSymbolTable();
+    groups_ = std::make_unique<GroupMap>(global_symbol_table);
+
+    // The groups hold dumb-pointers (no need to increment then decrement every refcount;
+    // ownership is held throughout by `metrics_`).
+    for (const auto& metric : metrics_) {
+      ASSERT(&global_symbol_table == &metric->constSymbolTable());
+      if (!params.shouldShowMetric(*metric)) {
+        continue;
+      }
+      (*groups_)[metric->tagExtractedStatName()].push_back(metric.get());
+    }
+    next_group_ = groups_->begin();
   }
 
-  auto result = groups.size();
-  for (auto& group : groups) {
-    const absl::optional<std::string> prefixed_tag_extracted_name =
-        PrometheusStatsFormatter::metricName(global_symbol_table.toString(group.first),
-                                             custom_namespaces);
+  // PrometheusStatsFormatter::Renderer::Phase
+  bool renderNextFamily(Buffer::Instance& response) override {
+    if (groups_ == nullptr || next_group_ == groups_->end()) {
+      return false;
+    }
+    auto& group = *next_group_++;
+    const absl::optional<std::string> prefixed_tag_extracted_name = familyName(group.first);
     if (!prefixed_tag_extracted_name.has_value()) {
-      --result;
-      continue;
+      return true;
     }
-    response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type));
+    ++family_count_;
+    std::string output =
+        absl::StrCat("# TYPE ", prefixed_tag_extracted_name.value(), " ", type_, "\n");
 
     // Sort before producing the final output to satisfy the "preferred" ordering from the
     // prometheus spec: metrics will be sorted by their tags' textual representation, which will
     // be consistent across calls.
     std::sort(group.second.begin(), group.second.end(), MetricLessThan());
 
-    for (const auto& metric : group.second) {
-      response.add(generate_output(*metric, prefixed_tag_extracted_name.value()));
+    for (const StatType* metric : group.second) {
+      generate_output_(*metric, prefixed_tag_extracted_name.value(), formattedTags(*metric),
+                       output);
     }
+    response.add(output);
+    return true;
   }
-  return result;
-}
 
-template <class StatType>
-uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams& params,
-                                 const std::vector<StatType>& metrics, absl::string_view type,
-                                 const Stats::CustomStatNamespaces& custom_namespaces) {
-
-  /*
-   * From
-   * https:*github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
-   *
-   * All lines for a given metric must be provided as one single group, with the optional HELP and
-   * TYPE lines first (in no particular order). Beyond that, reproducible sorting in repeated
-   * expositions is preferred but not required, i.e. do not sort if the computational cost is
-   * prohibitive.
-   */
+private:
+  using GroupMap =
+      std::map<Stats::StatName, std::vector<const StatType*>, Stats::StatNameLessThan>;
 
-  // This is an unsorted collection of dumb-pointers (no need to increment then decrement every
-  // refcount; ownership is held throughout by `metrics`). It is unsorted for efficiency, but will
-  // be sorted before producing the final output to satisfy the "preferred" ordering from the
-  // prometheus spec: metrics will be sorted by their tags' textual representation, which will be
-  // consistent across calls.
-  using StatTypeUnsortedCollection = std::vector<const StatType*>;
+  absl::optional<std::string> familyName(Stats::StatName tag_extracted_name) const {
+    if (cache_ != nullptr) {
+      return cache_->familyName(tag_extracted_name, custom_namespaces_);
+    }
+    return PrometheusStatsFormatter::metricName(
+        metrics_.front()->constSymbolTable().toString(tag_extracted_name), custom_namespaces_);
+  }
 
-  // Return early to avoid crashing when getting the symbol table from the first metric.
-  if (metrics.empty()) {
-    return 0;
+  const std::string& formattedTags(const StatType& metric) {
+    if (cache_ != nullptr) {
+      return cache_->formattedTags(metric);
+    }
+    tags_ = PrometheusStatsFormatter::formattedTags(metric.tags());
+    return tags_;
   }
 
-  // Sorted collection of metrics sorted by their tagExtractedName, to satisfy the requirements
-  // of the exposition format.
-  std::map<std::string, StatTypeUnsortedCollection> groups;
+  const std::vector<Stats::RefcountPtr<StatType>> metrics_;
+  const GenerateFn generate_output_;
+  const absl::string_view type_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  PrometheusNameCache* const cache_;
+  std::unique_ptr<GroupMap> groups_;
+  typename GroupMap::iterator next_group_;
+  std::string tags_;
+};
 
-  for (const auto& metric : metrics) {
-    if (!params.shouldShowMetric(metric)) {
-      continue;
+/**
+ * Renders the per-endpoint primitive stats of a type grouped by tag-extracted metric name.
+ */
+template <class StatType>
+class PrimitiveStatPhase : public PrometheusStatsFormatter::Renderer::Phase {
+public:
+  PrimitiveStatPhase(std::vector<StatType> metrics, const StatsParams& params,
+                     absl::string_view type, const Stats::CustomStatNamespaces& custom_namespaces)
+      : metrics_(std::move(metrics)), type_(type), custom_namespaces_(custom_namespaces) {
+    for (const auto& metric : metrics_) {
+      if (!params.shouldShowMetric(metric)) {
+        continue;
+      }
+      groups_[metric.tagExtractedName()].push_back(&metric);
     }
-    groups[metric.tagExtractedName()].push_back(&metric);
+    next_group_ = groups_.begin();
   }
 
-  auto result = groups.size();
-  for (auto& group : groups) {
+  // PrometheusStatsFormatter::Renderer::Phase
+  bool renderNextFamily(Buffer::Instance& response) override {
+    if (next_group_ == groups_.end()) {
+      return false;
+    }
+    auto& group = *next_group_++;
     const absl::optional<std::string> prefixed_tag_extracted_name =
-        PrometheusStatsFormatter::metricName(group.first, custom_namespaces);
+        PrometheusStatsFormatter::metricName(group.first, custom_namespaces_);
     if (!prefixed_tag_extracted_name.has_value()) {
-      --result;
-      continue;
+      return true;
     }
-    response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type));
+    ++family_count_;
+    response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type_));
 
     // Sort before producing the final output to satisfy the "preferred" ordering from the
     // prometheus spec: metrics will be sorted by their tags' textual representation, which will
@@ -272,37 +331,19 @@ uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams&
       response.add(generateNumericOutput(metric->value(), metric->tags(),
                                          prefixed_tag_extracted_name.value()));
     }
-  }
-  return result;
-}
-
-/*
- * Returns the prometheus output for a summary. The output is a multi-line string (with embedded
- * newlines) that contains all the individual quantile values and sum/count for a single histogram
- * (metric_name plus all tags).
- */
-std::string generateSummaryOutput(const Stats::ParentHistogram& histogram,
-                                  const std::string& prefixed_tag_extracted_name) {
-  const std::string tags = PrometheusStatsFormatter::formattedTags(histogram.tags());
-  const std::string hist_tags = histogram.tags().empty() ? EMPTY_STRING : (tags + ",");
-
-  const Stats::HistogramStatistics& stats = histogram.intervalStatistics();
-  Stats::ConstSupportedBuckets& supported_quantiles = stats.supportedQuantiles();
-  const std::vector<double>& computed_quantiles = stats.computedQuantiles();
-  std::string output;
-  for (size_t i = 0; i < supported_quantiles.size(); ++i) {
-    double quantile = supported_quantiles[i];
-    double value = computed_quantiles[i];
-    output.append(fmt::format("{0}{{{1}quantile=\"{2}\"}} {3:.32g}\n", prefixed_tag_extracted_name,
-                              hist_tags, quantile, value));
+    return true;
   }
 
-  output.append(fmt::format("{0}_sum{{{1}}} {2:.32g}\n", prefixed_tag_extracted_name, tags,
-                            stats.sampleSum()));
-  output.append(fmt::format("{0}_count{{{1}}} {2}\n", prefixed_tag_extracted_name, tags,
-                            stats.sampleCount()));
+private:
+  // Sorted collection of metrics sorted by their tagExtractedName, to satisfy the requirements
+  // of the exposition format.
+  using GroupMap = std::map<std::string, std::vector<const StatType*>>;
 
-  return output;
+  const std::vector<StatType> metrics_;
+  const absl::string_view type_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  GroupMap groups_;
+  typename GroupMap::iterator next_group_;
 };
 
 } // namespace
@@ -358,37 +399,72 @@ PrometheusStatsFormatter::metricName(const std::string& extracted_name,
   return absl::StrCat("envoy_", sanitizeName(extracted_name));
 }
 
-uint64_t PrometheusStatsFormatter::statsAsPrometheus(
-    const std::vector<Stats::CounterSharedPtr>& counters,
-    const std::vector<Stats::GaugeSharedPtr>& gauges,
-    const std::vector<Stats::ParentHistogramSharedPtr>& histograms,
-    const std::vector<Stats::TextReadoutSharedPtr>& text_readouts,
-    const Upstream::ClusterManager& cluster_manager, Buffer::Instance& response,
-    const StatsParams& params, const Stats::CustomStatNamespaces& custom_namespaces) {
+const absl::optional<std::string>&
+PrometheusNameCache::familyName(Stats::StatName tag_extracted_name,
+                                const Stats::CustomStatNamespaces& custom_namespaces) {
+  return lookup(family_names_, tag_extracted_name, [&]() {
+    return PrometheusStatsFormatter::metricName(symbol_table_.toString(tag_extracted_name),
+                                                custom_namespaces);
+  });
+}
 
-  uint64_t metric_name_count = 0;
-  metric_name_count += outputStatType<Stats::Counter>(response, params, counters,
-                                                      generateStatNumericOutput<Stats::Counter>,
-                                                      "counter", custom_namespaces);
+const std::string& PrometheusNameCache::formattedTags(const Stats::Metric& metric) {
+  return lookup(formatted_tags_, metric.statName(),
+                [&]() { return PrometheusStatsFormatter::formattedTags(metric.tags()); });
+}
+
+template <class Value, class ComputeFn>
+const Value& PrometheusNameCache::lookup(EntryMap<Value>& map, Stats::StatName name,
+                                         ComputeFn compute) {
+  auto it = map.find(name);
+  if (it == map.end()) {
+    auto entry = std::make_unique<Entry<Value>>(name, symbol_table_);
+    entry->value_ = compute();
+    // The key refers to the storage held by the entry, which keeps the name's symbols alive.
+    const Stats::StatName key = entry->name_.statName();
+    it = map.emplace(key, std::move(entry)).first;
+  }
+  it->second->generation_ = generation_;
+  return it->second->value_;
+}
 
-  metric_name_count += outputStatType<Stats::Gauge>(response, params, gauges,
-                                                    generateStatNumericOutput<Stats::Gauge>,
-                                                    "gauge", custom_namespaces);
+void PrometheusNameCache::endScrape() {
+  auto unused = [this](const auto& item) { return item.second->generation_ != generation_; };
+  absl::erase_if(family_names_, unused);
+  absl::erase_if(formatted_tags_, unused);
+  ++generation_;
+}
+
+PrometheusStatsFormatter::Renderer::Renderer(
+    std::vector<Stats::CounterSharedPtr> counters, std::vector<Stats::GaugeSharedPtr> gauges,
+    std::vector<Stats::ParentHistogramSharedPtr> histograms,
+    std::vector<Stats::TextReadoutSharedPtr> text_readouts,
+    const Upstream::ClusterManager& cluster_manager, const StatsParams& params,
+    const Stats::CustomStatNamespaces& custom_namespaces, PrometheusNameCache* cache) {
+  phases_.push_back(std::make_unique<StatPhase<Stats::Counter>>(
+      std::move(counters), params, generateStatNumericOutput<Stats::Counter>, "counter",
+      custom_namespaces, cache));
+  phases_.push_back(std::make_unique<StatPhase<Stats::Gauge>>(
+      std::move(gauges), params, generateStatNumericOutput<Stats::Gauge>, "gauge",
+      custom_namespaces, cache));
 
   // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
-  metric_name_count += outputStatType<Stats::TextReadout>(
-      response, params, text_readouts, generateTextReadoutOutput, "gauge", custom_namespaces);
+  phases_.push_back(std::make_unique<StatPhase<Stats::TextReadout>>(
+      std::move(text_readouts), params, generateTextReadoutOutput, "gauge", custom_namespaces,
+      cache));
 
   // validation of bucket modes is handled separately
   switch (params.histogram_buckets_mode_) {
   case Utility::HistogramBucketsMode::Summary:
-    metric_name_count += outputStatType<Stats::ParentHistogram>(
-        response, params, histograms, generateSummaryOutput, "summary", custom_namespaces);
+    phases_.push_back(std::make_unique<StatPhase<Stats::ParentHistogram>>(
+        std::move(histograms), params, generateSummaryOutput, "summary", custom_namespaces,
+        cache));
     break;
   case Utility::HistogramBucketsMode::Unset:
   case Utility::HistogramBucketsMode::Cumulative:
-    metric_name_count += outputStatType<Stats::ParentHistogram>(
-        response, params, histograms, generateHistogramOutput, "histogram", custom_namespaces);
+    phases_.push_back(std::make_unique<StatPhase<Stats::ParentHistogram>>(
+        std::move(histograms), params, generateHistogramOutput, "histogram", custom_namespaces,
+        cache));
     break;
   // "Detailed" and "Disjoint" don't make sense for prometheus histogram semantics
   case Utility::HistogramBucketsMode::Detailed:
@@ -409,14 +485,87 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
       },
       [&](Stats::PrimitiveGaugeSnapshot&& metric) { host_gauges.emplace_back(std::move(metric)); });
 
-  metric_name_count +=
-      outputPrimitiveStatType(response, params, host_counters, "counter", custom_namespaces);
+  phases_.push_back(std::make_unique<PrimitiveStatPhase<Stats::PrimitiveCounterSnapshot>>(
+      std::move(host_counters), params, "counter", custom_namespaces));
+  phases_.push_back(std::make_unique<PrimitiveStatPhase<Stats::PrimitiveGaugeSnapshot>>(
+      std::move(host_gauges), params, "gauge", custom_namespaces));
+}
 
-  metric_name_count +=
-      outputPrimitiveStatType(response, params, host_gauges, "gauge", custom_namespaces);
+PrometheusStatsFormatter::Renderer::~Renderer() = default;
 
+bool PrometheusStatsFormatter::Renderer::nextChunk(Buffer::Instance& response,
+                                                   uint64_t chunk_size) {
+  const uint64_t starting_response_length = response.length();
+  while (current_phase_ < phases_.size()) {
+    if (!phases_[current_phase_]->renderNextFamily(response)) {
+      ++current_phase_;
+    } else if (response.length() - starting_response_length >= chunk_size) {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t PrometheusStatsFormatter::Renderer::metricNameCount() const {
+  uint64_t metric_name_count = 0;
+  for (const auto& phase : phases_) {
+    metric_name_count += phase->familyCount();
+  }
   return metric_name_count;
 }
 
+uint64_t PrometheusStatsFormatter::statsAsPrometheus(
+    const std::vector<Stats::CounterSharedPtr>& counters,
+    const std::vector<Stats::GaugeSharedPtr>& gauges,
+    const std::vector<Stats::ParentHistogramSharedPtr>& histograms,
+    const std::vector<Stats::TextReadoutSharedPtr>& text_readouts,
+    const Upstream::ClusterManager& cluster_manager, Buffer::Instance& response,
+    const StatsParams& params, const Stats::CustomStatNamespaces& custom_namespaces) {
+  Renderer renderer(counters, gauges, histograms, text_readouts, cluster_manager, params,
+                    custom_namespaces, nullptr);
+  while (renderer.nextChunk(response, std::numeric_limits<uint64_t>::max())) {
+  }
+  return renderer.metricNameCount();
+}
+
+PrometheusStatsRequest::PrometheusStatsRequest(
+    Stats::Store& stats, const StatsParams& params,
+    const Upstream::ClusterManager& cluster_manager,
+    const Stats::CustomStatNamespaces& custom_namespaces, PrometheusNameCache& cache,
+    Compression::Compressor::CompressorPtr compressor, absl::string_view content_encoding)
+    : stats_(stats), params_(params), cluster_manager_(cluster_manager),
+      custom_namespaces_(custom_namespaces), cache_(cache), compressor_(std::move(compressor)),
+      content_encoding_(content_encoding) {}
+
+Http::Code PrometheusStatsRequest::start(Http::ResponseHeaderMap& response_headers) {
+  renderer_ = std::make_unique<PrometheusStatsFormatter::Renderer>(
+      stats_.counters(), stats_.gauges(), stats_.histograms(),
+      params_.prometheus_text_readouts_ ? stats_.textReadouts()
+                                        : std::vector<Stats::TextReadoutSharedPtr>(),
+      cluster_manager_, params_, custom_namespaces_, &cache_);
+  if (compressor_ != nullptr) {
+    response_headers.setCopy(Http::CustomHeaders::get().ContentEncoding, content_encoding_);
+    response_headers.setReference(Http::CustomHeaders::get().Vary,
+                                  Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+  }
+  return Http::Code::OK;
+}
+
+bool PrometheusStatsRequest::nextChunk(Buffer::Instance& response) {
+  // The caller does not have to drain the response between calls, so only the newly rendered
+  // data is compressed.
+  Buffer::OwnedImpl chunk;
+  const bool more = renderer_->nextChunk(chunk, chunk_size_);
+  if (compressor_ != nullptr) {
+    compressor_->compress(chunk, more ? Compression::Compressor::State::Flush
+                                      : Compression::Compressor::State::Finish);
+  }
+  response.move(chunk);
+  if (!more) {
+    cache_.endScrape();
+  }
+  return more;
+}
+
 } // namespace Server
 } // namespace Envoy
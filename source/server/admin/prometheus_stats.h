@@ -4,14 +4,72 @@
 #include <string>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/compression/compressor/compressor.h"
+#include "envoy/server/admin.h"
 #include "envoy/stats/custom_stat_namespaces.h"
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/store.h"
 
+#include "source/common/stats/symbol_table.h"
 #include "source/server/admin/stats_params.h"
 
 namespace Envoy {
 namespace Server {
+
+/**
+ * Caches the Prometheus family names and formatted tags of stats across scrapes, so that the name
+ * lookups, tag extraction and sanitization are only done for stats that were not rendered by the
+ * previous scrape. Entries that are not used by a scrape are dropped when it ends. This is only
+ * used on the main thread.
+ *
+ * Family names are cached by tag-extracted name, which assumes that custom stat namespaces are
+ * registered before stats in them are created.
+ */
+class PrometheusNameCache {
+public:
+  explicit PrometheusNameCache(Stats::SymbolTable& symbol_table) : symbol_table_(symbol_table) {}
+
+  /**
+   * @return the family name for the given tag-extracted name, as computed by
+   *         PrometheusStatsFormatter::metricName().
+   */
+  const absl::optional<std::string>&
+  familyName(Stats::StatName tag_extracted_name,
+             const Stats::CustomStatNamespaces& custom_namespaces);
+
+  /**
+   * @return the tags of the metric, as formatted by PrometheusStatsFormatter::formattedTags().
+   */
+  const std::string& formattedTags(const Stats::Metric& metric);
+
+  /**
+   * Drops the entries that were not used since the previous call.
+   */
+  void endScrape();
+
+  uint64_t size() const { return family_names_.size() + formatted_tags_.size(); }
+
+private:
+  template <class Value> struct Entry {
+    Entry(Stats::StatName name, Stats::SymbolTable& symbol_table) : name_(name, symbol_table) {}
+
+    Stats::StatNameManagedStorage name_;
+    Value value_;
+    uint64_t generation_{0};
+  };
+  template <class Value>
+  using EntryMap = Stats::StatNameHashMap<std::unique_ptr<Entry<Value>>>;
+
+  template <class Value, class ComputeFn>
+  const Value& lookup(EntryMap<Value>& map, Stats::StatName name, ComputeFn compute);
+
+  Stats::SymbolTable& symbol_table_;
+  EntryMap<absl::optional<std::string>> family_names_;
+  EntryMap<std::string> formatted_tags_;
+  uint64_t generation_{0};
+};
+
 /**
  * Formatter for metric/labels exported to Prometheus.
  *
@@ -19,6 +77,43 @@ namespace Server {
  */
 class PrometheusStatsFormatter {
 public:
+  /**
+   * Renders stats one metric family at a time, so that the output can be streamed out in chunks
+   * instead of being rendered into a single buffer.
+   */
+  class Renderer {
+  public:
+    /**
+     * @param cache if not null, supplies the family names and tags, and is kept across renderers.
+     */
+    Renderer(std::vector<Stats::CounterSharedPtr> counters,
+             std::vector<Stats::GaugeSharedPtr> gauges,
+             std::vector<Stats::ParentHistogramSharedPtr> histograms,
+             std::vector<Stats::TextReadoutSharedPtr> text_readouts,
+             const Upstream::ClusterManager& cluster_manager, const StatsParams& params,
+             const Stats::CustomStatNamespaces& custom_namespaces, PrometheusNameCache* cache);
+    ~Renderer();
+
+    /**
+     * Renders metric families into response until at least chunk_size bytes have been added or
+     * all families have been rendered.
+     * @return true if there are more families to render.
+     */
+    bool nextChunk(Buffer::Instance& response, uint64_t chunk_size);
+
+    /**
+     * @return the number of metric families rendered so far.
+     */
+    uint64_t metricNameCount() const;
+
+    // The stats of one type, rendered one metric family at a time.
+    class Phase;
+
+  private:
+    std::vector<std::unique_ptr<Phase>> phases_;
+    size_t current_phase_{0};
+  };
+
   /**
    * Extracts counters and gauges and relevant tags, appending them to
    * the response buffer after sanitizing the metric / label names.
@@ -53,5 +148,42 @@ public:
              const Stats::CustomStatNamespaces& custom_namespace_factory);
 };
 
+/**
+ * Streams the Prometheus rendering of a stats store out in chunks, optionally compressing it.
+ */
+class PrometheusStatsRequest : public Admin::Request {
+public:
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+
+  /**
+   * @param compressor if set, the response is compressed with it.
+   * @param content_encoding the content-encoding matching the compressor.
+   */
+  PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                         const Upstream::ClusterManager& cluster_manager,
+                         const Stats::CustomStatNamespaces& custom_namespaces,
+                         PrometheusNameCache& cache,
+                         Compression::Compressor::CompressorPtr compressor = nullptr,
+                         absl::string_view content_encoding = "");
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+  // Sets the chunk size.
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
+
+private:
+  Stats::Store& stats_;
+  const StatsParams params_;
+  const Upstream::ClusterManager& cluster_manager_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  PrometheusNameCache& cache_;
+  Compression::Compressor::CompressorPtr compressor_;
+  const std::string content_encoding_;
+  std::unique_ptr<PrometheusStatsFormatter::Renderer> renderer_;
+  uint64_t chunk_size_{DefaultChunkSize};
+};
+
 } // namespace Server
 } // namespace Envoy
@@ -4,23 +4,67 @@
 #include <vector>
 
 #include "envoy/admin/v3/mutex_stats.pb.h"
+#include "envoy/compression/compressor/config.h"
+#include "envoy/registry/registry.h"
 #include "envoy/server/admin.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/empty_string.h"
+#include "source/common/http/header_utility.h"
 #include "source/common/http/headers.h"
 #include "source/common/http/utility.h"
 #include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_request.h"
 
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
 
 namespace Envoy {
 namespace Server {
 
 const uint64_t RecentLookupsCapacity = 100;
 
-StatsHandler::StatsHandler(Server::Instance& server) : HandlerContextBase(server) {}
+namespace {
+
+struct PrometheusEncoding {
+  absl::string_view content_encoding_;
+  absl::string_view compressor_factory_name_;
+};
+
+// The encodings Prometheus responses can be compressed with, in order of preference.
+constexpr PrometheusEncoding PrometheusEncodings[] = {
+    {"zstd", "envoy.compression.zstd.compressor"},
+    {"gzip", "envoy.compression.gzip.compressor"},
+};
+
+// Returns whether the accept-encoding header value lists the given content coding with a non-zero
+// quality value.
+bool acceptsEncoding(absl::string_view accept_encoding, absl::string_view content_encoding) {
+  for (absl::string_view coding : absl::StrSplit(accept_encoding, ',')) {
+    std::vector<absl::string_view> params = absl::StrSplit(coding, ';');
+    if (!absl::EqualsIgnoreCase(absl::StripAsciiWhitespace(params[0]), content_encoding)) {
+      continue;
+    }
+    for (size_t i = 1; i < params.size(); ++i) {
+      const absl::string_view param = absl::StripAsciiWhitespace(params[i]);
+      double quality;
+      if (absl::StartsWithIgnoreCase(param, "q=") &&
+          absl::SimpleAtod(param.substr(2), &quality) && quality <= 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+} // namespace
+
+StatsHandler::StatsHandler(Server::Instance& server,
+                           OptRef<Configuration::FactoryContext> factory_context)
+    : HandlerContextBase(server), factory_context_(factory_context) {}
 
 Http::Code StatsHandler::handlerResetCounters(Http::ResponseHeaderMap&, Buffer::Instance& response,
                                               AdminStream&) {
@@ -80,16 +124,7 @@ Admin::RequestPtr StatsHandler::makeRequest(AdminStream& admin_stream) {
   }
 
   if (params.format_ == StatsFormat::Prometheus) {
-    // TODO(#16139): modify streaming algorithm to cover Prometheus.
-    //
-    // This may be easiest to accomplish by populating the set
-    // with tagExtractedName(), and allowing for vectors of
-    // stats as multiples will have the same tag-extracted names.
-    // Ideally we'd find a way to do this without slowing down
-    // the non-Prometheus implementations.
-    Buffer::OwnedImpl response;
-    Http::Code code = prometheusFlushAndRender(params, response);
-    return Admin::makeStaticTextRequest(response, code);
+    return makePrometheusRequest(params, admin_stream);
   }
 
   if (server_.statsConfig().flushOnAdmin()) {
@@ -113,40 +148,84 @@ Admin::RequestPtr StatsHandler::makeRequest(Stats::Store& stats, const StatsPara
   return std::make_unique<StatsRequest>(stats, params, cluster_manager, url_handler_fn);
 }
 
-Http::Code StatsHandler::handlerPrometheusStats(Http::ResponseHeaderMap&,
-                                                Buffer::Instance& response,
-                                                AdminStream& admin_stream) {
-  return prometheusStats(admin_stream.getRequestHeaders().getPathValue(), response);
-}
-
-Http::Code StatsHandler::prometheusStats(absl::string_view path_and_query,
-                                         Buffer::Instance& response) {
+Admin::RequestPtr StatsHandler::makePrometheusRequest(AdminStream& admin_stream) {
   StatsParams params;
-  Http::Code code = params.parse(path_and_query, response);
+  Buffer::OwnedImpl response;
+  Http::Code code = params.parse(admin_stream.getRequestHeaders().getPathValue(), response);
   if (code != Http::Code::OK) {
-    return code;
-  }
-
-  if (server_.statsConfig().flushOnAdmin()) {
-    server_.flushStats();
+    return Admin::makeStaticTextRequest(response, code);
   }
-
-  return prometheusFlushAndRender(params, response);
+  return makePrometheusRequest(params, admin_stream);
 }
 
-Http::Code StatsHandler::prometheusFlushAndRender(const StatsParams& params,
-                                                  Buffer::Instance& response) {
+Admin::RequestPtr StatsHandler::makePrometheusRequest(const StatsParams& params,
+                                                      AdminStream& admin_stream) {
   absl::Status paramsStatus = PrometheusStatsFormatter::validateParams(params);
   if (!paramsStatus.ok()) {
+    Buffer::OwnedImpl response;
     response.add(paramsStatus.message());
-    return Http::Code::BadRequest;
+    return Admin::makeStaticTextRequest(response, Http::Code::BadRequest);
   }
   if (server_.statsConfig().flushOnAdmin()) {
     server_.flushStats();
   }
-  prometheusRender(server_.stats(), server_.api().customStatNamespaces(), server_.clusterManager(),
-                   params, response);
-  return Http::Code::OK;
+
+  if (prometheus_name_cache_ == nullptr) {
+    prometheus_name_cache_ = std::make_unique<PrometheusNameCache>(server_.stats().symbolTable());
+  }
+  Compression::Compressor::CompressorPtr compressor;
+  absl::string_view content_encoding;
+  Compression::Compressor::CompressorFactory* compressor_factory =
+      prometheusCompressorFactory(admin_stream.getRequestHeaders());
+  if (compressor_factory != nullptr) {
+    compressor = compressor_factory->createCompressor();
+    content_encoding = compressor_factory->contentEncoding();
+  }
+  return std::make_unique<PrometheusStatsRequest>(
+      server_.stats(), params, server_.clusterManager(), server_.api().customStatNamespaces(),
+      *prometheus_name_cache_, std::move(compressor), content_encoding);
+}
+
+Compression::Compressor::CompressorFactory*
+StatsHandler::prometheusCompressorFactory(const Http::RequestHeaderMap& request_headers) {
+  if (!factory_context_.has_value()) {
+    return nullptr;
+  }
+  const auto accept_encoding = Http::HeaderUtility::getAllOfHeaderAsString(
+      request_headers, Http::CustomHeaders::get().AcceptEncoding);
+  if (!accept_encoding.result().has_value()) {
+    return nullptr;
+  }
+  for (const PrometheusEncoding& encoding : PrometheusEncodings) {
+    if (!acceptsEncoding(accept_encoding.result().value(), encoding.content_encoding_)) {
+      continue;
+    }
+    Compression::Compressor::CompressorFactory* compressor_factory =
+        compressorFactory(encoding.compressor_factory_name_);
+    if (compressor_factory != nullptr) {
+      return compressor_factory;
+    }
+  }
+  return nullptr;
+}
+
+Compression::Compressor::CompressorFactory*
+StatsHandler::compressorFactory(absl::string_view factory_name) {
+  auto it = compressor_factories_.find(factory_name);
+  if (it != compressor_factories_.end()) {
+    return it->second.get();
+  }
+  // The compressors are extensions, so they are looked up by name and may not be compiled in.
+  Compression::Compressor::CompressorFactoryPtr compressor_factory;
+  auto* config_factory = Registry::FactoryRegistry<
+      Compression::Compressor::NamedCompressorLibraryConfigFactory>::getFactory(factory_name);
+  if (config_factory != nullptr) {
+    ProtobufTypes::MessagePtr config = config_factory->createEmptyConfigProto();
+    compressor_factory =
+        config_factory->createCompressorFactoryFromProto(*config, factory_context_.ref());
+  }
+  return compressor_factories_.emplace(factory_name, std::move(compressor_factory))
+      .first->second.get();
 }
 
 void StatsHandler::prometheusRender(Stats::Store& stats,
@@ -217,5 +296,26 @@ Admin::UrlHandler StatsHandler::statsHandler(bool active_mode) {
       params};
 }
 
+Admin::UrlHandler StatsHandler::prometheusHandler() {
+  return {"/stats/prometheus",
+          "print server stats in prometheus format",
+          [this](AdminStream& admin_stream) -> Admin::RequestPtr {
+            return makePrometheusRequest(admin_stream);
+          },
+          false,
+          false,
+          {{Admin::ParamDescriptor::Type::Boolean, "usedonly",
+            "Only include stats that have been written by system since restart"},
+           {Admin::ParamDescriptor::Type::Boolean, "text_readouts",
+            "Render text_readouts as new gaugues with value 0 (increases Prometheus "
+            "data size)"},
+           {Admin::ParamDescriptor::Type::String, "filter",
+            "Regular expression (Google re2) for filtering stats"},
+           {Admin::ParamDescriptor::Type::Enum,
+            "histogram_buckets",
+            "Histogram bucket display mode",
+            {"cumulative", "summary"}}}};
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -4,15 +4,20 @@
 #include <string>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/common/optref.h"
+#include "envoy/compression/compressor/factory.h"
 #include "envoy/http/codes.h"
 #include "envoy/http/header_map.h"
 #include "envoy/server/admin.h"
+#include "envoy/server/factory_context.h"
 #include "envoy/server/instance.h"
 
 #include "source/server/admin/handler_ctx.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_request.h"
 #include "source/server/admin/utils.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 
 namespace Envoy {
@@ -21,7 +26,11 @@ namespace Server {
 class StatsHandler : public HandlerContextBase {
 
 public:
-  StatsHandler(Server::Instance& server);
+  /**
+   * @param factory_context if set, used to create the compressors for Prometheus responses.
+   */
+  StatsHandler(Server::Instance& server,
+               OptRef<Configuration::FactoryContext> factory_context = absl::nullopt);
 
   Http::Code handlerResetCounters(Http::ResponseHeaderMap& response_headers,
                                   Buffer::Instance& response, AdminStream&);
@@ -33,26 +42,13 @@ public:
                                               Buffer::Instance& response, AdminStream&);
   Http::Code handlerStatsRecentLookupsEnable(Http::ResponseHeaderMap& response_headers,
                                              Buffer::Instance& response, AdminStream&);
-  Http::Code handlerPrometheusStats(Http::ResponseHeaderMap& response_headers,
-                                    Buffer::Instance& response, AdminStream&);
 
   /**
-   * Parses and executes a prometheus stats request.
-   *
-   * @param path_and_query the URL path and query
-   * @param response buffer into which to write response
-   * @return http response code
+   * Parses a prometheus stats request, returning a request that streams the stats out. The
+   * response is compressed with zstd or gzip when the client accepts it and the compressor
+   * extension is available.
    */
-  Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response);
-
-  /**
-   * Checks the server_ to see if a flush is needed, and then renders the
-   * prometheus stats request.
-   *
-   * @params params the already-parsed parameters.
-   * @param response buffer into which to write response
-   */
-  Http::Code prometheusFlushAndRender(const StatsParams& params, Buffer::Instance& response);
+  Admin::RequestPtr makePrometheusRequest(AdminStream& admin_stream);
 
   /**
    * Renders the stats as prometheus. This is broken out as a separately
@@ -87,15 +83,29 @@ public:
    */
   Admin::UrlHandler statsHandler(bool active_mode);
 
+  /**
+   * @return the URL handler for /stats/prometheus.
+   */
+  Admin::UrlHandler prometheusHandler();
+
   static Admin::RequestPtr makeRequest(Stats::Store& stats, const StatsParams& params,
                                        const Upstream::ClusterManager& cm,
                                        StatsRequest::UrlHandlerFn url_handler_fn = nullptr);
   Admin::RequestPtr makeRequest(AdminStream&);
 
 private:
-  static Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response,
-                                    Stats::Store& stats,
-                                    Stats::CustomStatNamespaces& custom_namespaces);
+  Admin::RequestPtr makePrometheusRequest(const StatsParams& params, AdminStream& admin_stream);
+  Compression::Compressor::CompressorFactory*
+  prometheusCompressorFactory(const Http::RequestHeaderMap& request_headers);
+  Compression::Compressor::CompressorFactory* compressorFactory(absl::string_view factory_name);
+
+  OptRef<Configuration::FactoryContext> factory_context_;
+  // Created on the first Prometheus request, and kept so that later scrapes reuse the names.
+  std::unique_ptr<PrometheusNameCache> prometheus_name_cache_;
+  // Compressor factories by extension name, created on first use. Null if the extension is not
+  // available.
+  absl::flat_hash_map<std::string, Compression::Compressor::CompressorFactoryPtr>
+      compressor_factories_;
 };
 
 } // namespace Server
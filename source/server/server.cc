@@ -1,5 +1,6 @@
 #include "source/server/server.h"
 
+#include <algorithm>
 #include <csignal>
 #include <cstdint>
 #include <ctime>
@@ -170,47 +171,58 @@ void InstanceBase::failHealthcheck(bool fail) {
 
 MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
                                        Upstream::ClusterManager& cluster_manager,
-                                       TimeSource& time_source) {
-  store.forEachSinkedCounter(
-      [this](std::size_t size) {
-        snapped_counters_.reserve(size);
-        counters_.reserve(size);
-      },
-      [this](Stats::Counter& counter) {
-        snapped_counters_.push_back(Stats::CounterSharedPtr(&counter));
-        counters_.push_back({counter.latch(), counter});
-      });
-
-  store.forEachSinkedGauge(
-      [this](std::size_t size) {
-        snapped_gauges_.reserve(size);
-        gauges_.reserve(size);
-      },
-      [this](Stats::Gauge& gauge) {
-        snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
-        gauges_.push_back(gauge);
-      });
+                                       TimeSource& time_source, bool changed_stats_only) {
+  auto counter_size = [this](std::size_t size) {
+    snapped_counters_.reserve(size);
+    counters_.reserve(size);
+  };
+  auto counter_stat = [this](Stats::Counter& counter) {
+    snapped_counters_.push_back(Stats::CounterSharedPtr(&counter));
+    counters_.push_back({counter.latch(), counter});
+  };
+  auto gauge_size = [this](std::size_t size) {
+    snapped_gauges_.reserve(size);
+    gauges_.reserve(size);
+  };
+  auto gauge_stat = [this](Stats::Gauge& gauge) {
+    snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
+    gauges_.push_back(gauge);
+  };
+  auto text_readout_size = [this](std::size_t size) {
+    snapped_text_readouts_.reserve(size);
+    text_readouts_.reserve(size);
+  };
+  auto text_readout_stat = [this](Stats::TextReadout& text_readout) {
+    snapped_text_readouts_.push_back(Stats::TextReadoutSharedPtr(&text_readout));
+    text_readouts_.push_back(text_readout);
+  };
+  if (changed_stats_only) {
+    store.forEachChangedCounter(counter_size, counter_stat);
+    store.forEachChangedGauge(gauge_size, gauge_stat);
+    store.forEachChangedTextReadout(text_readout_size, text_readout_stat);
+  } else {
+    store.forEachSinkedCounter(counter_size, counter_stat);
+    store.forEachSinkedGauge(gauge_size, gauge_stat);
+    store.forEachSinkedTextReadout(text_readout_size, text_readout_stat);
+  }
 
+  // Histograms are all walked by the merge anyway, so rather than tracking changes the ones without
+  // samples in the last interval are left out of snapshots of changed stats.
   store.forEachSinkedHistogram(
-      [this](std::size_t size) {
-        snapped_histograms_.reserve(size);
-        histograms_.reserve(size);
+      [this, changed_stats_only](std::size_t size) {
+        if (!changed_stats_only) {
+          snapped_histograms_.reserve(size);
+          histograms_.reserve(size);
+        }
       },
-      [this](Stats::ParentHistogram& histogram) {
+      [this, changed_stats_only](Stats::ParentHistogram& histogram) {
+        if (changed_stats_only && histogram.intervalStatistics().sampleCount() == 0) {
+          return;
+        }
         snapped_histograms_.push_back(Stats::ParentHistogramSharedPtr(&histogram));
         histograms_.push_back(histogram);
       });
 
-  store.forEachSinkedTextReadout(
-      [this](std::size_t size) {
-        snapped_text_readouts_.reserve(size);
-        text_readouts_.reserve(size);
-      },
-      [this](Stats::TextReadout& text_readout) {
-        snapped_text_readouts_.push_back(Stats::TextReadoutSharedPtr(&text_readout));
-        text_readouts_.push_back(text_readout);
-      });
-
   Upstream::HostUtility::forEachHostMetric(
       cluster_manager,
       [this](Stats::PrimitiveCounterSnapshot&& metric) {
@@ -223,15 +235,26 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
   snapshot_time_ = time_source.systemTime();
 }
 
-void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                       Upstream::ClusterManager& cm, TimeSource& time_source) {
-  // Create a snapshot and flush to all sinks.
+std::unique_ptr<Stats::MetricSnapshot>
+InstanceUtil::createMetricSnapshot(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
+                                   Upstream::ClusterManager& cm, TimeSource& time_source) {
   // NOTE: Even if there are no sinks, creating the snapshot has the important property that it
   //       latches all counters on a periodic basis. The hot restart code assumes this is being
   //       done so this should not be removed.
-  MetricSnapshotImpl snapshot(store, cm, time_source);
+  const bool changed_stats_only =
+      !sinks.empty() && std::all_of(sinks.begin(), sinks.end(), [](const Stats::SinkPtr& sink) {
+        return sink->changedStatsOnly();
+      });
+  return std::make_unique<MetricSnapshotImpl>(store, cm, time_source, changed_stats_only);
+}
+
+void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
+                                       Upstream::ClusterManager& cm, TimeSource& time_source) {
+  // Create a snapshot and flush to all sinks.
+  std::unique_ptr<Stats::MetricSnapshot> snapshot =
+      createMetricSnapshot(sinks, store, cm, time_source);
   for (const auto& sink : sinks) {
-    sink->flush(snapshot);
+    sink->flush(*snapshot);
   }
 }
 
@@ -290,8 +313,40 @@ void InstanceBase::updateServerStats() {
 void InstanceBase::flushStatsInternal() {
   updateServerStats();
   auto& stats_config = config_.statsConfig();
-  InstanceUtil::flushMetricsToSinks(stats_config.sinks(), stats_store_, clusterManager(),
-                                    timeSource());
+  if (stats_sink_dispatcher_ == nullptr) {
+    InstanceUtil::flushMetricsToSinks(stats_config.sinks(), stats_store_, clusterManager(),
+                                      timeSource());
+    finishStatsFlush();
+    return;
+  }
+
+  // The snapshot is handed to the sink thread for the sinks that opted in, and comes back to the
+  // main thread to be released once they are done. The flush stays in progress until then, so the
+  // next histogram merge cannot race with the sinks reading the snapshot.
+  std::unique_ptr<Stats::MetricSnapshot> snapshot = InstanceUtil::createMetricSnapshot(
+      stats_config.sinks(), stats_store_, clusterManager(), timeSource());
+  for (const Stats::SinkPtr& sink : stats_config.sinks()) {
+    if (!sink->flushOnSinkThread()) {
+      sink->flush(*snapshot);
+    }
+  }
+  stats_sink_dispatcher_->post([this, snapshot = std::move(snapshot)]() mutable {
+    for (const Stats::SinkPtr& sink : config_.statsConfig().sinks()) {
+      if (sink->flushOnSinkThread()) {
+        sink->flush(*snapshot);
+      }
+    }
+    dispatcher_->post([this, snapshot = std::move(snapshot)]() {
+      // The sink thread has been stopped by terminate(), which already ended this flush.
+      if (!terminated_) {
+        finishStatsFlush();
+      }
+    });
+  });
+}
+
+void InstanceBase::finishStatsFlush() {
+  auto& stats_config = config_.statsConfig();
   if (const auto evict_on_flush = stats_config.evictOnFlush(); evict_on_flush > 0) {
     stats_eviction_counter_ = (stats_eviction_counter_ + 1) % evict_on_flush;
     if (stats_eviction_counter_ == 0) {
@@ -841,8 +896,16 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
       [this]() { onClusterManagerPrimaryInitializationComplete(); });
 
   auto& stats_config = config_.statsConfig();
+  bool use_sink_thread = false;
   for (const Stats::SinkPtr& sink : stats_config.sinks()) {
     stats_store_.addSink(*sink);
+    use_sink_thread |= sink->flushOnSinkThread();
+  }
+  if (use_sink_thread) {
+    stats_sink_dispatcher_ = api_->allocateDispatcher("stats_sink");
+    stats_sink_thread_ = api_->threadFactory().createThread(
+        [this]() -> void { stats_sink_dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit); },
+        Thread::Options{std::string("stats_sink")});
   }
   if (!stats_config.flushOnAdmin()) {
     // Some of the stat sinks may need dispatcher support so don't flush until the main loop starts.
@@ -1099,6 +1162,10 @@ void InstanceBase::terminate() {
     listener_manager_->stopWorkers();
   }
 
+  // Let any flush running on the sink thread finish, so that the final flush below runs all of the
+  // sinks on this thread.
+  stopStatsSinkThread();
+
   // Only flush if we have not been hot restarted.
   if (stat_flush_timer_) {
     flushStats();
@@ -1115,6 +1182,18 @@ void InstanceBase::terminate() {
   FatalErrorHandler::clearFatalActionsOnTerminate();
 }
 
+void InstanceBase::stopStatsSinkThread() {
+  if (stats_sink_thread_ == nullptr) {
+    return;
+  }
+  stats_sink_dispatcher_->exit();
+  stats_sink_thread_->join();
+  stats_sink_thread_.reset();
+  // Any snapshot still queued for the sink thread is released here on the main thread.
+  stats_sink_dispatcher_.reset();
+  stats_flush_in_progress_ = false;
+}
+
 Runtime::Loader& InstanceBase::runtime() { return *runtime_; }
 
 void InstanceBase::shutdown() {
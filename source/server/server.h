@@ -22,6 +22,7 @@
 #include "envoy/ssl/context_manager.h"
 #include "envoy/stats/stats_macros.h"
 #include "envoy/stats/timespan.h"
+#include "envoy/thread/thread.h"
 #include "envoy/tracing/tracer.h"
 
 #include "source/common/access_log/access_log_manager_impl.h"
@@ -136,6 +137,16 @@ public:
   static void flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
                                   Upstream::ClusterManager& cm, TimeSource& time_source);
 
+  /**
+   * Create the snapshot that is flushed to sinks, latching all counters. Unchanged stats are left
+   * out when every sink only needs changed stats.
+   * @param sinks supplies the list of sinks the snapshot is for.
+   * @param store provides the store being flushed.
+   */
+  static std::unique_ptr<Stats::MetricSnapshot>
+  createMetricSnapshot(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
+                       Upstream::ClusterManager& cm, TimeSource& time_source);
+
   /**
    * Load a bootstrap config and perform validation.
    * @param bootstrap supplies the bootstrap to fill.
@@ -351,6 +362,8 @@ private:
 
   ProtobufTypes::MessagePtr dumpBootstrapConfig();
   void flushStatsInternal();
+  void finishStatsFlush();
+  void stopStatsSinkThread();
   void updateServerStats();
   // This does most of the work of initialization, but can throw or return errors caught
   // by initialize().
@@ -415,6 +428,9 @@ private:
   Configuration::MainImpl config_;
   Network::DnsResolverSharedPtr dns_resolver_;
   Event::TimerPtr stat_flush_timer_;
+  // Only created when a sink flushes on the sink thread.
+  Event::DispatcherPtr stats_sink_dispatcher_;
+  Thread::ThreadPtr stats_sink_thread_;
   DrainManagerPtr drain_manager_;
   std::unique_ptr<Upstream::ClusterManagerFactory> cluster_manager_factory_;
   std::unique_ptr<Server::GuardDog> main_thread_guard_dog_;
@@ -471,9 +487,10 @@ private:
 class MetricSnapshotImpl : public Stats::MetricSnapshot {
 public:
   // MetricSnapshotImpl captures a snapshot of metrics by latching the delta usage, and optionally
-  // marking the stats as used.
+  // marking the stats as used. With changed_stats_only, only the stats that changed since the
+  // previous such snapshot are captured.
   explicit MetricSnapshotImpl(Stats::Store& store, Upstream::ClusterManager& cluster_manager,
-                              TimeSource& time_source);
+                              TimeSource& time_source, bool changed_stats_only = false);
 
   // Stats::MetricSnapshot
   const std::vector<CounterSnapshot>& counters() override { return counters_; }
@@ -9,7 +9,9 @@
 #include "envoy/server/configuration.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/config/utility.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/server/listener_manager_factory.h"
 
 namespace Envoy {
@@ -48,7 +50,11 @@ WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
                        WorkerStatNames& stat_names)
     : tls_(tls), hooks_(hooks), dispatcher_(std::move(dispatcher)), handler_(std::move(handler)),
       api_(api), reset_streams_counter_(
-                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)) {
+                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)),
+      buffer_slice_cache_max_bytes_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.buffer_slice_storage_cache")
+              ? Buffer::SliceStorageCache::DefaultMaxCachedBytes
+              : 0) {
   tls_.registerThread(*dispatcher_, false);
   overload_manager.registerForAction(
       OverloadActionNames::get().StopAcceptingConnections, *dispatcher_,
@@ -59,6 +65,9 @@ WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
   overload_manager.registerForAction(
       OverloadActionNames::get().ResetStreams, *dispatcher_,
       [this](OverloadActionState state) { resetStreamsUsingExcessiveMemory(state); });
+  overload_manager.registerForAction(
+      OverloadActionNames::get().ShrinkBufferSliceCache, *dispatcher_,
+      [this](OverloadActionState state) { shrinkBufferSliceCacheCb(state); });
 }
 
 void WorkerImpl::addListener(absl::optional<uint64_t> overridden_listener,
@@ -144,6 +153,7 @@ void WorkerImpl::stopListener(Network::ListenerConfig& listener,
 
 void WorkerImpl::threadRoutine(OptRef<GuardDog> guard_dog, const std::function<void()>& cb) {
   ENVOY_LOG(debug, "worker entering dispatch loop");
+  Buffer::SliceStorageCache::setMaxCachedBytes(buffer_slice_cache_max_bytes_);
   // The watch dog must be created after the dispatcher starts running and has post events flushed,
   // as this is when TLS stat scopes start working.
   dispatcher_->post([this, &guard_dog, cb]() {
@@ -166,6 +176,7 @@ void WorkerImpl::threadRoutine(OptRef<GuardDog> guard_dog, const std::function<v
   handler_.reset();
   tls_.shutdownThread();
   watch_dog_.reset();
+  Buffer::SliceStorageCache::setMaxCachedBytes(0);
 }
 
 void WorkerImpl::stopAcceptingConnectionsCb(OverloadActionState state) {
@@ -186,5 +197,12 @@ void WorkerImpl::resetStreamsUsingExcessiveMemory(OverloadActionState state) {
   reset_streams_counter_.add(streams_reset_count);
 }
 
+void WorkerImpl::shrinkBufferSliceCacheCb(OverloadActionState state) {
+  // Scale the cache down as the action's pressure grows, releasing all of it once saturated.
+  const double retained = 1.0 - state.value().value();
+  Buffer::SliceStorageCache::setMaxCachedBytes(
+      static_cast<uint64_t>(buffer_slice_cache_max_bytes_ * retained));
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -74,6 +74,7 @@ private:
   void stopAcceptingConnectionsCb(OverloadActionState state);
   void rejectIncomingConnectionsCb(OverloadActionState state);
   void resetStreamsUsingExcessiveMemory(OverloadActionState state);
+  void shrinkBufferSliceCacheCb(OverloadActionState state);
 
   ThreadLocal::Instance& tls_;
   ListenerHooks& hooks_;
@@ -81,6 +82,8 @@ private:
   Network::ConnectionHandlerPtr handler_;
   Api::Api& api_;
   Stats::Counter& reset_streams_counter_;
+  // Bound of this worker's Buffer::SliceStorageCache when not under memory pressure.
+  const uint64_t buffer_slice_cache_max_bytes_;
   Thread::ThreadPtr thread_;
   WatchDogSharedPtr watch_dog_;
 };
@@ -11,6 +11,7 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/synchronization/notification.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -168,9 +169,9 @@ TEST_F(AccessLogManagerImplTest, FlushToLogFileOnDemand) {
 
   EXPECT_EQ(0UL, store_.counter("filesystem.flushed_by_timer").value());
 
-  // The first write to a given file will start the flush thread. Because AccessManagerImpl::write
-  // holds the write_lock_ when the thread is started, the thread will flush on its first loop, once
-  // it obtains the write_lock_. Perform a write to get all that out of the way.
+  // The first write to a given file will start the flush thread. Because AccessLogFileImpl::write
+  // buffers the data before the thread is started, the thread will flush on its first loop.
+  // Perform a write to get all that out of the way.
   EXPECT_CALL(*file_, write_(_))
       .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
         return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
@@ -443,6 +444,47 @@ TEST_F(AccessLogManagerImplTest, BigDataChunkShouldBeFlushedWithoutTimer) {
   EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+TEST_F(AccessLogManagerImplTest, DropWhenDiskFallsBehind) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager_
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  // Stall the flush thread inside its first disk write.
+  absl::Notification write_started;
+  absl::Notification unblock_write;
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([&](absl::string_view data) -> Api::IoCallSizeResult {
+        write_started.Notify();
+        unblock_write.WaitForNotification();
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }))
+      .WillRepeatedly(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  log_file->write("a");
+  write_started.WaitForNotification();
+
+  // "a" is still waiting to be written, so this does not fit and must be dropped without blocking.
+  log_file->write(std::string(AccessLogFileImpl::MAX_BUFFERED_SIZE, 'b'));
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_dropped").value());
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_buffered").value());
+
+  // Small writes are still accepted.
+  log_file->write("c");
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_dropped").value());
+  EXPECT_EQ(2UL, store_.counter("filesystem.write_buffered").value());
+
+  unblock_write.Notify();
+  log_file->flush();
+  EXPECT_TRUE(waitForCounterEq("filesystem.write_completed", 2));
+  EXPECT_TRUE(waitForGaugeEq("filesystem.write_total_buffered", 0));
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
   EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
 
@@ -558,4 +558,50 @@ BENCHMARK(bufferAddVsAddFragments)
     ->Args({1, 1, 64, 5})
     ->Args({1, 1, 4096, 5});
 
+// Simulate draining a write buffer filled by a gRPC streaming response: every message is a 9 byte
+// HTTP/2 frame header slice followed by a DATA payload slice. Each loop iteration emulates one
+// writev() of up to 16 slices, optionally coalescing small slices first. The writev counter reports
+// the number of simulated syscalls needed to drain the buffer.
+static void bufferCoalesceForWrite(benchmark::State& state) {
+  static constexpr uint64_t MaxWriteSlices = 16;
+  static constexpr uint64_t CoalesceThreshold = 1024;
+  static constexpr uint64_t Messages = 256;
+  static constexpr uint64_t FrameHeaderSize = 9;
+
+  const uint64_t payload_size = state.range(0);
+  const bool coalesce = state.range(1) != 0;
+  const std::string frame_header(FrameHeaderSize, 'h');
+  const std::string payload(payload_size, 'p');
+
+  uint64_t writes = 0;
+  for (auto _ : state) { // NOLINT
+    Buffer::OwnedImpl buffer;
+    for (uint64_t i = 0; i < Messages; ++i) {
+      buffer.appendSliceForTest(frame_header);
+      buffer.appendSliceForTest(payload);
+    }
+    while (buffer.length() > 0) {
+      if (coalesce) {
+        buffer.coalesceForWrite(MaxWriteSlices, CoalesceThreshold);
+      }
+      uint64_t write_size = 0;
+      for (const Buffer::RawSlice& slice : buffer.getRawSlices(MaxWriteSlices)) {
+        write_size += slice.len_;
+      }
+      buffer.drain(write_size);
+      ++writes;
+    }
+  }
+  state.counters["writev"] = benchmark::Counter(writes, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(bufferCoalesceForWrite)
+    ->Args({16, 0})
+    ->Args({16, 1})
+    ->Args({128, 0})
+    ->Args({128, 1})
+    ->Args({900, 0})
+    ->Args({900, 1})
+    ->Args({16384, 0})
+    ->Args({16384, 1});
+
 } // namespace Envoy
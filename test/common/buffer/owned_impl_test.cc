@@ -732,6 +732,83 @@ TEST_F(OwnedImplTest, LinearizeDrainTracking) {
   expectSlices({}, buffer);
 }
 
+TEST_F(OwnedImplTest, CoalesceForWriteFewSlices) {
+  Buffer::OwnedImpl buffer;
+  for (int i = 0; i < 4; ++i) {
+    buffer.appendSliceForTest(std::string(10, 'a' + i));
+  }
+
+  // Nothing is copied when a single write already covers every slice.
+  const CoalesceResult result = buffer.coalesceForWrite(4, 1024);
+  EXPECT_EQ(0, result.bytes_copied_);
+  EXPECT_EQ(4, result.write_slices_);
+  EXPECT_EQ(4, buffer.describeSlicesForTest().size());
+}
+
+TEST_F(OwnedImplTest, CoalesceForWriteSmallSlices) {
+  Buffer::OwnedImpl buffer;
+  std::string expected;
+  for (int i = 0; i < 40; ++i) {
+    const std::string data(10, 'a' + (i % 26));
+    buffer.appendSliceForTest(data);
+    expected += data;
+  }
+
+  const CoalesceResult result = buffer.coalesceForWrite(16, 1024);
+  EXPECT_EQ(400, result.bytes_copied_);
+  EXPECT_EQ(1, result.write_slices_);
+  EXPECT_EQ(1, buffer.describeSlicesForTest().size());
+  EXPECT_EQ(expected, buffer.toString());
+  EXPECT_EQ(1, buffer.getRawSlices(16).size());
+}
+
+TEST_F(OwnedImplTest, CoalesceForWriteKeepsLargeAndUnownedSlices) {
+  Buffer::OwnedImpl buffer;
+  std::string expected;
+
+  // Frame header, large payload, frame header, unowned fragment, then small slices.
+  buffer.appendSliceForTest("hdr1");
+  buffer.appendSliceForTest(std::string(4096, 'x'));
+  buffer.appendSliceForTest("hdr2");
+  std::string frag_input(10, 'f');
+  BufferFragmentImpl frag(
+      frag_input.c_str(), frag_input.size(),
+      [this](const void*, size_t, const BufferFragmentImpl*) { release_callback_called_ = true; });
+  buffer.addBufferFragment(frag);
+  expected = "hdr1" + std::string(4096, 'x') + "hdr2" + frag_input;
+  for (int i = 0; i < 8; ++i) {
+    buffer.appendSliceForTest("small");
+    expected += "small";
+  }
+
+  const CoalesceResult result = buffer.coalesceForWrite(5, 1024);
+  EXPECT_EQ(40, result.bytes_copied_);
+  EXPECT_EQ(5, result.write_slices_);
+  EXPECT_EQ(expected, buffer.toString());
+
+  // The large slice and the fragment are still written from their own storage, the trailing small
+  // slices are merged into one.
+  const RawSliceVector slices = buffer.getRawSlices();
+  ASSERT_EQ(5, slices.size());
+  EXPECT_EQ(4096, slices[1].len_);
+  EXPECT_EQ(frag_input.c_str(), slices[3].mem_);
+  EXPECT_EQ(40, slices[4].len_);
+  EXPECT_FALSE(release_callback_called_);
+}
+
+TEST_F(OwnedImplTest, CoalesceForWriteDrainTracking) {
+  Buffer::OwnedImpl buffer;
+  testing::MockFunction<void()> tracker;
+  for (int i = 0; i < 20; ++i) {
+    buffer.appendSliceForTest("abc");
+  }
+  buffer.addDrainTracker(tracker.AsStdFunction());
+
+  buffer.coalesceForWrite(16, 1024);
+  EXPECT_CALL(tracker, Call());
+  buffer.drain(buffer.length());
+}
+
 TEST_F(OwnedImplTest, ReserveCommit) {
   // This fragment will later be added to the buffer. It is declared in an enclosing scope to
   // ensure it is not destructed until after the buffer is.
@@ -938,6 +1015,48 @@ TEST_F(OwnedImplTest, SliceFreeList) {
   }
 }
 
+TEST_F(OwnedImplTest, SliceStorageCache) {
+  // The cache is disabled until the thread bounds it.
+  {
+    Buffer::OwnedImpl buffer(std::string(100, 'a'));
+  }
+  EXPECT_EQ(0, SliceStorageCache::cachedBytes());
+
+  SliceStorageCache::setMaxCachedBytes(3 * 4096);
+  void* first_storage;
+  {
+    Buffer::OwnedImpl buffer(std::string(100, 'a'));
+    first_storage = buffer.getRawSlices()[0].mem_;
+  }
+  EXPECT_EQ(4096, SliceStorageCache::cachedBytes());
+
+  {
+    // A slice of the same size class reuses the cached storage.
+    Buffer::OwnedImpl buffer(std::string(200, 'b'));
+    EXPECT_EQ(first_storage, buffer.getRawSlices()[0].mem_);
+    EXPECT_EQ(0, SliceStorageCache::cachedBytes());
+  }
+
+  {
+    // 3 pages is not a size class, and 16kb does not fit in the bound.
+    Buffer::OwnedImpl buffer1(std::string(3 * 4096, 'c'));
+    Buffer::OwnedImpl buffer2(std::string(16384, 'd'));
+  }
+  EXPECT_EQ(4096, SliceStorageCache::cachedBytes());
+
+  {
+    Buffer::OwnedImpl buffer1(std::string(8192, 'e'));
+    Buffer::OwnedImpl buffer2(std::string(100, 'f'));
+  }
+  EXPECT_EQ(3 * 4096, SliceStorageCache::cachedBytes());
+
+  // Shrinking the bound releases the largest storage first.
+  SliceStorageCache::setMaxCachedBytes(2 * 4096);
+  EXPECT_EQ(4096, SliceStorageCache::cachedBytes());
+  SliceStorageCache::setMaxCachedBytes(0);
+  EXPECT_EQ(0, SliceStorageCache::cachedBytes());
+}
+
 TEST_F(OwnedImplTest, Search) {
   // Populate a buffer with a string split across many small slices, to
   // exercise edge cases in the search implementation.
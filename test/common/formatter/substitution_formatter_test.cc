@@ -4695,6 +4695,46 @@ TEST(SubstitutionFormatterTest, CompositeFormatterEmpty) {
   }
 }
 
+TEST(SubstitutionFormatterTest, CompositeFormatterAppend) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{"first", "GET"}, {":path", "/"}};
+  Http::TestResponseHeaderMapImpl response_header{{"second", "PUT"}};
+  Http::TestResponseTrailerMapImpl response_trailer{{"third", "POST"}};
+  std::string body;
+
+  HttpFormatterContext formatter_context(&request_header, &response_header, &response_trailer,
+                                         body);
+
+  EXPECT_CALL(stream_info, bytesReceived()).WillRepeatedly(Return(1024));
+  EXPECT_CALL(stream_info, protocol()).WillRepeatedly(Return(absl::nullopt));
+  EXPECT_CALL(stream_info, currentDuration())
+      .WillRepeatedly(Return(std::chrono::nanoseconds(15000000)));
+
+  const std::string format = "%REQ(first):2% %RESP(second)% %TRAILER(third)% %RESP(not_exist)% "
+                             "%BYTES_RECEIVED% %PROTOCOL% %DURATION%";
+
+  {
+    FormatterPtr formatter = *FormatterImpl::create(format, false);
+    const std::string expected = "GE PUT POST - 1024 - 15";
+    EXPECT_EQ(expected, formatter->formatWithContext(formatter_context, stream_info));
+
+    // Output is appended to whatever the buffer already holds.
+    std::string output = "prefix:";
+    formatter->appendWithContext(formatter_context, stream_info, output);
+    EXPECT_EQ("prefix:" + expected, output);
+    formatter->appendWithContext(formatter_context, stream_info, output);
+    EXPECT_EQ("prefix:" + expected + expected, output);
+  }
+
+  {
+    FormatterPtr formatter = *FormatterImpl::create(format, true);
+    std::string output;
+    formatter->appendWithContext(formatter_context, stream_info, output);
+    EXPECT_EQ("GE PUT POST  1024  15", output);
+    EXPECT_EQ(output, formatter->formatWithContext(formatter_context, stream_info));
+  }
+}
+
 TEST(SubstitutionFormatterTest, ParserFailures) {
   SubstitutionFormatParser parser;
 
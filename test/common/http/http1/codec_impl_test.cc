@@ -1209,6 +1209,74 @@ TEST_F(Http1ServerConnectionImplTest, SimpleGet) {
   EXPECT_EQ(Protocol::Http11, codec_->protocol());
 }
 
+// Verify that with zero copy headers enabled, header names, values and the path reference the
+// parser storage, and stay valid after the connection has moved on to a pipelined request.
+TEST_F(Http1ServerConnectionImplTest, ZeroCopyHeadersOutliveNextRequest) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.http1_zero_copy_headers", "true"}});
+  initialize();
+
+  MockRequestDecoder decoder;
+  EXPECT_CALL(callbacks_, newStream(_, _)).Times(2).WillRepeatedly(ReturnRef(decoder));
+
+  RequestHeaderMapSharedPtr first_headers;
+  RequestHeaderMapSharedPtr second_headers;
+  EXPECT_CALL(decoder, decodeHeaders_(_, true))
+      .WillOnce(Invoke([&](RequestHeaderMapSharedPtr& headers, bool) { first_headers = headers; }))
+      .WillOnce(
+          Invoke([&](RequestHeaderMapSharedPtr& headers, bool) { second_headers = headers; }));
+
+  Buffer::OwnedImpl buffer(
+      "GET /first HTTP/1.1\r\nHost: Example.COM  \r\nX-Custom:   a b\r\n\r\n");
+  EXPECT_TRUE(codec_->dispatch(buffer).ok());
+  ASSERT_NE(nullptr, first_headers);
+  ASSERT_NE(nullptr, first_headers->Path());
+  EXPECT_TRUE(first_headers->Path()->value().isReference());
+  EXPECT_TRUE(first_headers->Host()->value().isReference());
+  EXPECT_EQ("Example.COM", first_headers->getHostValue());
+  const auto custom = first_headers->get(LowerCaseString("x-custom"));
+  ASSERT_EQ(1, custom.size());
+  EXPECT_TRUE(custom[0]->key().isReference());
+  EXPECT_TRUE(custom[0]->value().isReference());
+
+  // Mutating a referenced value copies it.
+  first_headers->setHost("other.com");
+  EXPECT_FALSE(first_headers->Host()->value().isReference());
+
+  Buffer::OwnedImpl buffer2("GET /second HTTP/1.1\r\nX-CUSTOM: c\r\n\r\n");
+  EXPECT_TRUE(codec_->dispatch(buffer2).ok());
+
+  TestRequestHeaderMapImpl expected_first{
+      {":path", "/first"}, {":method", "GET"}, {"host", "other.com"}, {"x-custom", "a b"}};
+  EXPECT_THAT(first_headers, HeaderMapEqualIgnoreOrder(&expected_first));
+  TestRequestHeaderMapImpl expected_second{
+      {":path", "/second"}, {":method", "GET"}, {"x-custom", "c"}};
+  EXPECT_THAT(second_headers, HeaderMapEqualIgnoreOrder(&expected_second));
+}
+
+// Verify that headers with obsolete line folding, which the parser has to copy, are copied by the
+// codec even with zero copy headers enabled.
+TEST_F(Http1ServerConnectionImplTest, ZeroCopyHeadersCopiesTransientData) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.http1_zero_copy_headers", "true"}});
+  initialize();
+
+  MockRequestDecoder decoder;
+  EXPECT_CALL(callbacks_, newStream(_, _)).WillOnce(ReturnRef(decoder));
+
+  RequestHeaderMapSharedPtr headers;
+  EXPECT_CALL(decoder, decodeHeaders_(_, true))
+      .WillOnce(Invoke([&](RequestHeaderMapSharedPtr& h, bool) { headers = h; }));
+
+  Buffer::OwnedImpl buffer("GET / HTTP/1.1\r\nfolded: a\r\n b\r\n\r\n");
+  EXPECT_TRUE(codec_->dispatch(buffer).ok());
+  ASSERT_NE(nullptr, headers);
+  const auto folded = headers->get(LowerCaseString("folded"));
+  ASSERT_EQ(1, folded.size());
+  EXPECT_TRUE(folded[0]->key().isReference());
+  EXPECT_FALSE(folded[0]->value().isReference());
+}
+
 // Test that if the stream is not created at the time an error is detected, it
 // is created as part of sending the protocol error.
 TEST_F(Http1ServerConnectionImplTest, BadRequestNoStream) {
@@ -625,6 +625,56 @@ TEST_P(Http2CodecImplTest, SimpleRequestResponse) {
   }
 }
 
+// Frames encoded outside of dispatch are written together at the end of the event loop iteration.
+TEST_P(Http2CodecImplTest, FlushOncePerDispatch) {
+  scoped_runtime_.mergeValues(
+      {{"envoy.reloadable_features.http2_flush_once_per_dispatch", "true"}});
+  initialize();
+
+  uint32_t client_writes = 0;
+  ON_CALL(client_connection_, write(_, _))
+      .WillByDefault(Invoke([&](Buffer::Instance& data, bool) -> void {
+        client_writes++;
+        server_wrapper_->buffer_.add(data);
+      }));
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  request_headers.setMethod("POST");
+  auto* client_flush_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&client_connection_.dispatcher_);
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, false).ok());
+  Buffer::OwnedImpl request_body(std::string(1024, 'a'));
+  request_encoder_->encodeData(request_body, false);
+  EXPECT_TRUE(client_flush_callback->enabled_);
+  EXPECT_EQ(0, client_writes);
+
+  // Both frames reach the network connection in a single write.
+  client_flush_callback->invokeCallback();
+  EXPECT_EQ(1, client_writes);
+
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  EXPECT_CALL(request_decoder_, decodeData(_, false)).Times(AtLeast(1));
+  driveToCompletion();
+
+  // The flush callback is reused.
+  TestRequestTrailerMapImpl request_trailers{{"trailing", "header"}};
+  request_encoder_->encodeTrailers(request_trailers);
+  EXPECT_TRUE(client_flush_callback->enabled_);
+  client_flush_callback->invokeCallback();
+  EXPECT_CALL(request_decoder_, decodeTrailers_(_));
+  driveToCompletion();
+
+  auto* server_flush_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&server_connection_.dispatcher_);
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  response_encoder_->encodeHeaders(response_headers, true);
+  EXPECT_TRUE(server_flush_callback->enabled_);
+  server_flush_callback->invokeCallback();
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, true));
+  driveToCompletion();
+}
+
 TEST_P(Http2CodecImplTest, ClientUnexpectedHeaders) {
   initialize();
 
@@ -401,6 +401,153 @@ TEST_F(IoUringImplTest, PrepareReadvQueueOverflow) {
   EXPECT_EQ(static_cast<char*>(iov3.iov_base)[1], 'f');
 }
 
+TEST_F(IoUringImplTest, PrepareReadvRegisteredFile) {
+  std::string test_file =
+      TestEnvironment::writeStringToFileForTest("prepare_readv_registered", "test text", true);
+  os_fd_t fd = open(test_file.c_str(), O_RDONLY);
+  ASSERT_TRUE(fd >= 0);
+  if (!io_uring_->registerFile(fd)) {
+    ::close(fd);
+    GTEST_SKIP() << "registered files are not supported";
+  }
+  // The same fd can not be registered twice.
+  EXPECT_FALSE(io_uring_->registerFile(fd));
+
+  auto dispatcher = api_->allocateDispatcher("test_thread");
+
+  uint8_t buffer[4096]{};
+  struct iovec iov;
+  iov.iov_base = buffer;
+  iov.iov_len = 4096;
+
+  os_fd_t event_fd = io_uring_->registerEventfd();
+  int32_t completions_nr = 0;
+  auto file_event = dispatcher->createFileEvent(
+      event_fd,
+      [this, &completions_nr](uint32_t) {
+        io_uring_->forEveryCompletion([&completions_nr](Request*, int32_t res, bool) {
+          completions_nr++;
+          EXPECT_EQ(res, strlen("test text"));
+        });
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+
+  io_uring_->prepareReadv(fd, &iov, 1, 0, nullptr);
+  io_uring_->submit();
+  waitForCondition(*dispatcher, [&completions_nr]() { return completions_nr == 1; });
+  EXPECT_STREQ(static_cast<char*>(iov.iov_base), "test text");
+
+  io_uring_->unregisterFile(fd);
+  EXPECT_TRUE(io_uring_->registerFile(fd));
+  io_uring_->unregisterFile(fd);
+  ::close(fd);
+}
+
+TEST_F(IoUringImplTest, PrepareRecvMultishot) {
+  if (!io_uring_->registerBufferRing(4, 16)) {
+    GTEST_SKIP() << "provided buffer rings are not supported";
+  }
+
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds));
+
+  auto dispatcher = api_->allocateDispatcher("test_thread");
+  os_fd_t event_fd = io_uring_->registerEventfd();
+  Buffer::OwnedImpl read_buf;
+  int32_t completions_nr = 0;
+  uint32_t flags = 0;
+  auto file_event = dispatcher->createFileEvent(
+      event_fd,
+      [this, &completions_nr, &flags, &read_buf](uint32_t) {
+        io_uring_->forEveryCompletion(
+            [this, &completions_nr, &flags, &read_buf](Request* req, int32_t res, bool) {
+              completions_nr++;
+              flags = req->completionFlags();
+              if (res > 0) {
+                ASSERT_TRUE(flags & IORING_CQE_F_BUFFER);
+                io_uring_->moveProvidedBufferData(flags >> IORING_CQE_BUFFER_SHIFT, res,
+                                                  read_buf);
+              }
+            });
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+
+  int data = 0;
+  TestRequest request(data);
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->prepareRecvMultishot(fds[0], &request));
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->submit());
+
+  // A single request completes once per write.
+  ASSERT_EQ(5, ::write(fds[1], "hello", 5));
+  waitForCondition(*dispatcher, [&completions_nr]() { return completions_nr == 1; });
+  ASSERT_EQ(5, ::write(fds[1], "world", 5));
+  waitForCondition(*dispatcher, [&completions_nr]() { return completions_nr == 2; });
+  EXPECT_TRUE(flags & IORING_CQE_F_MORE);
+  EXPECT_EQ("helloworld", read_buf.toString());
+
+  // Draining the data hands the buffers back to the kernel.
+  read_buf.drain(read_buf.length());
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(5, ::write(fds[1], "again", 5));
+    waitForCondition(*dispatcher, [&completions_nr, i]() { return completions_nr == 3 + i; });
+  }
+  EXPECT_EQ("againagainagainagain", read_buf.toString());
+  read_buf.drain(read_buf.length());
+
+  // Closing the peer terminates the request.
+  ::close(fds[1]);
+  waitForCondition(*dispatcher, [&flags]() { return !(flags & IORING_CQE_F_MORE); });
+  ::close(fds[0]);
+}
+
+// Released buffers go back to the ring, so a request keeps receiving into a ring smaller than the
+// number of completions.
+TEST_F(IoUringImplTest, ReleaseProvidedBuffer) {
+  if (!io_uring_->registerBufferRing(2, 16)) {
+    GTEST_SKIP() << "provided buffer rings are not supported";
+  }
+
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds));
+
+  auto dispatcher = api_->allocateDispatcher("test_thread");
+  os_fd_t event_fd = io_uring_->registerEventfd();
+  int32_t completions_nr = 0;
+  int32_t last_result = 0;
+  auto file_event = dispatcher->createFileEvent(
+      event_fd,
+      [this, &completions_nr, &last_result](uint32_t) {
+        io_uring_->forEveryCompletion(
+            [this, &completions_nr, &last_result](Request* req, int32_t res, bool) {
+              completions_nr++;
+              last_result = res;
+              const uint32_t flags = req->completionFlags();
+              if (flags & IORING_CQE_F_BUFFER) {
+                io_uring_->releaseProvidedBuffer(flags >> IORING_CQE_BUFFER_SHIFT);
+              }
+            });
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+
+  int data = 0;
+  TestRequest request(data);
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->prepareRecvMultishot(fds[0], &request));
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->submit());
+
+  for (int i = 0; i < 8; i++) {
+    ASSERT_EQ(5, ::write(fds[1], "hello", 5));
+    waitForCondition(*dispatcher, [&completions_nr, i]() { return completions_nr == 1 + i; });
+    EXPECT_EQ(5, last_result);
+  }
+
+  ::close(fds[1]);
+  waitForCondition(*dispatcher, [&last_result]() { return last_result == 0; });
+  ::close(fds[0]);
+}
+
 } // namespace
 } // namespace Io
 } // namespace Envoy
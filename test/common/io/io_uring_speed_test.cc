@@ -0,0 +1,154 @@
+// Compares reading from many idle-most-of-the-time connections through io_uring and through the
+// epoll based file events. Connections are unix stream socket pairs, which behave like loopback
+// TCP without running out of ephemeral ports at 100k connections.
+
+#include <sys/socket.h>
+
+#include "source/common/io/io_uring_impl.h"
+#include "source/common/io/io_uring_worker_impl.h"
+
+#include "test/benchmark/main.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Io {
+namespace {
+
+constexpr uint32_t MessageSize = 64;
+
+class SocketPairs {
+public:
+  explicit SocketPairs(uint32_t count) {
+    fds_.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+      int fds[2];
+      if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) != 0) {
+        break;
+      }
+      fds_.push_back({fds[0], fds[1]});
+    }
+  }
+
+  ~SocketPairs() {
+    for (const auto& fds : fds_) {
+      ::close(fds.first);
+      ::close(fds.second);
+    }
+  }
+
+  bool ok(uint32_t count) const { return fds_.size() == count; }
+
+  // Write a message from the peer of every connection.
+  void writeAll() {
+    const char message[MessageSize]{};
+    for (const auto& fds : fds_) {
+      RELEASE_ASSERT(::write(fds.second, message, MessageSize) == MessageSize, "");
+    }
+  }
+
+  std::vector<std::pair<os_fd_t, os_fd_t>> fds_;
+};
+
+uint32_t connectionCount(benchmark::State& state) {
+  return Envoy::benchmark::skipExpensiveBenchmarks() ? 100 : state.range(0);
+}
+
+void bmEpollRead(benchmark::State& state) {
+  const uint32_t count = connectionCount(state);
+  SocketPairs pairs(count);
+  if (!pairs.ok(count)) {
+    state.SkipWithError("unable to create connections, check the open file limit");
+    return;
+  }
+
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("bench");
+  uint64_t received = 0;
+  std::vector<Event::FileEventPtr> events;
+  events.reserve(count);
+  for (const auto& fds : pairs.fds_) {
+    events.push_back(dispatcher->createFileEvent(
+        fds.first,
+        [fd = fds.first, &received](uint32_t) {
+          char buf[MessageSize];
+          ssize_t rc;
+          while ((rc = ::read(fd, buf, MessageSize)) > 0) {
+            received += rc;
+          }
+          return absl::OkStatus();
+        },
+        Event::PlatformDefaultTriggerType, Event::FileReadyType::Read));
+  }
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    received = 0;
+    pairs.writeAll();
+    while (received < static_cast<uint64_t>(count) * MessageSize) {
+      dispatcher->run(Event::Dispatcher::RunType::NonBlock);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(bmEpollRead)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(::benchmark::kMillisecond);
+
+// The second argument is the number of provided buffers for multishot reads, 0 for a read request
+// per read.
+void bmIoUringRead(benchmark::State& state) {
+  if (!isIoUringSupported()) {
+    state.SkipWithError("io_uring is not supported");
+    return;
+  }
+  const uint32_t count = connectionCount(state);
+  SocketPairs pairs(count);
+  if (!pairs.ok(count)) {
+    state.SkipWithError("unable to create connections, check the open file limit");
+    return;
+  }
+
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("bench");
+  IoUringWorkerImpl worker(4096, false, 8192, 1000, state.range(1), 0, false, *dispatcher);
+  uint64_t received = 0;
+  std::vector<IoUringSocket*> sockets(count);
+  for (uint32_t i = 0; i < count; i++) {
+    sockets[i] = &worker.addServerSocket(
+        pairs.fds_[i].first,
+        [&sockets, i, &received](uint32_t events) {
+          if (events & Event::FileReadyType::Read) {
+            Buffer::Instance& buf = sockets[i]->getReadParam()->buf_;
+            received += buf.length();
+            buf.drain(buf.length());
+          }
+          return absl::OkStatus();
+        },
+        false);
+    sockets[i]->enableRead();
+  }
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    received = 0;
+    pairs.writeAll();
+    while (received < static_cast<uint64_t>(count) * MessageSize) {
+      dispatcher->run(Event::Dispatcher::RunType::NonBlock);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+
+  for (IoUringSocket* socket : sockets) {
+    socket->close(true);
+  }
+  while (worker.getNumOfSockets() > 0) {
+    dispatcher->run(Event::Dispatcher::RunType::NonBlock);
+  }
+}
+BENCHMARK(bmIoUringRead)
+    ->ArgsProduct({{1000, 10000, 100000}, {0, 256}})
+    ->Unit(::benchmark::kMillisecond);
+
+} // namespace
+} // namespace Io
+} // namespace Envoy
@@ -33,8 +33,11 @@ public:
 
 class IoUringWorkerTestImpl : public IoUringWorkerImpl {
 public:
-  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher)
-      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher) {}
+  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher,
+                        uint32_t multishot_read_buffer_count = 0,
+                        uint32_t zero_copy_send_threshold = 0)
+      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, multishot_read_buffer_count,
+                          zero_copy_send_threshold, false, dispatcher) {}
 
   IoUringSocket& addTestSocket(os_fd_t fd) {
     return addSocket(std::make_unique<IoUringSocketTestImpl>(fd, *this));
@@ -693,6 +696,317 @@ TEST(IoUringWorkerImplTest, NoEnableReadOnConnectError) {
   delete static_cast<Request*>(connect_req);
 }
 
+TEST(IoUringWorkerImplTest, ZeroCopySendAboveThreshold) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher, createFileEvent_(_, _, Event::PlatformDefaultTriggerType,
+                                           Event::FileReadyType::Read));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 0, 16);
+
+  os_fd_t fd;
+  SET_SOCKET_INVALID(fd);
+  auto& io_uring_socket = worker.addTestSocket(fd);
+
+  // Small writes are still copied by the kernel.
+  Buffer::OwnedImpl small_buf("Hello");
+  EXPECT_CALL(mock_io_uring, prepareWritev(fd, _, 1, _, _))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok));
+  EXPECT_CALL(mock_io_uring, prepareSendmsgZc(_, _, _)).Times(0);
+  EXPECT_CALL(mock_io_uring, submit());
+  delete worker.submitWriteRequest(io_uring_socket, small_buf.getRawSlices());
+
+  // The threshold applies to the total length of all the slices.
+  Buffer::OwnedImpl large_buf;
+  large_buf.appendSliceForTest(std::string(8, 'a'));
+  large_buf.appendSliceForTest(std::string(8, 'b'));
+  EXPECT_CALL(mock_io_uring, prepareWritev(_, _, _, _, _)).Times(0);
+  EXPECT_CALL(mock_io_uring, prepareSendmsgZc(fd, _, _))
+      .WillOnce(Invoke([](os_fd_t, const struct msghdr* msg, Request*) {
+        EXPECT_EQ(2, msg->msg_iovlen);
+        EXPECT_EQ(8, msg->msg_iov[1].iov_len);
+        return IoUringResult::Ok;
+      }));
+  EXPECT_CALL(mock_io_uring, submit());
+  delete worker.submitWriteRequest(io_uring_socket, large_buf.getRawSlices());
+
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(mock_io_uring, unregisterFile(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  dynamic_cast<IoUringSocketTestImpl*>(worker.getSockets().front().get())->cleanupForTest();
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+}
+
+// The write buffer is pinned by a zero copy send until the notification completion arrives.
+TEST(IoUringWorkerImplTest, ServerSocketZeroCopySendWaitsForNotification) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 0, 1);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  auto& io_uring_socket =
+      worker.addServerSocket(fd, [](uint32_t) { return absl::OkStatus(); }, false);
+
+  Buffer::OwnedImpl buf("Hello");
+  Request* write_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareSendmsgZc(fd, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&write_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.write(buf);
+
+  // The first completion carries the result, the request must stay alive.
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&write_req](const CompletionCb& cb) {
+        write_req->setCompletionFlags(IORING_CQE_F_MORE);
+        cb(write_req, 5, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  // No new write is submitted while the previous send is in flight.
+  Buffer::OwnedImpl buf2("World");
+  EXPECT_CALL(mock_io_uring, prepareSendmsgZc(fd, _, _)).Times(0);
+  io_uring_socket.write(buf2);
+
+  // The notification drains the sent data and submits the pending write.
+  Request* write_req2 = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&write_req](const CompletionCb& cb) {
+        write_req->setCompletionFlags(IORING_CQE_F_NOTIF);
+        cb(write_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareSendmsgZc(fd, _, _))
+      .WillOnce(Invoke([&write_req2](os_fd_t, const struct msghdr* msg, Request* req) {
+        EXPECT_EQ(1, msg->msg_iovlen);
+        EXPECT_EQ("World", absl::string_view(static_cast<const char*>(msg->msg_iov[0].iov_base),
+                                             msg->msg_iov[0].iov_len));
+        write_req2 = req;
+        return IoUringResult::Ok;
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  // Close the socket once both requests are drained.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  EXPECT_CALL(dispatcher, createTimer_(_)).WillOnce(ReturnNew<NiceMock<Event::MockTimer>>());
+  io_uring_socket.close(false);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req, &cancel_req, &write_req2](const CompletionCb& cb) {
+        cb(read_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+        cb(write_req2, 5, false);
+      }));
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, unregisterFile(fd));
+  EXPECT_CALL(mock_io_uring, prepareClose(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(mock_io_uring, unregisterFile(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
+// A multishot read request keeps delivering data from provided buffers without being re-armed.
+TEST(IoUringWorkerImplTest, ServerSocketMultishotRead) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  // The buffer count is rounded up to a power of two.
+  EXPECT_CALL(mock_io_uring, registerBufferRing(8, 8192)).WillOnce(Return(true));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 5, 0);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareReadv(_, _, _, _, _)).Times(0);
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  uint32_t read_events = 0;
+  IoUringSocket* socket = nullptr;
+  auto& io_uring_socket = worker.addServerSocket(
+      fd,
+      [&read_events, &socket](uint32_t events) {
+        if (events & Event::FileReadyType::Read) {
+          EXPECT_EQ("Hello", socket->getReadParam()->buf_.toString());
+          socket->getReadParam()->buf_.drain(5);
+          read_events++;
+        }
+        return absl::OkStatus();
+      },
+      false);
+  socket = &io_uring_socket;
+  io_uring_socket.enableRead();
+
+  EXPECT_CALL(mock_io_uring, moveProvidedBufferData(3, 5, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([](uint16_t, uint32_t, Buffer::Instance& buffer) {
+        buffer.add("Hello");
+      }));
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) {
+        read_req->setCompletionFlags(IORING_CQE_F_MORE | IORING_CQE_F_BUFFER |
+                                     (3 << IORING_CQE_BUFFER_SHIFT));
+        cb(read_req, 5, false);
+        cb(read_req, 5, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(2, read_events);
+
+  // Running out of provided buffers terminates the request, and it is re-armed.
+  Request* read_req2 = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) {
+        read_req->setCompletionFlags(0);
+        cb(read_req, -ENOBUFS, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&read_req2), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(2, read_events);
+
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(read_req2, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.close(false);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req2, &cancel_req](const CompletionCb& cb) {
+        cb(read_req2, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, unregisterFile(fd));
+  EXPECT_CALL(mock_io_uring, prepareClose(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(mock_io_uring, unregisterFile(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
+// The final completion of a multishot read request may still carry data after the socket is
+// closed. Its provided buffer goes back to the ring even though the data is dropped.
+TEST(IoUringWorkerImplTest, ServerSocketMultishotReadReleasesBufferOnClose) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  EXPECT_CALL(mock_io_uring, registerBufferRing(8, 8192)).WillOnce(Return(true));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 5, 0);
+  // The number of buffers in the ring, taken by completions and returned by the worker.
+  uint32_t free_buffers = 8;
+  EXPECT_CALL(mock_io_uring, moveProvidedBufferData(_, _, _)).Times(0);
+  EXPECT_CALL(mock_io_uring, releaseProvidedBuffer(3)).WillOnce(Invoke([&free_buffers](uint16_t) {
+    free_buffers++;
+  }));
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  auto& io_uring_socket = worker.addServerSocket(
+      fd, [](uint32_t) { return absl::OkStatus(); }, false);
+  io_uring_socket.enableRead();
+
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.close(false);
+
+  // The cancellation completes first, then the read request ends with data in buffer 3.
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req, &cancel_req, &free_buffers](const CompletionCb& cb) {
+        cb(cancel_req, 0, false);
+        read_req->setCompletionFlags(IORING_CQE_F_BUFFER | (3 << IORING_CQE_BUFFER_SHIFT));
+        free_buffers--;
+        cb(read_req, 5, false);
+      }));
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, unregisterFile(fd));
+  EXPECT_CALL(mock_io_uring, prepareClose(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(8, free_buffers);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(mock_io_uring, unregisterFile(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
 } // namespace
 } // namespace Io
 } // namespace Envoy
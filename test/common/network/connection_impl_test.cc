@@ -816,8 +816,10 @@ TEST_P(ConnectionImplTest, ServerResetClose) {
 
 struct MockConnectionStats {
   Connection::ConnectionStats toBufferStats() {
-    return {rx_total_,   rx_current_,   tx_total_,
-            tx_current_, &bind_errors_, &delayed_close_timeouts_};
+    return {rx_total_,     rx_current_,
+            tx_total_,     tx_current_,
+            &bind_errors_, &delayed_close_timeouts_,
+            nullptr,       nullptr};
   }
 
   StrictMock<Stats::MockCounter> rx_total_;
@@ -830,8 +832,10 @@ struct MockConnectionStats {
 
 struct NiceMockConnectionStats {
   Connection::ConnectionStats toBufferStats() {
-    return {rx_total_,   rx_current_,   tx_total_,
-            tx_current_, &bind_errors_, &delayed_close_timeouts_};
+    return {rx_total_,     rx_current_,
+            tx_total_,     tx_current_,
+            &bind_errors_, &delayed_close_timeouts_,
+            nullptr,       nullptr};
   }
 
   NiceMock<Stats::MockCounter> rx_total_;
@@ -1838,6 +1842,64 @@ TEST_P(ConnectionImplTest, WatermarkFuzzing) {
   disconnect(true);
 }
 
+// With write coalescing enabled, runs of small slices are copied together so that a single
+// writev() covers the whole write buffer.
+TEST_P(ConnectionImplTest, CoalesceWriteSlices) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.coalesce_write_slices", "true"}});
+  setUpBasicConnection();
+  connect();
+
+  NiceMockConnectionStats client_connection_stats;
+  StrictMock<Stats::MockHistogram> write_slices;
+  StrictMock<Stats::MockCounter> write_coalesced_bytes;
+  Connection::ConnectionStats stats = client_connection_stats.toBufferStats();
+  stats.write_slices_ = &write_slices;
+  stats.write_coalesced_bytes_ = &write_coalesced_bytes;
+  client_connection_->setConnectionStats(stats);
+
+  NiceMock<Api::MockOsSysCalls> os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+
+  // 64 slices of 600 bytes are too large to be merged when moved into the write buffer, and are
+  // coalesced into runs of 27 slices filling 16KiB slices.
+  Buffer::OwnedImpl data;
+  for (int i = 0; i < 64; ++i) {
+    data.appendSliceForTest(std::string(600, 'a'));
+  }
+  EXPECT_CALL(write_slices, recordValue(3));
+  EXPECT_CALL(write_coalesced_bytes, add(64 * 600));
+  EXPECT_CALL(os_sys_calls, writev(_, _, _))
+      .WillOnce(Invoke([&](os_fd_t, const iovec* iov, int iovcnt) -> Api::SysCallSizeResult {
+        EXPECT_EQ(3, iovcnt);
+        ssize_t length = 0;
+        for (int i = 0; i < iovcnt; ++i) {
+          length += iov[i].iov_len;
+        }
+        EXPECT_EQ(64 * 600, length);
+        dispatcher_->exit();
+        return {length, 0};
+      }));
+  client_connection_->write(data, false);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  // Nothing is copied when the write buffer already fits in a single writev(), and no stats are
+  // recorded.
+  for (int i = 0; i < 4; ++i) {
+    data.appendSliceForTest(std::string(600, 'b'));
+  }
+  EXPECT_CALL(os_sys_calls, writev(_, _, _))
+      .WillOnce(Invoke([&](os_fd_t, const iovec*, int iovcnt) -> Api::SysCallSizeResult {
+        EXPECT_EQ(4, iovcnt);
+        dispatcher_->exit();
+        return {4 * 600, 0};
+      }));
+  client_connection_->write(data, false);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  disconnect(true);
+}
+
 TEST_P(ConnectionImplTest, BindTest) {
   std::string address_string = TestUtility::getIpv4Loopback();
   if (GetParam() == Network::Address::IpVersion::v4) {
@@ -182,7 +182,8 @@ public:
                 read_filter_->callbacks_->connection().addConnectionCallbacks(
                     network_connection_callbacks_);
                 read_filter_->callbacks_->connection().setConnectionStats(
-                    {read_total_, read_current_, write_total_, write_current_, nullptr, nullptr});
+                    {read_total_, read_current_, write_total_, write_current_, nullptr, nullptr,
+                     nullptr, nullptr});
               }));
       EXPECT_CALL(test.listener_config_, filterChainManager())
           .WillOnce(ReturnRef(filter_chain_manager_));
@@ -286,7 +287,8 @@ TEST_P(EnvoyQuicDispatcherTest, CloseConnectionDuringNetworkFilterInstallation)
             read_filter->callbacks_->connection().addConnectionCallbacks(
                 network_connection_callbacks);
             read_filter->callbacks_->connection().setConnectionStats(
-                {read_total, read_current, write_total, write_current, nullptr, nullptr});
+                {read_total, read_current, write_total, write_current, nullptr, nullptr, nullptr,
+                 nullptr});
             // This will not close connection right away, but during processing the first packet.
             read_filter->callbacks_->connection().close(Network::ConnectionCloseType::NoFlush);
           }));
@@ -449,7 +451,8 @@ TEST_P(EnvoyQuicDispatcherTest, CloseWithGivenFilterChain) {
             read_filter->callbacks_->connection().addConnectionCallbacks(
                 network_connection_callbacks);
             read_filter->callbacks_->connection().setConnectionStats(
-                {read_total, read_current, write_total, write_current, nullptr, nullptr});
+                {read_total, read_current, write_total, write_current, nullptr, nullptr, nullptr,
+                 nullptr});
           }));
 
   EXPECT_CALL(listener_config_, filterChainManager()).WillOnce(ReturnRef(filter_chain_manager));
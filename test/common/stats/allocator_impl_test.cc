@@ -1,6 +1,7 @@
 #include <cmath>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/stats/sink.h"
 
@@ -10,6 +11,7 @@
 #include "test/test_common/logging.h"
 #include "test/test_common/thread_factory_for_test.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/notification.h"
 #include "gmock/gmock-matchers.h"
 #include "gtest/gtest.h"
@@ -626,6 +628,136 @@ TEST_F(AllocatorImplTest, ForEachSinkedTextReadout) {
   EXPECT_EQ(num_iterations, 0);
 }
 
+TEST_F(AllocatorImplTest, ForEachChangedCounter) {
+  CounterSharedPtr c1 = alloc_.makeCounter(makeStat("c1"), StatName(), {});
+  CounterSharedPtr c2 = alloc_.makeCounter(makeStat("c2"), StatName(), {});
+  c1->inc();
+
+  std::vector<std::string> names;
+  size_t num_changed = 0;
+  auto latch = [&names](Counter& counter) {
+    names.push_back(counter.name());
+    counter.latch();
+  };
+  auto size = [&num_changed](std::size_t size) { num_changed = size; };
+
+  // Changes were not tracked before the first call, so every counter is visited.
+  alloc_.forEachChangedCounter(size, latch);
+  EXPECT_EQ(2, num_changed);
+  EXPECT_THAT(names, testing::UnorderedElementsAre("c1", "c2"));
+
+  names.clear();
+  alloc_.forEachChangedCounter(size, latch);
+  EXPECT_EQ(0, num_changed);
+  EXPECT_TRUE(names.empty());
+
+  c2->add(5);
+  c2->inc();
+  alloc_.forEachChangedCounter(size, latch);
+  EXPECT_EQ(1, num_changed);
+  EXPECT_THAT(names, testing::ElementsAre("c2"));
+
+  // A counter freed after it changed is not visited.
+  names.clear();
+  c1->inc();
+  c1.reset();
+  alloc_.forEachChangedCounter(size, latch);
+  EXPECT_EQ(0, num_changed);
+  EXPECT_TRUE(names.empty());
+}
+
+// A visited counter counts as unchanged whether or not it is latched, and its next change queues it
+// again.
+TEST_F(AllocatorImplTest, ForEachChangedCounterWithoutLatch) {
+  CounterSharedPtr c1 = alloc_.makeCounter(makeStat("c1"), StatName(), {});
+  size_t num_changed = 0;
+  auto visit = [&num_changed](Counter&) { ++num_changed; };
+
+  alloc_.forEachChangedCounter(nullptr, visit);
+  EXPECT_EQ(1, num_changed);
+
+  for (int i = 0; i < 3; ++i) {
+    num_changed = 0;
+    c1->inc();
+    alloc_.forEachChangedCounter(nullptr, visit);
+    EXPECT_EQ(1, num_changed);
+    num_changed = 0;
+    alloc_.forEachChangedCounter(nullptr, visit);
+    EXPECT_EQ(0, num_changed);
+  }
+  EXPECT_EQ(3, c1->latch());
+}
+
+// Stats changed on many threads are all visited once.
+TEST_F(AllocatorImplTest, ForEachChangedFromThreads) {
+  std::vector<CounterSharedPtr> counters;
+  for (int i = 0; i < 1000; ++i) {
+    counters.push_back(alloc_.makeCounter(makeStat(absl::StrCat("c", i)), StatName(), {}));
+  }
+  alloc_.forEachChangedCounter(nullptr, [](Counter&) {});
+
+  std::vector<Thread::ThreadPtr> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.push_back(Thread::threadFactoryForTest().createThread([&counters, t]() {
+      for (size_t i = t; i < counters.size(); i += 2) {
+        counters[i]->inc();
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+
+  size_t num_changed = 0;
+  alloc_.forEachChangedCounter([&num_changed](std::size_t size) { num_changed = size; },
+                               [](Counter& counter) { EXPECT_EQ(2, counter.latch()); });
+  EXPECT_EQ(1000, num_changed);
+}
+
+TEST_F(AllocatorImplTest, ForEachChangedGaugeAndTextReadout) {
+  std::unique_ptr<TestUtil::TestSinkPredicates> moved_sink_predicates =
+      std::make_unique<TestUtil::TestSinkPredicates>();
+  TestUtil::TestSinkPredicates* sink_predicates = moved_sink_predicates.get();
+  alloc_.setSinkPredicates(std::move(moved_sink_predicates));
+
+  StatName sinked_name = makeStat("sinked");
+  sink_predicates->add(sinked_name);
+  GaugeSharedPtr sinked =
+      alloc_.makeGauge(sinked_name, StatName(), {}, Gauge::ImportMode::Accumulate);
+  GaugeSharedPtr unsinked =
+      alloc_.makeGauge(makeStat("unsinked"), StatName(), {}, Gauge::ImportMode::Accumulate);
+  StatName text_readout_name = makeStat("text_readout");
+  sink_predicates->add(text_readout_name);
+  TextReadoutSharedPtr text_readout = alloc_.makeTextReadout(text_readout_name, StatName(), {});
+
+  size_t num_gauges = 0;
+  alloc_.forEachChangedGauge([](std::size_t) {}, [&num_gauges](Gauge&) { ++num_gauges; });
+  EXPECT_EQ(1, num_gauges);
+  size_t num_text_readouts = 0;
+  alloc_.forEachChangedTextReadout([](std::size_t) {},
+                                   [&num_text_readouts](TextReadout&) { ++num_text_readouts; });
+  EXPECT_EQ(1, num_text_readouts);
+
+  // Decrementing counts as a change, and only sinked stats are visited.
+  sinked->set(5);
+  alloc_.forEachChangedGauge([](std::size_t) {}, [](Gauge&) {});
+  sinked->dec();
+  unsinked->inc();
+  std::vector<uint64_t> values;
+  alloc_.forEachChangedGauge([](std::size_t) {},
+                             [&values](Gauge& gauge) { values.push_back(gauge.value()); });
+  EXPECT_THAT(values, testing::ElementsAre(4));
+
+  num_text_readouts = 0;
+  alloc_.forEachChangedTextReadout([](std::size_t) {},
+                                   [&num_text_readouts](TextReadout&) { ++num_text_readouts; });
+  EXPECT_EQ(0, num_text_readouts);
+  text_readout->set("value");
+  alloc_.forEachChangedTextReadout([](std::size_t) {},
+                                   [&num_text_readouts](TextReadout&) { ++num_text_readouts; });
+  EXPECT_EQ(1, num_text_readouts);
+}
+
 } // namespace
 } // namespace Stats
 } // namespace Envoy
@@ -1,3 +1,6 @@
+#include <limits>
+#include <vector>
+
 #include "envoy/config/metrics/v3/stats.pb.h"
 
 #include "source/common/stats/histogram_impl.h"
@@ -121,5 +124,87 @@ TEST_F(HistogramSettingsImplTest, ScaledPercent) {
   EXPECT_EQ(settings_->buckets("abcd"), ConstSupportedBuckets({0.1, 2}));
 }
 
+// Test that fixed log-linear buckets are enabled by any matching config.
+TEST_F(HistogramSettingsImplTest, FixedLogLinearBuckets) {
+  {
+    envoy::config::metrics::v3::HistogramBucketSettings setting;
+    setting.mutable_match()->set_prefix("a");
+    setting.mutable_bins()->set_value(5);
+    buckets_configs_.push_back(setting);
+  }
+  {
+    envoy::config::metrics::v3::HistogramBucketSettings setting;
+    setting.mutable_match()->set_prefix("ab");
+    setting.set_fixed_log_linear_buckets(true);
+    buckets_configs_.push_back(setting);
+  }
+
+  initialize();
+  EXPECT_FALSE(settings_->fixedLogLinearBuckets("ac"));
+  EXPECT_TRUE(settings_->fixedLogLinearBuckets("abc"));
+  EXPECT_FALSE(settings_->fixedLogLinearBuckets("b"));
+}
+
+TEST(LogLinearBucketsTest, Layout) {
+  // Small values are exact.
+  for (uint64_t value = 0; value < LogLinearBuckets::SubBuckets; ++value) {
+    EXPECT_EQ(value, LogLinearBuckets::index(value));
+    EXPECT_EQ(value, LogLinearBuckets::lowerBound(value));
+    EXPECT_EQ(1, LogLinearBuckets::width(value));
+  }
+
+  // Every value falls in the bucket it is indexed to, and buckets are contiguous.
+  for (uint32_t i = 1; i < LogLinearBuckets::NumBuckets; ++i) {
+    EXPECT_EQ(LogLinearBuckets::lowerBound(i - 1) + LogLinearBuckets::width(i - 1),
+              LogLinearBuckets::lowerBound(i));
+    EXPECT_EQ(i, LogLinearBuckets::index(LogLinearBuckets::lowerBound(i)));
+    EXPECT_EQ(i, LogLinearBuckets::index(LogLinearBuckets::lowerBound(i) +
+                                         LogLinearBuckets::width(i) - 1));
+  }
+  EXPECT_EQ(LogLinearBuckets::NumBuckets - 1,
+            LogLinearBuckets::index(std::numeric_limits<uint64_t>::max()));
+
+  // A power of two is split into 8 buckets.
+  EXPECT_EQ(LogLinearBuckets::index(1000), LogLinearBuckets::index(1023));
+  EXPECT_EQ(LogLinearBuckets::index(1024) + 7, LogLinearBuckets::index(2047));
+  EXPECT_EQ(128, LogLinearBuckets::width(LogLinearBuckets::index(1024)));
+}
+
+TEST(LogLinearBucketsTest, MergeAndInsert) {
+  std::vector<uint32_t> worker1(LogLinearBuckets::PageBuckets);
+  std::vector<uint32_t> worker2(LogLinearBuckets::PageBuckets);
+  worker1[LogLinearBuckets::index(3)] = 2;
+  worker1[LogLinearBuckets::index(1000)] = 1;
+  worker2[LogLinearBuckets::index(3)] = 5;
+
+  // The last page is only partially used.
+  const uint32_t last_page = LogLinearBuckets::NumPages - 1;
+  const uint32_t max_index = LogLinearBuckets::index(std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(last_page, max_index / LogLinearBuckets::PageBuckets);
+  std::vector<uint32_t> worker2_last_page(LogLinearBuckets::PageBuckets);
+  worker2_last_page[max_index % LogLinearBuckets::PageBuckets] = 1;
+
+  std::vector<uint64_t> merged(LogLinearBuckets::NumBuckets);
+  LogLinearBuckets::mergePageAndClear(merged.data(), 0, worker1.data());
+  LogLinearBuckets::mergePageAndClear(merged.data(), 0, worker2.data());
+  LogLinearBuckets::mergePageAndClear(merged.data(), last_page, worker2_last_page.data());
+  EXPECT_EQ(7, merged[LogLinearBuckets::index(3)]);
+  EXPECT_EQ(1, merged[LogLinearBuckets::index(1000)]);
+  EXPECT_EQ(1, merged[max_index]);
+  EXPECT_EQ(std::vector<uint32_t>(LogLinearBuckets::PageBuckets), worker1);
+  EXPECT_EQ(std::vector<uint32_t>(LogLinearBuckets::PageBuckets), worker2);
+  EXPECT_EQ(std::vector<uint32_t>(LogLinearBuckets::PageBuckets), worker2_last_page);
+  merged[max_index] = 0;
+
+  histogram_t* histogram = hist_alloc();
+  LogLinearBuckets::insertInto(histogram, merged.data());
+  EXPECT_EQ(8, hist_sample_count(histogram));
+  EXPECT_EQ(7, hist_approx_count_below(histogram, 4));
+  // 1000 is recorded at 992, the middle of its bucket [960, 1024).
+  EXPECT_EQ(7, hist_approx_count_below(histogram, 985));
+  EXPECT_EQ(8, hist_approx_count_below(histogram, 1010));
+  hist_free(histogram);
+}
+
 } // namespace Stats
 } // namespace Envoy
@@ -748,6 +748,33 @@ TEST_F(StatNameTest, SupportsAbslHash) {
   }));
 }
 
+TEST_F(StatNameTest, PoolSpanningBlocks) {
+  std::vector<std::pair<std::string, StatName>> names;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    const std::string name = absl::StrCat("cluster.service_", i, ".upstream_rq_total");
+    names.emplace_back(name, makeStat(name));
+  }
+
+  // A name with more symbols than fit in the largest block gets a block of its own.
+  std::vector<std::string> tokens;
+  for (uint32_t i = 0; i < 5000; ++i) {
+    tokens.push_back(absl::StrCat("t", i));
+  }
+  const std::string long_name = absl::StrJoin(tokens, ".");
+  names.emplace_back(long_name, makeStat(long_name));
+  names.emplace_back("after.long", makeStat("after.long"));
+
+  // Copying a StatName into the pool keeps its own references to the symbols.
+  {
+    StatNameManagedStorage copied("copied.name", table_);
+    names.emplace_back("copied.name", pool_.add(copied.statName()));
+  }
+
+  for (const auto& [name, stat_name] : names) {
+    EXPECT_EQ(name, table_.toString(stat_name));
+  }
+}
+
 // Tests the memory savings realized from using symbol tables with 1k
 // clusters. This test shows the memory drops from almost 8M to less than
 // 2M.
@@ -784,5 +811,31 @@ TEST(SymbolTableTest, Memory) {
   EXPECT_MEMORY_EQ(symbol_table_mem_used, 1726056);
 }
 
+// Tests the memory used by a StatNamePool holding the sample stat names for 10k
+// clusters, which packs the encodings rather than allocating each name separately.
+TEST(SymbolTableTest, PoolMemory) {
+  SymbolTableImpl table;
+  size_t storage_mem_used, pool_mem_used;
+  {
+    Memory::TestUtil::MemoryTest memory_test;
+    std::vector<StatNameStorage> names;
+    TestUtil::forEachSampleStat(10000, true, [&names, &table](absl::string_view stat) {
+      names.emplace_back(StatNameStorage(stat, table));
+    });
+    storage_mem_used = memory_test.consumedBytes();
+    for (StatNameStorage& name : names) {
+      name.free(table); // NOLINT(clang-analyzer-unix.Malloc)
+    }
+  }
+  {
+    Memory::TestUtil::MemoryTest memory_test;
+    StatNamePool pool(table);
+    TestUtil::forEachSampleStat(10000, true, [&pool](absl::string_view stat) { pool.add(stat); });
+    pool_mem_used = memory_test.consumedBytes();
+  }
+
+  EXPECT_MEMORY_LE(pool_mem_used, storage_mem_used / 2);
+}
+
 } // namespace Stats
 } // namespace Envoy
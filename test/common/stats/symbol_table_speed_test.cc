@@ -6,11 +6,13 @@
 #include "source/common/common/hash.h"
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
+#include "source/common/memory/stats.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/common/stats/symbol_table.h"
 #include "source/common/stats/utility.h"
 
 #include "test/common/stats/make_elements_helper.h"
+#include "test/common/stats/stat_test_utility.h"
 #include "test/test_common/utility.h"
 
 #include "absl/synchronization/blocking_counter.h"
@@ -213,3 +215,47 @@ static void bmSetStrings(benchmark::State& state) {
   }
 }
 BENCHMARK(bmSetStrings);
+
+// Reports the memory used to hold the names of the sample cluster stats for 10k
+// clusters, as strings, as individually allocated StatNameStorage, and packed
+// into a StatNamePool. Memory is only reported when built with tcmalloc.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmStatNameMemory(benchmark::State& state) {
+  constexpr int num_clusters = 10 * 1000;
+  size_t string_bytes = 0, storage_bytes = 0, pool_bytes = 0, num_names = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Envoy::Stats::SymbolTableImpl symbol_table;
+    {
+      const uint64_t start = Envoy::Memory::Stats::totalCurrentlyAllocated();
+      std::vector<std::string> names;
+      Envoy::Stats::TestUtil::forEachSampleStat(
+          num_clusters, true, [&names](absl::string_view name) { names.emplace_back(name); });
+      string_bytes = Envoy::Memory::Stats::totalCurrentlyAllocated() - start;
+      num_names = names.size();
+    }
+    {
+      const uint64_t start = Envoy::Memory::Stats::totalCurrentlyAllocated();
+      std::vector<Envoy::Stats::StatNameStorage> names;
+      Envoy::Stats::TestUtil::forEachSampleStat(
+          num_clusters, true, [&names, &symbol_table](absl::string_view name) {
+            names.emplace_back(name, symbol_table);
+          });
+      storage_bytes = Envoy::Memory::Stats::totalCurrentlyAllocated() - start;
+      for (Envoy::Stats::StatNameStorage& name : names) {
+        name.free(symbol_table); // NOLINT(clang-analyzer-unix.Malloc)
+      }
+    }
+    {
+      const uint64_t start = Envoy::Memory::Stats::totalCurrentlyAllocated();
+      Envoy::Stats::StatNamePool pool(symbol_table);
+      Envoy::Stats::TestUtil::forEachSampleStat(
+          num_clusters, true, [&pool](absl::string_view name) { pool.add(name); });
+      pool_bytes = Envoy::Memory::Stats::totalCurrentlyAllocated() - start;
+    }
+  }
+  state.counters["string_bytes_per_name"] = static_cast<double>(string_bytes) / num_names;
+  state.counters["storage_bytes_per_name"] = static_cast<double>(storage_bytes) / num_names;
+  state.counters["pool_bytes_per_name"] = static_cast<double>(pool_bytes) / num_names;
+}
+BENCHMARK(bmStatNameMemory)->Unit(::benchmark::kMillisecond);
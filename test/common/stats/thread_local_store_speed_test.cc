@@ -12,7 +12,10 @@
 #include "source/common/stats/tag_producer_impl.h"
 #include "source/common/stats/thread_local_store.h"
 #include "source/common/thread_local/thread_local_impl.h"
+#include "source/exe/process_wide.h"
 
+#include "test/benchmark/main.h"
+#include "test/common/stats/real_thread_test_base.h"
 #include "test/common/stats/stat_test_utility.h"
 #include "test/mocks/server/server_factory_context.h"
 #include "test/test_common/simulated_time_system.h"
@@ -138,5 +141,69 @@ static void BM_StatsWithTlsAndRejectionsWithoutDot(benchmark::State& state) {
 }
 BENCHMARK(BM_StatsWithTlsAndRejectionsWithoutDot);
 
-// TODO(jmarantz): add multi-threaded variant of this test, that aggressively
-// looks up stats in multiple threads to try to trigger contention issues.
+namespace Envoy {
+namespace Stats {
+
+class ThreadLocalStoreMultiThreadPerf : public ThreadLocalRealThreadsMixin {
+public:
+  static constexpr uint32_t NumStats = 100;
+
+  explicit ThreadLocalStoreMultiThreadPerf(uint32_t num_threads)
+      : ThreadLocalRealThreadsMixin(num_threads) {
+    for (uint32_t i = 0; i < NumStats; ++i) {
+      stat_names_.push_back(pool_.add(absl::StrCat("stat_", i)));
+    }
+  }
+
+  ~ThreadLocalStoreMultiThreadPerf() {
+    shutdownThreading();
+    waitForScopeCleanup();
+  }
+
+  // Waits for the main thread to clear released scopes from the TLS caches of all the workers,
+  // and then to release their central caches.
+  void waitForScopeCleanup() {
+    mainDispatchBlock();
+    tlsBlock();
+    mainDispatchBlock();
+  }
+
+  std::vector<StatName> stat_names_;
+};
+
+} // namespace Stats
+} // namespace Envoy
+
+// Tests stat creation from many workers at once. Each iteration creates fresh scopes
+// on the main thread, and then every worker looks up the same counters in all of
+// them, so that every lookup misses the TLS cache and goes to the central cache.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_CreateScopedStatsMultiThreaded(benchmark::State& state) {
+  const uint32_t num_threads = state.range(0);
+  const uint32_t num_scopes = Envoy::benchmark::skipExpensiveBenchmarks() ? 10 : state.range(1);
+  Envoy::ProcessWide process_wide;
+  Envoy::Stats::ThreadLocalStoreMultiThreadPerf test(num_threads);
+
+  std::vector<Envoy::Stats::ScopeSharedPtr> scopes;
+  for (auto _ : state) { // NOLINT
+    test.runOnMainBlocking([&test, &scopes, num_scopes]() {
+      for (uint32_t i = 0; i < num_scopes; ++i) {
+        scopes.push_back(test.scope_.createScope(absl::StrCat("scope_", i)));
+      }
+    });
+    test.runOnAllWorkersBlocking([&test, &scopes]() {
+      for (const Envoy::Stats::ScopeSharedPtr& scope : scopes) {
+        for (Envoy::Stats::StatName stat_name : test.stat_names_) {
+          scope->counterFromStatName(stat_name).inc();
+        }
+      }
+    });
+    test.runOnMainBlocking([&scopes]() { scopes.clear(); });
+    test.waitForScopeCleanup();
+  }
+  state.SetItemsProcessed(state.iterations() * num_threads * num_scopes *
+                          Envoy::Stats::ThreadLocalStoreMultiThreadPerf::NumStats);
+}
+BENCHMARK(BM_CreateScopedStatsMultiThreaded)
+    ->ArgsProduct({{1, 8, 32}, {1000}})
+    ->Unit(::benchmark::kMillisecond);
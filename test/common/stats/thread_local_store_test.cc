@@ -2054,6 +2054,57 @@ TEST_F(HistogramTest, UnsinkedHistogramsAreMerged) {
   EXPECT_EQ(h2.used(), true);
 }
 
+// Histograms matched by a fixed_log_linear_buckets setting record into per-worker bucket arrays,
+// which are added up and converted into the interval circllhist at merge time.
+TEST_F(HistogramTest, FixedLogLinearBuckets) {
+  envoy::config::metrics::v3::StatsConfig config;
+  auto& setting = *config.mutable_histogram_bucket_settings()->Add();
+  setting.mutable_match()->set_prefix("h1");
+  setting.set_fixed_log_linear_buckets(true);
+  store_->setHistogramSettings(std::make_unique<HistogramSettingsImpl>(config, context_));
+
+  auto& h1 = static_cast<ParentHistogramImpl&>(
+      scope_.histogramFromString("h1", Histogram::Unit::Unspecified));
+  auto& h2 = static_cast<ParentHistogramImpl&>(
+      scope_.histogramFromString("h2", Histogram::Unit::Unspecified));
+  EXPECT_TRUE(h1.fixedLogLinearBuckets());
+  EXPECT_FALSE(h2.fixedLogLinearBuckets());
+
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(h1), _)).Times(100);
+  for (uint64_t value = 1; value <= 100; ++value) {
+    h1.recordValue(value);
+  }
+  store_->mergeHistograms([]() -> void {});
+
+  EXPECT_EQ(100, h1.intervalStatistics().sampleCount());
+  EXPECT_EQ(100, h1.cumulativeStatistics().sampleCount());
+  // The 50th percentile lands in the [48, 56) bucket.
+  EXPECT_EQ(0.5, h1.intervalStatistics().supportedQuantiles()[2]);
+  EXPECT_NEAR(50, h1.intervalStatistics().computedQuantiles()[2], 6);
+
+  // An idle interval leaves the cumulative histogram unchanged.
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_EQ(0, h1.intervalStatistics().sampleCount());
+  EXPECT_EQ(100, h1.cumulativeStatistics().sampleCount());
+
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(h1), 1000));
+  h1.recordValue(1000);
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_EQ(1, h1.intervalStatistics().sampleCount());
+  EXPECT_EQ(101, h1.cumulativeStatistics().sampleCount());
+
+  // Counts freed by idle intervals are allocated again, in any page.
+  store_->mergeHistograms([]() -> void {});
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(h1), 3));
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(h1), uint64_t(1) << 40));
+  h1.recordValue(3);
+  h1.recordValue(uint64_t(1) << 40);
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_EQ(2, h1.intervalStatistics().sampleCount());
+  EXPECT_EQ(103, h1.cumulativeStatistics().sampleCount());
+}
+
 class OneWorkerThread : public ThreadLocalRealThreadsMixin, public testing::Test {
 protected:
   static constexpr uint32_t NumThreads = 1;
@@ -2183,6 +2234,49 @@ TEST_F(ClusterShutdownCleanupStarvationTest, TwelveThreadsWithoutBlockade) {
   store_->sync().signal(ThreadLocalStoreImpl::MainDispatcherCleanupSync);
 }
 
+class ConcurrentScopedStatsTest : public ThreadLocalRealThreadsMixin, public testing::Test {
+protected:
+  static constexpr uint32_t NumThreads = 8;
+  // More scopes than there are central cache lock shards, so some scopes share a shard.
+  static constexpr uint32_t NumConcurrentScopes = 200;
+
+  ConcurrentScopedStatsTest() : ThreadLocalRealThreadsMixin(NumThreads) {}
+};
+
+// Creates the same counters in many scopes from all the workers at once. Each worker misses its
+// TLS cache and goes to the central cache of the scope, and all of them must end up with the
+// same counter.
+TEST_F(ConcurrentScopedStatsTest, CreateCountersInManyScopes) {
+  const StatName counter_name = pool_.add("counter");
+  std::vector<ScopeSharedPtr> scopes;
+  runOnMainBlocking([this, &scopes]() {
+    for (uint32_t i = 0; i < NumConcurrentScopes; ++i) {
+      scopes.push_back(store_->createScope(absl::StrCat("scope", i)));
+    }
+  });
+  runOnAllWorkersBlocking([&scopes, counter_name]() {
+    for (const ScopeSharedPtr& scope : scopes) {
+      scope->counterFromStatName(counter_name).inc();
+    }
+  });
+
+  for (const ScopeSharedPtr& scope : scopes) {
+    Counter& counter = scope->counterFromStatName(counter_name);
+    EXPECT_EQ(NumThreads, counter.value());
+    uint32_t num_counters = 0;
+    scope->iterate(IterateFn<Counter>([&num_counters](const CounterSharedPtr&) -> bool {
+      ++num_counters;
+      return true;
+    }));
+    EXPECT_EQ(1, num_counters);
+  }
+
+  runOnMainBlocking([&scopes]() { scopes.clear(); });
+  mainDispatchBlock();
+  tlsBlock();
+  mainDispatchBlock();
+}
+
 class HistogramThreadTest : public ThreadLocalRealThreadsMixin, public testing::Test {
 protected:
   static constexpr uint32_t NumThreads = 10;
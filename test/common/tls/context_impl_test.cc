@@ -14,6 +14,7 @@
 #include "source/common/tls/context_config_impl.h"
 #include "source/common/tls/context_impl.h"
 #include "source/common/tls/server_context_config_impl.h"
+#include "source/common/tls/server_context_impl.h"
 #include "source/common/tls/server_ssl_socket.h"
 #include "source/common/tls/utility.h"
 
@@ -669,6 +670,63 @@ TEST_F(SslContextImplTest, MultipleCertsSansAndCN) {
   EXPECT_NO_THROW(loadConfig(*server_context_config));
 }
 
+// The certificate of the name matching the SNI is selected, preferring ECDSA, and the first
+// certificate compatible with the client when the SNI does not match any name.
+TEST_F(SslContextImplTest, FindTlsContextPrefersEcdsaInConfigurationOrder) {
+  envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
+  // The last three certificates all have the DNS SAN server1.example.com.
+  const std::string tls_context_yaml = R"EOF(
+  common_tls_context:
+    tls_certificates:
+    - certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/no_san_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/no_san_key.pem"
+    - certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/san_dns_rsa_1_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/san_dns_rsa_1_key.pem"
+    - certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/selfsigned_ecdsa_p384_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/selfsigned_ecdsa_p384_key.pem"
+    - certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/san_dns_ecdsa_1_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/san_dns_ecdsa_1_key.pem"
+  full_scan_certs_on_sni_mismatch: true
+  )EOF";
+  TestUtility::loadFromYaml(TestEnvironment::substitute(tls_context_yaml), tls_context);
+  auto server_context_config =
+      *ServerContextConfigImpl::create(tls_context, factory_context_, false);
+  Envoy::Ssl::ServerContextSharedPtr server_ctx(
+      *manager_.createSslServerContext(*store_.rootScope(), *server_context_config, {}, nullptr));
+  auto cleanup = cleanUpHelper(server_ctx);
+  auto& context = dynamic_cast<ServerContextImpl&>(*server_ctx);
+
+  auto find = [&context](absl::string_view sni, const Ssl::CurveNIDVector& curves,
+                         bool expected_match) -> std::string {
+    bool cert_matched_sni = false;
+    const std::string file_name =
+        context.findTlsContext(sni, curves, false, &cert_matched_sni).first.getCertChainFileName();
+    EXPECT_EQ(expected_match, cert_matched_sni);
+    return file_name.substr(file_name.rfind('/') + 1);
+  };
+
+  // Only the first ECDSA certificate is kept for a name.
+  EXPECT_EQ("selfsigned_ecdsa_p384_cert.pem",
+            find("server1.example.com", {NID_secp384r1, NID_X9_62_prime256v1}, true));
+  EXPECT_EQ("san_dns_rsa_1_cert.pem", find("server1.example.com", {NID_X9_62_prime256v1}, true));
+  EXPECT_EQ("san_dns_rsa_1_cert.pem", find("server1.example.com", {}, true));
+
+  EXPECT_EQ("san_dns_ecdsa_1_cert.pem", find("nomatch.example.com", {NID_X9_62_prime256v1}, false));
+  EXPECT_EQ("selfsigned_ecdsa_p384_cert.pem",
+            find("nomatch.example.com", {NID_X9_62_prime256v1, NID_secp384r1}, false));
+  EXPECT_EQ("no_san_cert.pem", find("nomatch.example.com", {NID_secp521r1}, false));
+  EXPECT_EQ("no_san_cert.pem", find("nomatch.example.com", {}, false));
+  EXPECT_EQ("san_dns_ecdsa_1_cert.pem", find("", {NID_X9_62_prime256v1}, false));
+}
+
 // Certificates with no subject CN and no SANs are rejected.
 TEST_F(SslContextImplTest, MustHaveSubjectOrSAN) {
   envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
@@ -0,0 +1,176 @@
+#include "envoy/extensions/key_value/file_based/v3/config.pb.h"
+
+#include "source/common/tls/session_resumption.h"
+
+#include "test/mocks/common.h"
+#include "test/mocks/server/server_factory_context.h"
+#include "test/test_common/registry.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+
+TEST(SharedSessionCacheTest, InsertLookupRemove) {
+  SharedSessionCache cache(100);
+  EXPECT_FALSE(cache.lookup("id1").has_value());
+  cache.insert("id1", "session1");
+  cache.insert("id2", "session2");
+  EXPECT_THAT(cache.lookup("id1"), testing::Optional(std::string("session1")));
+  // Inserting an existing ID replaces its session.
+  cache.insert("id1", "session1b");
+  EXPECT_THAT(cache.lookup("id1"), testing::Optional(std::string("session1b")));
+  EXPECT_EQ(cache.size(), 2);
+
+  cache.remove("id1");
+  // Removing a missing ID is a no-op.
+  cache.remove("id3");
+  EXPECT_FALSE(cache.lookup("id1").has_value());
+  EXPECT_TRUE(cache.lookup("id2").has_value());
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(SharedSessionCacheTest, EvictsLeastRecentlyUsedSessions) {
+  // One session per shard.
+  SharedSessionCache cache(1);
+  for (int i = 0; i < 1000; ++i) {
+    cache.insert(absl::StrCat("id", i), "session");
+  }
+  EXPECT_LE(cache.size(), 16);
+  // The last session inserted is the most recently used of its shard.
+  EXPECT_TRUE(cache.lookup("id999").has_value());
+  EXPECT_FALSE(cache.lookup("id0").has_value());
+}
+
+class SessionTicketKeyDeriverTest : public testing::Test {
+protected:
+  SessionTicketKeyDeriverTest() { time_system_.setSystemTime(std::chrono::hours(1000)); }
+
+  static absl::Span<const uint8_t> nameOf(const SessionTicketKeyDeriver::SessionTicketKey& key) {
+    return absl::MakeConstSpan(key.name_);
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  SessionTicketKeyDeriver deriver_{std::string(32, 'a'), std::chrono::seconds(60), time_system_};
+};
+
+TEST_F(SessionTicketKeyDeriverTest, KeysRotateEachInterval) {
+  const SessionTicketKeyDeriver::SessionTicketKey key = deriver_.encryptionKey();
+  absl::optional<SessionTicketKeyDeriver::DecryptionKey> decryption_key =
+      deriver_.decryptionKey(nameOf(key));
+  ASSERT_TRUE(decryption_key.has_value());
+  EXPECT_FALSE(decryption_key->renew_);
+  EXPECT_EQ(decryption_key->key_.aes_key_, key.aes_key_);
+  EXPECT_EQ(decryption_key->key_.hmac_key_, key.hmac_key_);
+
+  // After a rotation, tickets encrypted with the previous key are renewed.
+  time_system_.advanceTimeWait(std::chrono::seconds(60));
+  const SessionTicketKeyDeriver::SessionTicketKey next_key = deriver_.encryptionKey();
+  EXPECT_NE(next_key.name_, key.name_);
+  EXPECT_NE(next_key.aes_key_, key.aes_key_);
+  decryption_key = deriver_.decryptionKey(nameOf(key));
+  ASSERT_TRUE(decryption_key.has_value());
+  EXPECT_TRUE(decryption_key->renew_);
+
+  // After a second rotation, they are no longer accepted.
+  time_system_.advanceTimeWait(std::chrono::seconds(60));
+  EXPECT_FALSE(deriver_.decryptionKey(nameOf(key)).has_value());
+  EXPECT_TRUE(deriver_.decryptionKey(nameOf(next_key)).has_value());
+}
+
+TEST_F(SessionTicketKeyDeriverTest, KeysDependOnSecret) {
+  SessionTicketKeyDeriver same_secret(std::string(32, 'a'), std::chrono::seconds(60),
+                                      time_system_);
+  SessionTicketKeyDeriver other_secret(std::string(32, 'b'), std::chrono::seconds(60),
+                                       time_system_);
+  const SessionTicketKeyDeriver::SessionTicketKey key = deriver_.encryptionKey();
+  EXPECT_EQ(same_secret.encryptionKey().aes_key_, key.aes_key_);
+  EXPECT_TRUE(same_secret.decryptionKey(nameOf(key)).has_value());
+  EXPECT_NE(other_secret.encryptionKey().aes_key_, key.aes_key_);
+  EXPECT_FALSE(other_secret.decryptionKey(nameOf(key)).has_value());
+}
+
+class SharedSessionResumptionRegistryTest : public testing::Test {
+protected:
+  std::shared_ptr<SharedSessionResumptionRegistry> newRegistry() {
+    return std::make_shared<SharedSessionResumptionRegistry>();
+  }
+
+  NiceMock<Server::Configuration::MockServerFactoryContext> context_;
+};
+
+TEST_F(SharedSessionResumptionRegistryTest, SameConfigSharesState) {
+  std::shared_ptr<SharedSessionResumptionRegistry> registry =
+      SharedSessionResumptionRegistry::get(context_);
+  EXPECT_EQ(SharedSessionResumptionRegistry::get(context_), registry);
+
+  SharedSessionResumptionConfig config;
+  SharedSessionResumptionSharedPtr state = registry->getOrCreate(config, context_);
+  EXPECT_EQ(registry->getOrCreate(config, context_), state);
+  SharedSessionResumptionConfig other_config;
+  other_config.mutable_max_cached_sessions()->set_value(10);
+  EXPECT_NE(registry->getOrCreate(other_config, context_), state);
+
+  // A state created after all the contexts released the previous one keeps the ticket keys.
+  const SessionTicketKeyDeriver::SessionTicketKey key = state->ticketKeys().encryptionKey();
+  state.reset();
+  state = registry->getOrCreate(config, context_);
+  EXPECT_TRUE(state->ticketKeys().decryptionKey(absl::MakeConstSpan(key.name_)).has_value());
+}
+
+TEST_F(SharedSessionResumptionRegistryTest, SecretIsKeptInKeyValueStore) {
+  MockKeyValueStoreFactory factory;
+  EXPECT_CALL(factory, createEmptyConfigProto()).WillRepeatedly(testing::Invoke([]() {
+    return std::make_unique<
+        envoy::extensions::key_value::file_based::v3::FileBasedKeyValueStoreConfig>();
+  }));
+  Registry::InjectFactory<KeyValueStoreFactory> injector(factory);
+  SharedSessionResumptionConfig config;
+  auto* key_value_config = config.mutable_key_value_store_config()->mutable_config();
+  key_value_config->set_name("mock_key_value_store_factory");
+  key_value_config->mutable_typed_config()->PackFrom(
+      envoy::extensions::key_value::file_based::v3::FileBasedKeyValueStoreConfig());
+
+  std::string stored_secret;
+  EXPECT_CALL(factory, createStore(_, _, _, _))
+      .WillOnce(testing::Invoke([&stored_secret]() {
+        auto store = std::make_unique<NiceMock<MockKeyValueStore>>();
+        EXPECT_CALL(*store, get("session_ticket_secret")).WillOnce(Return(absl::nullopt));
+        EXPECT_CALL(*store, addOrUpdate("session_ticket_secret", _, _))
+            .WillOnce(testing::Invoke(
+                [&stored_secret](absl::string_view, absl::string_view value,
+                                 absl::optional<std::chrono::seconds>) { stored_secret = value; }));
+        EXPECT_CALL(*store, flush());
+        return store;
+      }))
+      .WillOnce(testing::Invoke([&stored_secret]() {
+        auto store = std::make_unique<NiceMock<MockKeyValueStore>>();
+        EXPECT_CALL(*store, get("session_ticket_secret"))
+            .WillOnce(Return(absl::string_view(stored_secret)));
+        EXPECT_CALL(*store, addOrUpdate(_, _, _)).Times(0);
+        return store;
+      }));
+
+  const SessionTicketKeyDeriver::SessionTicketKey key =
+      newRegistry()->getOrCreate(config, context_)->ticketKeys().encryptionKey();
+  EXPECT_EQ(stored_secret.size(), 64);
+  // A registry in a restarted process loads the secret, so it can decrypt the same tickets.
+  SharedSessionResumptionSharedPtr restarted = newRegistry()->getOrCreate(config, context_);
+  EXPECT_TRUE(restarted->ticketKeys().decryptionKey(absl::MakeConstSpan(key.name_)).has_value());
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
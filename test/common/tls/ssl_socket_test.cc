@@ -4433,6 +4433,81 @@ TEST_P(SslSocketTest, TicketSessionResumptionWrongKey) {
                               version_);
 }
 
+// Tickets are encrypted with keys derived from a secret shared by the contexts with the same
+// shared session resumption settings, so they are resumed by another context.
+TEST_P(SslSocketTest, TicketSessionResumptionSharedKeys) {
+  const std::string server_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem"
+  shared_session_resumption: {}
+)EOF";
+
+  const std::string client_ctx_yaml = R"EOF(
+    common_tls_context:
+  )EOF";
+
+  testTicketSessionResumption(server_ctx_yaml, {}, server_ctx_yaml, {}, client_ctx_yaml, true,
+                              version_);
+}
+
+TEST_P(SslSocketTest, TicketSessionResumptionSharedKeysDifferentSettings) {
+  const std::string server_ctx_yaml1 = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem"
+  shared_session_resumption: {}
+)EOF";
+
+  const std::string server_ctx_yaml2 = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem"
+  shared_session_resumption:
+    ticket_key_rotation_interval: 600s
+)EOF";
+
+  const std::string client_ctx_yaml = R"EOF(
+    common_tls_context:
+  )EOF";
+
+  testTicketSessionResumption(server_ctx_yaml1, {}, server_ctx_yaml2, {}, client_ctx_yaml, false,
+                              version_);
+}
+
+// Without tickets, TLSv1.2 sessions are resumed from the session cache shared by the contexts.
+TEST_P(SslSocketTest, StatefulSessionResumptionSharedCache) {
+  const std::string server_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_params:
+      tls_minimum_protocol_version: TLSv1_2
+      tls_maximum_protocol_version: TLSv1_2
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem"
+  disable_stateless_session_resumption: true
+  shared_session_resumption: {}
+)EOF";
+
+  const std::string client_ctx_yaml = R"EOF(
+    common_tls_context:
+  )EOF";
+
+  testTicketSessionResumption(server_ctx_yaml, {}, server_ctx_yaml, {}, client_ctx_yaml, true,
+                              version_);
+}
+
 // Sessions cannot be resumed even though the server certificates are the same,
 // because of the different SNI requirements.
 TEST_P(SslSocketTest, TicketSessionResumptionDifferentServerNames) {
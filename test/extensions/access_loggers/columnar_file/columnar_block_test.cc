@@ -0,0 +1,116 @@
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/access_loggers/columnar_file/columnar_block.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace ColumnarFile {
+namespace {
+
+TEST(ColumnarBlockTest, RoundTrip) {
+  BlockBuilder builder({"cluster", "code"});
+  const std::vector<std::vector<absl::string_view>> records = {
+      {"cluster_a", "200"}, {"cluster_b", "200"}, {"cluster_a", "503"}, {"", "200"}};
+  for (const auto& record : records) {
+    builder.addRecord(record);
+  }
+  EXPECT_EQ(4U, builder.records());
+
+  Buffer::OwnedImpl payload;
+  builder.serialize(payload);
+  // Repeated values are stored once per block: 2 header bytes, then per column the name, the
+  // dictionary and one byte per record.
+  EXPECT_EQ(2U + (8 + 1 + 10 + 10 + 1 + 4) + (5 + 1 + 4 + 4 + 4), payload.length());
+
+  const auto block = decodeBlock(payload.toString());
+  ASSERT_TRUE(block.ok());
+  EXPECT_EQ(std::vector<std::string>({"cluster", "code"}), block->column_names_);
+  ASSERT_EQ(records.size(), block->records_.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(std::vector<std::string>(records[i].begin(), records[i].end()), block->records_[i]);
+  }
+}
+
+TEST(ColumnarBlockTest, Clear) {
+  BlockBuilder builder({"a"});
+  builder.addRecord({"x"});
+  builder.clear();
+  EXPECT_EQ(0U, builder.records());
+  builder.addRecord({"y"});
+
+  Buffer::OwnedImpl payload;
+  builder.serialize(payload);
+  const auto block = decodeBlock(payload.toString());
+  ASSERT_TRUE(block.ok());
+  ASSERT_EQ(1U, block->records_.size());
+  EXPECT_EQ("y", block->records_[0][0]);
+}
+
+TEST(ColumnarBlockTest, LongValues) {
+  const std::string long_value(300, 'v');
+  BlockBuilder builder({"a"});
+  builder.addRecord({long_value});
+
+  Buffer::OwnedImpl payload;
+  builder.serialize(payload);
+  const auto block = decodeBlock(payload.toString());
+  ASSERT_TRUE(block.ok());
+  EXPECT_EQ(long_value, block->records_[0][0]);
+}
+
+TEST(ColumnarBlockTest, DecodeErrors) {
+  BlockBuilder builder({"a", "b"});
+  builder.addRecord({"x", "y"});
+  builder.addRecord({"z", "y"});
+  Buffer::OwnedImpl payload;
+  builder.serialize(payload);
+  const std::string encoded = payload.toString();
+
+  for (size_t length = 0; length < encoded.size(); ++length) {
+    EXPECT_FALSE(decodeBlock(encoded.substr(0, length)).ok()) << length;
+  }
+  EXPECT_EQ("trailing data after columnar block",
+            decodeBlock(encoded + "x").status().message());
+
+  // Point the second record of the last column past its dictionary.
+  std::string bad_code = encoded;
+  bad_code.back() = 5;
+  EXPECT_EQ("invalid value of column 'b'", decodeBlock(bad_code).status().message());
+
+  // Record and column counts that cannot fit in the payload are rejected before allocating.
+  EXPECT_FALSE(decodeBlock("\xff\xff\xff\xff\x0f\xff\xff\xff\xff\x0f").ok());
+  // So are records without columns, whose count the payload size does not bound.
+  EXPECT_EQ("columnar block records without columns",
+            decodeBlock(absl::string_view("\xff\xff\xff\xff\x0f\x00", 6)).status().message());
+}
+
+TEST(ColumnarBlockTest, Frames) {
+  Buffer::OwnedImpl data;
+  addFrameHeader(data, 3);
+  data.add("abc");
+  addFrameHeader(data, 0);
+  addFrameHeader(data, 2);
+  data.add("de");
+
+  const auto frames = splitFrames(data.toString());
+  ASSERT_TRUE(frames.ok());
+  EXPECT_EQ(std::vector<absl::string_view>({"abc", "", "de"}), frames.value());
+
+  const std::string truncated = data.toString().substr(0, data.length() - 1);
+  EXPECT_EQ("truncated frame 2", splitFrames(truncated).status().message());
+  EXPECT_EQ("invalid frame header at frame 0",
+            splitFrames(std::string("ECB2\x01\0\0\0x", 9)).status().message());
+  EXPECT_EQ("invalid frame header at frame 0", splitFrames("ECB1").status().message());
+}
+
+TEST(ColumnarBlockTest, DecompressErrors) {
+  EXPECT_FALSE(decompressFrame("not a zstd frame").ok());
+}
+
+} // namespace
+} // namespace ColumnarFile
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
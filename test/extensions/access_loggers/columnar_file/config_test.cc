@@ -0,0 +1,166 @@
+#include "envoy/config/accesslog/v3/accesslog.pb.h"
+#include "envoy/extensions/access_loggers/columnar_file/v3/columnar_file.pb.h"
+
+#include "source/common/access_log/access_log_impl.h"
+#include "source/extensions/access_loggers/columnar_file/columnar_block.h"
+#include "source/extensions/access_loggers/columnar_file/config.h"
+
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace ColumnarFile {
+namespace {
+
+TEST(ColumnarFileAccessLogNegativeTest, ValidateFail) {
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+
+  EXPECT_THROW(
+      ColumnarFileAccessLogFactory().createAccessLogInstance(
+          envoy::extensions::access_loggers::columnar_file::v3::ColumnarFileAccessLog(), nullptr,
+          context),
+      ProtoValidationException);
+}
+
+class ColumnarFileAccessLogTest : public testing::Test {
+public:
+  void createLogger(const std::string& yaml) {
+    envoy::extensions::access_loggers::columnar_file::v3::ColumnarFileAccessLog proto_config;
+    TestUtility::loadFromYaml(yaml, proto_config);
+
+    envoy::config::accesslog::v3::AccessLog config;
+    config.mutable_typed_config()->PackFrom(proto_config);
+
+    Filesystem::FilePathAndType file_info{Filesystem::DestinationType::File,
+                                          proto_config.path()};
+    EXPECT_CALL(context_.server_factory_context_.access_log_manager_, createAccessLog(file_info))
+        .WillOnce(Return(file_));
+    flush_timer_ =
+        new NiceMock<Event::MockTimer>(&context_.server_factory_context_.thread_local_.dispatcher_);
+    logger_ = AccessLog::AccessLogFactory::fromProto(config, context_);
+    EXPECT_CALL(*file_, write(_)).WillRepeatedly(Invoke([this](absl::string_view data) {
+      written_.append(data.data(), data.size());
+    }));
+  }
+
+  void log(absl::string_view path, uint64_t response_code) {
+    Http::TestRequestHeaderMapImpl request_headers{{":method", "GET"}, {":path", path}};
+    stream_info_.setResponseCode(response_code);
+    logger_->log({&request_headers}, stream_info_);
+  }
+
+  std::vector<DecodedBlock> decodeWritten() {
+    std::vector<DecodedBlock> blocks;
+    const auto frames = splitFrames(written_);
+    EXPECT_TRUE(frames.ok()) << frames.status();
+    if (!frames.ok()) {
+      return blocks;
+    }
+    for (const absl::string_view frame : frames.value()) {
+      const auto payload = decompressFrame(frame);
+      EXPECT_TRUE(payload.ok()) << payload.status();
+      if (!payload.ok()) {
+        return blocks;
+      }
+      auto block = decodeBlock(payload.value());
+      EXPECT_TRUE(block.ok()) << block.status();
+      if (!block.ok()) {
+        return blocks;
+      }
+      blocks.push_back(std::move(block.value()));
+    }
+    return blocks;
+  }
+
+  NiceMock<Server::Configuration::MockFactoryContext> context_;
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+  std::shared_ptr<AccessLog::MockAccessLogFile> file_{
+      std::make_shared<AccessLog::MockAccessLogFile>()};
+  Event::MockTimer* flush_timer_{};
+  std::string written_;
+  AccessLog::InstanceSharedPtr logger_;
+};
+
+TEST_F(ColumnarFileAccessLogTest, WritesFullBlocks) {
+  createLogger(R"EOF(
+path: /foo
+records_per_block: 2
+columns:
+- name: path
+  format: "%REQ(:PATH)%"
+- name: code
+  format: "%RESPONSE_CODE%"
+- name: service
+  format: "static"
+)EOF");
+
+  log("/a", 200);
+  EXPECT_TRUE(flush_timer_->enabled());
+  EXPECT_TRUE(written_.empty());
+  log("/b", 503);
+  EXPECT_FALSE(flush_timer_->enabled());
+  log("/a", 200);
+  log("/a", 200);
+
+  const std::vector<DecodedBlock> blocks = decodeWritten();
+  ASSERT_EQ(2U, blocks.size());
+  EXPECT_EQ(std::vector<std::string>({"path", "code", "service"}), blocks[0].column_names_);
+  EXPECT_EQ(std::vector<std::vector<std::string>>(
+                {{"/a", "200", "static"}, {"/b", "503", "static"}}),
+            blocks[0].records_);
+  EXPECT_EQ(std::vector<std::vector<std::string>>(
+                {{"/a", "200", "static"}, {"/a", "200", "static"}}),
+            blocks[1].records_);
+}
+
+TEST_F(ColumnarFileAccessLogTest, FlushesPartialBlockOnTimer) {
+  createLogger(R"EOF(
+path: /foo
+flush_interval: 0.5s
+columns:
+- name: path
+  format: "%REQ(:PATH)%"
+)EOF");
+
+  EXPECT_CALL(*flush_timer_, enableTimer(std::chrono::milliseconds(500), _));
+  log("/a", 200);
+  EXPECT_TRUE(written_.empty());
+
+  flush_timer_->invokeCallback();
+  const std::vector<DecodedBlock> blocks = decodeWritten();
+  ASSERT_EQ(1U, blocks.size());
+  EXPECT_EQ(std::vector<std::vector<std::string>>({{"/a"}}), blocks[0].records_);
+}
+
+TEST_F(ColumnarFileAccessLogTest, FlushesOnDestruction) {
+  createLogger(R"EOF(
+path: /foo
+columns:
+- name: path
+  format: "%REQ(:PATH)%"
+)EOF");
+
+  log("/a", 200);
+  log("/b", 200);
+  EXPECT_TRUE(written_.empty());
+
+  logger_.reset();
+  const std::vector<DecodedBlock> blocks = decodeWritten();
+  ASSERT_EQ(1U, blocks.size());
+  EXPECT_EQ(std::vector<std::vector<std::string>>({{"/a"}, {"/b"}}), blocks[0].records_);
+}
+
+} // namespace
+} // namespace ColumnarFile
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -175,6 +175,20 @@ public:
   envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig config_;
 };
 
+// A logger that does not add entries in place builds them separately for logInPlace().
+TEST_F(StreamingGrpcAccessLogTest, LogInPlaceWithSeparateEntry) {
+  initLogger(FlushInterval, 0);
+
+  MockAccessLogStream stream;
+  AccessLogCallbacks* callbacks;
+  expectStreamStart(stream, &callbacks);
+  expectFlushedLogEntriesCount(stream, MOCK_HTTP_LOG_FIELD_NAME, 1);
+  logger_->logInPlace([this](Protobuf::Struct& entry) { entry = mockHttpEntry(); });
+  EXPECT_EQ(1, logger_->numClears());
+  EXPECT_EQ(1,
+            TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_written")->value());
+}
+
 // Test basic stream logging flow.
 TEST_F(StreamingGrpcAccessLogTest, BasicFlow) {
   initLogger(FlushInterval, 0);
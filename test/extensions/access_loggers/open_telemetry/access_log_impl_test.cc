@@ -35,7 +35,6 @@ using opentelemetry::proto::common::v1::AnyValue;
 using opentelemetry::proto::common::v1::KeyValueList;
 using opentelemetry::proto::logs::v1::LogRecord;
 using testing::_;
-using testing::An;
 using testing::InSequence;
 using testing::Invoke;
 using testing::NiceMock;
@@ -53,6 +52,7 @@ class MockGrpcAccessLogger : public GrpcAccessLogger {
 public:
   // GrpcAccessLogger
   MOCK_METHOD(void, log, (LogRecord && entry));
+  MOCK_METHOD(void, logInPlace, (absl::FunctionRef<void(LogRecord&)> build));
   MOCK_METHOD(void, log, (Protobuf::Empty && entry));
 };
 
@@ -92,9 +92,12 @@ public:
   void expectLog(const std::string& expected_log_entry_yaml) {
     LogRecord expected_log_entry;
     TestUtility::loadFromYaml(expected_log_entry_yaml, expected_log_entry);
-    EXPECT_CALL(*logger_, log(An<LogRecord&&>()))
-        .WillOnce(Invoke([expected_log_entry](LogRecord&& entry) {
-          EXPECT_EQ(entry.DebugString(), expected_log_entry.DebugString());
+    EXPECT_CALL(*logger_, logInPlace(_))
+        .WillOnce(Invoke([this, expected_log_entry](absl::FunctionRef<void(LogRecord&)> build) {
+          // The logger may hand out a cleared record that was used before.
+          reused_entry_.Clear();
+          build(reused_entry_);
+          EXPECT_EQ(reused_entry_.DebugString(), expected_log_entry.DebugString());
         }));
   }
 
@@ -104,6 +107,7 @@ public:
   envoy::extensions::access_loggers::open_telemetry::v3::OpenTelemetryAccessLogConfig config_;
   std::shared_ptr<MockGrpcAccessLogger> logger_{new MockGrpcAccessLogger()};
   std::shared_ptr<MockGrpcAccessLoggerCache> logger_cache_{new MockGrpcAccessLoggerCache()};
+  LogRecord reused_entry_;
 };
 
 // Test log marshaling.
@@ -147,6 +147,55 @@ TEST_F(GrpcAccessLoggerImplTest, Log) {
             1);
 }
 
+// Records logged in place are added to the batch directly, and the records of a sent batch are
+// cleared and reused by the next one.
+TEST_F(GrpcAccessLoggerImplTest, LogInPlaceReusesRecords) {
+  setUpLogger();
+  const std::string expected_message_yaml = R"EOF(
+  resource_logs:
+    resource:
+      attributes:
+        - key: "log_name"
+          value:
+            string_value: "test_log_name"
+        - key: "zone_name"
+          value:
+            string_value: "zone_name"
+        - key: "cluster_name"
+          value:
+            string_value: "cluster_name"
+        - key: "node_name"
+          value:
+            string_value: "node_name"
+    scope_logs:
+      - log_records:
+          - severity_text: "{}"
+            attributes:
+              - key: "key"
+                value:
+                  string_value: "{}"
+  )EOF";
+  std::vector<const opentelemetry::proto::logs::v1::LogRecord*> records;
+  for (const std::string value : {"first", "second"}) {
+    grpc_access_logger_impl_test_helper_.expectSentMessage(
+        fmt::format(expected_message_yaml, value, value));
+    logger_->logInPlace([&](opentelemetry::proto::logs::v1::LogRecord& entry) {
+      EXPECT_EQ(entry.ByteSizeLong(), 0);
+      records.push_back(&entry);
+      entry.set_severity_text(value);
+      auto* attribute = entry.add_attributes();
+      attribute->set_key("key");
+      attribute->mutable_value()->set_string_value(value);
+    });
+  }
+  EXPECT_EQ(records[0], records[1]);
+  EXPECT_EQ(stats_store_.findCounterByString("access_logs.open_telemetry_access_log.logs_written")
+                .value()
+                .get()
+                .value(),
+            2);
+}
+
 TEST_F(GrpcAccessLoggerImplTest, LogWithStats) {
   setUpLogger();
   std::string expected_message_yaml = R"EOF(
@@ -7,6 +7,7 @@
 
 #include "benchmark/benchmark.h"
 #include "opentelemetry/proto/common/v1/common.pb.h"
+#include "opentelemetry/proto/logs/v1/logs.pb.h"
 
 using testing::NiceMock;
 
@@ -65,6 +66,9 @@ std::unique_ptr<Envoy::TestStreamInfo> makeStreamInfo() {
   return stream_info;
 }
 
+// Number of records in a batch before the batch is sent and cleared.
+constexpr int BATCH_SIZE = 100;
+
 } // namespace
 
 // NOLINTNEXTLINE(readability-identifier-naming)
@@ -81,6 +85,70 @@ static void BM_OpenTelemetryAccessLogFormatter(benchmark::State& state) {
 }
 BENCHMARK(BM_OpenTelemetryAccessLogFormatter);
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_OpenTelemetryAccessLogFormatterInPlace(benchmark::State& state) {
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeStreamInfo();
+  std::unique_ptr<OpenTelemetryFormatter> otel_formatter = makeOpenTelemetryFormatter();
+
+  size_t output_bytes = 0;
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    ::opentelemetry::proto::common::v1::KeyValueList output;
+    otel_formatter->format({}, *stream_info, *output.mutable_values());
+    output_bytes += output.ByteSize();
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+BENCHMARK(BM_OpenTelemetryAccessLogFormatterInPlace);
+
+// Builds each record separately and moves it into the pending batch, as the access logger did
+// before records were built in place.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_OpenTelemetryAccessLogBatchMoved(benchmark::State& state) {
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeStreamInfo();
+  std::unique_ptr<OpenTelemetryFormatter> otel_formatter = makeOpenTelemetryFormatter();
+  ::opentelemetry::proto::logs::v1::ScopeLogs batch;
+
+  size_t output_bytes = 0;
+  int batched = 0;
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    ::opentelemetry::proto::logs::v1::LogRecord entry;
+    otel_formatter->format({}, *stream_info, *entry.mutable_attributes());
+    output_bytes += entry.ByteSizeLong();
+    batch.mutable_log_records()->Add(std::move(entry));
+    if (++batched == BATCH_SIZE) {
+      batch.clear_log_records();
+      batched = 0;
+    }
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+BENCHMARK(BM_OpenTelemetryAccessLogBatchMoved);
+
+// Builds each record in place in the pending batch, reusing the records of cleared batches.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_OpenTelemetryAccessLogBatchInPlace(benchmark::State& state) {
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeStreamInfo();
+  std::unique_ptr<OpenTelemetryFormatter> otel_formatter = makeOpenTelemetryFormatter();
+  ::opentelemetry::proto::logs::v1::ScopeLogs batch;
+
+  size_t output_bytes = 0;
+  int batched = 0;
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    ::opentelemetry::proto::logs::v1::LogRecord& entry = *batch.add_log_records();
+    otel_formatter->format({}, *stream_info, *entry.mutable_attributes());
+    output_bytes += entry.ByteSizeLong();
+    if (++batched == BATCH_SIZE) {
+      batch.clear_log_records();
+      batched = 0;
+    }
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+BENCHMARK(BM_OpenTelemetryAccessLogBatchInPlace);
+
 } // namespace OpenTelemetry
 } // namespace AccessLoggers
 } // namespace Extensions
@@ -891,6 +891,64 @@ TEST(SubstitutionFormatterTest, OpenTelemetryFormatterMultiTokenTest) {
   }
 }
 
+TEST(SubstitutionFormatterTest, OpenTelemetryFormatterInPlaceTest) {
+  StreamInfo::MockStreamInfo stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{"some_request_header", "SOME_REQUEST_HEADER"}};
+
+  absl::optional<Http::Protocol> protocol = Http::Protocol::Http11;
+  EXPECT_CALL(stream_info, protocol()).WillRepeatedly(Return(protocol));
+
+  KeyValueList key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    values:
+      - key: "protocol"
+        value:
+          string_value: "%PROTOCOL% %REQ(missing_header)%"
+      - key: "nested"
+        value:
+          kvlist_value:
+            values:
+              - key: "header"
+                value:
+                  string_value: "%REQ(some_request_header)%"
+      - key: "list"
+        value:
+          array_value:
+            values:
+              - string_value: "%PROTOCOL%"
+  )EOF",
+                            key_mapping);
+  OpenTelemetryFormatter formatter(key_mapping, {});
+
+  // Formatting in place appends after any entries that are already present.
+  KeyValueList output;
+  output.add_values()->set_key("existing");
+  formatter.format({&request_header}, stream_info, *output.mutable_values());
+
+  KeyValueList expected;
+  TestUtility::loadFromYaml(R"EOF(
+    values:
+      - key: "existing"
+      - key: "protocol"
+        value:
+          string_value: "HTTP/1.1 -"
+      - key: "nested"
+        value:
+          kvlist_value:
+            values:
+              - key: "header"
+                value:
+                  string_value: "SOME_REQUEST_HEADER"
+      - key: "list"
+        value:
+          array_value:
+            values:
+              - string_value: "HTTP/1.1"
+  )EOF",
+                            expected);
+  EXPECT_TRUE(TestUtility::protoEqual(output, expected));
+}
+
 #ifdef USE_CEL_PARSER
 TEST(SubstitutionFormatterTest, CELFormatterTest) {
   {
@@ -322,6 +322,39 @@ TEST_F(AsyncFileHandleTest, TruncateReducesFileSize) {
   close(handle);
 }
 
+TEST_F(AsyncFileHandleTest, ReadMappedReturnsFileContentsClippedToFileSize) {
+  AsyncFileHandle handle = createAnonymousFile();
+  absl::StatusOr<size_t> write_status;
+  Buffer::OwnedImpl buf("hello world");
+  EXPECT_OK(handle->write(dispatcher_.get(), buf, 0, [&](absl::StatusOr<size_t> result) {
+    write_status = std::move(result);
+  }));
+  resolveFileActions();
+  EXPECT_THAT(write_status, IsOkAndHolds(11U));
+  absl::StatusOr<Buffer::InstancePtr> read_result, clipped_read_result, past_end_read_result;
+  EXPECT_OK(handle->readMapped(dispatcher_.get(), 6, 5,
+                               [&](absl::StatusOr<Buffer::InstancePtr> result) {
+                                 read_result = std::move(result);
+                               }));
+  resolveFileActions();
+  EXPECT_THAT(read_result, IsOkAndHolds(Pointee(BufferStringEqual("world"))));
+  EXPECT_OK(handle->readMapped(dispatcher_.get(), 6, 100,
+                               [&](absl::StatusOr<Buffer::InstancePtr> result) {
+                                 clipped_read_result = std::move(result);
+                               }));
+  resolveFileActions();
+  EXPECT_THAT(clipped_read_result, IsOkAndHolds(Pointee(BufferStringEqual("world"))));
+  EXPECT_OK(handle->readMapped(dispatcher_.get(), 20, 5,
+                               [&](absl::StatusOr<Buffer::InstancePtr> result) {
+                                 past_end_read_result = std::move(result);
+                               }));
+  resolveFileActions();
+  EXPECT_THAT(past_end_read_result, IsOkAndHolds(Pointee(BufferStringEqual(""))));
+  // The mapping outlives the file handle.
+  close(handle);
+  EXPECT_THAT(read_result, IsOkAndHolds(Pointee(BufferStringEqual("world"))));
+}
+
 TEST_F(AsyncFileHandleTest, DuplicateCreatesIndependentHandle) {
   auto handle = createAnonymousFile();
   absl::StatusOr<AsyncFileHandle> duplicate_status;
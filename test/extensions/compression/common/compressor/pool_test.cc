@@ -0,0 +1,89 @@
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/compression/common/compressor/pool.h"
+
+#include "test/mocks/thread_local/mocks.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Common {
+namespace Compressor {
+namespace {
+
+using testing::NiceMock;
+
+class FakeCompressor : public Envoy::Compression::Compressor::Compressor {
+public:
+  explicit FakeCompressor(uint64_t memory_usage) : memory_usage_(memory_usage) {}
+
+  void compress(Buffer::Instance&, Envoy::Compression::Compressor::State) override {
+    ++streams_compressed_;
+  }
+  void reset() { ++resets_; }
+  uint64_t memoryUsage() const { return memory_usage_; }
+
+  const uint64_t memory_usage_;
+  int streams_compressed_{0};
+  int resets_{0};
+};
+
+TEST(CompressorPoolTest, AcquireResetsReleasedCompressor) {
+  CompressorPool<FakeCompressor> pool(2, 1000);
+  EXPECT_EQ(pool.acquire(), nullptr);
+  auto compressor = std::make_unique<FakeCompressor>(100);
+  FakeCompressor* raw = compressor.get();
+  pool.release(std::move(compressor));
+  EXPECT_EQ(pool.idleCount(), 1);
+  EXPECT_EQ(pool.idleBytes(), 100);
+  std::unique_ptr<FakeCompressor> acquired = pool.acquire();
+  EXPECT_EQ(acquired.get(), raw);
+  EXPECT_EQ(acquired->resets_, 1);
+  EXPECT_EQ(pool.idleCount(), 0);
+  EXPECT_EQ(pool.idleBytes(), 0);
+}
+
+TEST(CompressorPoolTest, ReleaseDropsCompressorsBeyondBounds) {
+  CompressorPool<FakeCompressor> pool(2, 1000);
+  pool.release(std::make_unique<FakeCompressor>(100));
+  pool.release(std::make_unique<FakeCompressor>(100));
+  // Over the count.
+  pool.release(std::make_unique<FakeCompressor>(100));
+  EXPECT_EQ(pool.idleCount(), 2);
+  pool.acquire();
+  // Over the memory.
+  pool.release(std::make_unique<FakeCompressor>(901));
+  EXPECT_EQ(pool.idleCount(), 1);
+  pool.release(std::make_unique<FakeCompressor>(900));
+  EXPECT_EQ(pool.idleCount(), 2);
+  EXPECT_EQ(pool.idleBytes(), 1000);
+}
+
+TEST(ThreadLocalCompressorPoolTest, CompressorsAreReturnedWhenDestroyed) {
+  NiceMock<ThreadLocal::MockInstance> tls;
+  int created = 0;
+  ThreadLocalCompressorPool<FakeCompressor> pool(4, 1000, tls, [&created]() {
+    ++created;
+    return std::make_unique<FakeCompressor>(100);
+  });
+  Buffer::OwnedImpl buffer;
+  {
+    Envoy::Compression::Compressor::CompressorPtr first = pool.createCompressor();
+    Envoy::Compression::Compressor::CompressorPtr second = pool.createCompressor();
+    first->compress(buffer, Envoy::Compression::Compressor::State::Finish);
+    EXPECT_EQ(created, 2);
+    EXPECT_EQ(pool.pool().idleCount(), 0);
+  }
+  EXPECT_EQ(pool.pool().idleCount(), 2);
+  Envoy::Compression::Compressor::CompressorPtr reused = pool.createCompressor();
+  EXPECT_EQ(created, 2);
+  EXPECT_EQ(pool.pool().idleCount(), 1);
+}
+
+} // namespace
+} // namespace Compressor
+} // namespace Common
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -3,6 +3,7 @@
 #include "source/extensions/compression/gzip/compressor/config.h"
 #include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
 
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/utility.h"
 
 #include "absl/container/fixed_array.h"
@@ -15,6 +16,8 @@ namespace Gzip {
 namespace Compressor {
 namespace {
 
+using testing::NiceMock;
+
 // Test helpers
 
 void expectValidFlushedBuffer(const Buffer::OwnedImpl& output_buffer) {
@@ -150,8 +153,9 @@ TEST_P(ZlibCompressorImplFactoryTest, CreateCompressorTest) {
                        strategy, compression_level);
   }
   TestUtility::loadFromJson(json, gzip);
+  NiceMock<ThreadLocal::MockInstance> tls;
   Envoy::Compression::Compressor::CompressorPtr compressor =
-      GzipCompressorFactory(gzip).createCompressor();
+      GzipCompressorFactory(gzip, tls).createCompressor();
   // Check the created compressor produces valid output.
   TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
   compressor->compress(buffer, Envoy::Compression::Compressor::State::Flush);
@@ -261,6 +265,30 @@ TEST_F(ZlibCompressorImplTest, CompressWithNotCommonParams) {
   expectValidFinishedBuffer(accumulation_buffer, input_size);
 }
 
+// Exercises reusing a pooled compressor whose previous stream was abandoned before finishing.
+TEST_F(ZlibCompressorImplTest, PooledCompressorIsResetBetweenStreams) {
+  envoy::extensions::compression::gzip::compressor::v3::Gzip gzip;
+  gzip.mutable_max_pooled_contexts()->set_value(1);
+  NiceMock<ThreadLocal::MockInstance> tls;
+  GzipCompressorFactory factory(gzip, tls);
+
+  Buffer::OwnedImpl buffer;
+  TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
+  Envoy::Compression::Compressor::CompressorPtr compressor = factory.createCompressor();
+  compressor->compress(buffer, Envoy::Compression::Compressor::State::Flush);
+  compressor.reset();
+  drainBuffer(buffer);
+
+  for (int i = 0; i < 2; i++) {
+    TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
+    compressor = factory.createCompressor();
+    compressor->compress(buffer, Envoy::Compression::Compressor::State::Finish);
+    expectValidFinishedBuffer(buffer, 4096);
+    compressor.reset();
+    drainBuffer(buffer);
+  }
+}
+
 } // namespace
 } // namespace Compressor
 } // namespace Gzip
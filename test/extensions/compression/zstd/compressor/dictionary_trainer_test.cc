@@ -0,0 +1,127 @@
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/compression/zstd/compressor/dictionary_trainer.h"
+#include "source/extensions/compression/zstd/compressor/zstd_compressor_impl.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+#include "zdict.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Compressor {
+namespace {
+
+class ZstdDictionaryTrainerTest : public testing::Test {
+protected:
+  ZstdDictionaryTrainerPtr makeTrainer(const std::string& yaml) {
+    DictionaryTrainingProto config;
+    TestUtility::loadFromYaml(yaml, config);
+    return std::make_unique<ZstdDictionaryTrainer>(
+        config, *dispatcher_, api_->threadFactory(), api_->fileSystem(),
+        [this](absl::string_view dictionary) {
+          dictionaries_.emplace_back(dictionary);
+          dispatcher_->exit();
+        });
+  }
+
+  // Similar API responses, which have enough in common for a dictionary to be trained.
+  static std::string response(int i) {
+    return absl::StrCat(R"({"id":)", i, R"(,"name":"user-)", i * 7919 % 1000, R"(","email":"user)",
+                        i, R"(@example.com","roles":["reader","writer"],"active":)",
+                        i % 2 == 0 ? "true" : "false", R"(,"created_at":"2024-01-)", 10 + i % 20,
+                        R"(T12:00:00Z"})");
+  }
+
+  void addSamples(ZstdDictionaryTrainer& trainer, int first, int count) {
+    for (int i = first; i < first + count; ++i) {
+      EXPECT_TRUE(trainer.wantsSamples());
+      trainer.addSample(response(i));
+    }
+  }
+
+  Api::ApiPtr api_ = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher_ = api_->allocateDispatcher("test_thread");
+  std::vector<std::string> dictionaries_;
+};
+
+TEST_F(ZstdDictionaryTrainerTest, TrainsDictionaryFromSamples) {
+  const std::string path = TestEnvironment::temporaryPath("zstd_trained_dictionary");
+  ZstdDictionaryTrainerPtr trainer = makeTrainer(fmt::format(R"EOF(
+sample_count: 1000
+dictionary_size: 4096
+output_path: {}
+)EOF",
+                                                             path));
+  addSamples(*trainer, 0, 1000);
+  EXPECT_FALSE(trainer->wantsSamples());
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+
+  ASSERT_EQ(dictionaries_.size(), 1);
+  EXPECT_LE(dictionaries_[0].size(), 4096);
+  EXPECT_NE(ZDICT_getDictID(dictionaries_[0].data(), dictionaries_[0].size()), 0);
+  EXPECT_EQ(TestEnvironment::readFileToStringForTest(path), dictionaries_[0]);
+  // The dictionary is published by renaming a complete file over the output path.
+  EXPECT_FALSE(api_->fileSystem().fileExists(absl::StrCat(path, ".tmp")));
+
+  // Without a retrain interval only one dictionary is trained.
+  trainer->addSample(response(0));
+  EXPECT_EQ(trainer->sampleCount(), 0);
+}
+
+TEST_F(ZstdDictionaryTrainerTest, RetrainsAfterInterval) {
+  ZstdDictionaryTrainerPtr trainer = makeTrainer(R"EOF(
+sample_count: 1000
+dictionary_size: 4096
+retrain_interval: 0.001s
+)EOF");
+  addSamples(*trainer, 0, 1000);
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  ASSERT_EQ(dictionaries_.size(), 1);
+
+  while (!trainer->wantsSamples()) {
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+  addSamples(*trainer, 1000, 1000);
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  ASSERT_EQ(dictionaries_.size(), 2);
+  // Dictionaries trained from different samples have different IDs.
+  EXPECT_NE(ZDICT_getDictID(dictionaries_[0].data(), dictionaries_[0].size()),
+            ZDICT_getDictID(dictionaries_[1].data(), dictionaries_[1].size()));
+}
+
+TEST_F(ZstdDictionaryTrainerTest, CompressorSamplesLeadingBytesOfFinishedStreams) {
+  ZstdDictionaryTrainerPtr trainer = makeTrainer(R"EOF(
+sample_count: 8
+max_sample_bytes: 100
+)EOF");
+  ZstdCDictManagerPtr cdict_manager;
+  ZstdCompressorImpl compressor(3, false, 0, cdict_manager, 4096, trainer.get());
+
+  Buffer::OwnedImpl buffer;
+  TestUtility::feedBufferWithRandomCharacters(buffer, 60);
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Flush);
+  buffer.drain(buffer.length());
+  EXPECT_EQ(trainer->sampleCount(), 0);
+  // Beyond max_sample_bytes the stream is not copied.
+  TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  buffer.drain(buffer.length());
+  EXPECT_EQ(trainer->sampleCount(), 1);
+
+  // A reset compressor samples its next stream.
+  compressor.reset();
+  TestUtility::feedBufferWithRandomCharacters(buffer, 10);
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  EXPECT_EQ(trainer->sampleCount(), 2);
+}
+
+} // namespace
+} // namespace Compressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -1,9 +1,12 @@
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/crypto/utility.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/compression/zstd/compressor/config.h"
 #include "source/extensions/compression/zstd/decompressor/zstd_decompressor_impl.h"
 
 #include "test/mocks/server/factory_context.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "gtest/gtest.h"
@@ -105,6 +108,97 @@ TEST_F(ZstdCompressorImplTest, CompressWitHugeBuffer) {
   verifyWithDecompressor(std::move(compressor));
 }
 
+// Exercises reusing a pooled compressor whose previous stream was abandoned before finishing.
+TEST_F(ZstdCompressorImplTest, PooledCompressorIsResetBetweenStreams) {
+  envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
+  zstd.mutable_max_pooled_contexts()->set_value(1);
+  Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
+  NiceMock<Server::Configuration::MockFactoryContext> mock_context;
+  Envoy::Compression::Compressor::CompressorFactoryPtr factory =
+      lib_factory.createCompressorFactoryFromProto(zstd, mock_context);
+
+  Buffer::OwnedImpl buffer;
+  TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
+  factory->createCompressor()->compress(buffer, Envoy::Compression::Compressor::State::Flush);
+
+  verifyWithDecompressor(factory->createCompressor());
+  verifyWithDecompressor(factory->createCompressor());
+}
+
+TEST_F(ZstdCompressorImplTest, AddedDictionaryIsUsedByLaterStreams) {
+  NiceMock<Server::Configuration::MockFactoryContext> mock_context;
+  auto& server_context = mock_context.serverFactoryContext();
+  ZstdCDictManagerPtr cdict_manager = std::make_unique<ZstdCDictManager>(
+      Protobuf::RepeatedPtrField<envoy::config::core::v3::DataSource>(),
+      server_context.mainThreadDispatcher(), server_context.api(), server_context.threadLocal(),
+      true, [](const void* dict_buffer, size_t dict_size) {
+        return ZSTD_createCDict(dict_buffer, dict_size, default_compression_level_);
+      });
+  auto dictionary_id_of_stream = [&cdict_manager]() {
+    ZstdCompressorImpl compressor(default_compression_level_, default_enable_checksum_,
+                                  default_strategy_, cdict_manager, 4096);
+    Buffer::OwnedImpl buffer;
+    TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
+    compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+    const std::string compressed = buffer.toString();
+    return ZSTD_getDictID_fromFrame(compressed.data(), compressed.size());
+  };
+  EXPECT_EQ(dictionary_id_of_stream(), 0);
+
+  const std::string dictionary = TestEnvironment::readFileToStringForTest(
+      TestEnvironment::runfilesPath("test/extensions/compression/zstd/test_data/dictionary_one"));
+  const unsigned id = cdict_manager->addDictionary(dictionary);
+  EXPECT_NE(id, 0);
+  EXPECT_EQ(dictionary_id_of_stream(), id);
+
+  // An invalid dictionary is not added.
+  EXPECT_EQ(cdict_manager->addDictionary("not a dictionary"), 0);
+  EXPECT_EQ(dictionary_id_of_stream(), id);
+}
+
+// With dictionary training, a dictionary is only used for the clients that advertise it, as the
+// others cannot decompress the response.
+TEST_F(ZstdCompressorImplTest, DictionaryIsOnlyUsedForClientsThatAdvertiseIt) {
+  const std::string dictionary = TestEnvironment::readFileToStringForTest(
+      TestEnvironment::runfilesPath("test/extensions/compression/zstd/test_data/dictionary_one"));
+  const unsigned id = ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size());
+  ASSERT_NE(id, 0);
+  Buffer::OwnedImpl dictionary_buffer(dictionary);
+  const std::vector<uint8_t> digest =
+      Envoy::Common::Crypto::UtilitySingleton::get().getSha256Digest(dictionary_buffer);
+  const std::string hash(digest.begin(), digest.end());
+
+  auto dictionary_id_of_stream = [](Envoy::Compression::Compressor::CompressorPtr compressor) {
+    Buffer::OwnedImpl buffer;
+    TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
+    compressor->compress(buffer, Envoy::Compression::Compressor::State::Finish);
+    const std::string compressed = buffer.toString();
+    return ZSTD_getDictID_fromFrame(compressed.data(), compressed.size());
+  };
+
+  // The second factory reuses pooled contexts, which must not keep the previous stream's
+  // dictionary.
+  for (const uint32_t max_pooled_contexts : {0u, 1u}) {
+    envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
+    zstd.mutable_dictionary()->set_inline_bytes(dictionary);
+    zstd.mutable_dictionary_training();
+    zstd.mutable_max_pooled_contexts()->set_value(max_pooled_contexts);
+    NiceMock<Server::Configuration::MockFactoryContext> mock_context;
+    ON_CALL(mock_context.server_factory_context_.api_, threadFactory())
+        .WillByDefault(testing::ReturnRef(Thread::threadFactoryForTest()));
+    Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
+    Envoy::Compression::Compressor::CompressorFactoryPtr factory =
+        lib_factory.createCompressorFactoryFromProto(zstd, mock_context);
+
+    EXPECT_EQ(dictionary_id_of_stream(factory->createCompressorForDictionary(hash)), id);
+    // A client without the dictionary gets a stream without a dictionary.
+    EXPECT_EQ(dictionary_id_of_stream(factory->createCompressor()), 0);
+    EXPECT_EQ(dictionary_id_of_stream(factory->createCompressorForDictionary(std::string(32, 'x'))),
+              0);
+    EXPECT_EQ(dictionary_id_of_stream(factory->createCompressorForDictionary(hash)), id);
+  }
+}
+
 TEST_F(ZstdCompressorImplTest, IllegalConfig) {
   envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
   Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
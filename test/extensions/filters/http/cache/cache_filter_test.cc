@@ -1641,6 +1641,85 @@ TEST_F(CacheFilterTest, UpstreamResetMidResponseShouldLocalReply) {
   }
 }
 
+class CacheFilterMissCoalescingTest : public CacheFilterTest {
+protected:
+  CacheFilterMissCoalescingTest() { config_.mutable_miss_coalescing_timeout()->set_seconds(5); }
+
+  // Starts a leader request that misses, and a second request for the same key that waits for it.
+  void startLeaderAndFollower(CacheFilterSharedPtr& leader, CacheFilterSharedPtr& follower) {
+    leader = makeFilter(simple_cache_);
+    testDecodeRequestMiss(0, leader);
+    follower = makeFilter(simple_cache_);
+    EXPECT_EQ(follower->decodeHeaders(request_headers_, true),
+              Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+    pumpDispatcher();
+    // The follower waits rather than sending its own upstream request.
+    EXPECT_EQ(mock_upstreams_.size(), 1);
+  }
+};
+
+TEST_F(CacheFilterMissCoalescingTest, FollowerServedFromCacheAfterLeaderInserts) {
+  request_headers_.setHost("FollowerServedFromCacheAfterLeaderInserts");
+  CacheFilterSharedPtr leader, follower;
+  startLeaderAndFollower(leader, follower);
+
+  receiveUpstreamHeaders(0, response_headers_, true);
+  // Once the insert completes, the follower looks the response up again.
+  EXPECT_CALL(decoder_callbacks_, encodeHeaders_(IsSupersetOfHeaders(response_headers_), true));
+  pumpDispatcher();
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+  EXPECT_EQ(mock_upstreams_.size(), 1);
+  follower->onStreamComplete();
+  EXPECT_THAT(lookupStatus(), IsOkAndHolds(LookupStatus::CacheHit));
+  EXPECT_THAT(insertStatus(), IsOkAndHolds(InsertStatus::NoInsertCacheHit));
+}
+
+TEST_F(CacheFilterMissCoalescingTest, FollowerForwardedUpstreamWhenLeaderResponseIsNotCached) {
+  request_headers_.setHost("FollowerForwardedUpstreamWhenLeaderResponseIsNotCached");
+  response_headers_.setReferenceKey(Http::CustomHeaders::get().CacheControl, "no-store");
+  CacheFilterSharedPtr leader, follower;
+  startLeaderAndFollower(leader, follower);
+
+  receiveUpstreamHeaders(0, response_headers_, true);
+  pumpDispatcher();
+  ASSERT_EQ(mock_upstreams_.size(), 2);
+  EXPECT_THAT(mock_upstreams_headers_sent_[1], testing::Optional(request_headers_));
+  receiveUpstreamHeaders(1, response_headers_, true);
+  follower->onStreamComplete();
+  EXPECT_THAT(lookupStatus(), IsOkAndHolds(LookupStatus::CacheMiss));
+}
+
+TEST_F(CacheFilterMissCoalescingTest, FollowerForwardedUpstreamAfterTimeout) {
+  request_headers_.setHost("FollowerForwardedUpstreamAfterTimeout");
+  CacheFilterSharedPtr leader, follower;
+  startLeaderAndFollower(leader, follower);
+
+  time_source_.advanceTimeAndRun(std::chrono::seconds(5), *dispatcher_,
+                                 Event::Dispatcher::RunType::NonBlock);
+  ASSERT_EQ(mock_upstreams_.size(), 2);
+  EXPECT_THAT(mock_upstreams_headers_sent_[1], testing::Optional(request_headers_));
+  receiveUpstreamHeaders(1, response_headers_, true);
+  pumpDispatcher();
+  follower->onStreamComplete();
+  EXPECT_THAT(lookupStatus(), IsOkAndHolds(LookupStatus::CacheMiss));
+}
+
+TEST_F(CacheFilterMissCoalescingTest, LocalReplyWhileWaitingStopsWaiting) {
+  request_headers_.setHost("LocalReplyWhileWaitingStopsWaiting");
+  CacheFilterSharedPtr leader, follower;
+  startLeaderAndFollower(leader, follower);
+
+  Envoy::Http::TestResponseHeaderMapImpl local_response_headers{{":status", "503"}};
+  EXPECT_EQ(follower->encodeHeaders(local_response_headers, true),
+            Envoy::Http::FilterHeadersStatus::Continue);
+  receiveUpstreamHeaders(0, response_headers_, true);
+  // The follower does not serve the inserted response.
+  EXPECT_CALL(decoder_callbacks_, encodeHeaders_).Times(0);
+  pumpDispatcher();
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+  EXPECT_EQ(mock_upstreams_.size(), 1);
+}
+
 } // namespace
 } // namespace Cache
 } // namespace HttpFilters
@@ -0,0 +1,101 @@
+#include "source/extensions/filters/http/cache/miss_coalescer.h"
+
+#include "test/extensions/filters/http/cache/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace {
+
+class MissCoalescerTest : public ::testing::Test {
+protected:
+  Key keyFor(absl::string_view path) {
+    Key key;
+    key.set_host("example.com");
+    key.set_path(std::string(path));
+    return key;
+  }
+
+  MissCoalescer::JoinResult join(const HttpCache& cache, const Key& key,
+                                 absl::optional<bool>& released) {
+    return coalescer_->join(cache, key, *dispatcher_,
+                            [&released](bool inserted) { released = inserted; });
+  }
+
+  void pumpDispatcher() { dispatcher_->run(Event::Dispatcher::RunType::NonBlock); }
+
+  std::shared_ptr<MissCoalescer> coalescer_ = std::make_shared<MissCoalescer>();
+  MockHttpCache cache_;
+  Api::ApiPtr api_ = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher_ = api_->allocateDispatcher("test_thread");
+};
+
+TEST_F(MissCoalescerTest, FollowersAreReleasedWhenLeaderInserts) {
+  absl::optional<bool> leader_released, follower1_released, follower2_released;
+  MissCoalescer::JoinResult leader = join(cache_, keyFor("/a"), leader_released);
+  ASSERT_NE(leader.leader_, nullptr);
+  EXPECT_EQ(leader.follower_, nullptr);
+  MissCoalescer::JoinResult follower1 = join(cache_, keyFor("/a"), follower1_released);
+  MissCoalescer::JoinResult follower2 = join(cache_, keyFor("/a"), follower2_released);
+  EXPECT_EQ(follower1.leader_, nullptr);
+  ASSERT_NE(follower1.follower_, nullptr);
+  ASSERT_NE(follower2.follower_, nullptr);
+
+  leader.leader_->setInserted();
+  leader.leader_ = nullptr;
+  // The release is posted to the followers' dispatchers.
+  EXPECT_FALSE(follower1_released.has_value());
+  pumpDispatcher();
+  EXPECT_THAT(follower1_released, testing::Optional(true));
+  EXPECT_THAT(follower2_released, testing::Optional(true));
+  EXPECT_FALSE(leader_released.has_value());
+
+  // The next miss starts a new leader.
+  absl::optional<bool> next_released;
+  EXPECT_NE(join(cache_, keyFor("/a"), next_released).leader_, nullptr);
+}
+
+TEST_F(MissCoalescerTest, FollowersAreReleasedWithoutInsertWhenLeaderIsDestroyed) {
+  absl::optional<bool> leader_released, follower_released;
+  MissCoalescer::JoinResult leader = join(cache_, keyFor("/a"), leader_released);
+  MissCoalescer::JoinResult follower = join(cache_, keyFor("/a"), follower_released);
+  leader.leader_ = nullptr;
+  pumpDispatcher();
+  EXPECT_THAT(follower_released, testing::Optional(false));
+}
+
+TEST_F(MissCoalescerTest, DestroyedFollowerIsNotReleased) {
+  absl::optional<bool> leader_released, follower1_released, follower2_released;
+  MissCoalescer::JoinResult leader = join(cache_, keyFor("/a"), leader_released);
+  MissCoalescer::JoinResult follower1 = join(cache_, keyFor("/a"), follower1_released);
+  MissCoalescer::JoinResult follower2 = join(cache_, keyFor("/a"), follower2_released);
+  // Stops waiting before the leader is released.
+  follower1.follower_ = nullptr;
+  leader.leader_ = nullptr;
+  // Stops waiting after the release has been posted.
+  follower2.follower_ = nullptr;
+  pumpDispatcher();
+  EXPECT_FALSE(follower1_released.has_value());
+  EXPECT_FALSE(follower2_released.has_value());
+}
+
+TEST_F(MissCoalescerTest, DifferentKeysAndCachesAreNotCoalesced) {
+  MockHttpCache other_cache;
+  absl::optional<bool> released;
+  MissCoalescer::JoinResult a = join(cache_, keyFor("/a"), released);
+  MissCoalescer::JoinResult b = join(cache_, keyFor("/b"), released);
+  MissCoalescer::JoinResult other_a = join(other_cache, keyFor("/a"), released);
+  EXPECT_NE(a.leader_, nullptr);
+  EXPECT_NE(b.leader_, nullptr);
+  EXPECT_NE(other_a.leader_, nullptr);
+}
+
+} // namespace
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,61 @@
+#include "source/extensions/filters/http/compressor/compressed_response_cache.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Compressor {
+namespace {
+
+std::shared_ptr<const std::string> body(size_t size) {
+  return std::make_shared<const std::string>(size, 'x');
+}
+
+TEST(CompressedResponseCacheTest, LookupReturnsInsertedBody) {
+  CompressedResponseCache cache(1000, 100);
+  EXPECT_EQ(cache.maxBodyBytes(), 100);
+  EXPECT_EQ(cache.lookup("a"), nullptr);
+  cache.insert("a", body(10));
+  std::shared_ptr<const std::string> found = cache.lookup("a");
+  ASSERT_NE(found, nullptr);
+  EXPECT_EQ(found->size(), 10);
+  EXPECT_EQ(cache.sizeBytes(), 11);
+}
+
+TEST(CompressedResponseCacheTest, EvictsLeastRecentlyUsed) {
+  CompressedResponseCache cache(300, 100);
+  cache.insert("a", body(99));
+  cache.insert("b", body(99));
+  cache.insert("c", body(99));
+  // Looking up "a" makes "b" the least recently used.
+  EXPECT_NE(cache.lookup("a"), nullptr);
+  cache.insert("d", body(99));
+  EXPECT_EQ(cache.lookup("b"), nullptr);
+  EXPECT_NE(cache.lookup("a"), nullptr);
+  EXPECT_NE(cache.lookup("c"), nullptr);
+  EXPECT_NE(cache.lookup("d"), nullptr);
+  EXPECT_EQ(cache.sizeBytes(), 300);
+}
+
+TEST(CompressedResponseCacheTest, ReinsertReplacesEntry) {
+  CompressedResponseCache cache(300, 100);
+  cache.insert("a", body(10));
+  cache.insert("a", body(20));
+  EXPECT_EQ(cache.lookup("a")->size(), 20);
+  EXPECT_EQ(cache.sizeBytes(), 21);
+}
+
+TEST(CompressedResponseCacheTest, BodyLargerThanCacheIsNotInserted) {
+  CompressedResponseCache cache(100, 1000);
+  cache.insert("a", body(10));
+  cache.insert("b", body(100));
+  EXPECT_EQ(cache.lookup("b"), nullptr);
+  EXPECT_NE(cache.lookup("a"), nullptr);
+}
+
+} // namespace
+} // namespace Compressor
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
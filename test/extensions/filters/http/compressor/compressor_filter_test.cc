@@ -1,5 +1,6 @@
 #include <sys/types.h>
 
+#include "source/common/common/base64.h"
 #include "source/extensions/filters/http/compressor/compressor_filter.h"
 
 #include "test/mocks/compression/compressor/mocks.h"
@@ -32,13 +33,20 @@ public:
     EXPECT_CALL(*compressor, compress(_, _)).Times(expected_compress_calls_);
     return compressor;
   }
+  Envoy::Compression::Compressor::CompressorPtr
+  createCompressorForDictionary(absl::string_view dictionary_hash) override {
+    dictionary_hash_ = std::string(dictionary_hash);
+    return createCompressor();
+  }
   const std::string& statsPrefix() const override { CONSTRUCT_ON_FIRST_USE(std::string, "test."); }
   const std::string& contentEncoding() const override { return content_encoding_; }
 
   void setExpectedCompressCalls(uint32_t calls) { expected_compress_calls_ = calls; }
+  const std::string& dictionaryHash() const { return dictionary_hash_; }
 
 private:
   uint32_t expected_compress_calls_{1};
+  std::string dictionary_hash_;
   const std::string content_encoding_;
 };
 
@@ -347,6 +355,115 @@ TEST_F(CompressorFilterTest, AcceptanceTestEncodingWithTrailers) {
   doResponseCompression(headers, true);
 }
 
+class CompressedResponseCacheFilterTest : public CompressorFilterTest {
+public:
+  void SetUp() override {
+    setUpFilter(R"EOF(
+{
+  "response_direction_config": {
+    "compressed_response_cache": {
+      "max_cache_size_bytes": 100000,
+      "max_body_bytes": 300
+    }
+  },
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF");
+    response_stats_prefix_ = "response.";
+  }
+
+  void startResponse(absl::string_view content_length,
+                     absl::string_view available_dictionary = "") {
+    filter_ = std::make_unique<CompressorFilter>(config_);
+    filter_->setDecoderFilterCallbacks(decoder_callbacks_);
+    filter_->setEncoderFilterCallbacks(encoder_callbacks_);
+    Http::TestRequestHeaderMapImpl request_headers{{":method", "get"}, {"accept-encoding", "test"}};
+    if (!available_dictionary.empty()) {
+      request_headers.addCopy("available-dictionary", available_dictionary);
+    }
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, false));
+    Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", content_length}};
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+    EXPECT_EQ("test", headers.get_("content-encoding"));
+  }
+
+  uint64_t responseCounter(absl::string_view name) {
+    return stats_.counter(absl::StrCat("test.compressor.test.test.response.", name)).value();
+  }
+};
+
+TEST_F(CompressedResponseCacheFilterTest, RepeatedBodyIsCompressedOnce) {
+  populateBuffer(256);
+  for (int i = 0; i < 2; ++i) {
+    startResponse("256");
+    Buffer::OwnedImpl first(expected_str_.substr(0, 100));
+    Buffer::OwnedImpl rest(expected_str_.substr(100));
+    // The body is held back until the end of the stream.
+    EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(first, false));
+    EXPECT_EQ(0, first.length());
+    EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(rest, true));
+    // The mock compressor leaves the body unchanged.
+    EXPECT_EQ(expected_str_, rest.toString());
+  }
+  EXPECT_EQ(1, responseCounter("compressed_response_cache_miss"));
+  EXPECT_EQ(1, responseCounter("compressed_response_cache_hit"));
+  EXPECT_EQ(512, responseCounter("total_uncompressed_bytes"));
+  EXPECT_EQ(512, responseCounter("total_compressed_bytes"));
+}
+
+// A body compressed for a client that advertised a dictionary may have been compressed with it,
+// so it is not served to clients that advertised another dictionary, or none.
+TEST_F(CompressedResponseCacheFilterTest, BodyIsCachedPerAdvertisedDictionary) {
+  populateBuffer(256);
+  for (absl::string_view available_dictionary : {":aGFzaA==:", "", ":aGFzaA==:"}) {
+    startResponse("256", available_dictionary);
+    Buffer::OwnedImpl body(expected_str_);
+    EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(body, true));
+  }
+  EXPECT_EQ(2, responseCounter("compressed_response_cache_miss"));
+  EXPECT_EQ(1, responseCounter("compressed_response_cache_hit"));
+  EXPECT_EQ("hash", compressor_factory_->dictionaryHash());
+}
+
+TEST_F(CompressedResponseCacheFilterTest, LargeContentLengthIsNotCached) {
+  startResponse("1000");
+  populateBuffer(1000);
+  EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(data_, true));
+  verifyCompressedData();
+  EXPECT_EQ(0, responseCounter("compressed_response_cache_miss"));
+}
+
+TEST_F(CompressedResponseCacheFilterTest, BodyLongerThanContentLengthIsStreamed) {
+  compressor_factory_->setExpectedCompressCalls(2);
+  startResponse("100");
+  populateBuffer(200);
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data_, false));
+  populateBuffer(200);
+  // Exceeds max_body_bytes, so the buffered body is compressed as it arrives from here on.
+  EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(data_, false));
+  EXPECT_EQ(400, data_.length());
+  EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(data_, true));
+  EXPECT_EQ(0, responseCounter("compressed_response_cache_miss"));
+  EXPECT_EQ(0, responseCounter("compressed_response_cache_hit"));
+}
+
+TEST_F(CompressedResponseCacheFilterTest, ResponseWithTrailersIsNotCached) {
+  startResponse("100");
+  populateBuffer(100);
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data_, false));
+  EXPECT_CALL(encoder_callbacks_, addEncodedData(_, true))
+      .WillOnce(Invoke([&](Buffer::Instance& data, bool) { data_.move(data); }));
+  Http::TestResponseTrailerMapImpl trailers;
+  EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_->encodeTrailers(trailers));
+  EXPECT_EQ(expected_str_, data_.toString());
+  EXPECT_EQ(0, responseCounter("compressed_response_cache_miss"));
+}
+
 TEST_F(CompressorFilterTest, NoAcceptEncodingHeader) {
   doRequestNoCompression({{":method", "get"}, {}});
   Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
@@ -433,6 +550,30 @@ TEST_F(CompressorFilterTest, EmptyResponse) {
   EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(data_, true));
 }
 
+// The dictionary a client advertises is passed to the compressor library, and the response varies
+// on it.
+TEST_F(CompressorFilterTest, AvailableDictionary) {
+  const std::string hash(32, 'h');
+  doRequestNoCompression(
+      {{":method", "get"},
+       {"accept-encoding", "test"},
+       {"available-dictionary", absl::StrCat(":", Base64::encode(hash.data(), hash.size()), ":")}});
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
+  doResponseCompression(headers, false);
+  EXPECT_EQ(hash, compressor_factory_->dictionaryHash());
+  EXPECT_EQ("Accept-Encoding, Available-Dictionary", headers.get_("vary"));
+}
+
+// An Available-Dictionary header that is not a byte sequence is ignored.
+TEST_F(CompressorFilterTest, InvalidAvailableDictionary) {
+  doRequestNoCompression(
+      {{":method", "get"}, {"accept-encoding", "test"}, {"available-dictionary", "aGFzaA=="}});
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
+  doResponseCompression(headers, false);
+  EXPECT_EQ("", compressor_factory_->dictionaryHash());
+  EXPECT_EQ("Accept-Encoding", headers.get_("vary"));
+}
+
 // Verify removeAcceptEncoding header.
 TEST_F(CompressorFilterTest, RemoveAcceptEncodingHeader) {
   // Filter true, no response direction overrides. Header is removed.
@@ -66,9 +66,11 @@ public:
         .WillByDefault([]() -> Thread::ThreadFactory& { return Thread::threadFactoryForTest(); });
   }
 
-  void initCache() {
+  void initCache() { initCache(testConfig()); }
+
+  void initCache(const ConfigProto& cfg) {
     cache_ = std::dynamic_pointer_cast<FileSystemHttpCache>(
-        http_cache_factory_->getCache(cacheConfig(testConfig()), context_));
+        http_cache_factory_->getCache(cacheConfig(cfg), context_));
   }
 
   void waitForEvictionThreadIdle() { cache_->cache_eviction_thread_.waitForIdle(); }
@@ -720,6 +722,60 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, ReadWithMultipleBlocksWorksCorrectl
   pumpDispatcher();
 }
 
+class FileSystemHttpCacheTestWithMockFilesAndMappedReads
+    : public FileSystemHttpCacheTestWithMockFiles {
+public:
+  void SetUp() override {
+    ConfigProto cfg = testConfig();
+    cfg.mutable_mmap_read_min_bytes()->set_value(8);
+    initCache(cfg);
+  }
+};
+
+TEST_F(FileSystemHttpCacheTestWithMockFilesAndMappedReads, OnlyReadsAboveThresholdAreMapped) {
+  trailers_size_ = 0;
+  auto lookup = testLookupContext();
+  LookupResult result;
+  EXPECT_CALL(*mock_async_file_manager_, openExistingFile(_, _, _, _));
+  EXPECT_CALL(*mock_async_file_handle_, read(_, 0, CacheFileFixedBlock::size(), _));
+  EXPECT_CALL(*mock_async_file_handle_,
+              read(_, CacheFileFixedBlock::offsetToHeaders(), headers_size_, _));
+  lookup->getHeaders([&](LookupResult&& r, bool /*end_stream*/) { result = std::move(r); });
+  mock_async_file_manager_->nextActionCompletes(
+      absl::StatusOr<AsyncFileHandle>(mock_async_file_handle_));
+  pumpDispatcher();
+  mock_async_file_manager_->nextActionCompletes(
+      absl::StatusOr<Buffer::InstancePtr>(testHeaderBlock(12)));
+  pumpDispatcher();
+  mock_async_file_manager_->nextActionCompletes(
+      absl::StatusOr<Buffer::InstancePtr>(testHeaderBuffer()));
+  pumpDispatcher();
+  EXPECT_CALL(*mock_async_file_handle_,
+              readMapped(_, CacheFileFixedBlock::offsetToHeaders() + headers_size_, 8, _));
+  lookup->getBody(AdjustedByteRange(0, 8), [&](Buffer::InstancePtr body, bool end_stream) {
+    EXPECT_EQ(body->toString(), "beepboop");
+    EXPECT_FALSE(end_stream);
+  });
+  mock_async_file_manager_->nextActionCompletes(
+      absl::StatusOr<Buffer::InstancePtr>(std::make_unique<Buffer::OwnedImpl>("beepboop")));
+  pumpDispatcher();
+  // A read below the threshold is copied as usual.
+  EXPECT_CALL(*mock_async_file_handle_,
+              read(_, CacheFileFixedBlock::offsetToHeaders() + headers_size_ + 8, 4, _));
+  lookup->getBody(AdjustedByteRange(8, 12), [&](Buffer::InstancePtr body, bool end_stream) {
+    EXPECT_EQ(body->toString(), "bzzt");
+    EXPECT_TRUE(end_stream);
+  });
+  mock_async_file_manager_->nextActionCompletes(
+      absl::StatusOr<Buffer::InstancePtr>(std::make_unique<Buffer::OwnedImpl>("bzzt")));
+  pumpDispatcher();
+  lookup->onDestroy();
+  lookup.reset();
+  // There should be a file-close in the queue.
+  mock_async_file_manager_->nextActionCompletes(absl::OkStatus());
+  pumpDispatcher();
+}
+
 TEST_F(FileSystemHttpCacheTestWithMockFiles, DestroyingALookupWithFileActionInFlightCancelsAction) {
   auto lookup = testLookupContext();
   absl::Cleanup destroy_lookup([&lookup]() { lookup->onDestroy(); });
@@ -1386,6 +1442,27 @@ INSTANTIATE_TEST_SUITE_P(FileSystemHttpCacheTest, HttpCacheImplementationTest,
                            return "FileSystemHttpCache";
                          });
 
+// The same tests with every body read served from a mapping of the cache file.
+class FileSystemHttpCacheMappedReadsTestDelegate : public HttpCacheTestDelegate,
+                                                   public FileSystemCacheTestContext {
+public:
+  FileSystemHttpCacheMappedReadsTestDelegate() {
+    ConfigProto cfg = testConfig();
+    cfg.mutable_mmap_read_min_bytes()->set_value(1);
+    initCache(cfg);
+  }
+  std::shared_ptr<HttpCache> cache() override { return cache_; }
+  bool validationEnabled() const override { return true; }
+  void beforePumpingDispatcher() override { cache_->drainAsyncFileActionsForTest(); }
+};
+
+INSTANTIATE_TEST_SUITE_P(FileSystemHttpCacheMappedReadsTest, HttpCacheImplementationTest,
+                         testing::Values(
+                             std::make_unique<FileSystemHttpCacheMappedReadsTestDelegate>),
+                         [](const testing::TestParamInfo<HttpCacheImplementationTest::ParamType>&) {
+                           return "FileSystemHttpCacheMappedReads";
+                         });
+
 TEST(Registration, GetCacheFromFactory) {
   HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
       "envoy.extensions.http.cache.file_system_http_cache.v3.FileSystemHttpCacheConfig");
@@ -0,0 +1,52 @@
+#include "source/extensions/http/cache/memory_http_cache/frequency_sketch.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace MemoryHttpCache {
+namespace {
+
+TEST(FrequencySketchTest, WidthIsRoundedUpToPowerOfTwo) {
+  EXPECT_EQ(1, FrequencySketch(0).width());
+  EXPECT_EQ(64, FrequencySketch(64).width());
+  EXPECT_EQ(128, FrequencySketch(65).width());
+}
+
+TEST(FrequencySketchTest, CountsAndSaturates) {
+  FrequencySketch sketch(1024);
+  EXPECT_EQ(0, sketch.frequency(1));
+  for (uint32_t i = 1; i <= 20; ++i) {
+    sketch.increment(1);
+    EXPECT_EQ(std::min<uint32_t>(i, 15), sketch.frequency(1));
+  }
+  EXPECT_EQ(0, sketch.frequency(2));
+}
+
+TEST(FrequencySketchTest, HalvesAfterSampleSize) {
+  FrequencySketch sketch(64);
+  for (uint32_t i = 0; i < 8; ++i) {
+    sketch.increment(42);
+  }
+  EXPECT_EQ(8, sketch.frequency(42));
+
+  // The sample size is ten times the width; other keys make up the rest of it. Increments of
+  // keys whose counters have all saturated do not count towards it, hence the slack.
+  uint64_t increments = 8;
+  for (uint64_t hash = 1000; sketch.frequency(42) >= 8; ++hash) {
+    sketch.increment(hash);
+    ++increments;
+    ASSERT_LE(increments, 11 * 64);
+  }
+  EXPECT_GE(increments, 10 * 64);
+  EXPECT_GE(sketch.frequency(42), 4);
+}
+
+} // namespace
+} // namespace MemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
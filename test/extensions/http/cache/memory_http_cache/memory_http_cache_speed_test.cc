@@ -0,0 +1,92 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+//
+// Measures the hit path of MemoryHttpCache with concurrent lookups, comparing a single shard, where
+// every lookup takes the same lock, with the default 16 shards.
+
+#include "source/common/http/header_map_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/http/cache/memory_http_cache/memory_http_cache.h"
+
+#include "test/mocks/server/server_factory_context.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace MemoryHttpCache {
+
+constexpr int NumEntries = 1024;
+
+class MemoryHttpCacheSpeedTest {
+public:
+  explicit MemoryHttpCacheSpeedTest(uint32_t shard_count) : cache_(config(shard_count), scope_) {
+    requests_.reserve(NumEntries);
+    for (int i = 0; i < NumEntries; ++i) {
+      Http::TestRequestHeaderMapImpl headers;
+      headers.setMethod("GET");
+      headers.setHost("example.com");
+      headers.setScheme("https");
+      headers.setPath(absl::StrCat("/", i));
+      requests_.emplace_back(headers, SystemTime(), vary_allow_list_);
+      cache_.insert(requests_.back().key(), headers, vary_allow_list_,
+                    std::make_shared<const CachedResponse>(
+                        Http::createHeaderMap<Http::ResponseHeaderMapImpl>(
+                            {{Http::Headers::get().Status, "200"}}),
+                        ResponseMetadata{}, std::make_shared<const std::string>(1024, 'x'),
+                        nullptr));
+    }
+  }
+
+  void lookup(int thread_index, int iteration) {
+    const LookupRequest& request = requests_[(thread_index * 31 + iteration) % NumEntries];
+    benchmark::DoNotOptimize(cache_.lookup(request));
+  }
+
+private:
+  static ConfigProto config(uint32_t shard_count) {
+    ConfigProto config;
+    config.set_name("speed_test");
+    config.set_max_cache_size_bytes(64 * 1024 * 1024);
+    config.mutable_shard_count()->set_value(shard_count);
+    return config;
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  Stats::Scope& scope_{*store_.rootScope()};
+  testing::NiceMock<Server::Configuration::MockServerFactoryContext> context_;
+  Protobuf::RepeatedPtrField<envoy::type::matcher::v3::StringMatcher> allow_list_;
+  VaryAllowList vary_allow_list_{allow_list_, context_};
+  std::vector<LookupRequest> requests_;
+  MemoryHttpCache cache_;
+};
+
+static void bmLookupHit(benchmark::State& state, MemoryHttpCacheSpeedTest& test) {
+  int iteration = 0;
+  for (auto _ : state) { // NOLINT
+    test.lookup(state.thread_index(), iteration++);
+  }
+}
+
+static void bmLookupHitSingleShard(benchmark::State& state) {
+  // Function-local statics are initialized once, by whichever benchmark thread gets there first.
+  static MemoryHttpCacheSpeedTest test(1);
+  bmLookupHit(state, test);
+}
+BENCHMARK(bmLookupHitSingleShard)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
+
+static void bmLookupHitSharded(benchmark::State& state) {
+  static MemoryHttpCacheSpeedTest test(16);
+  bmLookupHit(state, test);
+}
+BENCHMARK(bmLookupHitSharded)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
+
+} // namespace MemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,220 @@
+#include "envoy/extensions/http/cache/memory_http_cache/v3/memory_http_cache.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/http/header_map_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/http/cache/cache_entry_utils.h"
+#include "source/extensions/http/cache/memory_http_cache/memory_http_cache.h"
+
+#include "test/extensions/filters/http/cache/http_cache_implementation_test_common.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace MemoryHttpCache {
+namespace {
+
+using ::testing::NiceMock;
+
+ConfigProto testConfig() {
+  ConfigProto config;
+  config.set_name("test");
+  config.set_max_cache_size_bytes(1024 * 1024);
+  return config;
+}
+
+Key keyFor(int i) {
+  Key key;
+  key.set_host("example.com");
+  key.set_path(absl::StrCat("/", i));
+  return key;
+}
+
+CachedResponseSharedPtr responseOfSize(size_t body_size) {
+  return std::make_shared<const CachedResponse>(
+      Http::createHeaderMap<Http::ResponseHeaderMapImpl>({}), ResponseMetadata{},
+      std::make_shared<const std::string>(body_size, 'x'), nullptr);
+}
+
+class MemoryCacheShardTest : public testing::Test {
+protected:
+  MemoryCacheStats makeStats() {
+    return generateStats(stat_names_, *store_.rootScope(), "test", 0);
+  }
+
+  // Looks up and inserts keys in the shard using the key number as the hash, so that the test
+  // does not depend on which keys collide in the frequency sketch.
+  CachedResponseSharedPtr lookup(MemoryCacheShard& shard, int i) {
+    return shard.lookup(keyFor(i), i);
+  }
+  bool insert(MemoryCacheShard& shard, int i, size_t body_size = 1000) {
+    return shard.insert(keyFor(i), i, responseOfSize(body_size));
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  MemoryCacheStatNames stat_names_{store_.symbolTable()};
+};
+
+TEST_F(MemoryCacheShardTest, RejectsUnpopularEntriesWhenFull) {
+  // A 1000 byte window and room for 99 entries in the main segment.
+  MemoryCacheShard shard(100000, 100000, makeStats());
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_TRUE(insert(shard, i));
+  }
+  // None of the entries has been looked up, so once the main segment is full each entry pushed
+  // out of the window is rejected rather than evicting an equally unpopular one.
+  EXPECT_EQ(shard.stats().insert_.value(), 200);
+  EXPECT_EQ(shard.stats().reject_.value(), 100);
+  EXPECT_EQ(shard.stats().eviction_.value(), 0);
+  EXPECT_EQ(shard.stats().size_count_.value(), 100);
+  EXPECT_EQ(shard.stats().size_bytes_.value(), 100000);
+  EXPECT_NE(lookup(shard, 0), nullptr);
+  EXPECT_NE(lookup(shard, 98), nullptr);
+  EXPECT_EQ(lookup(shard, 99), nullptr);
+  EXPECT_EQ(lookup(shard, 198), nullptr);
+  EXPECT_NE(lookup(shard, 199), nullptr);
+}
+
+TEST_F(MemoryCacheShardTest, AdmitsPopularEntryByEvictingLeastRecentlyUsed) {
+  MemoryCacheShard shard(100000, 100000, makeStats());
+  for (int i = 0; i < 200; ++i) {
+    insert(shard, i);
+  }
+  // Misses count towards the frequency of the key.
+  for (int j = 0; j < 3; ++j) {
+    EXPECT_EQ(lookup(shard, 500), nullptr);
+  }
+  EXPECT_TRUE(insert(shard, 500));
+  // Pushes 500 out of the window, evicting the least recently used entry of the main segment.
+  EXPECT_TRUE(insert(shard, 501));
+  EXPECT_EQ(shard.stats().eviction_.value(), 1);
+  EXPECT_EQ(lookup(shard, 0), nullptr);
+  EXPECT_NE(lookup(shard, 500), nullptr);
+  EXPECT_NE(lookup(shard, 501), nullptr);
+}
+
+TEST_F(MemoryCacheShardTest, RejectsOversizedEntry) {
+  MemoryCacheShard shard(100000, 500, makeStats());
+  EXPECT_FALSE(insert(shard, 1, 1000));
+  EXPECT_TRUE(insert(shard, 2, 500));
+  EXPECT_EQ(shard.stats().reject_.value(), 1);
+  EXPECT_EQ(lookup(shard, 1), nullptr);
+  EXPECT_NE(lookup(shard, 2), nullptr);
+}
+
+TEST_F(MemoryCacheShardTest, HashCollisionComparesKeys) {
+  MemoryCacheShard shard(100000, 100000, makeStats());
+  EXPECT_TRUE(shard.insert(keyFor(1), 7, responseOfSize(10)));
+  EXPECT_EQ(shard.lookup(keyFor(2), 7), nullptr);
+  // Inserting a colliding key replaces the previous entry.
+  EXPECT_TRUE(shard.insert(keyFor(2), 7, responseOfSize(20)));
+  EXPECT_EQ(shard.lookup(keyFor(1), 7), nullptr);
+  CachedResponseSharedPtr response = shard.lookup(keyFor(2), 7);
+  ASSERT_NE(response, nullptr);
+  EXPECT_EQ(response->body_->size(), 20);
+  EXPECT_EQ(shard.stats().size_count_.value(), 1);
+}
+
+TEST_F(MemoryCacheShardTest, UpdateReplacesResponse) {
+  MemoryCacheShard shard(100000, 100000, makeStats());
+  EXPECT_FALSE(shard.update(keyFor(1), 1, [](const CachedResponse&) -> CachedResponseSharedPtr {
+    ADD_FAILURE() << "update_fn called for a missing entry";
+    return nullptr;
+  }));
+  insert(shard, 1, 100);
+  EXPECT_TRUE(shard.update(keyFor(1), 1, [](const CachedResponse& entry) {
+    Http::ResponseHeaderMapPtr headers = Http::createHeaderMap<Http::ResponseHeaderMapImpl>(
+        {{Http::LowerCaseString("etag"), "abc"}});
+    return std::make_shared<const CachedResponse>(std::move(headers), ResponseMetadata{},
+                                                  entry.body_, nullptr);
+  }));
+  CachedResponseSharedPtr response = lookup(shard, 1);
+  ASSERT_NE(response, nullptr);
+  EXPECT_EQ(response->response_headers_->get(Http::LowerCaseString("etag"))[0]->value(), "abc");
+  EXPECT_EQ(response->body_->size(), 100);
+  EXPECT_EQ(shard.stats().size_bytes_.value(), response->size_);
+}
+
+TEST_F(MemoryCacheShardTest, EraseRemovesEntry) {
+  MemoryCacheShard shard(100000, 100000, makeStats());
+  insert(shard, 1, 100);
+  insert(shard, 2, 100);
+  EXPECT_NE(shard.peek(keyFor(1), 1), nullptr);
+  shard.erase(keyFor(1), 1);
+  // Erasing a missing key is a no-op.
+  shard.erase(keyFor(3), 3);
+  EXPECT_EQ(shard.peek(keyFor(1), 1), nullptr);
+  EXPECT_NE(lookup(shard, 2), nullptr);
+  EXPECT_EQ(shard.stats().size_count_.value(), 1);
+}
+
+class MemoryHttpCacheTestDelegate : public HttpCacheTestDelegate {
+public:
+  std::shared_ptr<HttpCache> cache() override { return cache_; }
+  bool validationEnabled() const override { return true; }
+
+private:
+  Stats::IsolatedStoreImpl store_;
+  std::shared_ptr<MemoryHttpCache> cache_ =
+      std::make_shared<MemoryHttpCache>(testConfig(), *store_.rootScope());
+};
+
+INSTANTIATE_TEST_SUITE_P(MemoryHttpCacheTest, HttpCacheImplementationTest,
+                         testing::Values(std::make_unique<MemoryHttpCacheTestDelegate>),
+                         [](const testing::TestParamInfo<HttpCacheImplementationTest::ParamType>&) {
+                           return "MemoryHttpCache";
+                         });
+
+class MemoryHttpCacheFactoryTest : public testing::Test {
+protected:
+  MemoryHttpCacheFactoryTest()
+      : factory_(Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+            "envoy.extensions.http.cache.memory_http_cache.v3.MemoryHttpCacheConfig")) {}
+
+  std::shared_ptr<HttpCache> getCache(const ConfigProto& config) {
+    envoy::extensions::filters::http::cache::v3::CacheConfig cache_config;
+    cache_config.mutable_typed_config()->PackFrom(config);
+    return factory_->getCache(cache_config, context_);
+  }
+
+  HttpCacheFactory* const factory_;
+  NiceMock<Server::Configuration::MockFactoryContext> context_;
+};
+
+TEST_F(MemoryHttpCacheFactoryTest, SameNameSharesCache) {
+  ASSERT_NE(factory_, nullptr);
+  std::shared_ptr<HttpCache> cache = getCache(testConfig());
+  EXPECT_EQ(cache->cacheInfo().name_, "envoy.extensions.http.cache.memory_http_cache");
+  EXPECT_EQ(getCache(testConfig()), cache);
+  ConfigProto other_config = testConfig();
+  other_config.set_name("other");
+  EXPECT_NE(getCache(other_config), cache);
+}
+
+TEST_F(MemoryHttpCacheFactoryTest, MismatchedConfigWithSameNameThrows) {
+  ASSERT_NE(factory_, nullptr);
+  std::shared_ptr<HttpCache> cache = getCache(testConfig());
+  ConfigProto mismatched_config = testConfig();
+  mismatched_config.set_max_cache_size_bytes(2048);
+  EXPECT_THROW_WITH_REGEX(getCache(mismatched_config), EnvoyException,
+                          "mismatched MemoryHttpCacheConfig with same name");
+}
+
+TEST_F(MemoryHttpCacheFactoryTest, InvalidConfigThrows) {
+  ASSERT_NE(factory_, nullptr);
+  ConfigProto config = testConfig();
+  config.set_max_cache_size_bytes(0);
+  EXPECT_THROW(getCache(config), EnvoyException);
+}
+
+} // namespace
+} // namespace MemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
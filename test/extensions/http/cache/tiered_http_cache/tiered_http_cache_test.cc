@@ -0,0 +1,205 @@
+#include "envoy/extensions/http/cache/simple_http_cache/v3/config.pb.h"
+#include "envoy/extensions/http/cache/tiered_http_cache/v3/tiered_http_cache.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
+#include "source/extensions/http/cache/tiered_http_cache/tiered_http_cache.h"
+
+#include "test/extensions/filters/http/cache/http_cache_implementation_test_common.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace TieredHttpCache {
+namespace {
+
+using ::testing::NiceMock;
+
+ConfigProto testConfig() {
+  ConfigProto config;
+  config.mutable_memory_tier()->set_name("test");
+  config.mutable_memory_tier()->set_max_cache_size_bytes(1024 * 1024);
+  config.mutable_memory_tier()->mutable_max_individual_cache_entry_size_bytes()->set_value(1024);
+  config.mutable_backing_tier()->PackFrom(
+      envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig());
+  return config;
+}
+
+class TieredHttpCacheTestDelegate : public HttpCacheTestDelegate {
+public:
+  std::shared_ptr<HttpCache> cache() override { return cache_; }
+  bool validationEnabled() const override { return true; }
+
+private:
+  Stats::IsolatedStoreImpl store_;
+  Event::SimulatedTimeSystem time_system_;
+  std::shared_ptr<TieredHttpCache> cache_ = std::make_shared<TieredHttpCache>(
+      testConfig(), std::make_shared<SimpleHttpCache>(), *store_.rootScope(), time_system_);
+};
+
+INSTANTIATE_TEST_SUITE_P(TieredHttpCacheTest, HttpCacheImplementationTest,
+                         testing::Values(std::make_unique<TieredHttpCacheTestDelegate>),
+                         [](const testing::TestParamInfo<HttpCacheImplementationTest::ParamType>&) {
+                           return "TieredHttpCache";
+                         });
+
+class TieredHttpCacheTest : public HttpCacheImplementationTest {
+protected:
+  TieredHttpCache& tieredCache() { return static_cast<TieredHttpCache&>(*cache()); }
+
+  Http::TestResponseHeaderMapImpl responseHeaders() {
+    return {{":status", "200"},
+            {"date", formatter_.fromTime(time_system_.systemTime())},
+            {"cache-control", "public,max-age=3600"}};
+  }
+
+  bool inMemoryTier(absl::string_view path) {
+    return tieredCache().memoryTier().lookup(makeLookupRequest(path)) != nullptr;
+  }
+
+  void removeFromMemoryTier(absl::string_view path) {
+    LookupRequest request = makeLookupRequest(path);
+    tieredCache().memoryTier().erase(request.key(), request.requestHeaders(),
+                                     request.varyAllowList());
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(TieredHttpCacheTest, TieredHttpCacheTest,
+                         testing::Values(std::make_unique<TieredHttpCacheTestDelegate>),
+                         [](const testing::TestParamInfo<TieredHttpCacheTest::ParamType>&) {
+                           return "TieredHttpCache";
+                         });
+
+TEST_P(TieredHttpCacheTest, InsertWritesThroughToMemoryTier) {
+  ASSERT_TRUE(insert("/a", responseHeaders(), "body").ok());
+  EXPECT_TRUE(inMemoryTier("/a"));
+}
+
+TEST_P(TieredHttpCacheTest, LargeResponseIsOnlyCachedInBackingTier) {
+  const std::string body(2048, 'x');
+  ASSERT_TRUE(insert("/a", responseHeaders(), body).ok());
+  EXPECT_FALSE(inMemoryTier("/a"));
+  LookupContextPtr context = lookup("/a");
+  EXPECT_EQ(lookup_result_.cache_entry_status_, CacheEntryStatus::Ok);
+  EXPECT_EQ(getBody(*context, 0, body.size()), std::make_pair(body, true));
+  // Too large to be promoted either.
+  EXPECT_FALSE(inMemoryTier("/a"));
+}
+
+TEST_P(TieredHttpCacheTest, BackingTierHitIsPromoted) {
+  ASSERT_TRUE(insert("/a", responseHeaders(), "body").ok());
+  removeFromMemoryTier("/a");
+  EXPECT_FALSE(inMemoryTier("/a"));
+  LookupContextPtr context = lookup("/a");
+  EXPECT_EQ(lookup_result_.cache_entry_status_, CacheEntryStatus::Ok);
+  // Not promoted until the whole body has been read.
+  EXPECT_FALSE(inMemoryTier("/a"));
+  EXPECT_EQ(getBody(*context, 0, 4), std::make_pair(std::string("body"), true));
+  EXPECT_TRUE(inMemoryTier("/a"));
+}
+
+TEST_P(TieredHttpCacheTest, PartiallyReadBackingTierHitIsNotPromoted) {
+  ASSERT_TRUE(insert("/a", responseHeaders(), "body").ok());
+  removeFromMemoryTier("/a");
+  LookupContextPtr context = lookup("/a");
+  EXPECT_EQ(getBody(*context, 1, 4), std::make_pair(std::string("ody"), true));
+  EXPECT_FALSE(inMemoryTier("/a"));
+}
+
+TEST_P(TieredHttpCacheTest, UpdateHeadersInvalidatesMemoryTier) {
+  ASSERT_TRUE(insert("/a", responseHeaders(), "body").ok());
+  ASSERT_TRUE(inMemoryTier("/a"));
+  Http::TestResponseHeaderMapImpl updated_headers = responseHeaders();
+  updated_headers.setCopy(Http::LowerCaseString("etag"), "v2");
+  EXPECT_TRUE(updateHeaders("/a", updated_headers, ResponseMetadata{time_system_.systemTime()}));
+  EXPECT_FALSE(inMemoryTier("/a"));
+
+  // The updated response is served from the backing tier, and promoted again.
+  LookupContextPtr context = lookup("/a");
+  ASSERT_NE(lookup_result_.headers_, nullptr);
+  EXPECT_EQ(lookup_result_.headers_->get(Http::LowerCaseString("etag"))[0]->value(), "v2");
+  EXPECT_EQ(getBody(*context, 0, 4), std::make_pair(std::string("body"), true));
+  EXPECT_TRUE(inMemoryTier("/a"));
+}
+
+TEST_P(TieredHttpCacheTest, UpdateHeadersKeepsMemoryTierUntilBackingTierIsUpdated) {
+  // Only the memory tier has the response, so the backing tier update fails.
+  LookupRequest request = makeLookupRequest("/a");
+  ASSERT_TRUE(tieredCache().memoryTier().insert(
+      request.key(), request.requestHeaders(), request.varyAllowList(),
+      std::make_shared<const MemoryHttpCache::CachedResponse>(
+          Http::createHeaderMap<Http::ResponseHeaderMapImpl>(responseHeaders()),
+          ResponseMetadata{time_system_.systemTime()}, std::make_shared<const std::string>("body"),
+          nullptr)));
+  Http::TestResponseHeaderMapImpl updated_headers = responseHeaders();
+  updated_headers.setCopy(Http::LowerCaseString("etag"), "v2");
+  EXPECT_FALSE(updateHeaders("/a", updated_headers, ResponseMetadata{time_system_.systemTime()}));
+  EXPECT_TRUE(inMemoryTier("/a"));
+}
+
+TEST_P(TieredHttpCacheTest, InsertDuringBackingTierReadIsNotOverwrittenByPromotion) {
+  ASSERT_TRUE(insert("/a", responseHeaders(), "body").ok());
+  removeFromMemoryTier("/a");
+  LookupContextPtr context = lookup("/a");
+  EXPECT_EQ(lookup_result_.cache_entry_status_, CacheEntryStatus::Ok);
+
+  // A newer response is inserted while the previous one is being read from the backing tier.
+  Http::TestResponseHeaderMapImpl new_headers = responseHeaders();
+  new_headers.setCopy(Http::LowerCaseString("etag"), "v2");
+  ASSERT_TRUE(insert("/a", new_headers, "body").ok());
+  EXPECT_EQ(getBody(*context, 0, 4), std::make_pair(std::string("body"), true));
+
+  // The memory tier keeps the newer response rather than the one that was read.
+  MemoryHttpCache::CachedResponseSharedPtr cached =
+      tieredCache().memoryTier().lookup(makeLookupRequest("/a"));
+  ASSERT_NE(cached, nullptr);
+  EXPECT_EQ(cached->response_headers_->get(Http::LowerCaseString("etag"))[0]->value(), "v2");
+}
+
+class TieredHttpCacheFactoryTest : public testing::Test {
+protected:
+  TieredHttpCacheFactoryTest()
+      : factory_(Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+            "envoy.extensions.http.cache.tiered_http_cache.v3.TieredHttpCacheConfig")) {}
+
+  std::shared_ptr<HttpCache> getCache(const ConfigProto& config) {
+    envoy::extensions::filters::http::cache::v3::CacheConfig cache_config;
+    cache_config.mutable_typed_config()->PackFrom(config);
+    return factory_->getCache(cache_config, context_);
+  }
+
+  HttpCacheFactory* const factory_;
+  NiceMock<Server::Configuration::MockFactoryContext> context_;
+};
+
+TEST_F(TieredHttpCacheFactoryTest, SameNameSharesCache) {
+  ASSERT_NE(factory_, nullptr);
+  std::shared_ptr<HttpCache> cache = getCache(testConfig());
+  EXPECT_EQ(cache->cacheInfo().name_, "envoy.extensions.http.cache.tiered_http_cache");
+  EXPECT_EQ(getCache(testConfig()), cache);
+  ConfigProto mismatched_config = testConfig();
+  mismatched_config.mutable_memory_tier()->set_max_cache_size_bytes(2048);
+  EXPECT_THROW_WITH_REGEX(getCache(mismatched_config), EnvoyException,
+                          "mismatched TieredHttpCacheConfig with same name");
+}
+
+TEST_F(TieredHttpCacheFactoryTest, TieredBackingTierThrows) {
+  ASSERT_NE(factory_, nullptr);
+  ConfigProto config = testConfig();
+  config.mutable_backing_tier()->PackFrom(testConfig());
+  EXPECT_THROW_WITH_REGEX(getCache(config), EnvoyException, "can't be tiered");
+}
+
+} // namespace
+} // namespace TieredHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
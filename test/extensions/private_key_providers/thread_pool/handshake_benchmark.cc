@@ -0,0 +1,194 @@
+// Measures the rate of TLS handshakes a single worker thread completes when the server signs
+// inline and when the signing is offloaded to the thread pool private key provider. The client
+// side of the handshakes runs on the same thread, over in-memory BIO pairs, so the absolute rates
+// understate what a worker that only runs the server side achieves.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/thread_local/thread_local_impl.h"
+#include "source/extensions/private_key_providers/thread_pool/config.h"
+
+#include "test/mocks/server/server_factory_context.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+#include "openssl/ssl.h"
+#include "tools/cpp/runfiles/runfiles.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+namespace {
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+struct Handshake : public Ssl::PrivateKeyConnectionCallbacks {
+  explicit Handshake(Event::Dispatcher& dispatcher) : dispatcher_(dispatcher) {}
+
+  // Ssl::PrivateKeyConnectionCallbacks
+  void onPrivateKeyMethodComplete() override {
+    waiting_ = false;
+    dispatcher_.exit();
+  }
+
+  // Advances both sides of the handshake, and returns whether it is complete.
+  bool step() {
+    const int client_result = SSL_do_handshake(client_.get());
+    const int server_result = SSL_do_handshake(server_.get());
+    if (server_result != 1) {
+      const int error = SSL_get_error(server_.get(), server_result);
+      RELEASE_ASSERT(error == SSL_ERROR_WANT_READ ||
+                         error == SSL_ERROR_WANT_PRIVATE_KEY_OPERATION,
+                     absl::StrCat("server handshake error ", error));
+      waiting_ = error == SSL_ERROR_WANT_PRIVATE_KEY_OPERATION;
+    }
+    return client_result == 1 && server_result == 1;
+  }
+
+  Event::Dispatcher& dispatcher_;
+  bssl::UniquePtr<SSL> client_;
+  bssl::UniquePtr<SSL> server_;
+  bool waiting_{};
+  bool done_{};
+};
+
+class HandshakeBenchmark {
+public:
+  HandshakeBenchmark(const std::string& key, bool offload)
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("worker")),
+        client_ctx_(SSL_CTX_new(TLS_method())), server_ctx_(SSL_CTX_new(TLS_method())) {
+    tls_.registerThread(*dispatcher_, true);
+    ON_CALL(factory_context_.server_context_, api()).WillByDefault(ReturnRef(*api_));
+    ON_CALL(factory_context_.server_context_, threadLocal()).WillByDefault(ReturnRef(tls_));
+
+    const std::string cert_path = TestEnvironment::substitute(
+        absl::StrCat("{{ test_rundir }}/test/common/tls/test_data/", key, "_cert.pem"));
+    const std::string key_path = TestEnvironment::substitute(
+        absl::StrCat("{{ test_rundir }}/test/common/tls/test_data/", key, "_key.pem"));
+    RELEASE_ASSERT(SSL_CTX_use_certificate_chain_file(server_ctx_.get(), cert_path.c_str()) == 1,
+                   "");
+    if (!offload) {
+      RELEASE_ASSERT(
+          SSL_CTX_use_PrivateKey_file(server_ctx_.get(), key_path.c_str(), SSL_FILETYPE_PEM) == 1,
+          "");
+      return;
+    }
+
+    envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider config;
+    TestUtility::loadFromYaml(fmt::format(R"EOF(
+      provider_name: thread_pool
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.private_key_providers.thread_pool.v3.ThreadPoolPrivateKeyMethodConfig
+        private_key: {{ filename: "{}" }}
+        thread_count: 4
+)EOF",
+                                          key_path),
+                              config);
+    ThreadPoolPrivateKeyMethodFactory factory;
+    provider_ = factory.createPrivateKeyMethodProviderInstance(config, factory_context_);
+    SSL_CTX_set_private_key_method(server_ctx_.get(),
+                                   provider_->getBoringSslPrivateKeyMethod().get());
+  }
+
+  ~HandshakeBenchmark() {
+    provider_.reset();
+    tls_.shutdownGlobalThreading();
+    tls_.shutdownThread();
+  }
+
+  // Runs the given number of handshakes concurrently until they all completed.
+  void run(uint32_t concurrency) {
+    std::vector<std::unique_ptr<Handshake>> handshakes;
+    for (uint32_t i = 0; i < concurrency; ++i) {
+      auto handshake = std::make_unique<Handshake>(*dispatcher_);
+      handshake->client_.reset(SSL_new(client_ctx_.get()));
+      handshake->server_.reset(SSL_new(server_ctx_.get()));
+      BIO* client_bio;
+      BIO* server_bio;
+      RELEASE_ASSERT(BIO_new_bio_pair(&client_bio, 0, &server_bio, 0) == 1, "");
+      SSL_set_bio(handshake->client_.get(), client_bio, client_bio);
+      SSL_set_bio(handshake->server_.get(), server_bio, server_bio);
+      SSL_set_connect_state(handshake->client_.get());
+      SSL_set_accept_state(handshake->server_.get());
+      if (provider_ != nullptr) {
+        provider_->registerPrivateKeyMethod(handshake->server_.get(), *handshake, *dispatcher_);
+      }
+      handshakes.push_back(std::move(handshake));
+    }
+
+    uint32_t remaining = concurrency;
+    while (remaining > 0) {
+      bool all_waiting = true;
+      for (auto& handshake : handshakes) {
+        if (handshake->done_ || handshake->waiting_) {
+          continue;
+        }
+        if (handshake->step()) {
+          handshake->done_ = true;
+          --remaining;
+        } else if (!handshake->waiting_) {
+          all_waiting = false;
+        }
+      }
+      if (remaining > 0 && all_waiting) {
+        // Hand the signing operations to the pool, and wait for at least one to complete.
+        dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+      }
+    }
+
+    if (provider_ != nullptr) {
+      for (auto& handshake : handshakes) {
+        provider_->unregisterPrivateKeyMethod(handshake->server_.get());
+      }
+    }
+  }
+
+private:
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  ThreadLocal::InstanceImpl tls_;
+  NiceMock<Server::Configuration::MockTransportSocketFactoryContext> factory_context_;
+  bssl::UniquePtr<SSL_CTX> client_ctx_;
+  bssl::UniquePtr<SSL_CTX> server_ctx_;
+  Ssl::PrivateKeyMethodProviderSharedPtr provider_;
+};
+
+} // namespace
+
+static void bmHandshakes(benchmark::State& state) {
+  std::string error;
+  std::unique_ptr<bazel::tools::cpp::runfiles::Runfiles> runfiles(
+      bazel::tools::cpp::runfiles::Runfiles::Create("handshake_benchmark", &error));
+  Envoy::TestEnvironment::setRunfiles(runfiles.get());
+
+  const std::string key = state.range(0) == 0 ? "san_dns" : "san_dns_ecdsa_1";
+  const bool offload = state.range(1) != 0;
+  const uint32_t concurrency = state.range(2);
+  HandshakeBenchmark handshake_benchmark(key, offload);
+
+  uint64_t handshakes = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    handshake_benchmark.run(concurrency);
+    handshakes += concurrency;
+  }
+  state.counters["handshakes"] = benchmark::Counter(handshakes, benchmark::Counter::kIsRate);
+}
+
+// Arguments: key type (0 for RSA 2048, 1 for ECDSA P-256), whether signing is offloaded, and the
+// number of concurrent handshakes.
+BENCHMARK(bmHandshakes)
+    ->ArgsProduct({{0, 1}, {0, 1}, {1, 64}})
+    ->Unit(::benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
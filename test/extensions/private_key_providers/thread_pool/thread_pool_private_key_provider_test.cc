@@ -0,0 +1,282 @@
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/thread_local/thread_local_impl.h"
+#include "source/extensions/private_key_providers/thread_pool/config.h"
+#include "source/extensions/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/server/server_factory_context.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/evp.h"
+#include "openssl/pem.h"
+#include "openssl/rsa.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+namespace {
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+class MockPrivateKeyConnectionCallbacks : public Ssl::PrivateKeyConnectionCallbacks {
+public:
+  MOCK_METHOD(void, onPrivateKeyMethodComplete, ());
+};
+
+class ThreadPoolPrivateKeyProviderTest : public testing::Test {
+protected:
+  ThreadPoolPrivateKeyProviderTest()
+      : api_(Api::createApiForTest(store_)), dispatcher_(api_->allocateDispatcher("test_thread")),
+        ssl_ctx_(SSL_CTX_new(TLS_method())) {
+    ON_CALL(factory_context_.server_context_, api()).WillByDefault(ReturnRef(*api_));
+    ON_CALL(factory_context_.server_context_, threadLocal()).WillByDefault(ReturnRef(tls_));
+    ON_CALL(factory_context_, statsScope()).WillByDefault(ReturnRef(*store_.rootScope()));
+    tls_.registerThread(*dispatcher_, true);
+  }
+
+  ~ThreadPoolPrivateKeyProviderTest() override {
+    provider_.reset();
+    tls_.shutdownGlobalThreading();
+    tls_.shutdownThread();
+  }
+
+  static std::string keyPath(absl::string_view key) {
+    return absl::StrCat("{{ test_rundir }}/test/common/tls/test_data/", key);
+  }
+
+  void createProvider(absl::string_view key, uint32_t max_batch_size = 16) {
+    const std::string yaml = fmt::format(R"EOF(
+      provider_name: thread_pool
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.private_key_providers.thread_pool.v3.ThreadPoolPrivateKeyMethodConfig
+        private_key: {{ filename: "{}" }}
+        max_batch_size: {}
+)EOF",
+                                         keyPath(key), max_batch_size);
+    envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider config;
+    TestUtility::loadFromYaml(TestEnvironment::substitute(yaml), config);
+    ThreadPoolPrivateKeyMethodFactory factory;
+    provider_ = factory.createPrivateKeyMethodProviderInstance(config, factory_context_);
+    method_ = provider_->getBoringSslPrivateKeyMethod();
+  }
+
+  bssl::UniquePtr<SSL> newConnection(Ssl::PrivateKeyConnectionCallbacks& cb) {
+    bssl::UniquePtr<SSL> ssl(SSL_new(ssl_ctx_.get()));
+    provider_->registerPrivateKeyMethod(ssl.get(), cb, *dispatcher_);
+    return ssl;
+  }
+
+  static bssl::UniquePtr<EVP_PKEY> readKey(absl::string_view key) {
+    const std::string pem =
+        TestEnvironment::readFileToStringForTest(TestEnvironment::substitute(keyPath(key)));
+    bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(pem.data(), pem.size()));
+    return bssl::UniquePtr<EVP_PKEY>(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  }
+
+  static bool verify(absl::string_view key, uint16_t signature_algorithm,
+                     const std::string& message, const std::vector<uint8_t>& signature) {
+    bssl::UniquePtr<EVP_PKEY> pkey = readKey(key);
+    bssl::ScopedEVP_MD_CTX ctx;
+    EVP_PKEY_CTX* pctx;
+    if (!EVP_DigestVerifyInit(ctx.get(), &pctx,
+                              SSL_get_signature_algorithm_digest(signature_algorithm), nullptr,
+                              pkey.get())) {
+      return false;
+    }
+    if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm) &&
+        (!EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PSS_PADDING) ||
+         !EVP_PKEY_CTX_set_rsa_pss_saltlen(pctx, -1))) {
+      return false;
+    }
+    return EVP_DigestVerify(ctx.get(), signature.data(), signature.size(),
+                            reinterpret_cast<const uint8_t*>(message.data()), message.size());
+  }
+
+  ssl_private_key_result_t sign(SSL* ssl, uint16_t signature_algorithm) {
+    size_t out_len = 0;
+    return method_->sign(ssl, out_.data(), &out_len, out_.size(), signature_algorithm,
+                         reinterpret_cast<const uint8_t*>(message_.data()), message_.size());
+  }
+
+  ssl_private_key_result_t complete(SSL* ssl, std::vector<uint8_t>& output) {
+    size_t out_len = 0;
+    const ssl_private_key_result_t result =
+        method_->complete(ssl, out_.data(), &out_len, out_.size());
+    output.assign(out_.begin(), out_.begin() + out_len);
+    return result;
+  }
+
+  Stats::TestUtil::TestStore store_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  ThreadLocal::InstanceImpl tls_;
+  NiceMock<Server::Configuration::MockTransportSocketFactoryContext> factory_context_;
+  bssl::UniquePtr<SSL_CTX> ssl_ctx_;
+  Ssl::PrivateKeyMethodProviderSharedPtr provider_;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  const std::string message_{"message signed during the handshake"};
+  std::array<uint8_t, 512> out_{};
+};
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, InvalidPrivateKey) {
+  EXPECT_THROW_WITH_MESSAGE(createProvider("san_dns_cert.pem"), EnvoyException,
+                            "Failed to read private key.");
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, RsaSign) {
+  createProvider("san_dns_key.pem");
+  EXPECT_TRUE(provider_->isAvailable());
+  NiceMock<MockPrivateKeyConnectionCallbacks> cb;
+  bssl::UniquePtr<SSL> ssl = newConnection(cb);
+
+  EXPECT_EQ(sign(ssl.get(), SSL_SIGN_RSA_PSS_RSAE_SHA256), ssl_private_key_retry);
+  // The operation is not complete before the pool thread handed it back.
+  std::vector<uint8_t> signature;
+  EXPECT_EQ(complete(ssl.get(), signature), ssl_private_key_retry);
+
+  EXPECT_CALL(cb, onPrivateKeyMethodComplete()).WillOnce([this]() { dispatcher_->exit(); });
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  EXPECT_EQ(complete(ssl.get(), signature), ssl_private_key_success);
+  EXPECT_TRUE(verify("san_dns_key.pem", SSL_SIGN_RSA_PSS_RSAE_SHA256, message_, signature));
+  EXPECT_EQ(store_.counter("thread_pool_private_key.operations").value(), 1);
+
+  provider_->unregisterPrivateKeyMethod(ssl.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, EcdsaSign) {
+  createProvider("san_dns_ecdsa_1_key.pem");
+  NiceMock<MockPrivateKeyConnectionCallbacks> cb;
+  bssl::UniquePtr<SSL> ssl = newConnection(cb);
+
+  // A signature algorithm for another key type fails once the operation is complete.
+  EXPECT_EQ(sign(ssl.get(), SSL_SIGN_RSA_PKCS1_SHA256), ssl_private_key_retry);
+  EXPECT_CALL(cb, onPrivateKeyMethodComplete()).WillRepeatedly([this]() { dispatcher_->exit(); });
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  std::vector<uint8_t> signature;
+  EXPECT_EQ(complete(ssl.get(), signature), ssl_private_key_failure);
+  EXPECT_EQ(store_.counter("thread_pool_private_key.failures").value(), 1);
+
+  EXPECT_EQ(sign(ssl.get(), SSL_SIGN_ECDSA_SECP256R1_SHA256), ssl_private_key_retry);
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  EXPECT_EQ(complete(ssl.get(), signature), ssl_private_key_success);
+  EXPECT_TRUE(verify("san_dns_ecdsa_1_key.pem", SSL_SIGN_ECDSA_SECP256R1_SHA256, message_,
+                     signature));
+
+  // Only RSA keys decrypt.
+  size_t out_len = 0;
+  EXPECT_EQ(method_->decrypt(ssl.get(), out_.data(), &out_len, out_.size(), out_.data(), 32),
+            ssl_private_key_failure);
+
+  provider_->unregisterPrivateKeyMethod(ssl.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, RsaDecrypt) {
+  createProvider("san_dns_key.pem");
+  NiceMock<MockPrivateKeyConnectionCallbacks> cb;
+  bssl::UniquePtr<SSL> ssl = newConnection(cb);
+
+  bssl::UniquePtr<EVP_PKEY> pkey = readKey("san_dns_key.pem");
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey.get());
+  std::vector<uint8_t> plaintext(RSA_size(rsa), 0);
+  plaintext.back() = 42;
+  std::vector<uint8_t> ciphertext(RSA_size(rsa));
+  size_t ciphertext_len;
+  ASSERT_TRUE(RSA_encrypt(rsa, &ciphertext_len, ciphertext.data(), ciphertext.size(),
+                          plaintext.data(), plaintext.size(), RSA_NO_PADDING));
+
+  size_t out_len = 0;
+  EXPECT_EQ(method_->decrypt(ssl.get(), out_.data(), &out_len, out_.size(), ciphertext.data(),
+                             ciphertext_len),
+            ssl_private_key_retry);
+  EXPECT_CALL(cb, onPrivateKeyMethodComplete()).WillOnce([this]() { dispatcher_->exit(); });
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  std::vector<uint8_t> output;
+  EXPECT_EQ(complete(ssl.get(), output), ssl_private_key_success);
+  EXPECT_EQ(output, plaintext);
+
+  provider_->unregisterPrivateKeyMethod(ssl.get());
+}
+
+// Operations started in the same event loop iteration are handed to the pool and back together,
+// and the operations of closed connections are not completed.
+TEST_F(ThreadPoolPrivateKeyProviderTest, BatchesOperationsOfAnIteration) {
+  createProvider("san_dns_key.pem");
+  constexpr int NumConnections = 5;
+  std::array<NiceMock<MockPrivateKeyConnectionCallbacks>, NumConnections> cbs;
+  std::vector<bssl::UniquePtr<SSL>> connections;
+  for (auto& cb : cbs) {
+    connections.push_back(newConnection(cb));
+    EXPECT_EQ(sign(connections.back().get(), SSL_SIGN_RSA_PKCS1_SHA256), ssl_private_key_retry);
+  }
+  // The first connection is closed while its operation is in progress.
+  EXPECT_CALL(cbs[0], onPrivateKeyMethodComplete()).Times(0);
+  provider_->unregisterPrivateKeyMethod(connections[0].get());
+
+  int completed = 0;
+  for (int i = 1; i < NumConnections; ++i) {
+    EXPECT_CALL(cbs[i], onPrivateKeyMethodComplete()).WillOnce([this, &completed]() {
+      if (++completed == NumConnections - 1) {
+        dispatcher_->exit();
+      }
+    });
+  }
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  EXPECT_THAT(store_.histogramValues("thread_pool_private_key.batch_sizes", false),
+              testing::ElementsAre(NumConnections));
+
+  for (int i = 1; i < NumConnections; ++i) {
+    std::vector<uint8_t> signature;
+    EXPECT_EQ(complete(connections[i].get(), signature), ssl_private_key_success);
+    EXPECT_TRUE(verify("san_dns_key.pem", SSL_SIGN_RSA_PKCS1_SHA256, message_, signature));
+    provider_->unregisterPrivateKeyMethod(connections[i].get());
+  }
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, FullBatchIsHandedOverImmediately) {
+  createProvider("san_dns_ecdsa_1_key.pem", 2);
+  constexpr int NumConnections = 5;
+  std::array<NiceMock<MockPrivateKeyConnectionCallbacks>, NumConnections> cbs;
+  std::vector<bssl::UniquePtr<SSL>> connections;
+  int completed = 0;
+  for (auto& cb : cbs) {
+    EXPECT_CALL(cb, onPrivateKeyMethodComplete()).WillOnce([this, &completed]() {
+      if (++completed == NumConnections) {
+        dispatcher_->exit();
+      }
+    });
+    connections.push_back(newConnection(cb));
+    EXPECT_EQ(sign(connections.back().get(), SSL_SIGN_ECDSA_SECP256R1_SHA256),
+              ssl_private_key_retry);
+  }
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  EXPECT_THAT(store_.histogramValues("thread_pool_private_key.batch_sizes", false),
+              testing::ElementsAre(2, 2, 1));
+
+  for (bssl::UniquePtr<SSL>& ssl : connections) {
+    provider_->unregisterPrivateKeyMethod(ssl.get());
+  }
+}
+
+TEST(PrivateKeyThreadPoolRegistryTest, SharesPoolsWithTheSameThreadCount) {
+  Api::ApiPtr api = Api::createApiForTest();
+  PrivateKeyThreadPoolRegistry registry;
+  PrivateKeyThreadPoolSharedPtr pool = registry.getOrCreate(2, api->threadFactory());
+  EXPECT_EQ(registry.getOrCreate(2, api->threadFactory()), pool);
+  EXPECT_NE(registry.getOrCreate(3, api->threadFactory()), pool);
+}
+
+} // namespace
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
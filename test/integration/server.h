@@ -316,6 +316,18 @@ public:
     Thread::LockGuard lock(lock_);
     store_.forEachSinkedHistogram(f_size, f_stat);
   }
+  void forEachChangedCounter(Stats::SizeFn f_size, StatFn<Counter> f_stat) override {
+    Thread::LockGuard lock(lock_);
+    store_.forEachChangedCounter(f_size, f_stat);
+  }
+  void forEachChangedGauge(Stats::SizeFn f_size, StatFn<Gauge> f_stat) override {
+    Thread::LockGuard lock(lock_);
+    store_.forEachChangedGauge(f_size, f_stat);
+  }
+  void forEachChangedTextReadout(Stats::SizeFn f_size, StatFn<TextReadout> f_stat) override {
+    Thread::LockGuard lock(lock_);
+    store_.forEachChangedTextReadout(f_size, f_stat);
+  }
   void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) override {
     UNREFERENCED_PARAMETER(sink_predicates);
   }
@@ -25,12 +25,21 @@ public:
   MOCK_METHOD(IoUringResult, prepareWritev,
               (os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                Request* user_data));
+  MOCK_METHOD(IoUringResult, prepareSendmsgZc,
+              (os_fd_t fd, const struct msghdr* msg, Request* user_data));
+  MOCK_METHOD(IoUringResult, prepareRecvMultishot, (os_fd_t fd, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareClose, (os_fd_t fd, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareCancel, (Request * cancelling_user_data, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareShutdown, (os_fd_t fd, int how, Request* user_data));
   MOCK_METHOD(IoUringResult, submit, ());
   MOCK_METHOD(void, injectCompletion, (os_fd_t fd, Request* user_data, int32_t result));
   MOCK_METHOD(void, removeInjectedCompletion, (os_fd_t fd));
+  MOCK_METHOD(bool, registerBufferRing, (uint32_t count, uint32_t size));
+  MOCK_METHOD(void, moveProvidedBufferData,
+              (uint16_t buffer_id, uint32_t length, Buffer::Instance& buffer));
+  MOCK_METHOD(void, releaseProvidedBuffer, (uint16_t buffer_id));
+  MOCK_METHOD(bool, registerFile, (os_fd_t fd));
+  MOCK_METHOD(void, unregisterFile, (os_fd_t fd));
 };
 
 class MockIoUringSocket : public IoUringSocket {
@@ -165,6 +165,9 @@ public:
   MOCK_METHOD(const std::vector<SessionTicketKey>&, sessionTicketKeys, (), (const));
   MOCK_METHOD(bool, disableStatelessSessionResumption, (), (const));
   MOCK_METHOD(bool, disableStatefulSessionResumption, (), (const));
+  MOCK_METHOD(const envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext::
+                  SharedSessionResumption*,
+              sharedSessionResumption, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogLocal, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogRemote, (), (const));
   MOCK_METHOD(const std::string&, tlsKeyLogPath, (), (const));
@@ -1,3 +1,4 @@
+#include <limits>
 #include <regex>
 #include <string>
 #include <vector>
@@ -12,6 +13,8 @@
 #include "test/test_common/stats_utility.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_join.h"
+
 using testing::NiceMock;
 using testing::ReturnRef;
 
@@ -1025,5 +1028,78 @@ envoy_cluster_endpoint_c1{a_tag_name="a.tag-value",envoy_cluster_name="test_1",e
   }
 }
 
+TEST_F(PrometheusStatsFormatterTest, RendererChunksByMetricFamily) {
+  Stats::CustomStatNamespacesImpl custom_namespaces;
+  addCounter("cluster.test_1.upstream_cx_total",
+             {{makeStat("a.tag-name"), makeStat("a.tag-value")}});
+  addCounter("cluster.test_2.upstream_cx_total",
+             {{makeStat("another_tag_name"), makeStat("another_tag-value")}});
+  addGauge("cluster.test_3.upstream_cx_total",
+           {{makeStat("another_tag_name_3"), makeStat("another_tag_3-value")}});
+
+  Buffer::OwnedImpl expected;
+  PrometheusStatsFormatter::statsAsPrometheus(counters_, gauges_, histograms_, textReadouts_,
+                                              endpoints_helper_->cm_, expected, StatsParams(),
+                                              custom_namespaces);
+
+  // With a one byte chunk size, every chunk holds exactly one metric family.
+  PrometheusStatsFormatter::Renderer renderer(counters_, gauges_, histograms_, textReadouts_,
+                                              endpoints_helper_->cm_, StatsParams(),
+                                              custom_namespaces, nullptr);
+  Buffer::OwnedImpl response;
+  std::vector<std::string> chunks;
+  bool more = true;
+  while (more) {
+    more = renderer.nextChunk(response, 1);
+    chunks.push_back(response.toString());
+    response.drain(response.length());
+  }
+  EXPECT_EQ(3UL, renderer.metricNameCount());
+  EXPECT_EQ("# TYPE envoy_cluster_test_1_upstream_cx_total counter\n"
+            "envoy_cluster_test_1_upstream_cx_total{a_tag_name=\"a.tag-value\"} 0\n",
+            chunks[0]);
+  EXPECT_EQ(expected.toString(), absl::StrJoin(chunks, ""));
+}
+
+TEST_F(PrometheusStatsFormatterTest, NameCacheReusedAcrossScrapes) {
+  Stats::CustomStatNamespacesImpl custom_namespaces;
+  addCounter("cluster.test_1.upstream_cx_total",
+             {{makeStat("a.tag-name"), makeStat("a.tag-value")}});
+  addCounter("cluster.test_2.upstream_cx_total",
+             {{makeStat("another_tag_name"), makeStat("another_tag-value")}});
+  addGauge("cluster.test_3.upstream_cx_total",
+           {{makeStat("another_tag_name_3"), makeStat("another_tag_3-value")}});
+
+  Buffer::OwnedImpl expected;
+  PrometheusStatsFormatter::statsAsPrometheus(counters_, gauges_, histograms_, textReadouts_,
+                                              endpoints_helper_->cm_, expected, StatsParams(),
+                                              custom_namespaces);
+
+  {
+    PrometheusNameCache cache(*symbol_table_);
+    auto scrape = [&]() {
+      PrometheusStatsFormatter::Renderer renderer(counters_, gauges_, histograms_, textReadouts_,
+                                                  endpoints_helper_->cm_, StatsParams(),
+                                                  custom_namespaces, &cache);
+      Buffer::OwnedImpl response;
+      while (renderer.nextChunk(response, std::numeric_limits<uint64_t>::max())) {
+      }
+      cache.endScrape();
+      return response.toString();
+    };
+
+    // Each stat has a family name and a formatted tags entry.
+    EXPECT_EQ(expected.toString(), scrape());
+    EXPECT_EQ(6UL, cache.size());
+    EXPECT_EQ(expected.toString(), scrape());
+    EXPECT_EQ(6UL, cache.size());
+
+    // Entries of stats that are no longer rendered are dropped at the end of the scrape.
+    gauges_.clear();
+    scrape();
+    EXPECT_EQ(4UL, cache.size());
+  }
+}
+
 } // namespace Server
 } // namespace Envoy
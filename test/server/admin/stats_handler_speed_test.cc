@@ -5,6 +5,7 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/stats/custom_stat_namespaces_impl.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_handler.h"
 
 #include "test/benchmark/main.h"
@@ -211,10 +212,34 @@ public:
     return count;
   }
 
+  /**
+   * Issues a streamed prometheus request against the stats saved in store_, reusing the names
+   * cached by previous requests.
+   */
+  uint64_t handlerPrometheusStream(const StatsParams& params) {
+    if (prometheus_name_cache_ == nullptr) {
+      prometheus_name_cache_ = std::make_unique<PrometheusNameCache>(store_->symbolTable());
+    }
+    PrometheusStatsRequest request(*store_, params, cm_, custom_namespaces_,
+                                   *prometheus_name_cache_);
+    auto response_headers = Http::ResponseHeaderMapImpl::create();
+    request.start(*response_headers);
+    Buffer::OwnedImpl data;
+    uint64_t count = 0;
+    bool more = true;
+    do {
+      more = request.nextChunk(data);
+      count += data.length();
+      data.drain(data.length());
+    } while (more);
+    return count;
+  }
+
   std::vector<Stats::ScopeSharedPtr> scopes_;
   Envoy::Stats::CustomStatNamespacesImpl custom_namespaces_;
   FastMockClusterManager cm_;
   bool endpoint_stats_initialized_{false};
+  std::unique_ptr<PrometheusNameCache> prometheus_name_cache_;
 };
 
 } // namespace Server
@@ -382,6 +407,27 @@ BENCHMARK_CAPTURE(BM_AllCountersPrometheus, per_endpoint_stats_disabled, false)
 BENCHMARK_CAPTURE(BM_AllCountersPrometheus, per_endpoint_stats_enabled, true)
     ->Unit(benchmark::kMillisecond);
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AllCountersPrometheusStreamed(benchmark::State& state, bool per_endpoint_stats) {
+  Envoy::Server::StatsHandlerTest& test_context = testContext(per_endpoint_stats);
+  Envoy::Server::StatsParams params;
+  Envoy::Buffer::OwnedImpl response;
+  params.parse("?format=prometheus&type=Counters", response);
+
+  uint64_t count;
+  for (auto _ : state) { // NOLINT
+    count = test_context.handlerPrometheusStream(params);
+    RELEASE_ASSERT(count > 250 * 1000 * 1000, "expected count > 250M");
+  }
+
+  auto label = absl::StrCat("output per iteration: ", count);
+  state.SetLabel(label);
+}
+BENCHMARK_CAPTURE(BM_AllCountersPrometheusStreamed, per_endpoint_stats_disabled, false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AllCountersPrometheusStreamed, per_endpoint_stats_enabled, true)
+    ->Unit(benchmark::kMillisecond);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_UsedCountersPrometheus(benchmark::State& state, bool per_endpoint_stats) {
   Envoy::Server::StatsHandlerTest& test_context = testContext(per_endpoint_stats);
@@ -3,11 +3,14 @@
 
 #include "source/common/common/regex.h"
 #include "source/common/stats/custom_stat_namespaces_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/extensions/compression/gzip/decompressor/zlib_decompressor_impl.h"
 #include "source/server/admin/stats_handler.h"
 #include "source/server/admin/stats_request.h"
 
 #include "test/mocks/server/admin_stream.h"
+#include "test/mocks/server/factory_context.h"
 #include "test/mocks/server/instance.h"
 #include "test/mocks/server/server_factory_context.h"
 #include "test/server/admin/admin_instance.h"
@@ -1420,6 +1423,56 @@ TEST_F(StatsHandlerPrometheusDefaultTest, StatsHandlerPrometheusInvalidRegex) {
   EXPECT_THAT(code_response.second, HasSubstr("Invalid re2 regex"));
 }
 
+TEST_F(StatsHandlerPrometheusDefaultTest, StatsHandlerPrometheusGzip) {
+  createTestStats();
+
+  NiceMock<MockInstance> instance;
+  NiceMock<Configuration::MockFactoryContext> factory_context;
+  EXPECT_CALL(admin_stream_, getRequestHeaders()).WillRepeatedly(ReturnRef(request_headers_));
+  EXPECT_CALL(instance, statsConfig()).WillRepeatedly(ReturnRef(stats_config_));
+  EXPECT_CALL(stats_config_, flushOnAdmin()).WillRepeatedly(Return(false));
+  ON_CALL(instance, stats()).WillByDefault(ReturnRef(*store_));
+  ON_CALL(instance, clusterManager()).WillByDefault(ReturnRef(endpoints_helper_.cm_));
+  EXPECT_CALL(instance, api()).WillRepeatedly(ReturnRef(api_));
+  EXPECT_CALL(api_, customStatNamespaces()).WillRepeatedly(ReturnRef(custom_namespaces_));
+  StatsHandler handler(instance, factory_context);
+  request_headers_.setPath("/stats/prometheus");
+
+  // A zero quality value means the coding is not acceptable.
+  request_headers_.setCopy(Http::CustomHeaders::get().AcceptEncoding, "gzip;q=0, identity");
+  {
+    Admin::RequestPtr request = handler.makePrometheusRequest(admin_stream_);
+    Http::TestResponseHeaderMapImpl response_headers;
+    EXPECT_EQ(Http::Code::OK, request->start(response_headers));
+    EXPECT_FALSE(response_headers.has(Http::CustomHeaders::get().ContentEncoding));
+  }
+
+  request_headers_.setCopy(Http::CustomHeaders::get().AcceptEncoding, "br, GZIP;q=0.5");
+  Admin::RequestPtr request = handler.makePrometheusRequest(admin_stream_);
+  Http::TestResponseHeaderMapImpl response_headers;
+  EXPECT_EQ(Http::Code::OK, request->start(response_headers));
+  EXPECT_EQ("gzip", response_headers.get_(Http::CustomHeaders::get().ContentEncoding));
+  EXPECT_EQ("Accept-Encoding", response_headers.get_(Http::CustomHeaders::get().Vary));
+  Buffer::OwnedImpl compressed;
+  while (request->nextChunk(compressed)) {
+  }
+
+  Stats::IsolatedStoreImpl decompressor_store;
+  Extensions::Compression::Gzip::Decompressor::ZlibDecompressorImpl decompressor(
+      *decompressor_store.rootScope(), "test.", 4096, 100);
+  decompressor.init(31);
+  Buffer::OwnedImpl decompressed;
+  decompressor.decompress(compressed, decompressed);
+  EXPECT_EQ(R"EOF(# TYPE envoy_cluster_upstream_cx_total counter
+envoy_cluster_upstream_cx_total{cluster="c1"} 10
+envoy_cluster_upstream_cx_total{cluster="c2"} 20
+# TYPE envoy_cluster_upstream_cx_active gauge
+envoy_cluster_upstream_cx_active{cluster="c1"} 11
+envoy_cluster_upstream_cx_active{cluster="c2"} 12
+)EOF",
+            decompressed.toString());
+}
+
 TEST_F(StatsHandlerPrometheusDefaultTest, HandlerStatsPrometheusDefaultHistogramEmission) {
   const std::string url = "/stats?format=prometheus";
 
@@ -1,5 +1,6 @@
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "envoy/stats/sink.h"
 #include "envoy/stats/stats.h"
@@ -42,6 +43,12 @@ private:
   size_t num_histograms_ = 0;
 };
 
+// A sink that only needs the stats changed since the previous flush.
+class ChangedStatsOnlySink : public testing::NiceMock<Stats::MockSink> {
+public:
+  bool changedStatsOnly() const override { return true; }
+};
+
 class StatsSinkFlushSpeedTest {
 public:
   StatsSinkFlushSpeedTest(size_t const num_stats, bool set_sink_predicates = false)
@@ -54,7 +61,12 @@ public:
     // Create counters
     for (uint64_t idx = 0; idx < num_stats; ++idx) {
       auto stat_name = pool_.add(absl::StrCat("counter.", idx));
-      stats_store_.rootScope()->counterFromStatName(stat_name).inc();
+      Stats::Counter& counter = stats_store_.rootScope()->counterFromStatName(stat_name);
+      counter.inc();
+      // Change one counter out of a hundred between flushes.
+      if (idx % 100 == 0) {
+        changing_counters_.push_back(&counter);
+      }
     }
     // Create gauges
     for (uint64_t idx = 0; idx < num_stats; ++idx) {
@@ -78,11 +90,18 @@ public:
     }
   }
 
-  void test(::benchmark::State& state) {
+  void test(::benchmark::State& state, bool changed_stats_only = false) {
     for (auto _ : state) {
       UNREFERENCED_PARAMETER(_);
+      for (Stats::Counter* counter : changing_counters_) {
+        counter->inc();
+      }
       std::list<Stats::SinkPtr> sinks;
-      sinks.emplace_back(new testing::NiceMock<Stats::MockSink>());
+      if (changed_stats_only) {
+        sinks.emplace_back(new ChangedStatsOnlySink());
+      } else {
+        sinks.emplace_back(new testing::NiceMock<Stats::MockSink>());
+      }
       Server::InstanceUtil::flushMetricsToSinks(sinks, stats_store_, cm_, time_system_);
     }
   }
@@ -94,6 +113,7 @@ private:
   Stats::ThreadLocalStoreImpl stats_store_;
   Event::SimulatedTimeSystem time_system_;
   FastMockClusterManager cm_;
+  std::vector<Stats::Counter*> changing_counters_;
 };
 
 static void bmFlushToSinks(::benchmark::State& state) {
@@ -118,10 +138,25 @@ static void bmFlushToSinksWithPredicatesSet(::benchmark::State& state) {
   speed_test.test(state);
 }
 
+static void bmFlushChangedToSinks(::benchmark::State& state) {
+  // Skip expensive benchmarks for unit tests.
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 100) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  StatsSinkFlushSpeedTest speed_test(state.range(0));
+  speed_test.test(state, true);
+}
+
 BENCHMARK(bmFlushToSinks)->Unit(::benchmark::kMillisecond)->RangeMultiplier(10)->Range(10, 1000000);
 BENCHMARK(bmFlushToSinksWithPredicatesSet)
     ->Unit(::benchmark::kMillisecond)
     ->RangeMultiplier(10)
     ->Range(10, 1000000);
+BENCHMARK(bmFlushChangedToSinks)
+    ->Unit(::benchmark::kMillisecond)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000000);
 
 } // namespace Envoy
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -14,6 +15,7 @@
 #include "source/common/network/listen_socket_impl.h"
 #include "source/common/network/socket_option_impl.h"
 #include "source/common/protobuf/protobuf.h"
+#include "source/common/stats/thread_local_store.h"
 #include "source/common/thread_local/thread_local_impl.h"
 #include "source/common/version/version.h"
 #include "source/server/instance_impl.h"
@@ -163,6 +165,53 @@ TEST(ServerInstanceUtil, flushImportModeUninitializedGauges) {
   InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
 }
 
+class ChangedStatsOnlySink : public Stats::MockSink {
+public:
+  bool changedStatsOnly() const override { return true; }
+};
+
+// When every sink only wants changed stats, the snapshot leaves out the unchanged ones.
+TEST(ServerInstanceUtil, flushChangedStatsOnly) {
+  NiceMock<Upstream::MockClusterManager> cm;
+  Stats::SymbolTableImpl symbol_table;
+  Stats::AllocatorImpl alloc(symbol_table);
+  Stats::ThreadLocalStoreImpl store(alloc);
+  Event::SimulatedTimeSystem time_system;
+  Stats::Counter& c1 = store.counterFromString("c1");
+  Stats::Counter& c2 = store.counterFromString("c2");
+  store.gaugeFromString("g", Stats::Gauge::ImportMode::Accumulate).set(5);
+  c1.inc();
+
+  std::list<Stats::SinkPtr> sinks;
+  Stats::MockSink* sink = new NiceMock<ChangedStatsOnlySink>();
+  sinks.emplace_back(sink);
+
+  // Changes are only tracked from the first flush on, so it includes every stat.
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.counters().size(), 2);
+    EXPECT_EQ(snapshot.gauges().size(), 1);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+
+  c2.add(3);
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.counters().size(), 1);
+    EXPECT_EQ(snapshot.counters()[0].counter_.get().name(), "c2");
+    EXPECT_EQ(snapshot.counters()[0].delta_, 3);
+    EXPECT_TRUE(snapshot.gauges().empty());
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+  EXPECT_EQ(1, c1.value());
+
+  // A sink that wants every stat gets all of them.
+  sinks.emplace_back(new NiceMock<Stats::MockSink>());
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.counters().size(), 2);
+    EXPECT_EQ(snapshot.gauges().size(), 1);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+}
+
 TEST(ServerInstanceUtil, RaiseFileLimits) {
   Api::MockOsSysCalls os_sys_calls_;
   TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls{&os_sys_calls_};
@@ -437,6 +486,40 @@ public:
   std::string name() const override { return "envoy.custom_stats_sink"; }
 };
 
+// Stats sink that is flushed on the stats sink thread, and records whether it was flushed on the
+// main thread.
+class SinkThreadStatsSink : public CustomStatsSink {
+public:
+  SinkThreadStatsSink(Stats::Scope& scope, Event::Dispatcher& main_thread_dispatcher,
+                      std::atomic<bool>& flushed_on_main_thread)
+      : CustomStatsSink(scope), main_thread_dispatcher_(main_thread_dispatcher),
+        flushed_on_main_thread_(flushed_on_main_thread) {}
+
+  // Stats::Sink
+  void flush(Stats::MetricSnapshot& snapshot) override {
+    flushed_on_main_thread_ = main_thread_dispatcher_.isThreadSafe();
+    CustomStatsSink::flush(snapshot);
+  }
+  bool flushOnSinkThread() const override { return true; }
+
+private:
+  Event::Dispatcher& main_thread_dispatcher_;
+  std::atomic<bool>& flushed_on_main_thread_;
+};
+
+class SinkThreadStatsSinkFactory : public CustomStatsSinkFactory {
+public:
+  // StatsSinkFactory
+  absl::StatusOr<Stats::SinkPtr>
+  createStatsSink(const Protobuf::Message&,
+                  Server::Configuration::ServerFactoryContext& server) override {
+    return std::make_unique<SinkThreadStatsSink>(server.scope(), server.mainThreadDispatcher(),
+                                                 flushed_on_main_thread_);
+  }
+
+  std::atomic<bool> flushed_on_main_thread_{true};
+};
+
 // CustomListenerHooks is used for synchronization between test thread and server thread.
 class CustomListenerHooks : public DefaultListenerHooks {
 public:
@@ -563,6 +646,21 @@ TEST_P(ServerInstanceImplTest, StatsFlushWhenServerIsStillInitializing) {
   server_thread->join();
 }
 
+// Validates that sinks which opt in are flushed on the stats sink thread.
+TEST_P(ServerInstanceImplTest, StatsFlushOnSinkThread) {
+  SinkThreadStatsSinkFactory factory;
+  Registry::InjectFactory<Server::Configuration::StatsSinkFactory> registered(factory);
+
+  auto server_thread =
+      startTestServer("test/server/test_data/server/stats_sink_bootstrap.yaml", true);
+
+  EXPECT_TRUE(TestUtility::waitForCounterEq(stats_store_, "stats.flushed", 1, time_system_));
+  EXPECT_FALSE(factory.flushed_on_main_thread_);
+
+  server_->dispatcher().post([&] { server_->shutdown(); });
+  server_thread->join();
+}
+
 // Validates that the "server.version" is updated with stats_server_version_override from bootstrap.
 TEST_P(ServerInstanceImplTest, ProxyVersionOveridesFromBootstrap) {
   auto server_thread =
@@ -1185,6 +1185,9 @@ public:
     return StatefulHeaderKeyFormatterOptConstRef(header_map_->formatter());
   }
   StatefulHeaderKeyFormatterOptRef formatter() override { return header_map_->formatter(); }
+  void pinStorage(std::shared_ptr<void> storage) override {
+    header_map_->pinStorage(std::move(storage));
+  }
 
   std::unique_ptr<Impl> header_map_{Impl::create()};
 };
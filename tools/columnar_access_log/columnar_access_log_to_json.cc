@@ -0,0 +1,85 @@
+/**
+ * Utility to convert a file written by the envoy.access_loggers.columnar_file access logger to
+ * JSON lines, one object per record.
+ *
+ * Usage:
+ *
+ * columnar_access_log_to_json <input path> [<output JSON lines path>]
+ *
+ * Without an output path, the records are written to standard output.
+ */
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "source/common/json/json_sanitizer.h"
+#include "source/extensions/access_loggers/columnar_file/columnar_block.h"
+
+namespace {
+
+void writeRecords(const Envoy::Extensions::AccessLoggers::ColumnarFile::DecodedBlock& block,
+                  std::ostream& output) {
+  std::string buffer;
+  for (const std::vector<std::string>& record : block.records_) {
+    output << '{';
+    for (size_t i = 0; i < record.size(); ++i) {
+      if (i > 0) {
+        output << ',';
+      }
+      output << '"' << Envoy::Json::sanitize(buffer, block.column_names_[i]) << "\":\"";
+      output << Envoy::Json::sanitize(buffer, record[i]) << '"';
+    }
+    output << "}\n";
+  }
+}
+
+} // namespace
+
+// NOLINT(namespace-envoy)
+int main(int argc, char** argv) {
+  namespace ColumnarFile = Envoy::Extensions::AccessLoggers::ColumnarFile;
+
+  if (argc != 2 && argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <input path> [<output JSON lines path>]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ifstream input(argv[1], std::ios::binary);
+  if (!input) {
+    std::cerr << "unable to open " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string data{std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()};
+
+  std::ofstream output_file;
+  if (argc == 3) {
+    output_file.open(argv[2]);
+    if (!output_file) {
+      std::cerr << "unable to open " << argv[2] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream& output = argc == 3 ? output_file : std::cout;
+
+  const auto frames = ColumnarFile::splitFrames(data);
+  if (!frames.ok()) {
+    std::cerr << frames.status().message() << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (const absl::string_view frame : frames.value()) {
+    const auto payload = ColumnarFile::decompressFrame(frame);
+    if (!payload.ok()) {
+      std::cerr << payload.status().message() << std::endl;
+      return EXIT_FAILURE;
+    }
+    const auto block = ColumnarFile::decodeBlock(payload.value());
+    if (!block.ok()) {
+      std::cerr << block.status().message() << std::endl;
+      return EXIT_FAILURE;
+    }
+    writeRecords(block.value(), output);
+  }
+  return EXIT_SUCCESS;
+}